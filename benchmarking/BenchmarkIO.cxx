@@ -0,0 +1,234 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include "Benchmarker.h"
+
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/RuntimeDeviceTracker.h>
+#include <vtkm/cont/Timer.h>
+
+#include <vtkm/filter/FieldSelection.h>
+#include <vtkm/filter/geometry_refinement/Tetrahedralize.h>
+
+#include <vtkm/io/VTKDataSetWriter.h>
+#include <vtkm/io/internal/Endian.h>
+#include <vtkm/io/internal/VTKDataSetTypes.h>
+
+#include <vtkm/source/Wavelet.h>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace
+{
+
+// Make this global so benchmarks can access the current device id:
+vtkm::cont::InitializeResult Config;
+
+const std::string OutputFileName = "BenchmarkIO-output.vtk";
+
+// Returns a tetrahedralized wavelet of the given dimension. Data sets are cached so that they
+// are only generated once for each size.
+const vtkm::cont::DataSet& GetUnstructuredDataSet(vtkm::Id dim)
+{
+  static std::map<vtkm::Id, vtkm::cont::DataSet> dataSets;
+  auto entry = dataSets.find(dim);
+  if (entry == dataSets.end())
+  {
+    vtkm::source::Wavelet source;
+    source.SetExtent({ 0 }, { dim - 1 });
+
+    vtkm::filter::geometry_refinement::Tetrahedralize tet;
+    tet.SetFieldsToPass(vtkm::filter::FieldSelection(vtkm::filter::FieldSelection::Mode::All));
+    entry = dataSets.emplace(dim, tet.Execute(source.Execute())).first;
+  }
+  return entry->second;
+}
+
+vtkm::UInt64 GetFileSize(const std::string& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  return static_cast<vtkm::UInt64>(file.tellg());
+}
+
+void BenchWrite(benchmark::State& state, vtkm::io::FileType fileType)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::cont::DataSet& dataSet =
+    GetUnstructuredDataSet(static_cast<vtkm::Id>(state.range(0)));
+
+  vtkm::io::VTKDataSetWriter writer(OutputFileName);
+  writer.SetFileType(fileType);
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    writer.WriteDataSet(dataSet);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+
+  const vtkm::UInt64 numBytes = GetFileSize(OutputFileName);
+  std::remove(OutputFileName.c_str());
+  state.SetLabel(vtkm::cont::GetHumanReadableSize(numBytes));
+  state.SetBytesProcessed(static_cast<int64_t>(numBytes) * state.iterations());
+  state.SetItemsProcessed(dataSet.GetNumberOfCells() * state.iterations());
+}
+
+void BenchWriteASCII(benchmark::State& state)
+{
+  BenchWrite(state, vtkm::io::FileType::ASCII);
+}
+VTKM_BENCHMARK_OPTS(BenchWriteASCII, ->ArgName("Dim")->Arg(32)->Arg(64));
+
+void BenchWriteBinary(benchmark::State& state)
+{
+  BenchWrite(state, vtkm::io::FileType::BINARY);
+}
+VTKM_BENCHMARK_OPTS(BenchWriteBinary, ->ArgName("Dim")->Arg(32)->Arg(64)->Arg(128));
+
+// The binary writer used to format each value individually through the ostream. This
+// reproduces that approach so the block writer can be compared against it.
+template <typename T>
+void WritePerValue(std::ostream& out, const vtkm::cont::UnknownArrayHandle& array)
+{
+  auto portal = array.ExtractArrayFromComponents<T>().ReadPortal();
+  std::vector<T> tuple;
+  for (vtkm::Id valueIndex = 0; valueIndex < portal.GetNumberOfValues(); ++valueIndex)
+  {
+    auto value = portal.Get(valueIndex);
+    tuple.resize(static_cast<std::size_t>(value.GetNumberOfComponents()));
+    for (vtkm::IdComponent cIndex = 0; cIndex < value.GetNumberOfComponents(); ++cIndex)
+    {
+      tuple[static_cast<std::size_t>(cIndex)] = value[cIndex];
+    }
+    if (vtkm::io::internal::IsLittleEndian())
+    {
+      vtkm::io::internal::FlipEndianness(tuple);
+    }
+    out.write(reinterpret_cast<const char*>(tuple.data()),
+              static_cast<std::streamsize>(tuple.size() * sizeof(T)));
+  }
+}
+
+// Writes the same file as `VTKDataSetWriter` does for the tetrahedralized wavelet.
+void WritePerValueDataSet(std::ostream& out, const vtkm::cont::DataSet& dataSet)
+{
+  const char* typeName = vtkm::io::internal::DataTypeName<vtkm::FloatDefault>::Name();
+  out << "# vtk DataFile Version 3.0\nvtk output\nBINARY\nDATASET UNSTRUCTURED_GRID\n";
+  out << "POINTS " << dataSet.GetNumberOfPoints() << " " << typeName << " \n";
+  WritePerValue<vtkm::FloatDefault>(out, dataSet.GetCoordinateSystem().GetData());
+
+  auto cellSet = dataSet.GetCellSet().AsCellSet<vtkm::cont::CellSetSingleType<>>();
+  vtkm::Id nCells = cellSet.GetNumberOfCells();
+  std::vector<vtkm::Int32> buffer;
+  for (vtkm::Id i = 0; i < nCells; ++i)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> ids;
+    cellSet.GetIndices(i, ids);
+    buffer.push_back(static_cast<vtkm::Int32>(ids.GetNumberOfValues()));
+    auto idPortal = ids.ReadPortal();
+    for (vtkm::Id j = 0; j < ids.GetNumberOfValues(); ++j)
+    {
+      buffer.push_back(static_cast<vtkm::Int32>(idPortal.Get(j)));
+    }
+  }
+  out << "CELLS " << nCells << " " << buffer.size() << "\n";
+  if (vtkm::io::internal::IsLittleEndian())
+  {
+    vtkm::io::internal::FlipEndianness(buffer);
+  }
+  out.write(reinterpret_cast<const char*>(buffer.data()),
+            static_cast<std::streamsize>(buffer.size() * sizeof(vtkm::Int32)));
+
+  out << "CELL_TYPES " << nCells << "\n";
+  buffer.clear();
+  for (vtkm::Id i = 0; i < nCells; ++i)
+  {
+    buffer.push_back(static_cast<vtkm::Int32>(cellSet.GetCellShape(i)));
+  }
+  if (vtkm::io::internal::IsLittleEndian())
+  {
+    vtkm::io::internal::FlipEndianness(buffer);
+  }
+  out.write(reinterpret_cast<const char*>(buffer.data()),
+            static_cast<std::streamsize>(buffer.size() * sizeof(vtkm::Int32)));
+
+  out << "POINT_DATA " << dataSet.GetNumberOfPoints() << "\n";
+  for (vtkm::IdComponent fieldIndex = 0; fieldIndex < dataSet.GetNumberOfFields(); ++fieldIndex)
+  {
+    const vtkm::cont::Field& field = dataSet.GetField(fieldIndex);
+    if (field.IsFieldPoint() && field.GetData().IsBaseComponentType<vtkm::FloatDefault>())
+    {
+      out << "SCALARS " << field.GetName() << " " << typeName << " 1\nLOOKUP_TABLE default\n";
+      WritePerValue<vtkm::FloatDefault>(out, field.GetData());
+    }
+  }
+}
+
+void BenchWritePerValueBinary(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::cont::DataSet& dataSet =
+    GetUnstructuredDataSet(static_cast<vtkm::Id>(state.range(0)));
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    {
+      std::ofstream out(OutputFileName, std::ios::trunc | std::ios::binary);
+      WritePerValueDataSet(out, dataSet);
+    }
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+
+  const vtkm::UInt64 numBytes = GetFileSize(OutputFileName);
+  std::remove(OutputFileName.c_str());
+  state.SetLabel(vtkm::cont::GetHumanReadableSize(numBytes));
+  state.SetBytesProcessed(static_cast<int64_t>(numBytes) * state.iterations());
+  state.SetItemsProcessed(dataSet.GetNumberOfCells() * state.iterations());
+}
+VTKM_BENCHMARK_OPTS(BenchWritePerValueBinary, ->ArgName("Dim")->Arg(32)->Arg(64)->Arg(128));
+
+} // end anon namespace
+
+int main(int argc, char* argv[])
+{
+  auto opts = vtkm::cont::InitializeOptions::RequireDevice;
+
+  std::vector<char*> args(argv, argv + argc);
+  vtkm::bench::detail::InitializeArgs(&argc, args, opts);
+
+  // Parse VTK-m options:
+  Config = vtkm::cont::Initialize(argc, args.data(), opts);
+
+  // This occurs when it is help
+  if (opts == vtkm::cont::InitializeOptions::None)
+  {
+    std::cout << Config.Usage << std::endl;
+  }
+  else
+  {
+    vtkm::cont::GetRuntimeDeviceTracker().ForceDevice(Config.Device);
+  }
+
+  // handle benchmarking related args and run benchmarks:
+  VTKM_EXECUTE_BENCHMARKS(argc, args.data());
+}
@@ -853,6 +853,14 @@ public:
   {
     return this->Variant.CastAndCall(detail::ImplicitFunctionGradientFunctor{}, point);
   }
+
+  /// Returns the variant holding the implicit function, which can be queried for the
+  /// type of the function.
+  VTKM_EXEC_CONT const vtkm::exec::internal::Variant<ImplicitFunctionTypes...>& GetVariant()
+    const
+  {
+    return this->Variant;
+  }
 };
 
 //============================================================================
@@ -482,8 +482,14 @@ public:
   {
     vtkm::cont::Token token;
 
-    return StorageType::CreateWritePortal(
+    WritePortalType portal = StorageType::CreateWritePortal(
       this->GetBuffers(), vtkm::cont::DeviceAdapterTagUndefined{}, token);
+    // The portal outlives the token, so the buffers cannot tell when it is written to.
+    for (const vtkm::cont::internal::Buffer& buffer : this->GetBuffers())
+    {
+      buffer.SetUntrackedWrites();
+    }
+    return portal;
   }
 
   /// Returns the number of entries in the array.
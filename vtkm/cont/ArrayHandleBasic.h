@@ -114,6 +114,8 @@ public:
         deleter,
         reallocater) })
   {
+    // The caller may still hold the pointer and change the memory at any time.
+    this->GetBuffers()[0].SetUntrackedWrites();
   }
 
   ArrayHandleBasic(
@@ -130,6 +132,8 @@ public:
         deleter,
         reallocater) })
   {
+    // The caller may still hold the pointer and change the memory at any time.
+    this->GetBuffers()[0].SetUntrackedWrites();
   }
 
   ArrayHandleBasic(
@@ -146,6 +150,8 @@ public:
         deleter,
         reallocater) })
   {
+    // The caller may still hold the pointer and change the memory at any time.
+    this->GetBuffers()[0].SetUntrackedWrites();
   }
 
   ArrayHandleBasic(
@@ -163,6 +169,8 @@ public:
         deleter,
         reallocater) })
   {
+    // The caller may still hold the pointer and change the memory at any time.
+    this->GetBuffers()[0].SetUntrackedWrites();
   }
 
   /// @{
@@ -187,7 +195,9 @@ public:
   T* GetWritePointer() const
   {
     vtkm::cont::Token token;
-    return this->GetWritePointer(token);
+    T* pointer = this->GetWritePointer(token);
+    this->GetBuffers()[0].SetUntrackedWrites();
+    return pointer;
   }
 
   const T* GetReadPointer(vtkm::cont::DeviceAdapterId device, vtkm::cont::Token& token) const
@@ -206,7 +216,9 @@ public:
   T* GetWritePointer(vtkm::cont::DeviceAdapterId device) const
   {
     vtkm::cont::Token token;
-    return this->GetWritePointer(device, token);
+    T* pointer = this->GetWritePointer(device, token);
+    this->GetBuffers()[0].SetUntrackedWrites();
+    return pointer;
   }
   /// @}
 };
@@ -222,8 +234,8 @@ VTKM_CONT vtkm::cont::ArrayHandleBasic<T> make_ArrayHandle(const T* array,
   {
     vtkm::cont::ArrayHandleBasic<T> handle;
     handle.Allocate(numberOfValues);
-    std::copy(
-      array, array + numberOfValues, vtkm::cont::ArrayPortalToIteratorBegin(handle.WritePortal()));
+    vtkm::cont::Token token;
+    std::copy(array, array + numberOfValues, handle.GetWritePointer(token));
     return handle;
   }
   else
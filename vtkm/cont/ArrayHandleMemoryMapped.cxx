@@ -0,0 +1,217 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayHandleMemoryMapped.h>
+
+#include <vtkm/cont/ErrorBadAllocation.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/internal/HostMemoryPool.h>
+
+#include <vtkm/Math.h>
+
+#include <cstring>
+#include <memory>
+
+#if defined(VTKM_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#else
+#include <fstream>
+#endif
+
+namespace
+{
+
+// The container for a memory mapped buffer. It holds either the file mapping or, after the
+// buffer has been reallocated, a regular block of host memory.
+struct MemoryMappedContainer
+{
+  void* MapAddress = nullptr;
+  std::size_t MapLength = 0;
+  void* HostMemory = nullptr;
+};
+
+void ReleaseContainerMemory(MemoryMappedContainer* container)
+{
+#if defined(VTKM_POSIX)
+  if (container->MapAddress != nullptr)
+  {
+    munmap(container->MapAddress, container->MapLength);
+  }
+#endif
+  container->MapAddress = nullptr;
+  container->MapLength = 0;
+
+  vtkm::cont::internal::GetHostMemoryPool().Free(container->HostMemory);
+  container->HostMemory = nullptr;
+}
+
+void MemoryMappedDeleter(void* container)
+{
+  MemoryMappedContainer* mmContainer = reinterpret_cast<MemoryMappedContainer*>(container);
+  ReleaseContainerMemory(mmContainer);
+  delete mmContainer;
+}
+
+// A mapped file cannot grow or shrink, so reallocating copies the data into regular host
+// memory. The container stays the same so that the deleter can still clean it up.
+void MemoryMappedReallocater(void*& memory,
+                             void*& container,
+                             vtkm::BufferSizeType oldSize,
+                             vtkm::BufferSizeType newSize)
+{
+  MemoryMappedContainer* mmContainer = reinterpret_cast<MemoryMappedContainer*>(container);
+
+  void* newMemory = vtkm::cont::internal::GetHostMemoryPool().Allocate(newSize);
+  if ((newMemory == nullptr) && (newSize > 0))
+  {
+    throw vtkm::cont::ErrorBadAllocation("Could not reallocate memory mapped array.");
+  }
+  if (memory != nullptr)
+  {
+    std::memcpy(newMemory, memory, static_cast<std::size_t>(vtkm::Min(oldSize, newSize)));
+  }
+
+  ReleaseContainerMemory(mmContainer);
+  mmContainer->HostMemory = newMemory;
+  memory = newMemory;
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+vtkm::cont::internal::Buffer MakeMemoryMappedBuffer(const std::string& fileName,
+                                                    vtkm::BufferSizeType byteOffset,
+                                                    vtkm::BufferSizeType numBytes,
+                                                    vtkm::cont::MemoryMapMode mode)
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "Map file %s", fileName.c_str());
+
+  if (byteOffset < 0)
+  {
+    throw vtkm::cont::ErrorBadValue("Negative offset given for mapping " + fileName);
+  }
+
+  // Until the buffer owns the container, unmap and free it here if anything throws.
+  std::unique_ptr<MemoryMappedContainer, void (*)(void*)> container(new MemoryMappedContainer,
+                                                                     MemoryMappedDeleter);
+  void* memory = nullptr;
+
+#if defined(VTKM_POSIX)
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw vtkm::cont::ErrorBadValue("Could not open " + fileName + " for mapping: " +
+                                    std::strerror(errno));
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0)
+  {
+    close(fd);
+    throw vtkm::cont::ErrorBadValue("Could not get size of " + fileName);
+  }
+  vtkm::BufferSizeType fileSize = static_cast<vtkm::BufferSizeType>(fileStat.st_size);
+
+  if (numBytes < 0)
+  {
+    numBytes = vtkm::Max(fileSize - byteOffset, vtkm::BufferSizeType{ 0 });
+  }
+  if ((byteOffset + numBytes) > fileSize)
+  {
+    close(fd);
+    throw vtkm::cont::ErrorBadValue("File " + fileName + " is too small to map " +
+                                    std::to_string(numBytes) + " bytes at offset " +
+                                    std::to_string(byteOffset));
+  }
+
+  if (numBytes > 0)
+  {
+    // The offset given to mmap must be a multiple of the page size.
+    const vtkm::BufferSizeType pageSize = static_cast<vtkm::BufferSizeType>(sysconf(_SC_PAGESIZE));
+    const vtkm::BufferSizeType mapOffset = (byteOffset / pageSize) * pageSize;
+    const vtkm::BufferSizeType offsetInMap = byteOffset - mapOffset;
+
+    container->MapLength = static_cast<std::size_t>(numBytes + offsetInMap);
+    void* mapAddress = (mode == vtkm::cont::MemoryMapMode::ReadOnly)
+      ? mmap(nullptr, container->MapLength, PROT_READ, MAP_SHARED, fd, mapOffset)
+      : mmap(nullptr, container->MapLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, mapOffset);
+    if (mapAddress == MAP_FAILED)
+    {
+      close(fd);
+      throw vtkm::cont::ErrorBadAllocation("Could not map " + fileName + ": " +
+                                           std::strerror(errno));
+    }
+    container->MapAddress = mapAddress;
+    memory = reinterpret_cast<char*>(mapAddress) + offsetInMap;
+  }
+
+  // The mapping holds its own reference to the file.
+  close(fd);
+#else
+  VTKM_LOG_S(vtkm::cont::LogLevel::Warn,
+             "Memory mapping not supported on this platform. Reading " << fileName);
+
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  if (!file)
+  {
+    throw vtkm::cont::ErrorBadValue("Could not open " + fileName + " for reading.");
+  }
+  vtkm::BufferSizeType fileSize = static_cast<vtkm::BufferSizeType>(file.tellg());
+  if (numBytes < 0)
+  {
+    numBytes = vtkm::Max(fileSize - byteOffset, vtkm::BufferSizeType{ 0 });
+  }
+  if ((byteOffset + numBytes) > fileSize)
+  {
+    throw vtkm::cont::ErrorBadValue("File " + fileName + " is too small to read " +
+                                    std::to_string(numBytes) + " bytes at offset " +
+                                    std::to_string(byteOffset));
+  }
+
+  container->HostMemory = vtkm::cont::internal::GetHostMemoryPool().Allocate(numBytes);
+  memory = container->HostMemory;
+  file.seekg(byteOffset);
+  file.read(reinterpret_cast<char*>(memory), static_cast<std::streamsize>(numBytes));
+  if (!file)
+  {
+    throw vtkm::cont::ErrorBadValue("Failed to read " + fileName);
+  }
+#endif
+
+  vtkm::cont::internal::Buffer buffer =
+    vtkm::cont::internal::MakeBuffer(vtkm::cont::DeviceAdapterTagUndefined{},
+                                     memory,
+                                     container.get(),
+                                     numBytes,
+                                     MemoryMappedDeleter,
+                                     MemoryMappedReallocater);
+  container.release();
+  if ((mode == vtkm::cont::MemoryMapMode::ReadOnly) && (numBytes > 0))
+  {
+    // Writing to the mapped pages would fault, so have the buffer refuse writes instead.
+    buffer.SetHostReadOnly();
+  }
+  return buffer;
+}
+
+}
+}
+} // namespace vtkm::cont::internal
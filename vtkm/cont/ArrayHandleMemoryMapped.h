@@ -0,0 +1,103 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_ArrayHandleMemoryMapped_h
+#define vtk_m_cont_ArrayHandleMemoryMapped_h
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <vtkm/cont/ArrayHandleBasic.h>
+#include <vtkm/cont/ErrorBadValue.h>
+
+#include <string>
+
+namespace vtkm
+{
+namespace cont
+{
+
+/// \brief Selects how a file is mapped into memory.
+///
+/// `ReadOnly` maps the file pages directly. The array may only be read. Attempting to write to
+/// the array (for example, by getting a write portal) throws an `ErrorBadValue`.
+///
+/// `CopyOnWrite` also maps the file pages directly, but writing to the array creates a private
+/// copy of the modified pages. The file on disk is never changed.
+///
+/// In either mode, resizing the array copies the data into regular host memory.
+///
+enum class MemoryMapMode
+{
+  ReadOnly,
+  CopyOnWrite
+};
+
+namespace internal
+{
+
+/// \brief Creates a `Buffer` whose host memory is a mapping of a file.
+///
+/// `numBytes` bytes are mapped starting at `byteOffset` bytes into the file. If `numBytes` is
+/// negative, the rest of the file is mapped. The offset does not need to be aligned to a page.
+/// An `ErrorBadValue` is thrown if the file cannot be opened or is too small. A buffer mapped
+/// with `MemoryMapMode::ReadOnly` throws an `ErrorBadValue` when written (see
+/// `Buffer::SetHostReadOnly`).
+///
+/// On platforms without `mmap`, the data are read into a regular host buffer instead.
+///
+VTKM_CONT_EXPORT VTKM_CONT vtkm::cont::internal::Buffer MakeMemoryMappedBuffer(
+  const std::string& fileName,
+  vtkm::BufferSizeType byteOffset,
+  vtkm::BufferSizeType numBytes,
+  vtkm::cont::MemoryMapMode mode);
+
+} // namespace internal
+
+/// \brief Creates an `ArrayHandle` whose data are mapped from a raw binary file.
+///
+/// The values are expected to be stored contiguously in the file in the native byte order.
+/// No data are read when the array is created. Instead, pages of the file are brought into
+/// memory as they are accessed. This makes creating the array nearly free and lets the
+/// operating system drop pages that are not in use, which keeps the resident memory low when
+/// only part of a large file is accessed.
+///
+/// If `numberOfValues` is negative, the array covers the rest of the file after
+/// `byteOffset`. `byteOffset` must be a multiple of the alignment of `T`, or an
+/// `ErrorBadValue` is thrown. The returned array is an ordinary `ArrayHandleBasic`, so it can
+/// be used anywhere a basic array is accepted.
+///
+template <typename T>
+VTKM_CONT vtkm::cont::ArrayHandleBasic<T> make_ArrayHandleMemoryMapped(
+  const std::string& fileName,
+  vtkm::Id numberOfValues = -1,
+  vtkm::BufferSizeType byteOffset = 0,
+  vtkm::cont::MemoryMapMode mode = vtkm::cont::MemoryMapMode::ReadOnly)
+{
+  if ((byteOffset % static_cast<vtkm::BufferSizeType>(alignof(T))) != 0)
+  {
+    throw vtkm::cont::ErrorBadValue("Offset " + std::to_string(byteOffset) + " into " + fileName +
+                                    " is not aligned for the value type.");
+  }
+  vtkm::BufferSizeType numBytes =
+    (numberOfValues >= 0) ? vtkm::internal::NumberOfValuesToNumberOfBytes<T>(numberOfValues) : -1;
+  vtkm::cont::internal::Buffer buffer =
+    vtkm::cont::internal::MakeMemoryMappedBuffer(fileName, byteOffset, numBytes, mode);
+  if ((buffer.GetNumberOfBytes() % static_cast<vtkm::BufferSizeType>(sizeof(T))) != 0)
+  {
+    throw vtkm::cont::ErrorBadValue("Size of mapped region of " + fileName +
+                                    " is not a multiple of the value size.");
+  }
+  return vtkm::cont::ArrayHandle<T, vtkm::cont::StorageTagBasic>(
+    std::vector<vtkm::cont::internal::Buffer>{ buffer });
+}
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_ArrayHandleMemoryMapped_h
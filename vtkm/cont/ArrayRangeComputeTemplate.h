@@ -16,12 +16,16 @@
 #include <vtkm/VecTraits.h>
 
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayHandleBasic.h>
 
 #ifndef VTKM_NO_DEPRECATED_VIRTUAL
 #include <vtkm/cont/ArrayHandleVirtual.h>
 #endif
 
 #include <limits>
+#include <memory>
+#include <typeinfo>
+#include <vector>
 
 namespace vtkm
 {
@@ -46,11 +50,52 @@ struct ArrayRangeComputeFunctor
   }
 };
 
+// Computed ranges are cached in the first buffer of the array along with the modified stamps
+// of all the buffers of the array, so the range of unchanged data is only computed once.
+struct ArrayRangeCacheEntry
+{
+  std::vector<vtkm::UInt64> Stamps;
+  std::vector<vtkm::Range> Ranges;
+};
+
+inline std::vector<vtkm::UInt64> ArrayRangeCacheStamps(
+  const std::vector<vtkm::cont::internal::Buffer>& buffers)
+{
+  std::vector<vtkm::UInt64> stamps;
+  stamps.reserve(buffers.size());
+  for (const auto& buffer : buffers)
+  {
+    stamps.push_back(buffer.GetModifiedStamp());
+  }
+  return stamps;
+}
+
+template <typename T, typename S>
+inline const std::string& ArrayRangeCacheKey()
+{
+  // The same buffers can be interpreted as different arrays, so the key depends on the type.
+  static const std::string key =
+    std::string("vtkm::cont::ArrayRangeCompute ") + typeid(vtkm::cont::ArrayHandle<T, S>).name();
+  return key;
+}
+
 template <typename T, typename S>
 inline vtkm::cont::ArrayHandle<vtkm::Range> ArrayRangeComputeImpl(
   const vtkm::cont::ArrayHandle<T, S>& input,
   vtkm::cont::DeviceAdapterId device)
 {
+  const std::vector<vtkm::cont::internal::Buffer>& buffers = input.GetBuffers();
+  std::vector<vtkm::UInt64> stamps = ArrayRangeCacheStamps(buffers);
+  if (!buffers.empty())
+  {
+    auto cached = std::static_pointer_cast<ArrayRangeCacheEntry>(
+      buffers[0].GetCachedData(ArrayRangeCacheKey<T, S>()));
+    if (cached && (cached->Stamps == stamps))
+    {
+      return vtkm::cont::make_ArrayHandle(cached->Ranges, vtkm::CopyFlag::On);
+    }
+  }
+
   VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "ArrayRangeCompute");
 
   using VecTraits = vtkm::VecTraits<T>;
@@ -94,6 +139,20 @@ inline vtkm::cont::ArrayHandle<vtkm::Range> ArrayRangeComputeImpl(
       }
     }
   }
+
+  if (!buffers.empty())
+  {
+    // The stamps were taken before computing, so writes that happened meanwhile invalidate the
+    // entry.
+    auto entry = std::make_shared<ArrayRangeCacheEntry>();
+    entry->Stamps = std::move(stamps);
+    auto portal = range.ReadPortal();
+    for (vtkm::Id i = 0; i < portal.GetNumberOfValues(); ++i)
+    {
+      entry->Ranges.push_back(portal.Get(i));
+    }
+    buffers[0].SetCachedData(ArrayRangeCacheKey<T, S>(), entry);
+  }
   return range;
 }
 
@@ -110,8 +110,11 @@ vtkm::cont::DeviceAdapterId BitField::GetDeviceAdapterId() const
 BitField::WritePortalType BitField::WritePortal() const
 {
   vtkm::cont::Token token;
-  return WritePortalType(this->Buffer.WritePointerHost(token),
+  WritePortalType portal(this->Buffer.WritePointerHost(token),
                          this->Buffer.GetMetaData<internal::BitFieldMetaData>().NumberOfBits);
+  // The portal outlives the token, so the buffer cannot tell when it is written to.
+  this->Buffer.SetUntrackedWrites();
+  return portal;
 }
 
 BitField::ReadPortalType BitField::ReadPortal() const
@@ -10,14 +10,30 @@
 #include <vtkm/cont/CellLocatorTwoLevel.h>
 
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/VecTraits.h>
+
 #include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandleConstant.h>
 #include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/internal/Fingerprint.h>
 
 #include <vtkm/cont/Invoker.h>
 #include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 
+#include <vtkm/thirdparty/diy/serialization.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <vector>
+
 using namespace vtkm::internal::cl_uniform_bins;
 
 namespace
@@ -335,6 +351,113 @@ struct DimensionsToCount
   VTKM_EXEC vtkm::Id operator()(const DimVec3& dim) const { return dim[0] * dim[1] * dim[2]; }
 };
 
+//----------------------------------------------------------------------------
+// Search structures are cached in the first coordinate buffer, so that all locators built
+// for the same cell set and coordinates (for example by several filters) share one build.
+// The entry is only used if the fingerprint, which holds the modified stamps of the buffers
+// of the cell set and coordinates and the densities, is unchanged. The locators using the
+// structure own it. The buffer only keeps a weak reference, so the memory is released with
+// the last of those locators rather than with the coordinates.
+struct SearchStructureCacheEntry
+{
+  std::vector<vtkm::UInt64> Fingerprint;
+  Grid TopLevel;
+  vtkm::cont::ArrayHandle<DimVec3> LeafDimensions;
+  vtkm::cont::ArrayHandle<vtkm::Id> LeafStartIndex;
+  vtkm::cont::ArrayHandle<vtkm::Id> CellStartIndex;
+  vtkm::cont::ArrayHandle<vtkm::Id> CellCount;
+  vtkm::cont::ArrayHandle<vtkm::Id> CellIds;
+};
+
+const std::string& SearchStructureCacheKey()
+{
+  static const std::string key = "vtkm::cont::CellLocatorTwoLevel SearchStructure";
+  return key;
+}
+
+vtkm::UInt64 FloatBits(vtkm::FloatDefault value)
+{
+  const vtkm::Float64 value64 = static_cast<vtkm::Float64>(value);
+  vtkm::UInt64 bits;
+  std::memcpy(&bits, &value64, sizeof(bits));
+  return bits;
+}
+
+// Returns false if the search structure for these inputs cannot be cached.
+bool ComputeFingerprint(const vtkm::cont::UnknownCellSet& cellSet,
+                        const vtkm::cont::CoordinateSystem& coords,
+                        vtkm::FloatDefault densityL1,
+                        vtkm::FloatDefault densityL2,
+                        std::vector<vtkm::UInt64>& fingerprint,
+                        vtkm::cont::internal::Buffer& cacheBuffer)
+{
+  fingerprint.clear();
+  fingerprint.push_back(FloatBits(densityL1));
+  fingerprint.push_back(FloatBits(densityL2));
+  if (!vtkm::cont::internal::AppendCellSetFingerprint(fingerprint, cellSet))
+  {
+    return false;
+  }
+  fingerprint.push_back(0);
+  return vtkm::cont::internal::AppendArrayFingerprint(fingerprint, coords.GetData(), &cacheBuffer);
+}
+
+// Identifies files written by `CellLocatorTwoLevel::WriteSearchStructure`.
+constexpr const char* SearchStructureFileTag = "vtkm::cont::CellLocatorTwoLevel";
+constexpr vtkm::Int32 SearchStructureFileVersion = 1;
+
+// `vtkmdiy::MemoryBuffer` does not check its bounds, so every size read from a file is checked
+// against what is left in the buffer before anything is loaded or allocated.
+void CheckAvailable(const vtkmdiy::MemoryBuffer& buffer,
+                    std::size_t offset,
+                    std::size_t numberOfBytes,
+                    const std::string& fileName)
+{
+  const std::size_t remaining = buffer.size() - buffer.position;
+  if ((offset > remaining) || (numberOfBytes > remaining - offset))
+  {
+    throw vtkm::cont::ErrorBadValue("The cell locator file " + fileName + " is truncated.");
+  }
+}
+
+template <typename T>
+T PeekValue(const vtkmdiy::MemoryBuffer& buffer, const std::string& fileName)
+{
+  CheckAvailable(buffer, 0, sizeof(T), fileName);
+  T value;
+  std::memcpy(&value, buffer.buffer.data() + buffer.position, sizeof(T));
+  return value;
+}
+
+template <typename T>
+void LoadValue(vtkmdiy::MemoryBuffer& buffer, T& value, const std::string& fileName)
+{
+  CheckAvailable(buffer, 0, sizeof(T), fileName);
+  vtkmdiy::load(buffer, value);
+}
+
+void LoadString(vtkmdiy::MemoryBuffer& buffer, std::string& value, const std::string& fileName)
+{
+  const std::size_t length = PeekValue<std::size_t>(buffer, fileName);
+  CheckAvailable(buffer, sizeof(std::size_t), length, fileName);
+  vtkmdiy::load(buffer, value);
+}
+
+template <typename T>
+void LoadArray(vtkmdiy::MemoryBuffer& buffer,
+               vtkm::cont::ArrayHandle<T>& array,
+               const std::string& fileName)
+{
+  const vtkm::BufferSizeType numberOfBytes = PeekValue<vtkm::BufferSizeType>(buffer, fileName);
+  if ((numberOfBytes < 0) || ((numberOfBytes % static_cast<vtkm::BufferSizeType>(sizeof(T))) != 0))
+  {
+    throw vtkm::cont::ErrorBadValue("Invalid array size in the cell locator file " + fileName);
+  }
+  CheckAvailable(
+    buffer, sizeof(vtkm::BufferSizeType), static_cast<std::size_t>(numberOfBytes), fileName);
+  vtkmdiy::load(buffer, array);
+}
+
 } // anonymous namespace
 
 namespace vtkm
@@ -343,9 +466,65 @@ namespace cont
 {
 
 //----------------------------------------------------------------------------
-/// Builds the cell locator lookup structure
+/// Builds the cell locator lookup structure, or takes it from the cache
 ///
 VTKM_CONT void CellLocatorTwoLevel::Build()
+{
+  const vtkm::cont::UnknownCellSet& cellset = this->GetCellSet();
+  const vtkm::cont::CoordinateSystem& coords = this->GetCoordinates();
+  using WeakEntry = std::weak_ptr<SearchStructureCacheEntry>;
+
+  // The stamps are taken before building, so writes that happen meanwhile invalidate the entry.
+  std::vector<vtkm::UInt64> fingerprint;
+  vtkm::cont::internal::Buffer cacheBuffer;
+  const bool cacheable = ComputeFingerprint(
+    cellset, coords, this->DensityL1, this->DensityL2, fingerprint, cacheBuffer);
+
+  const bool useStructureRead = this->StructureRead &&
+    (this->StructureNumberOfCells == cellset.GetNumberOfCells()) &&
+    (this->StructureNumberOfPoints == coords.GetNumberOfPoints());
+  this->StructureRead = false;
+  if (!useStructureRead)
+  {
+    auto weakCached = cacheable ? std::static_pointer_cast<WeakEntry>(
+                                    cacheBuffer.GetCachedData(SearchStructureCacheKey()))
+                                : nullptr;
+    auto cached = weakCached ? weakCached->lock() : nullptr;
+    if (cached && (cached->Fingerprint == fingerprint))
+    {
+      VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+                 "Reusing the CellLocatorTwoLevel search structure of the same cells.");
+      this->TopLevel = cached->TopLevel;
+      this->LeafDimensions = cached->LeafDimensions;
+      this->LeafStartIndex = cached->LeafStartIndex;
+      this->CellStartIndex = cached->CellStartIndex;
+      this->CellCount = cached->CellCount;
+      this->CellIds = cached->CellIds;
+      this->SharedSearchStructure = cached;
+      return;
+    }
+    this->BuildSearchStructure();
+  }
+  this->SharedSearchStructure = nullptr;
+
+  // A structure read from a file is only checked against the number of cells and points, so
+  // other locators must not take it for the fingerprint of these cells.
+  if (cacheable && !useStructureRead)
+  {
+    auto entry = std::make_shared<SearchStructureCacheEntry>();
+    entry->Fingerprint = std::move(fingerprint);
+    entry->TopLevel = this->TopLevel;
+    entry->LeafDimensions = this->LeafDimensions;
+    entry->LeafStartIndex = this->LeafStartIndex;
+    entry->CellStartIndex = this->CellStartIndex;
+    entry->CellCount = this->CellCount;
+    entry->CellIds = this->CellIds;
+    cacheBuffer.SetCachedData(SearchStructureCacheKey(), std::make_shared<WeakEntry>(entry));
+    this->SharedSearchStructure = entry;
+  }
+}
+
+VTKM_CONT void CellLocatorTwoLevel::BuildSearchStructure()
 {
   VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "CellLocatorTwoLevel::Build");
 
@@ -354,6 +533,13 @@ VTKM_CONT void CellLocatorTwoLevel::Build()
   auto cellset = this->GetCellSet();
   const auto& coords = this->GetCoordinates();
 
+  // The arrays of a previous build may be shared with the cache, so do not write into them.
+  this->LeafDimensions = vtkm::cont::ArrayHandle<DimVec3>{};
+  this->LeafStartIndex = vtkm::cont::ArrayHandle<vtkm::Id>{};
+  this->CellStartIndex = vtkm::cont::ArrayHandle<vtkm::Id>{};
+  this->CellCount = vtkm::cont::ArrayHandle<vtkm::Id>{};
+  this->CellIds = vtkm::cont::ArrayHandle<vtkm::Id>{};
+
   // 1: Compute the top level grid
   auto bounds = coords.GetBounds();
   FloatVec3 bmin(static_cast<vtkm::FloatDefault>(bounds.X.Min),
@@ -488,6 +674,83 @@ CellLocatorTwoLevel::ExecObjType CellLocatorTwoLevel::PrepareForExecution(
   return execObject;
 }
 
+//----------------------------------------------------------------------------
+void CellLocatorTwoLevel::WriteSearchStructure(const std::string& fileName) const
+{
+  this->Update();
+
+  vtkmdiy::MemoryBuffer buffer;
+  vtkmdiy::save(buffer, std::string(SearchStructureFileTag));
+  vtkmdiy::save(buffer, SearchStructureFileVersion);
+  vtkmdiy::save(buffer, this->GetCellSet().GetNumberOfCells());
+  vtkmdiy::save(buffer, this->GetCoordinates().GetNumberOfPoints());
+  vtkmdiy::save(buffer, this->DensityL1);
+  vtkmdiy::save(buffer, this->DensityL2);
+  vtkmdiy::save(buffer, this->TopLevel);
+  vtkmdiy::save(buffer, this->LeafDimensions);
+  vtkmdiy::save(buffer, this->LeafStartIndex);
+  vtkmdiy::save(buffer, this->CellStartIndex);
+  vtkmdiy::save(buffer, this->CellCount);
+  vtkmdiy::save(buffer, this->CellIds);
+
+  std::ofstream file(fileName, std::ios::binary);
+  file.write(buffer.buffer.data(), static_cast<std::streamsize>(buffer.buffer.size()));
+  if (!file)
+  {
+    throw vtkm::cont::ErrorBadValue("Could not write cell locator file " + fileName);
+  }
+}
+
+void CellLocatorTwoLevel::ReadSearchStructure(const std::string& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file)
+  {
+    throw vtkm::cont::ErrorBadValue("Could not open cell locator file " + fileName);
+  }
+  vtkmdiy::MemoryBuffer buffer;
+  buffer.buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+  std::string tag;
+  vtkm::Int32 version = 0;
+  LoadString(buffer, tag, fileName);
+  if (tag != SearchStructureFileTag)
+  {
+    throw vtkm::cont::ErrorBadValue(fileName + " is not a CellLocatorTwoLevel file.");
+  }
+  LoadValue(buffer, version, fileName);
+  if (version != SearchStructureFileVersion)
+  {
+    throw vtkm::cont::ErrorBadValue("Unsupported CellLocatorTwoLevel file version in " +
+                                    fileName);
+  }
+
+  vtkm::Id numberOfCells;
+  vtkm::Id numberOfPoints;
+  LoadValue(buffer, numberOfCells, fileName);
+  LoadValue(buffer, numberOfPoints, fileName);
+  if ((numberOfCells != this->GetCellSet().GetNumberOfCells()) ||
+      (numberOfPoints != this->GetCoordinates().GetNumberOfPoints()))
+  {
+    throw vtkm::cont::ErrorBadValue("The cell locator in " + fileName +
+                                    " was built for different cells.");
+  }
+
+  LoadValue(buffer, this->DensityL1, fileName);
+  LoadValue(buffer, this->DensityL2, fileName);
+  LoadValue(buffer, this->TopLevel, fileName);
+  LoadArray(buffer, this->LeafDimensions, fileName);
+  LoadArray(buffer, this->LeafStartIndex, fileName);
+  LoadArray(buffer, this->CellStartIndex, fileName);
+  LoadArray(buffer, this->CellCount, fileName);
+  LoadArray(buffer, this->CellIds, fileName);
+
+  this->StructureRead = true;
+  this->StructureNumberOfCells = numberOfCells;
+  this->StructureNumberOfPoints = numberOfPoints;
+  this->SetModified();
+}
+
 //----------------------------------------------------------------------------
 void CellLocatorTwoLevel::PrintSummary(std::ostream& out) const
 {
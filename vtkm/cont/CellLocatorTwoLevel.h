@@ -18,6 +18,8 @@
 #include <vtkm/exec/CellLocatorMultiplexer.h>
 #include <vtkm/exec/CellLocatorTwoLevel.h>
 
+#include <memory>
+#include <string>
 
 namespace vtkm
 {
@@ -83,8 +85,32 @@ public:
   }
   vtkm::FloatDefault GetDensityL2() const { return this->DensityL2; }
 
+  /// The ids of the cells in the leaf bins, and where the cells of each leaf bin start in them.
+  /// Locators for the same cells and coordinates share these arrays.
+  VTKM_CONT const vtkm::cont::ArrayHandle<vtkm::Id>& GetCellIds() const { return this->CellIds; }
+  VTKM_CONT const vtkm::cont::ArrayHandle<vtkm::Id>& GetCellStartIndex() const
+  {
+    return this->CellStartIndex;
+  }
+
   void PrintSummary(std::ostream& out) const;
 
+  /// \brief Writes the search structure to a file.
+  ///
+  /// The structure is built first if needed. Reading it back with `ReadSearchStructure` in a
+  /// later run on the same mesh skips the build.
+  ///
+  VTKM_CONT void WriteSearchStructure(const std::string& fileName) const;
+
+  /// \brief Reads a search structure written by `WriteSearchStructure`.
+  ///
+  /// The cell set and coordinates must be set before and must be the ones that the structure
+  /// was built for. Only their number of cells and points are checked. The densities are
+  /// replaced by the ones the structure was built with. Because it is not checked further, the
+  /// structure read is not shared with other locators for the same cells.
+  ///
+  VTKM_CONT void ReadSearchStructure(const std::string& fileName);
+
 public:
   ExecObjType PrepareForExecution(vtkm::cont::DeviceAdapterId device,
                                   vtkm::cont::Token& token) const;
@@ -92,6 +118,7 @@ public:
 private:
   friend Superclass;
   VTKM_CONT void Build();
+  VTKM_CONT void BuildSearchStructure();
 
   vtkm::FloatDefault DensityL1, DensityL2;
 
@@ -102,6 +129,14 @@ private:
   vtkm::cont::ArrayHandle<vtkm::Id> CellCount;
   vtkm::cont::ArrayHandle<vtkm::Id> CellIds;
 
+  // Keeps the search structure shared with other locators for the same cells alive.
+  std::shared_ptr<void> SharedSearchStructure;
+
+  // Set by `ReadSearchStructure` so that the next build keeps the structure read.
+  bool StructureRead = false;
+  vtkm::Id StructureNumberOfCells = 0;
+  vtkm::Id StructureNumberOfPoints = 0;
+
   struct MakeExecObject;
 };
 
@@ -22,14 +22,79 @@
 namespace
 {
 
+// Reverse connectivity built for a pair of connectivity/offsets arrays. The cell sets using it
+// own it. The first buffer of the connectivity array only keeps a weak reference, so any cell
+// set sharing that array (for example the cell sets of consecutive time steps with fixed
+// topology) can reuse it while another cell set still holds it, and its memory is released with
+// the last of those cell sets.
+struct ReverseConnectivityCacheEntry
+{
+  std::vector<vtkm::UInt64> Stamps;
+  vtkm::Id NumberOfPoints;
+  vtkm::cont::detail::DefaultVisitPointsWithCellsConnectivityExplicit VisitPointsWithCells;
+};
+
+template <typename Storage>
+void AppendFingerprint(std::vector<vtkm::UInt64>& stamps,
+                       const vtkm::cont::ArrayHandle<vtkm::Id, Storage>& array)
+{
+  for (const auto& buffer : array.GetBuffers())
+  {
+    stamps.push_back(buffer.GetModifiedStamp());
+  }
+}
+
+// `CellSetSingleType` creates new counting offsets on every `Fill`, so identify them by value.
+void AppendFingerprint(
+  std::vector<vtkm::UInt64>& stamps,
+  const vtkm::cont::ArrayHandle<vtkm::Id, vtkm::cont::StorageTagCounting>& array)
+{
+  auto portal = array.ReadPortal();
+  stamps.push_back(static_cast<vtkm::UInt64>(portal.GetStart()));
+  stamps.push_back(static_cast<vtkm::UInt64>(portal.GetStep()));
+  stamps.push_back(static_cast<vtkm::UInt64>(portal.GetNumberOfValues()));
+}
+
+template <typename ConnectStorage, typename OffsetStorage>
+std::vector<vtkm::UInt64> ReverseConnectivityCacheStamps(
+  const vtkm::cont::ArrayHandle<vtkm::Id, ConnectStorage>& connections,
+  const vtkm::cont::ArrayHandle<vtkm::Id, OffsetStorage>& offsets)
+{
+  std::vector<vtkm::UInt64> stamps;
+  AppendFingerprint(stamps, connections);
+  // Separate the two lists so that values cannot be attributed to the wrong array.
+  stamps.push_back(0);
+  AppendFingerprint(stamps, offsets);
+  return stamps;
+}
+
 template <typename ConnectStorage, typename OffsetStorage>
 void DoBuildReverseConnectivity(
   const vtkm::cont::ArrayHandle<vtkm::Id, ConnectStorage>& connections,
   const vtkm::cont::ArrayHandle<vtkm::Id, OffsetStorage>& offsets,
   vtkm::Id numberOfPoints,
   vtkm::cont::detail::DefaultVisitPointsWithCellsConnectivityExplicit& visitPointsWithCells,
+  std::shared_ptr<void>& sharedPointCellIds,
   vtkm::cont::DeviceAdapterId suggestedDevice)
 {
+  using WeakEntry = std::weak_ptr<ReverseConnectivityCacheEntry>;
+  const std::vector<vtkm::cont::internal::Buffer>& buffers = connections.GetBuffers();
+  std::vector<vtkm::UInt64> stamps = ReverseConnectivityCacheStamps(connections, offsets);
+  if (!buffers.empty())
+  {
+    auto weakCached = std::static_pointer_cast<WeakEntry>(
+      buffers[0].GetCachedData(vtkm::cont::detail::ReverseConnectivityCacheKey()));
+    auto cached = weakCached ? weakCached->lock() : nullptr;
+    if (cached && (cached->Stamps == stamps) && (cached->NumberOfPoints == numberOfPoints))
+    {
+      VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+                 "Reusing reverse connectivity of a cell set with the same connectivity.");
+      visitPointsWithCells = cached->VisitPointsWithCells;
+      sharedPointCellIds = cached;
+      return;
+    }
+  }
+
   using CellsWithPointsConnectivity = vtkm::cont::internal::
     ConnectivityExplicitInternals<VTKM_DEFAULT_STORAGE_TAG, ConnectStorage, OffsetStorage>;
 
@@ -52,6 +117,17 @@ void DoBuildReverseConnectivity(
     throw vtkm::cont::ErrorExecution("Failed to run CellSetExplicit reverse "
                                      "connectivity builder.");
   }
+
+  if (!buffers.empty())
+  {
+    auto entry = std::make_shared<ReverseConnectivityCacheEntry>();
+    entry->Stamps = std::move(stamps);
+    entry->NumberOfPoints = numberOfPoints;
+    entry->VisitPointsWithCells = visitPointsWithCells;
+    buffers[0].SetCachedData(vtkm::cont::detail::ReverseConnectivityCacheKey(),
+                             std::make_shared<WeakEntry>(entry));
+    sharedPointCellIds = entry;
+  }
 }
 
 struct BuildReverseConnectivityForCellSetType
@@ -63,6 +139,7 @@ struct BuildReverseConnectivityForCellSetType
     const vtkm::cont::UnknownArrayHandle* offsets,
     vtkm::Id numberOfPoints,
     vtkm::cont::detail::DefaultVisitPointsWithCellsConnectivityExplicit* visitPointsWithCells,
+    std::shared_ptr<void>* sharedPointCellIds,
     vtkm::cont::DeviceAdapterId* device) const
   {
     if (visitPointsWithCells->ElementsValid)
@@ -78,6 +155,7 @@ struct BuildReverseConnectivityForCellSetType
                                  offsets->AsArrayHandle<OffsetArrayType>(),
                                  numberOfPoints,
                                  *visitPointsWithCells,
+                                 *sharedPointCellIds,
                                  *device);
     }
   }
@@ -110,10 +188,16 @@ struct BuildReverseConnectivityForCellSetType
     const vtkm::cont::UnknownArrayHandle& offsets,
     vtkm::Id numberOfPoints,
     vtkm::cont::detail::DefaultVisitPointsWithCellsConnectivityExplicit& visitPointsWithCells,
+    std::shared_ptr<void>& sharedPointCellIds,
     vtkm::cont::DeviceAdapterId device) const
   {
-    this->BuildExplicit(
-      &cellset, &connections, &offsets, numberOfPoints, &visitPointsWithCells, &device);
+    this->BuildExplicit(&cellset,
+                        &connections,
+                        &offsets,
+                        numberOfPoints,
+                        &visitPointsWithCells,
+                        &sharedPointCellIds,
+                        &device);
   }
 };
 
@@ -133,11 +217,18 @@ template class VTKM_CONT_EXPORT
 namespace detail
 {
 
+const std::string& ReverseConnectivityCacheKey()
+{
+  static const std::string key = "vtkm::cont::CellSetExplicit ReverseConnectivity";
+  return key;
+}
+
 void BuildReverseConnectivity(
   const vtkm::cont::UnknownArrayHandle& connections,
   const vtkm::cont::UnknownArrayHandle& offsets,
   vtkm::Id numberOfPoints,
   vtkm::cont::detail::DefaultVisitPointsWithCellsConnectivityExplicit& visitPointsWithCells,
+  std::shared_ptr<void>& sharedPointCellIds,
   vtkm::cont::DeviceAdapterId device)
 {
   if (visitPointsWithCells.ElementsValid)
@@ -151,6 +242,7 @@ void BuildReverseConnectivity(
                     offsets,
                     numberOfPoints,
                     visitPointsWithCells,
+                    sharedPointCellIds,
                     device);
 
   if (!visitPointsWithCells.ElementsValid)
@@ -162,8 +254,12 @@ void BuildReverseConnectivity(
     vtkm::cont::ArrayCopy(connections, connectionsCopy);
     vtkm::cont::ArrayHandle<vtkm::Id> offsetsCopy;
     vtkm::cont::ArrayCopy(offsets, offsetsCopy);
-    DoBuildReverseConnectivity(
-      connectionsCopy, offsetsCopy, numberOfPoints, visitPointsWithCells, device);
+    DoBuildReverseConnectivity(connectionsCopy,
+                               offsetsCopy,
+                               numberOfPoints,
+                               visitPointsWithCells,
+                               sharedPointCellIds,
+                               device);
   }
 }
 
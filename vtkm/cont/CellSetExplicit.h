@@ -46,11 +46,19 @@ using DefaultVisitPointsWithCellsConnectivityExplicit =
   vtkm::cont::internal::ConnectivityExplicitInternals<
     typename ArrayHandleConstant<vtkm::UInt8>::StorageTag>;
 
+/// Key of the reverse connectivity that `BuildReverseConnectivity` attaches to the
+/// first buffer of the connectivity array for reuse by other cell sets.
+VTKM_CONT_EXPORT const std::string& ReverseConnectivityCacheKey();
+
+/// Builds `visitPointsWithCells`, or reuses the one built for the same arrays by another cell
+/// set. The buffer only keeps a weak reference to it. `sharedPointCellIds` is set to the owning
+/// reference, which the cell set must hold for as long as it uses the reverse connectivity.
 VTKM_CONT_EXPORT void BuildReverseConnectivity(
   const vtkm::cont::UnknownArrayHandle& connections,
   const vtkm::cont::UnknownArrayHandle& offsets,
   vtkm::Id numberOfPoints,
   vtkm::cont::detail::DefaultVisitPointsWithCellsConnectivityExplicit& visitPointsWithCells,
+  std::shared_ptr<void>& sharedPointCellIds,
   vtkm::cont::DeviceAdapterId device);
 
 } // namespace detail
@@ -235,7 +243,9 @@ public:
     return this->HasConnectivityImpl(visit, incident);
   }
 
-  // Can be used to reset a connectivity table, mostly useful for benchmarking.
+  // Can be used to reset a connectivity table, mostly useful for benchmarking. Resetting the
+  // point-to-cell table also drops the copy shared with other cell sets through the
+  // connectivity array, so the next request really rebuilds it.
   template <typename VisitTopology, typename IncidentTopology>
   VTKM_CONT void ResetConnectivity(VisitTopology visit, IncidentTopology incident)
   {
@@ -259,6 +269,7 @@ protected:
                                      this->Data->CellPointIds.Offsets,
                                      this->Data->NumberOfPoints,
                                      this->Data->PointCellIds,
+                                     this->Data->SharedPointCellIds,
                                      device);
   }
 
@@ -279,6 +290,7 @@ protected:
     // Reset entire cell set
     this->Data->CellPointIds = CellPointIdsType{};
     this->Data->PointCellIds = PointCellIdsType{};
+    this->Data->SharedPointCellIds.reset();
     this->Data->ConnectivityAdded = -1;
     this->Data->NumberOfCellsAdded = -1;
     this->Data->NumberOfPoints = 0;
@@ -287,6 +299,12 @@ protected:
   VTKM_CONT void ResetConnectivityImpl(vtkm::TopologyElementTagPoint, vtkm::TopologyElementTagCell)
   {
     this->Data->PointCellIds = PointCellIdsType{};
+    this->Data->SharedPointCellIds.reset();
+    const auto& buffers = this->Data->CellPointIds.Connectivity.GetBuffers();
+    if (!buffers.empty())
+    {
+      buffers[0].SetCachedData(detail::ReverseConnectivityCacheKey(), nullptr);
+    }
   }
 
   // Store internals in a shared pointer so shallow copies stay consistent.
@@ -295,6 +313,8 @@ protected:
   {
     CellPointIdsType CellPointIds;
     PointCellIdsType PointCellIds;
+    // Keeps the reverse connectivity shared with other cell sets alive.
+    std::shared_ptr<void> SharedPointCellIds;
 
     // These are used in the AddCell and related methods to incrementally add
     // cells. They need to be protected as subclasses of CellSetExplicit
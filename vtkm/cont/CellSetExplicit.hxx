@@ -359,7 +359,9 @@ void CellSetExplicit<SST, CST, OST>
 
   this->Data->CellPointIds.ElementsValid = true;
 
-  this->ResetConnectivity(TopologyElementTagPoint{}, TopologyElementTagCell{});
+  // Reverse connectivity previously built for these arrays stays shared with the arrays.
+  this->Data->PointCellIds = PointCellIdsType{};
+  this->Data->SharedPointCellIds.reset();
 }
 
 //----------------------------------------------------------------------------
@@ -204,7 +204,9 @@ public:
 
     this->Data->CellPointIds.ElementsValid = true;
 
-    this->ResetConnectivity(TopologyElementTagPoint{}, TopologyElementTagCell{});
+    // Reverse connectivity previously built for these arrays stays shared with the arrays.
+    this->Data->PointCellIds = {};
+    this->Data->SharedPointCellIds.reset();
   }
 
   VTKM_CONT
@@ -0,0 +1,184 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_ConcurrentHashSet_h
+#define vtk_m_cont_ConcurrentHashSet_h
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopyDevice.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/ExecutionObjectBase.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/exec/ConcurrentHashSet.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace vtkm
+{
+namespace cont
+{
+
+namespace detail
+{
+
+struct ConcurrentHashSetInsert : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn index, ExecObject hashSet, FieldOut slot);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename HashSetType>
+  VTKM_EXEC void operator()(vtkm::Id index, const HashSetType& hashSet, vtkm::Id& slot) const
+  {
+    slot = hashSet.Insert(index);
+  }
+};
+
+struct ConcurrentHashSetFind : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn key, ExecObject hashSet, FieldOut index);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename KeyType, typename HashSetType>
+  VTKM_EXEC void operator()(const KeyType& key, const HashSetType& hashSet, vtkm::Id& index) const
+  {
+    index = hashSet.Find(key);
+  }
+};
+
+struct ConcurrentHashSetMarkFirst : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn index, FieldIn representative, FieldOut isFirst);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  VTKM_EXEC void operator()(vtkm::Id index, vtkm::Id representative, vtkm::Id& isFirst) const
+  {
+    isFirst = (index == representative) ? 1 : 0;
+  }
+};
+
+} // namespace detail
+
+/// \brief A set of keys built concurrently with a lock-free hash table.
+///
+/// `ConcurrentHashSet` finds the distinct values of an array of keys in linear time, which
+/// is an alternative to sorting the keys (as `vtkm::worklet::Keys` does) when only the
+/// duplicates are needed. The keys can be any type supported by `vtkm::Hash`, such as
+/// `vtkm::Id` or `vtkm::Id2`, or a `vtkm::Pair` of them.
+///
+/// The table holds indices into the array of keys. Building the set inserts every key in
+/// parallel. Afterwards, the representative of each key is the smallest index of the keys
+/// equal to it, so the results do not depend on the order in which threads insert keys.
+///
+/// The set can be passed to a worklet as an `ExecObject` to find or insert keys with
+/// `vtkm::exec::ConcurrentHashSet`.
+///
+template <typename KeyType, typename KeyStorage = VTKM_DEFAULT_STORAGE_TAG>
+class ConcurrentHashSet : public vtkm::cont::ExecutionObjectBase
+{
+public:
+  using KeyArrayType = vtkm::cont::ArrayHandle<KeyType, KeyStorage>;
+  using ExecObjectType = vtkm::exec::ConcurrentHashSet<typename KeyArrayType::ReadPortalType>;
+
+  ConcurrentHashSet() = default;
+
+  VTKM_CONT explicit ConcurrentHashSet(const KeyArrayType& keys) { this->Build(keys); }
+
+  /// Inserts all the keys in the set, replacing its previous contents.
+  VTKM_CONT void Build(const KeyArrayType& keys)
+  {
+    VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "ConcurrentHashSet::Build");
+
+    this->Keys = keys;
+    const vtkm::Id numberOfKeys = keys.GetNumberOfValues();
+
+    // Keep the table at most half full so that probe sequences stay short.
+    vtkm::Id numberOfSlots = 2;
+    while (numberOfSlots < 2 * numberOfKeys)
+    {
+      numberOfSlots *= 2;
+    }
+    vtkm::cont::ArrayCopyDevice(
+      vtkm::cont::ArrayHandleConstant<vtkm::Id>(ExecObjectType::EmptySlot, numberOfSlots),
+      this->Slots);
+
+    vtkm::cont::Invoker invoke;
+    vtkm::cont::ArrayHandle<vtkm::Id> slotOfKey;
+    invoke(detail::ConcurrentHashSetInsert{},
+           vtkm::cont::ArrayHandleIndex(numberOfKeys),
+           *this,
+           slotOfKey);
+    vtkm::cont::ArrayCopyDevice(vtkm::cont::make_ArrayHandlePermutation(slotOfKey, this->Slots),
+                                this->Representatives);
+  }
+
+  VTKM_CONT const KeyArrayType& GetKeys() const { return this->Keys; }
+
+  VTKM_CONT vtkm::Id GetNumberOfSlots() const { return this->Slots.GetNumberOfValues(); }
+
+  /// Returns, for every key, the smallest index of the keys equal to it.
+  VTKM_CONT const vtkm::cont::ArrayHandle<vtkm::Id>& GetRepresentatives() const
+  {
+    return this->Representatives;
+  }
+
+  /// \brief Numbers the distinct keys.
+  ///
+  /// `uniqueIndices` receives the index of the first occurrence of every distinct key, in
+  /// increasing order. `keyToUnique` receives, for every key, the position of its first
+  /// occurrence in `uniqueIndices`. Returns the number of distinct keys.
+  VTKM_CONT vtkm::Id GetUniqueKeyIds(vtkm::cont::ArrayHandle<vtkm::Id>& uniqueIndices,
+                                     vtkm::cont::ArrayHandle<vtkm::Id>& keyToUnique) const
+  {
+    vtkm::cont::Invoker invoke;
+    const vtkm::cont::ArrayHandleIndex indices(this->Representatives.GetNumberOfValues());
+    vtkm::cont::ArrayHandle<vtkm::Id> isFirst;
+    invoke(detail::ConcurrentHashSetMarkFirst{}, indices, this->Representatives, isFirst);
+    vtkm::cont::Algorithm::CopyIf(indices, isFirst, uniqueIndices);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> firstToUnique;
+    const vtkm::Id numberOfUniqueKeys =
+      vtkm::cont::Algorithm::ScanExclusive(isFirst, firstToUnique);
+    vtkm::cont::ArrayCopyDevice(
+      vtkm::cont::make_ArrayHandlePermutation(this->Representatives, firstToUnique), keyToUnique);
+    return numberOfUniqueKeys;
+  }
+
+  /// Returns, for every query, the smallest index of the keys equal to it, or -1 if the
+  /// query is not in the set.
+  template <typename QueryStorage>
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Id> Find(
+    const vtkm::cont::ArrayHandle<KeyType, QueryStorage>& queries) const
+  {
+    vtkm::cont::Invoker invoke;
+    vtkm::cont::ArrayHandle<vtkm::Id> indices;
+    invoke(detail::ConcurrentHashSetFind{}, queries, *this, indices);
+    return indices;
+  }
+
+  VTKM_CONT ExecObjectType PrepareForExecution(vtkm::cont::DeviceAdapterId device,
+                                               vtkm::cont::Token& token) const
+  {
+    return ExecObjectType(
+      this->Keys.PrepareForInput(device, token),
+      vtkm::exec::AtomicArrayExecutionObject<vtkm::Id>(this->Slots, device, token));
+  }
+
+private:
+  KeyArrayType Keys;
+  vtkm::cont::ArrayHandle<vtkm::Id> Slots;
+  vtkm::cont::ArrayHandle<vtkm::Id> Representatives;
+};
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_ConcurrentHashSet_h
@@ -12,6 +12,7 @@
 
 #include <vtkm/cont/Logging.h>
 #include <vtkm/cont/RuntimeDeviceTracker.h>
+#include <vtkm/cont/Trace.h>
 #include <vtkm/cont/internal/OptionParser.h>
 #include <vtkm/cont/internal/OptionParserArguments.h>
 
@@ -154,6 +155,14 @@ InitializeResult Initialize(int& argc, char* argv[], InitializeOptions opts)
                       loggingFlagName.c_str(),
                       opt::VtkmArg::Required,
                       loggingHelp.c_str() });
+    usage.push_back({ opt::OptionIndex::TRACE_FILE,
+                      0,
+                      "",
+                      "vtkm-trace-file",
+                      opt::VtkmArg::Required,
+                      "  --vtkm-trace-file <file> \tRecord the time spent in each logged scope, "
+                      "worklet, filter, and memory transfer and write it to file in Chrome trace "
+                      "event format." });
 
     // TODO: remove deprecated options on next vtk-m release
     usage.push_back({ opt::OptionIndex::DEPRECATED_DEVICE,
@@ -218,6 +227,11 @@ InitializeResult Initialize(int& argc, char* argv[], InitializeOptions opts)
         vtkm::cont::DeviceAdapterTagAny{}, runtimeDeviceOptions, argc, argv);
     }
 
+    if (options[opt::OptionIndex::TRACE_FILE])
+    {
+      vtkm::cont::StartTrace(options[opt::OptionIndex::TRACE_FILE].arg);
+    }
+
     if (options[opt::OptionIndex::DEPRECATED_LOGLEVEL])
     {
       VTKM_LOG_S(vtkm::cont::LogLevel::Error,
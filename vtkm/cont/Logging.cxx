@@ -9,6 +9,7 @@
 //============================================================================
 
 #include <vtkm/cont/Logging.h>
+#include <vtkm/cont/Trace.h>
 
 #ifdef VTKM_ENABLE_LOGGING
 
@@ -31,11 +32,15 @@
 #endif // VTKM_ENABLE_LOGGING
 
 #include <cassert>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace
 {
@@ -358,6 +363,76 @@ void LogScope(LogLevel level, const char* file, unsigned line, const char* forma
   }
 }
 
+namespace detail
+{
+
+struct LogScope::InternalStruct
+{
+  std::unique_ptr<loguru::LogScopeRAII> Scope;
+  bool Trace = false;
+  std::string Name;
+  const char* File;
+  unsigned Line;
+  std::chrono::steady_clock::time_point Start;
+};
+
+VTKM_CONT
+LogScope::LogScope(LogLevel level, const char* file, unsigned line, const char* format...)
+{
+  auto verbosity = getVerbosityByLevel(level);
+  const bool log = (verbosity <= loguru::current_verbosity_cutoff());
+  const bool trace = vtkm::cont::IsTraceEnabled();
+  if (!log && !trace)
+  {
+    return;
+  }
+
+  this->Internals.reset(new InternalStruct);
+  va_list args;
+  va_start(args, format);
+  if (trace)
+  {
+    va_list traceArgs;
+    va_copy(traceArgs, args);
+    const int size = std::vsnprintf(nullptr, 0, format, traceArgs);
+    va_end(traceArgs);
+    std::vector<char> name(static_cast<std::size_t>(size > 0 ? size : 0) + 1, '\0');
+    va_copy(traceArgs, args);
+    std::vsnprintf(name.data(), name.size(), format, traceArgs);
+    va_end(traceArgs);
+
+    this->Internals->Trace = true;
+    this->Internals->Name = name.data();
+    this->Internals->File = file;
+    this->Internals->Line = line;
+  }
+  if (log)
+  {
+    this->Internals->Scope.reset(new loguru::LogScopeRAII(verbosity, file, line, format, args));
+  }
+  va_end(args);
+
+  if (trace)
+  {
+    this->Internals->Start = std::chrono::steady_clock::now();
+  }
+}
+
+VTKM_CONT
+LogScope::~LogScope()
+{
+  if (this->Internals && this->Internals->Trace)
+  {
+    vtkm::cont::detail::AddTraceEvent(this->Internals->Name,
+                                      this->Internals->File,
+                                      this->Internals->Line,
+                                      this->Internals->Start,
+                                      std::chrono::steady_clock::now());
+  }
+}
+
+} // namespace detail
+
 VTKM_CONT
 void LogCond(LogLevel level, bool cond, const char* file, unsigned line, const char* format...)
 {
@@ -18,6 +18,7 @@
 #include <vtkm/cont/vtkm_cont_export.h>
 
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <typeindex>
@@ -58,7 +59,8 @@
 /// "logging scope" is opened within the C++ scope the macro is called from. New
 /// messages will be indented in the log until the scope ends, at which point
 /// a message is logged with the elapsed time that the scope was active. Scopes
-/// may be nested to arbitrary depths.
+/// may be nested to arbitrary depths. While a trace is recorded (see
+/// vtkm::cont::StartTrace), every scope is also recorded as a trace event.
 ///
 /// The logging implementation is thread-safe. When working in a multithreaded
 /// environment, each thread may be assigned a human-readable name using
@@ -198,7 +200,12 @@
 #define VTKM_LOG_S(level, ...) VTKM_LOG_IF_S(level, true, __VA_ARGS__)
 #define VTKM_LOG_F(level, ...) VTKM_LOG_IF_F(level, true, __VA_ARGS__)
 
-#define VTKM_LOG_SCOPE(level, ...) vtkm::cont::LogScope(level, __FILE__, __LINE__, __VA_ARGS__)
+#define VTKM_LOG_SCOPE_CONCAT_IMPL(prefix, line) prefix##line
+#define VTKM_LOG_SCOPE_CONCAT(prefix, line) VTKM_LOG_SCOPE_CONCAT_IMPL(prefix, line)
+
+#define VTKM_LOG_SCOPE(level, ...)                                            \
+  vtkm::cont::detail::LogScope VTKM_LOG_SCOPE_CONCAT(vtkmLogScope, __LINE__)( \
+    level, __FILE__, __LINE__, __VA_ARGS__)
 
 #define VTKM_LOG_SCOPE_FUNCTION(level) VTKM_LOG_SCOPE(level, __func__)
 #define VTKM_LOG_ALWAYS_S(level, ...) VTKM_LOG_S(level, __VA_ARGS__)
@@ -508,6 +515,34 @@ VTKM_CONT_EXPORT
 VTKM_CONT
 void LogScope(LogLevel level, const char* file, unsigned line, const char* format...);
 
+namespace detail
+{
+
+/**
+ * \brief Logs a scope, created by VTKM_LOG_SCOPE.
+ *
+ * Logs the message when constructed and its wall time when destroyed, if the
+ * level is logged. While a trace is recorded, the scope is also added to the
+ * trace whatever its level.
+ */
+struct VTKM_CONT_EXPORT LogScope
+{
+  VTKM_CONT
+  LogScope(LogLevel level, const char* file, unsigned line, const char* format...);
+
+  VTKM_CONT
+  ~LogScope();
+
+  LogScope(const LogScope&) = delete;
+  LogScope& operator=(const LogScope&) = delete;
+
+private:
+  struct InternalStruct;
+  std::unique_ptr<InternalStruct> Internals;
+};
+
+} // namespace detail
+
 /**
  * \brief Conditionally logs a message with a stream-like interface.
  *
@@ -0,0 +1,240 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/Trace.h>
+
+#include <vtkm/cont/Logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+
+struct TraceEvent
+{
+  std::string Name;
+  const char* File;
+  unsigned Line;
+  std::chrono::steady_clock::time_point Start;
+  std::chrono::steady_clock::time_point End;
+};
+
+// The events of one thread. Each thread adds to its own list, so threads rarely wait on each
+// other to record events.
+struct ThreadTrace
+{
+  std::mutex Mutex;
+  std::vector<TraceEvent> Events;
+  std::size_t ThreadIndex;
+  std::string ThreadName;
+};
+
+struct TraceState
+{
+  std::mutex Mutex;
+  std::atomic<bool> Enabled{ false };
+  // Changed whenever a trace starts so that threads register with the new trace.
+  std::atomic<vtkm::UInt64> Generation{ 0 };
+  std::string FileName;
+  std::chrono::steady_clock::time_point StartTime;
+  std::vector<std::shared_ptr<ThreadTrace>> Threads;
+};
+
+TraceState& GetTraceState()
+{
+  static TraceState state;
+  return state;
+}
+
+ThreadTrace& GetThreadTrace(TraceState& state)
+{
+  thread_local std::shared_ptr<ThreadTrace> threadTrace;
+  thread_local vtkm::UInt64 threadGeneration = 0;
+
+  if (!threadTrace || (threadGeneration != state.Generation.load()))
+  {
+    threadTrace = std::make_shared<ThreadTrace>();
+    threadTrace->ThreadName = vtkm::cont::GetLogThreadName();
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    threadTrace->ThreadIndex = state.Threads.size();
+    state.Threads.push_back(threadTrace);
+    threadGeneration = state.Generation.load();
+  }
+  return *threadTrace;
+}
+
+void WriteJSONString(std::ostream& out, const std::string& str)
+{
+  out << '"';
+  for (char c : str)
+  {
+    switch (c)
+    {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      case '\n':
+        out << "\\n";
+        break;
+      case '\t':
+        out << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+          out << escaped;
+        }
+        else
+        {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+
+// Writes the trace in the Chrome trace event format. Every event is a complete ("X") event
+// with its start time and duration in microseconds.
+void WriteTrace(TraceState& state)
+{
+  std::ofstream out(state.FileName);
+  if (!out)
+  {
+    VTKM_LOG_S(vtkm::cont::LogLevel::Error, "Could not open trace file " << state.FileName);
+    return;
+  }
+
+  using Microseconds = std::chrono::duration<double, std::micro>;
+  out << std::fixed << std::setprecision(3);
+  out << "{\"traceEvents\":[";
+  const char* separator = "\n";
+  vtkm::Id numEvents = 0;
+  for (auto& threadTrace : state.Threads)
+  {
+    std::lock_guard<std::mutex> lock(threadTrace->Mutex);
+    const std::size_t tid = threadTrace->ThreadIndex + 1;
+    out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << tid
+        << ",\"args\":{\"name\":";
+    WriteJSONString(out, threadTrace->ThreadName);
+    out << "}}";
+    separator = ",\n";
+
+    // Outer scopes first, so viewers nest events that start at the same time correctly.
+    std::vector<TraceEvent>& events = threadTrace->Events;
+    std::stable_sort(
+      events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+        return (a.Start < b.Start) || ((a.Start == b.Start) && (a.End > b.End));
+      });
+    for (const TraceEvent& event : events)
+    {
+      out << separator << "{\"name\":";
+      WriteJSONString(out, event.Name);
+      out << ",\"cat\":\"vtkm\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid
+          << ",\"ts\":" << Microseconds(event.Start - state.StartTime).count()
+          << ",\"dur\":" << Microseconds(event.End - event.Start).count()
+          << ",\"args\":{\"source\":";
+      WriteJSONString(out, std::string(event.File) + ":" + std::to_string(event.Line));
+      out << "}}";
+    }
+    numEvents += static_cast<vtkm::Id>(events.size());
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  VTKM_LOG_S(vtkm::cont::LogLevel::Info,
+             "Wrote " << numEvents << " trace events to " << state.FileName);
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+
+VTKM_CONT void StartTrace(const std::string& fileName)
+{
+  TraceState& state = GetTraceState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  if (state.Enabled)
+  {
+    VTKM_LOG_S(vtkm::cont::LogLevel::Warn,
+               "A trace is already being written to " << state.FileName << ". Ignoring "
+                                                      << fileName);
+    return;
+  }
+
+  // The state was constructed above, so it is destroyed after this runs at exit.
+  static bool writeAtExit = false;
+  if (!writeAtExit)
+  {
+    std::atexit([]() { vtkm::cont::StopTrace(); });
+    writeAtExit = true;
+  }
+
+  state.FileName = fileName;
+  state.Threads.clear();
+  ++state.Generation;
+  state.StartTime = std::chrono::steady_clock::now();
+  state.Enabled = true;
+}
+
+VTKM_CONT void StopTrace()
+{
+  TraceState& state = GetTraceState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  if (!state.Enabled)
+  {
+    return;
+  }
+  state.Enabled = false;
+  WriteTrace(state);
+  state.Threads.clear();
+}
+
+VTKM_CONT bool IsTraceEnabled()
+{
+  return GetTraceState().Enabled.load(std::memory_order_relaxed);
+}
+
+namespace detail
+{
+
+VTKM_CONT void AddTraceEvent(const std::string& name,
+                             const char* file,
+                             unsigned line,
+                             std::chrono::steady_clock::time_point start,
+                             std::chrono::steady_clock::time_point end)
+{
+  TraceState& state = GetTraceState();
+  if (!state.Enabled.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+  ThreadTrace& threadTrace = GetThreadTrace(state);
+  std::lock_guard<std::mutex> lock(threadTrace.Mutex);
+  threadTrace.Events.push_back(TraceEvent{ name, file, line, start, end });
+}
+
+} // namespace detail
+}
+} // namespace vtkm::cont
@@ -0,0 +1,67 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_Trace_h
+#define vtk_m_cont_Trace_h
+
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <chrono>
+#include <string>
+
+namespace vtkm
+{
+namespace cont
+{
+
+/// \brief Starts recording a trace of where the program spends its time.
+///
+/// While a trace is recorded, every scope logged with `VTKM_LOG_SCOPE` is recorded as an
+/// event with its start time and duration, whatever the log level. This includes worklet
+/// invocations, filter executions, and copies of array data between the host and devices.
+/// Events are recorded separately for each thread and nest like the scopes they come from.
+///
+/// The trace is written to `fileName` in the Chrome trace event format when `StopTrace` is
+/// called or the program exits. It can be viewed with `chrome://tracing` or
+/// https://ui.perfetto.dev.
+///
+/// `vtkm::cont::Initialize` starts a trace when given the `--vtkm-trace-file <file>` option.
+/// Scopes are only recorded when VTK-m is built with logging enabled.
+///
+VTKM_CONT_EXPORT VTKM_CONT void StartTrace(const std::string& fileName);
+
+/// \brief Stops recording the trace and writes it to its file.
+///
+/// Does nothing if no trace is being recorded.
+///
+VTKM_CONT_EXPORT VTKM_CONT void StopTrace();
+
+/// Returns true while a trace is being recorded.
+///
+VTKM_CONT_EXPORT VTKM_CONT bool IsTraceEnabled();
+
+namespace detail
+{
+
+/// Records an event in the trace. `start` and `end` are from `std::chrono::steady_clock`.
+/// Does nothing if no trace is being recorded.
+///
+VTKM_CONT_EXPORT VTKM_CONT void AddTraceEvent(const std::string& name,
+                                              const char* file,
+                                              unsigned line,
+                                              std::chrono::steady_clock::time_point start,
+                                              std::chrono::steady_clock::time_point end);
+
+} // namespace detail
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_Trace_h
@@ -13,7 +13,9 @@
 #include <vtkm/cont/DeviceAdapter.h>
 #include <vtkm/cont/ErrorBadAllocation.h>
 #include <vtkm/cont/ErrorBadDevice.h>
+#include <vtkm/cont/ErrorBadValue.h>
 #include <vtkm/cont/ErrorBadType.h>
+#include <vtkm/cont/Logging.h>
 #include <vtkm/cont/RuntimeDeviceInformation.h>
 #include <vtkm/cont/TryExecute.h>
 
@@ -22,6 +24,7 @@
 
 #include <vtkm/exec/FunctorBase.h>
 
+#include <atomic>
 #include <condition_variable>
 #include <cstring>
 #include <deque>
@@ -59,11 +62,20 @@ namespace
 
 using LockType = std::unique_lock<std::mutex>;
 
+// Modification stamps are drawn from a single counter so that no two buffers, or two states of
+// the same buffer, ever share a stamp.
+vtkm::UInt64 NextModifiedStamp()
+{
+  static std::atomic<vtkm::UInt64> counter{ 0 };
+  return ++counter;
+}
+
 struct BufferState
 {
   vtkm::cont::internal::BufferInfo Info;
   bool Pinned = false;
   bool UpToDate = false;
+  bool ReadOnly = false;
 
   BufferState() = default;
   BufferState(const vtkm::cont::internal::BufferInfo& info,
@@ -92,6 +104,8 @@ struct BufferState
     if (this->Info.GetSize() != newSize)
     {
       this->Info.Reallocate(newSize);
+      // The data were moved to new memory.
+      this->ReadOnly = false;
     }
   }
 
@@ -102,6 +116,7 @@ struct BufferState
     if (!this->Pinned)
     {
       this->Info = vtkm::cont::internal::BufferInfo{};
+      this->ReadOnly = false;
     }
     this->UpToDate = false;
   }
@@ -280,6 +295,10 @@ private:
   DeviceBufferMap DeviceBuffers;
   BufferState HostBuffer;
 
+  vtkm::UInt64 ModifiedStamp = NextModifiedStamp();
+  bool UntrackedWrites = false;
+  std::map<std::string, std::shared_ptr<void>> CachedData;
+
 public:
   std::mutex Mutex;
   std::condition_variable ConditionVariable;
@@ -327,6 +346,36 @@ public:
     this->CheckLock(lock);
     this->NumberOfBytes = numberOfBytes;
   }
+
+  VTKM_CONT vtkm::UInt64 GetModifiedStamp(const LockType& lock) const
+  {
+    this->CheckLock(lock);
+    // The data can change at any time, so no two stamps can be considered the same data.
+    return this->UntrackedWrites ? NextModifiedStamp() : this->ModifiedStamp;
+  }
+  VTKM_CONT void Modified(const LockType& lock)
+  {
+    this->CheckLock(lock);
+    this->ModifiedStamp = NextModifiedStamp();
+    this->CachedData.clear();
+  }
+
+  VTKM_CONT bool GetUntrackedWrites(const LockType& lock) const
+  {
+    this->CheckLock(lock);
+    return this->UntrackedWrites;
+  }
+  VTKM_CONT void SetUntrackedWrites(const LockType& lock, bool untrackedWrites)
+  {
+    this->CheckLock(lock);
+    this->UntrackedWrites = untrackedWrites;
+  }
+
+  VTKM_CONT std::map<std::string, std::shared_ptr<void>>& GetCachedData(const LockType& lock)
+  {
+    this->CheckLock(lock);
+    return this->CachedData;
+  }
 };
 
 namespace detail
@@ -468,6 +517,18 @@ struct VTKM_NEVER_EXPORT BufferHelper
     }
   }
 
+  // Writing in place to read only host memory would fault. A buffer whose size has changed
+  // moves its data out of that memory before they are written, so it can be written.
+  static void CheckWritable(const std::shared_ptr<Buffer::InternalsStruct>& internals,
+                            std::unique_lock<std::mutex>& lock)
+  {
+    const BufferState& hostBuffer = internals->GetHostBuffer(lock);
+    if (hostBuffer.ReadOnly && (hostBuffer.GetSize() == internals->GetNumberOfBytes(lock)))
+    {
+      throw vtkm::cont::ErrorBadValue("Attempted to write to a buffer with read only memory.");
+    }
+  }
+
   static void SetNumberOfBytes(const std::shared_ptr<Buffer::InternalsStruct>& internals,
                                std::unique_lock<std::mutex>& lock,
                                vtkm::BufferSizeType numberOfBytes,
@@ -539,6 +600,10 @@ struct VTKM_NEVER_EXPORT BufferHelper
         deviceBuffer.second.Reallocate(targetSize);
       }
 
+      VTKM_LOG_SCOPE(vtkm::cont::LogLevel::MemTransfer,
+                     "Copy %s from device '%s' to host",
+                     vtkm::cont::GetHumanReadableSize(targetSize).c_str(),
+                     deviceBuffer.first.GetName().c_str());
       if (!hostBuffer.Pinned)
       {
         hostBuffer = memoryManager.CopyDeviceToHost(deviceBuffer.second);
@@ -620,6 +685,10 @@ struct VTKM_NEVER_EXPORT BufferHelper
         hostBuffer.Reallocate(targetSize);
       }
 
+      VTKM_LOG_SCOPE(vtkm::cont::LogLevel::MemTransfer,
+                     "Copy %s from host to device '%s'",
+                     vtkm::cont::GetHumanReadableSize(targetSize).c_str(),
+                     device.GetName().c_str());
       if (!deviceBuffers[device].Pinned)
       {
         deviceBuffers[device] = memoryManager.CopyHostToDevice(hostBuffer);
@@ -677,6 +746,9 @@ struct VTKM_NEVER_EXPORT BufferHelper
 
     AllocateOnHost(srcInternals, srcLock, token, AccessMode::READ);
 
+    VTKM_LOG_SCOPE(vtkm::cont::LogLevel::MemTransfer,
+                   "Copy %s on host",
+                   vtkm::cont::GetHumanReadableSize(size).c_str());
     std::memcpy(destInternals->GetHostBuffer(destLock).GetPointer(),
                 srcInternals->GetHostBuffer(srcLock).GetPointer(),
                 static_cast<std::size_t>(size));
@@ -708,6 +780,11 @@ struct VTKM_NEVER_EXPORT BufferHelper
     // Do the copy
     vtkm::cont::internal::DeviceAdapterMemoryManagerBase& memoryManager =
       vtkm::cont::RuntimeDeviceInformation().GetMemoryManager(device);
+    const vtkm::BufferSizeType size = srcInternals->GetNumberOfBytes(srcLock);
+    VTKM_LOG_SCOPE(vtkm::cont::LogLevel::MemTransfer,
+                   "Copy %s on device '%s'",
+                   vtkm::cont::GetHumanReadableSize(size).c_str(),
+                   device.GetName().c_str());
 
     if (!destDeviceBuffers[device].Pinned)
     {
@@ -721,7 +798,7 @@ struct VTKM_NEVER_EXPORT BufferHelper
       destDeviceBuffers[device].UpToDate = true;
     }
 
-    destInternals->SetNumberOfBytes(destLock, srcInternals->GetNumberOfBytes(srcLock));
+    destInternals->SetNumberOfBytes(destLock, size);
 
     destInternals->MetaData.DeepCopyFrom(srcInternals->MetaData);
   }
@@ -775,6 +852,60 @@ void Buffer::SetNumberOfBytes(vtkm::BufferSizeType numberOfBytes,
 {
   LockType lock = this->Internals->GetLock();
   detail::BufferHelper::SetNumberOfBytes(this->Internals, lock, numberOfBytes, preserve, token);
+  this->Internals->Modified(lock);
+}
+
+vtkm::UInt64 Buffer::GetModifiedStamp() const
+{
+  LockType lock = this->Internals->GetLock();
+  return this->Internals->GetModifiedStamp(lock);
+}
+
+void Buffer::SetUntrackedWrites() const
+{
+  LockType lock = this->Internals->GetLock();
+  this->Internals->SetUntrackedWrites(lock, true);
+  this->Internals->Modified(lock);
+}
+
+bool Buffer::HasUntrackedWrites() const
+{
+  LockType lock = this->Internals->GetLock();
+  return this->Internals->GetUntrackedWrites(lock);
+}
+
+void Buffer::SetHostReadOnly() const
+{
+  LockType lock = this->Internals->GetLock();
+  this->Internals->GetHostBuffer(lock).ReadOnly = true;
+}
+
+bool Buffer::IsHostReadOnly() const
+{
+  LockType lock = this->Internals->GetLock();
+  const BufferState& hostBuffer = this->Internals->GetHostBuffer(lock);
+  return hostBuffer.ReadOnly && (hostBuffer.GetSize() == this->Internals->GetNumberOfBytes(lock));
+}
+
+void Buffer::SetCachedData(const std::string& key, const std::shared_ptr<void>& data) const
+{
+  LockType lock = this->Internals->GetLock();
+  if (!this->Internals->GetUntrackedWrites(lock))
+  {
+    this->Internals->GetCachedData(lock)[key] = data;
+  }
+}
+
+std::shared_ptr<void> Buffer::GetCachedData(const std::string& key) const
+{
+  LockType lock = this->Internals->GetLock();
+  if (this->Internals->GetUntrackedWrites(lock))
+  {
+    return {};
+  }
+  auto& cachedData = this->Internals->GetCachedData(lock);
+  auto it = cachedData.find(key);
+  return (it != cachedData.end()) ? it->second : std::shared_ptr<void>{};
 }
 
 bool Buffer::HasMetaData() const
@@ -793,6 +924,8 @@ void Buffer::SetMetaData(void* data,
                          detail::CopierType* copier) const
 {
   this->Internals->MetaData.Initialize(data, type, deleter, copier);
+  LockType lock = this->Internals->GetLock();
+  this->Internals->Modified(lock);
 }
 
 void* Buffer::GetMetaData(const std::string& type) const
@@ -896,6 +1029,7 @@ const void* Buffer::ReadPointerDevice(vtkm::cont::DeviceAdapterId device,
 void* Buffer::WritePointerHost(vtkm::cont::Token& token) const
 {
   LockType lock = this->Internals->GetLock();
+  detail::BufferHelper::CheckWritable(this->Internals, lock);
   detail::BufferHelper::WaitToWrite(this->Internals, lock, token);
   detail::BufferHelper::AllocateOnHost(
     this->Internals, lock, token, detail::BufferHelper::AccessMode::WRITE);
@@ -905,6 +1039,7 @@ void* Buffer::WritePointerHost(vtkm::cont::Token& token) const
   {
     deviceBuffer.second.Release();
   }
+  this->Internals->Modified(lock);
 
   return this->Internals->GetHostBuffer(lock).GetPointer();
 }
@@ -914,6 +1049,7 @@ void* Buffer::WritePointerDevice(vtkm::cont::DeviceAdapterId device, vtkm::cont:
   if (device.IsValueValid())
   {
     LockType lock = this->Internals->GetLock();
+    detail::BufferHelper::CheckWritable(this->Internals, lock);
     detail::BufferHelper::WaitToWrite(this->Internals, lock, token);
     detail::BufferHelper::AllocateOnDevice(
       this->Internals, lock, token, device, detail::BufferHelper::AccessMode::WRITE);
@@ -927,6 +1063,7 @@ void* Buffer::WritePointerDevice(vtkm::cont::DeviceAdapterId device, vtkm::cont:
         deviceBuffer.second.Release();
       }
     }
+    this->Internals->Modified(lock);
 
     return this->Internals->GetDeviceBuffers(lock)[device].GetPointer();
   }
@@ -958,7 +1095,9 @@ void Buffer::DeepCopyFrom(const vtkm::cont::internal::Buffer& src) const
     LockType srcLock = src.Internals->GetLock();
     LockType destLock = dest.Internals->GetLock();
 
+    detail::BufferHelper::CheckWritable(dest.Internals, destLock);
     detail::BufferHelper::WaitToRead(src.Internals, srcLock, token);
+    dest.Internals->Modified(destLock);
 
     // If we are on a device, copy there.
     for (auto&& deviceBuffer : src.Internals->GetDeviceBuffers(srcLock))
@@ -999,8 +1138,10 @@ void Buffer::DeepCopyFrom(const vtkm::cont::internal::Buffer& src,
   {
     LockType srcLock = src.Internals->GetLock();
     LockType destLock = this->Internals->GetLock();
+    detail::BufferHelper::CheckWritable(this->Internals, destLock);
     detail::BufferHelper::CopyOnDevice(
       device, this->Internals, srcLock, this->Internals, destLock, token);
+    this->Internals->Modified(destLock);
   }
 }
 
@@ -1029,12 +1170,28 @@ void Buffer::Reset(const vtkm::cont::internal::BufferInfo& bufferInfo)
   }
 
   this->Internals->SetNumberOfBytes(lock, bufferInfo.GetSize());
+  // The old memory, and any pointer into it, is no longer used by the buffer.
+  this->Internals->SetUntrackedWrites(lock, false);
+  this->Internals->Modified(lock);
 }
 
 void Buffer::ReleaseDeviceResources() const
 {
   vtkm::cont::Token token;
 
+  if (this->IsHostReadOnly())
+  {
+    // Read only host memory is never written, so it is current and device copies can simply
+    // be dropped.
+    LockType lock = this->Internals->GetLock();
+    detail::BufferHelper::WaitToWrite(this->Internals, lock, token);
+    for (auto&& deviceBuffer : this->Internals->GetDeviceBuffers(lock))
+    {
+      deviceBuffer.second.Release();
+    }
+    return;
+  }
+
   // Getting a write host buffer will invalidate any device arrays and preserve data
   // on the host (copying if necessary).
   this->WritePointerHost(token);
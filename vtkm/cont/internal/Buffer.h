@@ -125,6 +125,59 @@ public:
                                   vtkm::CopyFlag preserve,
                                   vtkm::cont::Token& token) const;
 
+  /// \brief Returns a stamp that changes whenever the buffer might be modified.
+  ///
+  /// A new stamp is given whenever the buffer is resized, reset, deep copied into, given new
+  /// meta data, or a pointer for writing is retrieved. Stamps are unique across all buffers, so
+  /// a buffer that returns the same stamp as a previous call holds the same data as it did then.
+  ///
+  /// Writes through a pointer are only tracked while the `Token` used to get the pointer is
+  /// attached. If a pointer can outlive its token (see `SetUntrackedWrites`), every call
+  /// returns a new stamp.
+  ///
+  VTKM_CONT vtkm::UInt64 GetModifiedStamp() const;
+
+  /// \brief Flags that the buffer can be written without the buffer knowing.
+  ///
+  /// This is the case when a write pointer outlives the `Token` used to get it (as with
+  /// `ArrayHandle::WritePortal`), or when the memory is owned by the caller. From then on
+  /// `GetModifiedStamp` returns a new stamp on every call and no data are cached, so nothing
+  /// derived from the old contents is reused. The flag is cleared when the buffer is `Reset`
+  /// to new memory.
+  ///
+  VTKM_CONT void SetUntrackedWrites() const;
+
+  /// \brief Returns whether `SetUntrackedWrites` was called since the last `Reset`.
+  ///
+  VTKM_CONT bool HasUntrackedWrites() const;
+
+  /// \brief Flags that the host memory of the buffer cannot be written.
+  ///
+  /// This is used for memory that faults when written, such as a read only file mapping.
+  /// Getting a pointer for writing (on the host or a device) or deep copying into the buffer
+  /// throws an `ErrorBadValue` instead. Resizing the buffer moves its data to new memory, which
+  /// clears the flag, as does a `Reset`.
+  ///
+  VTKM_CONT void SetHostReadOnly() const;
+
+  /// \brief Returns whether the host memory of the buffer cannot be written.
+  ///
+  VTKM_CONT bool IsHostReadOnly() const;
+
+  /// \brief Attaches data computed from the contents of the buffer, such as their range.
+  ///
+  /// All cached data are dropped whenever the buffer gets a new modified stamp (see
+  /// `GetModifiedStamp`), so they are never returned after the buffer is written to. Nothing
+  /// is cached in buffers with untracked writes. Cached data are shared by all copies of a
+  /// `Buffer` and released with the buffer. Data derived from several buffers should record
+  /// the stamps of the other buffers to check them.
+  ///
+  VTKM_CONT void SetCachedData(const std::string& key, const std::shared_ptr<void>& data) const;
+
+  /// \brief Returns the data attached with `SetCachedData`, or `nullptr` if there is none.
+  ///
+  VTKM_CONT std::shared_ptr<void> GetCachedData(const std::string& key) const;
+
 private:
   VTKM_CONT bool MetaDataIsType(const std::string& type) const;
   VTKM_CONT void SetMetaData(void* data,
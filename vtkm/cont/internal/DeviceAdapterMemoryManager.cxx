@@ -10,88 +10,29 @@
 
 #include <vtkm/cont/ErrorBadAllocation.h>
 #include <vtkm/cont/internal/DeviceAdapterMemoryManager.h>
+#include <vtkm/cont/internal/HostMemoryPool.h>
 
 #include <vtkm/Math.h>
 
 #include <atomic>
 #include <cstring>
 
-//----------------------------------------------------------------------------------------
-// Special allocation/deallocation code
-
-#if defined(VTKM_POSIX)
-#define VTKM_MEMALIGN_POSIX
-#elif defined(_WIN32)
-#define VTKM_MEMALIGN_WIN
-#elif defined(__SSE__)
-#define VTKM_MEMALIGN_SSE
-#else
-#define VTKM_MEMALIGN_NONE
-#endif
-
-#if defined(VTKM_MEMALIGN_POSIX)
-#include <stdlib.h>
-#elif defined(VTKM_MEMALIGN_WIN)
-#include <malloc.h>
-#elif defined(VTKM_MEMALIGN_SSE)
-#include <xmmintrin.h>
-#else
-#include <malloc.h>
-#endif
-
-#include <cstddef>
-#include <cstdlib>
-
 namespace
 {
 
-/// A deleter object that can be used with our aligned mallocs
+/// A deleter object that can be used with memory allocated by `HostAllocate`.
 void HostDeleter(void* memory)
 {
-  if (memory == nullptr)
-  {
-    return;
-  }
-
-#if defined(VTKM_MEMALIGN_POSIX)
-  free(memory);
-#elif defined(VTKM_MEMALIGN_WIN)
-  _aligned_free(memory);
-#elif defined(VTKM_MEMALIGN_SSE)
-  _mm_free(memory);
-#else
-  free(memory);
-#endif
+  vtkm::cont::internal::GetHostMemoryPool().Free(memory);
 }
 
 /// Allocates a buffer of a specified size using VTK-m's preferred memory alignment.
-/// Returns a void* pointer that should be deleted with `HostDeleter`.
+/// The memory comes from the global `HostMemoryPool`, which may recycle a block previously
+/// freed. Returns a void* pointer that should be deleted with `HostDeleter`.
 void* HostAllocate(vtkm::BufferSizeType numBytes)
 {
   VTKM_ASSERT(numBytes >= 0);
-  if (numBytes <= 0)
-  {
-    return nullptr;
-  }
-
-  const std::size_t size = static_cast<std::size_t>(numBytes);
-  constexpr std::size_t align = VTKM_ALLOCATION_ALIGNMENT;
-
-#if defined(VTKM_MEMALIGN_POSIX)
-  void* memory = nullptr;
-  if (posix_memalign(&memory, align, size) != 0)
-  {
-    memory = nullptr;
-  }
-#elif defined(VTKM_MEMALIGN_WIN)
-  void* memory = _aligned_malloc(size, align);
-#elif defined(VTKM_MEMALIGN_SSE)
-  void* memory = _mm_malloc(size, align);
-#else
-  void* memory = malloc(size);
-#endif
-
-  return memory;
+  return vtkm::cont::internal::GetHostMemoryPool().Allocate(numBytes);
 }
 
 /// Reallocates a buffer on the host.
@@ -102,14 +43,19 @@ void HostReallocate(void*& memory,
 {
   VTKM_ASSERT(memory == container);
 
-  // If the new size is not much smaller than the old size, just reuse the buffer (and waste a
-  // little memory).
-  if ((newSize > ((3 * oldSize) / 4)) && (newSize <= oldSize))
+  // If the new size fits in the block we already have and is not much smaller than the old
+  // size, just reuse the buffer (and waste a little memory).
+  if ((newSize > ((3 * oldSize) / 4)) &&
+      (newSize <= vtkm::cont::internal::HostMemoryPool::GetCapacity(memory)))
   {
     return;
   }
 
   void* newBuffer = HostAllocate(newSize);
+  if ((newBuffer == nullptr) && (newSize > 0))
+  {
+    throw vtkm::cont::ErrorBadAllocation("Could not reallocate host memory.");
+  }
   std::memcpy(newBuffer, memory, static_cast<std::size_t>(vtkm::Min(newSize, oldSize)));
 
   if (memory != nullptr)
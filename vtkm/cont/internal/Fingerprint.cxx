@@ -0,0 +1,205 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#include <vtkm/cont/internal/Fingerprint.h>
+
+#include <vtkm/TypeList.h>
+#include <vtkm/VecTraits.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/ErrorBadValue.h>
+
+#include <cstring>
+
+namespace
+{
+
+vtkm::UInt64 FloatBits(vtkm::Float64 value)
+{
+  vtkm::UInt64 bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+template <typename T, typename S>
+void AppendBuffersFingerprint(std::vector<vtkm::UInt64>& fingerprint,
+                              const vtkm::cont::ArrayHandle<T, S>& array)
+{
+  for (const auto& buffer : array.GetBuffers())
+  {
+    fingerprint.push_back(buffer.GetModifiedStamp());
+  }
+}
+
+// Implicit arrays are recreated with the cell set, so identify them by value.
+template <typename T>
+void AppendBuffersFingerprint(
+  std::vector<vtkm::UInt64>& fingerprint,
+  const vtkm::cont::ArrayHandle<T, vtkm::cont::StorageTagConstant>& array)
+{
+  const vtkm::Id numberOfValues = array.GetNumberOfValues();
+  fingerprint.push_back(
+    (numberOfValues > 0) ? static_cast<vtkm::UInt64>(array.ReadPortal().Get(0)) : 0);
+  fingerprint.push_back(static_cast<vtkm::UInt64>(numberOfValues));
+}
+
+template <typename T>
+void AppendBuffersFingerprint(
+  std::vector<vtkm::UInt64>& fingerprint,
+  const vtkm::cont::ArrayHandle<T, vtkm::cont::StorageTagCounting>& array)
+{
+  auto portal = array.ReadPortal();
+  fingerprint.push_back(static_cast<vtkm::UInt64>(portal.GetStart()));
+  fingerprint.push_back(static_cast<vtkm::UInt64>(portal.GetStep()));
+  fingerprint.push_back(static_cast<vtkm::UInt64>(portal.GetNumberOfValues()));
+}
+
+template <typename CellSetType>
+void AppendExplicitFingerprint(std::vector<vtkm::UInt64>& fingerprint, const CellSetType& cellSet)
+{
+  vtkm::TopologyElementTagCell visit;
+  vtkm::TopologyElementTagPoint incident;
+  AppendBuffersFingerprint(fingerprint, cellSet.GetShapesArray(visit, incident));
+  fingerprint.push_back(0);
+  AppendBuffersFingerprint(fingerprint, cellSet.GetConnectivityArray(visit, incident));
+  fingerprint.push_back(0);
+  AppendBuffersFingerprint(fingerprint, cellSet.GetOffsetsArray(visit, incident));
+}
+
+template <vtkm::IdComponent Dimension>
+bool AppendStructuredFingerprint(std::vector<vtkm::UInt64>& fingerprint,
+                                 const vtkm::cont::UnknownCellSet& cellSet)
+{
+  using CellSetType = vtkm::cont::CellSetStructured<Dimension>;
+  if (!cellSet.IsType<CellSetType>())
+  {
+    return false;
+  }
+  fingerprint.push_back(static_cast<vtkm::UInt64>(Dimension));
+  const auto pointDimensions = cellSet.AsCellSet<CellSetType>().GetPointDimensions();
+  using Traits = vtkm::VecTraits<std::decay_t<decltype(pointDimensions)>>;
+  for (vtkm::IdComponent d = 0; d < Traits::GetNumberOfComponents(pointDimensions); ++d)
+  {
+    fingerprint.push_back(static_cast<vtkm::UInt64>(Traits::GetComponent(pointDimensions, d)));
+  }
+  return true;
+}
+
+struct AppendComponentsFingerprint
+{
+  template <typename T>
+  void operator()(T,
+                  std::vector<vtkm::UInt64>& fingerprint,
+                  const vtkm::cont::UnknownArrayHandle& array,
+                  vtkm::cont::internal::Buffer* firstBuffer,
+                  bool& found) const
+  {
+    if (found || !array.IsBaseComponentType<T>())
+    {
+      return;
+    }
+    found = true;
+    for (vtkm::IdComponent c = 0; c < array.GetNumberOfComponentsFlat(); ++c)
+    {
+      // Components that are not stored in memory cannot be extracted without a copy.
+      vtkm::cont::ArrayHandleStride<T> component;
+      try
+      {
+        component = array.ExtractComponent<T>(c, vtkm::CopyFlag::Off);
+      }
+      catch (const vtkm::cont::ErrorBadValue&)
+      {
+        fingerprint.clear();
+        return;
+      }
+      const vtkm::cont::internal::Buffer data = component.GetBasicArray().GetBuffers()[0];
+      fingerprint.push_back(data.GetModifiedStamp());
+      fingerprint.push_back(static_cast<vtkm::UInt64>(component.GetStride()));
+      fingerprint.push_back(static_cast<vtkm::UInt64>(component.GetOffset()));
+      fingerprint.push_back(static_cast<vtkm::UInt64>(component.GetModulo()));
+      fingerprint.push_back(static_cast<vtkm::UInt64>(component.GetDivisor()));
+      if ((c == 0) && (firstBuffer != nullptr))
+      {
+        *firstBuffer = data;
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+bool AppendCellSetFingerprint(std::vector<vtkm::UInt64>& fingerprint,
+                              const vtkm::cont::UnknownCellSet& cellSet)
+{
+  if (cellSet.IsType<vtkm::cont::CellSetExplicit<>>())
+  {
+    fingerprint.push_back(4);
+    AppendExplicitFingerprint(fingerprint, cellSet.AsCellSet<vtkm::cont::CellSetExplicit<>>());
+    return true;
+  }
+  if (cellSet.IsType<vtkm::cont::CellSetSingleType<>>())
+  {
+    fingerprint.push_back(5);
+    AppendExplicitFingerprint(fingerprint, cellSet.AsCellSet<vtkm::cont::CellSetSingleType<>>());
+    return true;
+  }
+  return AppendStructuredFingerprint<1>(fingerprint, cellSet) ||
+    AppendStructuredFingerprint<2>(fingerprint, cellSet) ||
+    AppendStructuredFingerprint<3>(fingerprint, cellSet);
+}
+
+bool AppendArrayFingerprint(std::vector<vtkm::UInt64>& fingerprint,
+                            const vtkm::cont::UnknownArrayHandle& array,
+                            vtkm::cont::internal::Buffer* firstBuffer)
+{
+  if (array.CanConvert<vtkm::cont::ArrayHandleUniformPointCoordinates>())
+  {
+    auto uniform = array.AsArrayHandle<vtkm::cont::ArrayHandleUniformPointCoordinates>();
+    auto portal = uniform.ReadPortal();
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      fingerprint.push_back(static_cast<vtkm::UInt64>(portal.GetDimensions()[d]));
+      fingerprint.push_back(FloatBits(static_cast<vtkm::Float64>(portal.GetOrigin()[d])));
+      fingerprint.push_back(FloatBits(static_cast<vtkm::Float64>(portal.GetSpacing()[d])));
+    }
+    if (firstBuffer != nullptr)
+    {
+      *firstBuffer = uniform.GetBuffers()[0];
+    }
+    return true;
+  }
+
+  // The components are appended to a separate vector, which is cleared if one of them is
+  // not stored in memory.
+  std::vector<vtkm::UInt64> components;
+  bool found = false;
+  vtkm::ListForEach(
+    AppendComponentsFingerprint{}, vtkm::TypeListBaseC{}, components, array, firstBuffer, found);
+  if (components.empty())
+  {
+    return false;
+  }
+  fingerprint.insert(fingerprint.end(), components.begin(), components.end());
+  return true;
+}
+
+}
+}
+} // namespace vtkm::cont::internal
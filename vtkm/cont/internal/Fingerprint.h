@@ -0,0 +1,53 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_internal_Fingerprint_h
+#define vtk_m_cont_internal_Fingerprint_h
+
+#include <vtkm/cont/UnknownArrayHandle.h>
+#include <vtkm/cont/UnknownCellSet.h>
+#include <vtkm/cont/internal/Buffer.h>
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <vector>
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+/// \brief Appends values that identify the current contents of a cell set.
+///
+/// Explicit cell sets are identified by the modified stamps of their buffers (see
+/// `Buffer::GetModifiedStamp`), and structured cell sets by their dimensions. Data derived
+/// from a cell set can record the fingerprint and later compare it to check whether the
+/// cell set changed. Returns false if the type of the cell set is not supported.
+///
+VTKM_CONT_EXPORT bool AppendCellSetFingerprint(std::vector<vtkm::UInt64>& fingerprint,
+                                               const vtkm::cont::UnknownCellSet& cellSet);
+
+/// \brief Appends values that identify the current contents of an array.
+///
+/// Arrays stored in memory are identified by the modified stamps of their buffers and the
+/// layout of their components. Uniform point coordinates are identified by their dimensions,
+/// origin and spacing. If `firstBuffer` is given, it receives a buffer of the array that
+/// can hold cached data. Returns false for other arrays, such as those computed on the fly.
+///
+VTKM_CONT_EXPORT bool AppendArrayFingerprint(std::vector<vtkm::UInt64>& fingerprint,
+                                             const vtkm::cont::UnknownArrayHandle& array,
+                                             vtkm::cont::internal::Buffer* firstBuffer = nullptr);
+
+}
+}
+} // namespace vtkm::cont::internal
+
+#endif //vtk_m_cont_internal_Fingerprint_h
@@ -0,0 +1,390 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/internal/HostMemoryPool.h>
+
+#include <vtkm/cont/Logging.h>
+
+#include <vtkm/StaticAssert.h>
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+//----------------------------------------------------------------------------------------
+// Special allocation/deallocation code
+
+#if defined(VTKM_POSIX)
+#define VTKM_MEMALIGN_POSIX
+#elif defined(_WIN32)
+#define VTKM_MEMALIGN_WIN
+#elif defined(__SSE__)
+#define VTKM_MEMALIGN_SSE
+#else
+#define VTKM_MEMALIGN_NONE
+#endif
+
+#if defined(VTKM_MEMALIGN_POSIX)
+#include <stdlib.h>
+#elif defined(VTKM_MEMALIGN_WIN)
+#include <malloc.h>
+#elif defined(VTKM_MEMALIGN_SSE)
+#include <xmmintrin.h>
+#else
+#include <malloc.h>
+#endif
+
+#include <cstddef>
+#include <cstdlib>
+
+namespace
+{
+
+// Every block is prefixed with a header that records the usable capacity. The header takes
+// a full alignment unit so that the memory handed out keeps VTK-m's preferred alignment.
+constexpr std::size_t HeaderSize = VTKM_ALLOCATION_ALIGNMENT;
+
+struct BlockHeader
+{
+  vtkm::BufferSizeType Capacity;
+};
+
+VTKM_STATIC_ASSERT(sizeof(BlockHeader) <= HeaderSize);
+
+// The smallest size class. Allocations smaller than this are rounded up.
+constexpr vtkm::BufferSizeType MinimumBlockSize = VTKM_ALLOCATION_ALIGNMENT;
+
+// Size classes are spaced at quarter powers of 2, so there are 4 classes per power of 2 plus
+// one for the power of 2 itself.
+constexpr vtkm::IdComponent ClassesPerPowerOf2 = 4;
+constexpr std::size_t NumberOfSizeClasses = 64 * ClassesPerPowerOf2;
+
+constexpr vtkm::BufferSizeType DefaultMaximumCachedBytes = vtkm::BufferSizeType{ 512 } << 20;
+
+/// Allocates a buffer of a specified size using VTK-m's preferred memory alignment.
+/// Returns a void* pointer that should be deleted with `AlignedFree`.
+void* AlignedAllocate(std::size_t size)
+{
+  constexpr std::size_t align = VTKM_ALLOCATION_ALIGNMENT;
+
+#if defined(VTKM_MEMALIGN_POSIX)
+  void* memory = nullptr;
+  if (posix_memalign(&memory, align, size) != 0)
+  {
+    memory = nullptr;
+  }
+#elif defined(VTKM_MEMALIGN_WIN)
+  void* memory = _aligned_malloc(size, align);
+#elif defined(VTKM_MEMALIGN_SSE)
+  void* memory = _mm_malloc(size, align);
+#else
+  (void)align;
+  void* memory = malloc(size);
+#endif
+
+  return memory;
+}
+
+void AlignedFree(void* memory)
+{
+#if defined(VTKM_MEMALIGN_POSIX)
+  free(memory);
+#elif defined(VTKM_MEMALIGN_WIN)
+  _aligned_free(memory);
+#elif defined(VTKM_MEMALIGN_SSE)
+  _mm_free(memory);
+#else
+  free(memory);
+#endif
+}
+
+BlockHeader* GetHeader(void* memory)
+{
+  return reinterpret_cast<BlockHeader*>(reinterpret_cast<char*>(memory) - HeaderSize);
+}
+
+const BlockHeader* GetHeader(const void* memory)
+{
+  return reinterpret_cast<const BlockHeader*>(reinterpret_cast<const char*>(memory) - HeaderSize);
+}
+
+void* AllocateBlock(vtkm::BufferSizeType capacity)
+{
+  void* base = AlignedAllocate(static_cast<std::size_t>(capacity) + HeaderSize);
+  if (base == nullptr)
+  {
+    return nullptr;
+  }
+  reinterpret_cast<BlockHeader*>(base)->Capacity = capacity;
+  return reinterpret_cast<char*>(base) + HeaderSize;
+}
+
+void FreeBlock(void* memory)
+{
+  AlignedFree(GetHeader(memory));
+}
+
+vtkm::IdComponent FloorLog2(vtkm::BufferSizeType value)
+{
+  VTKM_ASSERT(value > 0);
+  vtkm::IdComponent log = 0;
+  while ((value >> 1) > 0)
+  {
+    value >>= 1;
+    ++log;
+  }
+  return log;
+}
+
+// Returns the index of the free list for a block with the given capacity, or -1 if the
+// capacity is not one of the size classes (which happens for blocks allocated while the
+// pool was disabled).
+vtkm::Id SizeClassIndex(vtkm::BufferSizeType capacity)
+{
+  if ((capacity < MinimumBlockSize) ||
+      (vtkm::cont::internal::HostMemoryPool::RoundUpToSizeClass(capacity) != capacity))
+  {
+    return -1;
+  }
+  vtkm::IdComponent log2 = FloorLog2(capacity);
+  vtkm::BufferSizeType powerOf2 = vtkm::BufferSizeType{ 1 } << log2;
+  vtkm::BufferSizeType step = powerOf2 / ClassesPerPowerOf2;
+  return (log2 * ClassesPerPowerOf2) + static_cast<vtkm::Id>((capacity - powerOf2) / step);
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+namespace detail
+{
+
+struct HostMemoryPoolInternals
+{
+  mutable std::mutex Mutex;
+
+  bool Enabled = true;
+  vtkm::BufferSizeType MaximumCachedBytes = DefaultMaximumCachedBytes;
+  std::array<std::vector<void*>, NumberOfSizeClasses> FreeLists;
+
+  HostMemoryPoolStatistics Statistics;
+
+  // Must be called with the mutex locked.
+  void ReleaseCachedMemory()
+  {
+    for (auto&& freeList : this->FreeLists)
+    {
+      for (void* memory : freeList)
+      {
+        FreeBlock(memory);
+      }
+      freeList.clear();
+      freeList.shrink_to_fit();
+    }
+    this->Statistics.BytesHeld = 0;
+    this->Statistics.BlocksHeld = 0;
+  }
+
+  // Frees cached blocks, starting with the largest size class, until no more than
+  // `maximumBytes` are held. Must be called with the mutex locked.
+  void ReleaseCachedMemoryAbove(vtkm::BufferSizeType maximumBytes)
+  {
+    for (auto freeList = this->FreeLists.rbegin();
+         (freeList != this->FreeLists.rend()) && (this->Statistics.BytesHeld > maximumBytes);
+         ++freeList)
+    {
+      while (!freeList->empty() && (this->Statistics.BytesHeld > maximumBytes))
+      {
+        void* memory = freeList->back();
+        freeList->pop_back();
+        this->Statistics.BytesHeld -= GetHeader(memory)->Capacity;
+        --this->Statistics.BlocksHeld;
+        FreeBlock(memory);
+      }
+    }
+  }
+};
+
+} // namespace detail
+
+HostMemoryPool::HostMemoryPool()
+  : Internals(new detail::HostMemoryPoolInternals)
+{
+}
+
+HostMemoryPool::~HostMemoryPool()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->ReleaseCachedMemory();
+}
+
+vtkm::BufferSizeType HostMemoryPool::RoundUpToSizeClass(vtkm::BufferSizeType numBytes)
+{
+  if (numBytes <= MinimumBlockSize)
+  {
+    return MinimumBlockSize;
+  }
+  vtkm::BufferSizeType powerOf2 = vtkm::BufferSizeType{ 1 } << FloorLog2(numBytes);
+  if (powerOf2 == numBytes)
+  {
+    return numBytes;
+  }
+  vtkm::BufferSizeType step = powerOf2 / ClassesPerPowerOf2;
+  return ((numBytes + step - 1) / step) * step;
+}
+
+vtkm::BufferSizeType HostMemoryPool::GetCapacity(const void* memory)
+{
+  return (memory != nullptr) ? GetHeader(memory)->Capacity : 0;
+}
+
+void* HostMemoryPool::Allocate(vtkm::BufferSizeType numBytes)
+{
+  VTKM_ASSERT(numBytes >= 0);
+  if (numBytes <= 0)
+  {
+    return nullptr;
+  }
+
+  vtkm::BufferSizeType capacity = numBytes;
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    if (this->Internals->Enabled)
+    {
+      capacity = RoundUpToSizeClass(numBytes);
+      auto& freeList =
+        this->Internals->FreeLists[static_cast<std::size_t>(SizeClassIndex(capacity))];
+      if (!freeList.empty())
+      {
+        void* memory = freeList.back();
+        freeList.pop_back();
+        ++this->Internals->Statistics.Hits;
+        this->Internals->Statistics.BytesHeld -= capacity;
+        --this->Internals->Statistics.BlocksHeld;
+        this->Internals->Statistics.BytesInUse += capacity;
+        return memory;
+      }
+      ++this->Internals->Statistics.Misses;
+    }
+  }
+
+  // Do the actual allocation outside of the lock.
+  void* memory = AllocateBlock(capacity);
+  if (memory == nullptr)
+  {
+    // The system may be out of memory because we are hanging on to blocks. Release them
+    // and try one more time.
+    VTKM_LOG_S(vtkm::cont::LogLevel::MemCont,
+               "Host allocation of " << vtkm::cont::GetHumanReadableSize(capacity)
+                                     << " failed. Releasing cached memory and retrying.");
+    this->ReleaseCachedMemory();
+    memory = AllocateBlock(capacity);
+    if (memory == nullptr)
+    {
+      return nullptr;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Statistics.BytesInUse += capacity;
+  return memory;
+}
+
+void HostMemoryPool::Free(void* memory)
+{
+  if (memory == nullptr)
+  {
+    return;
+  }
+
+  vtkm::BufferSizeType capacity = GetCapacity(memory);
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    this->Internals->Statistics.BytesInUse -= capacity;
+    vtkm::Id sizeClass = SizeClassIndex(capacity);
+    if (this->Internals->Enabled && (sizeClass >= 0) &&
+        ((this->Internals->Statistics.BytesHeld + capacity) <=
+         this->Internals->MaximumCachedBytes))
+    {
+      this->Internals->FreeLists[static_cast<std::size_t>(sizeClass)].push_back(memory);
+      this->Internals->Statistics.BytesHeld += capacity;
+      ++this->Internals->Statistics.BlocksHeld;
+      return;
+    }
+  }
+
+  FreeBlock(memory);
+}
+
+void HostMemoryPool::SetEnabled(bool enabled)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Enabled = enabled;
+  if (!enabled)
+  {
+    this->Internals->ReleaseCachedMemory();
+  }
+}
+
+bool HostMemoryPool::GetEnabled() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->Enabled;
+}
+
+void HostMemoryPool::SetMaximumCachedBytes(vtkm::BufferSizeType numBytes)
+{
+  VTKM_ASSERT(numBytes >= 0);
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->MaximumCachedBytes = numBytes;
+  this->Internals->ReleaseCachedMemoryAbove(numBytes);
+}
+
+vtkm::BufferSizeType HostMemoryPool::GetMaximumCachedBytes() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->MaximumCachedBytes;
+}
+
+void HostMemoryPool::ReleaseCachedMemory()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->ReleaseCachedMemory();
+}
+
+HostMemoryPoolStatistics HostMemoryPool::GetStatistics() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->Statistics;
+}
+
+void HostMemoryPool::ResetStatistics()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Statistics.Hits = 0;
+  this->Internals->Statistics.Misses = 0;
+}
+
+vtkm::cont::internal::HostMemoryPool& GetHostMemoryPool()
+{
+  // The pool is intentionally never destroyed. Buffers held in static objects may be
+  // released after any static pool would be destructed.
+  static vtkm::cont::internal::HostMemoryPool* pool = new vtkm::cont::internal::HostMemoryPool;
+  return *pool;
+}
+
+}
+}
+} // namespace vtkm::cont::internal
@@ -0,0 +1,133 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_internal_HostMemoryPool_h
+#define vtk_m_cont_internal_HostMemoryPool_h
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <vtkm/cont/internal/DeviceAdapterMemoryManager.h>
+
+#include <vtkm/Types.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+/// Statistics collected by a `HostMemoryPool`.
+///
+struct HostMemoryPoolStatistics
+{
+  /// Number of allocations satisfied from a cached block.
+  vtkm::UInt64 Hits = 0;
+  /// Number of allocations that required a fresh allocation from the system.
+  vtkm::UInt64 Misses = 0;
+  /// Number of bytes currently held in the cache (allocated but not in use).
+  vtkm::BufferSizeType BytesHeld = 0;
+  /// Number of blocks currently held in the cache.
+  vtkm::Id BlocksHeld = 0;
+  /// Number of bytes handed out by the pool and not yet returned.
+  vtkm::BufferSizeType BytesInUse = 0;
+};
+
+namespace detail
+{
+struct HostMemoryPoolInternals;
+}
+
+/// \brief A caching allocator for host memory.
+///
+/// Array allocations on the host (including those for the Serial, TBB, and OpenMP devices) are
+/// served by `AllocateOnHost`, which by default goes through a global `HostMemoryPool`. Rather
+/// than returning memory to the system when a buffer is freed, the pool keeps the block in a
+/// free list for its size class so that a later allocation of a similar size can reuse it.
+/// This avoids the repeated allocation and page faulting of temporary arrays in filter
+/// pipelines that run the same operations over and over.
+///
+/// Requested sizes are rounded up to a size class. Size classes are spaced at quarter powers
+/// of two so that no more than 25% of a block is wasted. The pool never holds more than
+/// `GetMaximumCachedBytes` of free memory. Blocks returned when the cache is full are freed.
+///
+/// The pool can be enabled or disabled at run time either directly or through the
+/// `--vtkm-host-memory-pool` and `--vtkm-host-memory-pool-max-mb` options (or the
+/// `VTKM_HOST_MEMORY_POOL` and `VTKM_HOST_MEMORY_POOL_MAX_MB` environment variables).
+/// Disabling the pool releases all cached memory. Memory allocated while the pool is enabled
+/// is still properly returned if the pool is later disabled.
+///
+/// All methods are thread safe.
+///
+class VTKM_CONT_EXPORT HostMemoryPool
+{
+public:
+  VTKM_CONT HostMemoryPool();
+  VTKM_CONT ~HostMemoryPool();
+
+  HostMemoryPool(const HostMemoryPool&) = delete;
+  void operator=(const HostMemoryPool&) = delete;
+
+  /// Allocates a block of at least `numBytes` bytes aligned to `VTKM_ALLOCATION_ALIGNMENT`.
+  /// The returned pointer must be returned with `Free`. Returns `nullptr` if `numBytes` is
+  /// 0 or the system is out of memory.
+  ///
+  VTKM_CONT void* Allocate(vtkm::BufferSizeType numBytes);
+
+  /// Returns a block previously allocated with `Allocate` to the pool.
+  ///
+  VTKM_CONT void Free(void* memory);
+
+  /// Returns the number of bytes usable in a block returned from `Allocate`. This is at least
+  /// the size requested.
+  ///
+  VTKM_CONT static vtkm::BufferSizeType GetCapacity(const void* memory);
+
+  /// Returns the size of the allocation that `Allocate` would make for the given request.
+  ///
+  VTKM_CONT static vtkm::BufferSizeType RoundUpToSizeClass(vtkm::BufferSizeType numBytes);
+
+  /// When disabled, `AllocateOnHost` bypasses the pool and allocates directly from the system.
+  /// Disabling the pool releases any cached memory.
+  ///
+  VTKM_CONT void SetEnabled(bool enabled);
+  VTKM_CONT bool GetEnabled() const;
+
+  /// Sets the high-water mark for the amount of free memory the pool will cache. If the pool
+  /// holds more than that, cached blocks are freed, largest first, until it fits.
+  ///
+  VTKM_CONT void SetMaximumCachedBytes(vtkm::BufferSizeType numBytes);
+  VTKM_CONT vtkm::BufferSizeType GetMaximumCachedBytes() const;
+
+  /// Returns all cached (unused) blocks to the system.
+  ///
+  VTKM_CONT void ReleaseCachedMemory();
+
+  VTKM_CONT HostMemoryPoolStatistics GetStatistics() const;
+
+  /// Resets the hit and miss counters. The held/in use counters are not affected.
+  ///
+  VTKM_CONT void ResetStatistics();
+
+private:
+  std::unique_ptr<detail::HostMemoryPoolInternals> Internals;
+};
+
+/// Returns the global pool used by `AllocateOnHost`.
+///
+VTKM_CONT_EXPORT VTKM_CONT vtkm::cont::internal::HostMemoryPool& GetHostMemoryPool();
+
+}
+}
+} // namespace vtkm::cont::internal
+
+#endif //vtk_m_cont_internal_HostMemoryPool_h
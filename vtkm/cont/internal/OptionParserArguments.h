@@ -32,6 +32,7 @@ enum OptionIndex
   HELP,
   DEVICE,
   LOGLEVEL, // not parsed by this parser, but by loguru
+  TRACE_FILE,
 
   // TODO: remove deprecated arguments on next vtk-m release
   DEPRECATED_DEVICE,
@@ -40,7 +41,9 @@ enum OptionIndex
   // All RuntimeDeviceConfiguration specific options
   NUM_THREADS,
   NUMA_REGIONS,
-  DEVICE_INSTANCE
+  DEVICE_INSTANCE,
+  HOST_MEMORY_POOL,
+  HOST_MEMORY_POOL_MAX_MB
 };
 
 struct VtkmArg : public option::Arg
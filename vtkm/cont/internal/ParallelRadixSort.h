@@ -91,6 +91,7 @@
 #include <functional>
 #include <stdint.h>
 #include <utility>
+#include <vector>
 
 #include <vtkm/Types.h>
 #include <vtkm/cont/Logging.h>
@@ -204,6 +205,11 @@ private:
   // Compute |pos_bgn_| and |pos_end_| (associated ranges for each threads)
   void ComputeRanges();
 
+  // Find the bits that differ between any of the encoded keys in |src|.
+  // Digits with no varying bits are the same for every key, so the passes
+  // over them can be skipped.
+  UnsignedType ComputeVaryingBits(UnsignedType* src);
+
   // First step of each iteration of sorting
   // Compute the histogram of |src| using bits in [b, b + Base)
   void ComputeHistogram(unsigned int b, UnsignedType* src);
@@ -422,11 +428,21 @@ UnsignedType* ParallelRadixSortInternal<PlainType,
   // Compute |pos_bgn_| and |pos_end_|
   ComputeRanges();
 
+  // Keys in a narrow range (such as 64-bit ids that only use their low bits)
+  // share their high digits. Scattering by a digit that is the same for every
+  // key does not move anything, so skip those passes.
+  const UnsignedType varying_bits = ComputeVaryingBits(data);
+
   // Iterate from lower bits to higher bits
   const size_t bits = CHAR_BIT * sizeof(UnsignedType);
   UnsignedType *src = data, *dst = tmp_;
   for (unsigned int b = 0; b < bits; b += Base)
   {
+    if (((varying_bits >> b) & ((1 << Base) - 1)) == 0)
+    {
+      continue;
+    }
+
     ComputeHistogram(b, src);
     Scatter(b, src, dst);
 
@@ -522,6 +538,63 @@ struct RunTask
   ThreaderType threader_;
 };
 
+template <typename PlainType,
+          typename CompareType,
+          typename UnsignedType,
+          typename Encoder,
+          typename ValueManager,
+          typename ThreaderType,
+          unsigned int Base>
+UnsignedType ParallelRadixSortInternal<PlainType,
+                                       CompareType,
+                                       UnsignedType,
+                                       Encoder,
+                                       ValueManager,
+                                       ThreaderType,
+                                       Base>::ComputeVaryingBits(UnsignedType* src)
+{
+  if (num_elems_ == 0)
+  {
+    return 0;
+  }
+
+  // A bit varies if it is set in some key (bitwise or) and clear in another (bitwise and).
+  std::vector<UnsignedType> set_bits(num_threads_, UnsignedType(0));
+  std::vector<UnsignedType> common_bits(num_threads_, static_cast<UnsignedType>(~UnsignedType(0)));
+  UnsignedType* my_set_bits = set_bits.data();
+  UnsignedType* my_common_bits = common_bits.data();
+
+  auto lambda = [=](const size_t my_id) {
+    const size_t my_bgn = pos_bgn_[my_id];
+    const size_t my_end = pos_end_[my_id];
+    UnsignedType set = 0;
+    UnsignedType common = static_cast<UnsignedType>(~UnsignedType(0));
+    for (size_t i = my_bgn; i < my_end; ++i)
+    {
+      const UnsignedType s = Encoder::encode(src[i]);
+      set |= s;
+      common &= s;
+    }
+    my_set_bits[my_id] = set;
+    my_common_bits[my_id] = common;
+  };
+
+  using RunTaskType =
+    RunTask<PlainType, UnsignedType, Encoder, Base, std::function<void(size_t)>, ThreaderType>;
+
+  RunTaskType root(0, 1, lambda, num_elems_, num_threads_, threader_);
+  this->threader_.RunParentTask(root);
+
+  UnsignedType set = 0;
+  UnsignedType common = static_cast<UnsignedType>(~UnsignedType(0));
+  for (size_t i = 0; i < num_threads_; ++i)
+  {
+    set |= set_bits[i];
+    common &= common_bits[i];
+  }
+  return set ^ common;
+}
+
 template <typename PlainType,
           typename CompareType,
           typename UnsignedType,
@@ -8,6 +8,7 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 #include <vtkm/cont/Logging.h>
+#include <vtkm/cont/internal/HostMemoryPool.h>
 #include <vtkm/cont/internal/RuntimeDeviceConfiguration.h>
 
 namespace vtkm
@@ -100,6 +101,16 @@ void RuntimeDeviceConfigurationBase::Initialize(
     [&](const vtkm::Id& value) { return this->SetDeviceInstance(value); },
     "SetDeviceInstance",
     this->GetDevice().GetName());
+  InitializeOption(
+    configOptions.VTKmHostMemoryPool,
+    [&](const vtkm::Id& value) { return this->SetHostMemoryPool(value); },
+    "SetHostMemoryPool",
+    this->GetDevice().GetName());
+  InitializeOption(
+    configOptions.VTKmHostMemoryPoolMaxMB,
+    [&](const vtkm::Id& value) { return this->SetHostMemoryPoolMaxMB(value); },
+    "SetHostMemoryPoolMaxMB",
+    this->GetDevice().GetName());
   this->InitializeSubsystem();
 }
 
@@ -127,6 +138,17 @@ RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetDeviceInstance(
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
 }
 
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetHostMemoryPool(const vtkm::Id&)
+{
+  return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
+}
+
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetHostMemoryPoolMaxMB(
+  const vtkm::Id&)
+{
+  return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
+}
+
 RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetThreads(vtkm::Id&) const
 {
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
@@ -142,6 +164,17 @@ RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetDeviceInstance(
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
 }
 
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetHostMemoryPool(vtkm::Id&) const
+{
+  return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
+}
+
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetHostMemoryPoolMaxMB(
+  vtkm::Id&) const
+{
+  return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
+}
+
 RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetMaxThreads(vtkm::Id&) const
 {
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
@@ -155,6 +188,44 @@ RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetMaxDevices(vtkm
 void RuntimeDeviceConfigurationBase::ParseExtraArguments(int&, char*[]) {}
 void RuntimeDeviceConfigurationBase::InitializeSubsystem() {}
 
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetSharedHostMemoryPool(
+  const vtkm::Id& value)
+{
+  if ((value != 0) && (value != 1))
+  {
+    return RuntimeDeviceConfigReturnCode::INVALID_VALUE;
+  }
+  vtkm::cont::internal::GetHostMemoryPool().SetEnabled(value != 0);
+  return RuntimeDeviceConfigReturnCode::SUCCESS;
+}
+
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetSharedHostMemoryPoolMaxMB(
+  const vtkm::Id& value)
+{
+  if (value < 0)
+  {
+    return RuntimeDeviceConfigReturnCode::OUT_OF_BOUNDS;
+  }
+  vtkm::cont::internal::GetHostMemoryPool().SetMaximumCachedBytes(
+    static_cast<vtkm::BufferSizeType>(value) << 20);
+  return RuntimeDeviceConfigReturnCode::SUCCESS;
+}
+
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetSharedHostMemoryPool(
+  vtkm::Id& value)
+{
+  value = vtkm::cont::internal::GetHostMemoryPool().GetEnabled() ? 1 : 0;
+  return RuntimeDeviceConfigReturnCode::SUCCESS;
+}
+
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetSharedHostMemoryPoolMaxMB(
+  vtkm::Id& value)
+{
+  value = static_cast<vtkm::Id>(vtkm::cont::internal::GetHostMemoryPool().GetMaximumCachedBytes() >>
+                                20);
+  return RuntimeDeviceConfigReturnCode::SUCCESS;
+}
+
 
 } // namespace vtkm::cont::internal
 } // namespace vtkm::cont
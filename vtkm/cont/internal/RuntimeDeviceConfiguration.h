@@ -56,12 +56,16 @@ public:
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetThreads(const vtkm::Id& value);
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetNumaRegions(const vtkm::Id& value);
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetDeviceInstance(const vtkm::Id& value);
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetHostMemoryPool(const vtkm::Id& value);
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetHostMemoryPoolMaxMB(const vtkm::Id& value);
 
   /// The following public methods are overriden in each individual device and store the
   /// values that were set via the above Set* methods for the given device.
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetThreads(vtkm::Id& value) const;
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetNumaRegions(vtkm::Id& value) const;
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetDeviceInstance(vtkm::Id& value) const;
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetHostMemoryPool(vtkm::Id& value) const;
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetHostMemoryPoolMaxMB(vtkm::Id& value) const;
 
   /// The following public methods should be overriden as needed for each individual device
   /// as they describe various device parameters.
@@ -81,6 +85,15 @@ protected:
   /// Set* methods at the end of Initialize. Particuarly useful when initializing
   /// additional subystems (like Kokkos).
   VTKM_CONT virtual void InitializeSubsystem();
+
+  /// Implementations of the host memory pool `Set*`/`Get*` methods for devices that allocate
+  /// their arrays with `vtkm::cont::internal::AllocateOnHost` (and therefore share the global
+  /// `HostMemoryPool`). Such devices can simply forward their overrides to these.
+  VTKM_CONT static RuntimeDeviceConfigReturnCode SetSharedHostMemoryPool(const vtkm::Id& value);
+  VTKM_CONT static RuntimeDeviceConfigReturnCode SetSharedHostMemoryPoolMaxMB(
+    const vtkm::Id& value);
+  VTKM_CONT static RuntimeDeviceConfigReturnCode GetSharedHostMemoryPool(vtkm::Id& value);
+  VTKM_CONT static RuntimeDeviceConfigReturnCode GetSharedHostMemoryPoolMaxMB(vtkm::Id& value);
 };
 
 template <typename DeviceAdapterTag>
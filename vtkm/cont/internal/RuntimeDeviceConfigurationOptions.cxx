@@ -46,6 +46,22 @@ void AppendOptionDescriptors(std::vector<option::Descriptor>& usage,
       option::VtkmArg::Required,
       "  --vtkm-device-instance <dev> \tSets the device instance to use when using "
       "kokkos/cuda" });
+  usage.push_back(
+    { useOptionIndex ? static_cast<uint32_t>(option::OptionIndex::HOST_MEMORY_POOL) : 3,
+      0,
+      "",
+      "vtkm-host-memory-pool",
+      option::VtkmArg::Required,
+      "  --vtkm-host-memory-pool <0|1> \tEnables (1) or disables (0) caching of host "
+      "allocations for the serial/TBB/OpenMP devices" });
+  usage.push_back(
+    { useOptionIndex ? static_cast<uint32_t>(option::OptionIndex::HOST_MEMORY_POOL_MAX_MB) : 4,
+      0,
+      "",
+      "vtkm-host-memory-pool-max-mb",
+      option::VtkmArg::Required,
+      "  --vtkm-host-memory-pool-max-mb <MB> \tSets the maximum amount of unused memory the "
+      "host memory pool caches" });
 }
 } // anonymous namespace
 
@@ -54,6 +70,10 @@ RuntimeDeviceConfigurationOptions::RuntimeDeviceConfigurationOptions(const bool&
   , VTKmNumaRegions(useOptionIndex ? option::OptionIndex::NUMA_REGIONS : 1, "VTKM_NUMA_REGIONS")
   , VTKmDeviceInstance(useOptionIndex ? option::OptionIndex::DEVICE_INSTANCE : 2,
                        "VTKM_DEVICE_INSTANCE")
+  , VTKmHostMemoryPool(useOptionIndex ? option::OptionIndex::HOST_MEMORY_POOL : 3,
+                       "VTKM_HOST_MEMORY_POOL")
+  , VTKmHostMemoryPoolMaxMB(useOptionIndex ? option::OptionIndex::HOST_MEMORY_POOL_MAX_MB : 4,
+                            "VTKM_HOST_MEMORY_POOL_MAX_MB")
   , Initialized(false)
 {
 }
@@ -102,6 +122,8 @@ void RuntimeDeviceConfigurationOptions::Initialize(const option::Option* options
   this->VTKmNumThreads.Initialize(options);
   this->VTKmNumaRegions.Initialize(options);
   this->VTKmDeviceInstance.Initialize(options);
+  this->VTKmHostMemoryPool.Initialize(options);
+  this->VTKmHostMemoryPoolMaxMB.Initialize(options);
   this->Initialized = true;
 }
 
@@ -50,6 +50,8 @@ public:
   RuntimeDeviceOption VTKmNumThreads;
   RuntimeDeviceOption VTKmNumaRegions;
   RuntimeDeviceOption VTKmDeviceInstance;
+  RuntimeDeviceOption VTKmHostMemoryPool;
+  RuntimeDeviceOption VTKmHostMemoryPoolMaxMB;
 
 protected:
   /// Sets the option indices and environment varaible names for the vtkm supported options.
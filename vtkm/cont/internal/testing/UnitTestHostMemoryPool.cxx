@@ -0,0 +1,256 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/internal/DeviceAdapterMemoryManager.h>
+#include <vtkm/cont/internal/HostMemoryPool.h>
+#include <vtkm/cont/internal/RuntimeDeviceConfigurationOptions.h>
+
+#include <vtkm/cont/RuntimeDeviceInformation.h>
+#include <vtkm/cont/serial/DeviceAdapterSerial.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <cstdint>
+
+namespace
+{
+
+using PoolType = vtkm::cont::internal::HostMemoryPool;
+
+void TestSizeClasses()
+{
+  std::cout << "Test size classes" << std::endl;
+
+  VTKM_TEST_ASSERT(PoolType::RoundUpToSizeClass(1) == VTKM_ALLOCATION_ALIGNMENT);
+  VTKM_TEST_ASSERT(PoolType::RoundUpToSizeClass(1024) == 1024);
+  VTKM_TEST_ASSERT(PoolType::RoundUpToSizeClass(1025) == 1280);
+  VTKM_TEST_ASSERT(PoolType::RoundUpToSizeClass(1280) == 1280);
+  VTKM_TEST_ASSERT(PoolType::RoundUpToSizeClass(1800) == 2048);
+
+  for (vtkm::BufferSizeType size = 1; size < (1 << 20); size = (size * 3) / 2 + 1)
+  {
+    vtkm::BufferSizeType capacity = PoolType::RoundUpToSizeClass(size);
+    VTKM_TEST_ASSERT(capacity >= size);
+    VTKM_TEST_ASSERT((size < 256) || (capacity <= (size + size / 4)), "Size class too wasteful");
+    VTKM_TEST_ASSERT(PoolType::RoundUpToSizeClass(capacity) == capacity);
+  }
+}
+
+void TestReuse()
+{
+  std::cout << "Test reuse of blocks" << std::endl;
+  PoolType pool;
+
+  void* memory1 = pool.Allocate(1000);
+  VTKM_TEST_ASSERT(memory1 != nullptr);
+  VTKM_TEST_ASSERT(
+    (reinterpret_cast<std::uintptr_t>(memory1) % VTKM_ALLOCATION_ALIGNMENT) == 0,
+    "Pool memory not aligned.");
+  VTKM_TEST_ASSERT(PoolType::GetCapacity(memory1) >= 1000);
+
+  auto stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.Hits == 0);
+  VTKM_TEST_ASSERT(stats.Misses == 1);
+  VTKM_TEST_ASSERT(stats.BytesHeld == 0);
+  VTKM_TEST_ASSERT(stats.BytesInUse == PoolType::GetCapacity(memory1));
+
+  pool.Free(memory1);
+  stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.BytesHeld == PoolType::GetCapacity(memory1));
+  VTKM_TEST_ASSERT(stats.BlocksHeld == 1);
+  VTKM_TEST_ASSERT(stats.BytesInUse == 0);
+
+  // Same size class should get the same block back.
+  void* memory2 = pool.Allocate(990);
+  VTKM_TEST_ASSERT(memory2 == memory1, "Did not reuse block.");
+  stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.Hits == 1);
+  VTKM_TEST_ASSERT(stats.Misses == 1);
+  VTKM_TEST_ASSERT(stats.BytesHeld == 0);
+
+  // A different size class should not.
+  void* memory3 = pool.Allocate(5000);
+  VTKM_TEST_ASSERT(memory3 != memory2);
+  stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.Misses == 2);
+
+  pool.Free(memory2);
+  pool.Free(memory3);
+  stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.BlocksHeld == 2);
+
+  pool.ReleaseCachedMemory();
+  stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.BlocksHeld == 0);
+  VTKM_TEST_ASSERT(stats.BytesHeld == 0);
+
+  pool.ResetStatistics();
+  stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.Hits == 0);
+  VTKM_TEST_ASSERT(stats.Misses == 0);
+}
+
+void TestHighWaterMark()
+{
+  std::cout << "Test maximum cached bytes" << std::endl;
+  PoolType pool;
+  pool.SetMaximumCachedBytes(4096);
+  VTKM_TEST_ASSERT(pool.GetMaximumCachedBytes() == 4096);
+
+  void* memory1 = pool.Allocate(2048);
+  void* memory2 = pool.Allocate(2048);
+  void* memory3 = pool.Allocate(2048);
+  pool.Free(memory1);
+  pool.Free(memory2);
+  pool.Free(memory3);
+
+  auto stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.BytesHeld == 4096, "Pool cached more than allowed.");
+  VTKM_TEST_ASSERT(stats.BlocksHeld == 2);
+
+  // Lowering the maximum only frees what no longer fits, largest blocks first.
+  pool.SetMaximumCachedBytes(8192);
+  pool.Free(pool.Allocate(1024));
+  VTKM_TEST_ASSERT(pool.GetStatistics().BytesHeld == 5120);
+  pool.SetMaximumCachedBytes(3072);
+  stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.BytesHeld == 3072, "Pool released too much or too little.");
+  VTKM_TEST_ASSERT(stats.BlocksHeld == 2);
+
+  pool.SetMaximumCachedBytes(0);
+  stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.BytesHeld == 0);
+}
+
+void TestDisable()
+{
+  std::cout << "Test disabling the pool" << std::endl;
+  PoolType pool;
+
+  void* memory1 = pool.Allocate(1000);
+  pool.Free(memory1);
+  VTKM_TEST_ASSERT(pool.GetStatistics().BlocksHeld == 1);
+
+  void* memory2 = pool.Allocate(1000);
+
+  pool.SetEnabled(false);
+  VTKM_TEST_ASSERT(!pool.GetEnabled());
+  VTKM_TEST_ASSERT(pool.GetStatistics().BlocksHeld == 0, "Disabling should release cache.");
+
+  // Memory allocated while enabled can be returned while disabled.
+  pool.Free(memory2);
+  VTKM_TEST_ASSERT(pool.GetStatistics().BlocksHeld == 0);
+
+  pool.ResetStatistics();
+
+  void* memory3 = pool.Allocate(1000);
+  VTKM_TEST_ASSERT(PoolType::GetCapacity(memory3) == 1000, "Disabled pool should not round.");
+  auto stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.Hits == 0, "Disabled pool should not record hits.");
+  VTKM_TEST_ASSERT(stats.Misses == 0, "Disabled pool should not record misses.");
+
+  // Memory allocated while disabled can be returned while enabled.
+  pool.SetEnabled(true);
+  pool.Free(memory3);
+  VTKM_TEST_ASSERT(pool.GetStatistics().BytesInUse == 0);
+}
+
+void TestAllocateOnHost()
+{
+  std::cout << "Test AllocateOnHost through global pool" << std::endl;
+  PoolType& pool = vtkm::cont::internal::GetHostMemoryPool();
+  VTKM_TEST_ASSERT(pool.GetEnabled(), "Pool should be enabled by default.");
+  pool.ReleaseCachedMemory();
+  pool.ResetStatistics();
+
+  void* pointer;
+  {
+    vtkm::cont::internal::BufferInfo info = vtkm::cont::internal::AllocateOnHost(3000);
+    pointer = info.GetPointer();
+    VTKM_TEST_ASSERT(pointer != nullptr);
+
+    // Growing within the size class should not move the buffer.
+    info.Reallocate(3050);
+    VTKM_TEST_ASSERT(info.GetPointer() == pointer);
+    VTKM_TEST_ASSERT(info.GetSize() == 3050);
+  }
+  VTKM_TEST_ASSERT(pool.GetStatistics().BlocksHeld == 1);
+
+  {
+    vtkm::cont::internal::BufferInfo info = vtkm::cont::internal::AllocateOnHost(3000);
+    VTKM_TEST_ASSERT(info.GetPointer() == pointer, "AllocateOnHost did not reuse block.");
+    VTKM_TEST_ASSERT(pool.GetStatistics().Hits == 1);
+
+    // Growing past the size class should copy into a new block.
+    static_cast<char*>(info.GetPointer())[10] = 42;
+    info.Reallocate(100000);
+    VTKM_TEST_ASSERT(static_cast<char*>(info.GetPointer())[10] == 42);
+  }
+
+  // The serial device shares the pool.
+  vtkm::cont::internal::DeviceAdapterMemoryManager<vtkm::cont::DeviceAdapterTagSerial> manager;
+  {
+    vtkm::cont::internal::BufferInfo info = manager.Allocate(3000);
+    VTKM_TEST_ASSERT(info.GetPointer() == pointer, "Serial device did not reuse block.");
+  }
+
+  pool.ReleaseCachedMemory();
+}
+
+void TestRuntimeConfiguration()
+{
+  std::cout << "Test configuring pool through runtime device configuration" << std::endl;
+  PoolType& pool = vtkm::cont::internal::GetHostMemoryPool();
+  vtkm::BufferSizeType oldMax = pool.GetMaximumCachedBytes();
+
+  vtkm::cont::internal::RuntimeDeviceConfigurationOptions options;
+  options.VTKmHostMemoryPool.SetOption(0);
+  options.VTKmHostMemoryPoolMaxMB.SetOption(16);
+  options.Initialize(nullptr);
+
+  auto& config = vtkm::cont::RuntimeDeviceInformation{}.GetRuntimeConfiguration(
+    vtkm::cont::DeviceAdapterTagSerial{});
+  config.Initialize(options);
+  VTKM_TEST_ASSERT(!pool.GetEnabled(), "Pool not disabled by runtime configuration.");
+  VTKM_TEST_ASSERT(pool.GetMaximumCachedBytes() == (16 << 20));
+
+  vtkm::Id value;
+  VTKM_TEST_ASSERT(config.GetHostMemoryPool(value) ==
+                   vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS);
+  VTKM_TEST_ASSERT(value == 0);
+  VTKM_TEST_ASSERT(config.GetHostMemoryPoolMaxMB(value) ==
+                   vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS);
+  VTKM_TEST_ASSERT(value == 16);
+
+  VTKM_TEST_ASSERT(config.SetHostMemoryPool(2) ==
+                   vtkm::cont::internal::RuntimeDeviceConfigReturnCode::INVALID_VALUE);
+  VTKM_TEST_ASSERT(config.SetHostMemoryPool(1) ==
+                   vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS);
+  VTKM_TEST_ASSERT(pool.GetEnabled());
+
+  pool.SetMaximumCachedBytes(oldMax);
+}
+
+void Run()
+{
+  TestSizeClasses();
+  TestReuse();
+  TestHighWaterMark();
+  TestDisable();
+  TestAllocateOnHost();
+  TestRuntimeConfiguration();
+}
+
+} // anonymous namespace
+
+int UnitTestHostMemoryPool(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(Run, argc, argv);
+}
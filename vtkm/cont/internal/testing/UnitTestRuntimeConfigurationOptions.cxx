@@ -189,10 +189,17 @@ void TestConfigOptionValues(const internal::RuntimeDeviceConfigurationOptions& c
   VTKM_TEST_ASSERT(configOptions.VTKmNumThreads.IsSet(), "num threads should be set");
   VTKM_TEST_ASSERT(configOptions.VTKmNumaRegions.IsSet(), "numa regions should be set");
   VTKM_TEST_ASSERT(configOptions.VTKmDeviceInstance.IsSet(), "device instance should be set");
+  VTKM_TEST_ASSERT(configOptions.VTKmHostMemoryPool.IsSet(), "host memory pool should be set");
+  VTKM_TEST_ASSERT(configOptions.VTKmHostMemoryPoolMaxMB.IsSet(),
+                   "host memory pool max should be set");
 
   VTKM_TEST_ASSERT(configOptions.VTKmNumThreads.GetValue() == 100, "num threads should == 100");
   VTKM_TEST_ASSERT(configOptions.VTKmNumaRegions.GetValue() == 2, "numa regions should == 2");
   VTKM_TEST_ASSERT(configOptions.VTKmDeviceInstance.GetValue() == 1, "device instance should == 1");
+  VTKM_TEST_ASSERT(configOptions.VTKmHostMemoryPool.GetValue() == 0,
+                   "host memory pool should == 0");
+  VTKM_TEST_ASSERT(configOptions.VTKmHostMemoryPoolMaxMB.GetValue() == 64,
+                   "host memory pool max should == 64");
 }
 
 void TestRuntimeDeviceConfigurationOptions()
@@ -218,7 +225,11 @@ void TestRuntimeDeviceConfigurationOptions()
                                            "--vtkm-numa-regions",
                                            "2",
                                            "--vtkm-device-instance",
-                                           "1");
+                                           "1",
+                                           "--vtkm-host-memory-pool",
+                                           "0",
+                                           "--vtkm-host-memory-pool-max-mb",
+                                           "64");
     auto options = GetOptions(argc, argv, usage);
 
     VTKM_TEST_ASSERT(!configOptions.IsInitialized(),
@@ -237,7 +248,11 @@ void TestRuntimeDeviceConfigurationOptions()
                                            "--vtkm-numa-regions",
                                            "2",
                                            "--vtkm-device-instance",
-                                           "1");
+                                           "1",
+                                           "--vtkm-host-memory-pool",
+                                           "0",
+                                           "--vtkm-host-memory-pool-max-mb",
+                                           "64");
     internal::RuntimeDeviceConfigurationOptions configOptions(argc, argv);
     TestConfigOptionValues(configOptions);
   }
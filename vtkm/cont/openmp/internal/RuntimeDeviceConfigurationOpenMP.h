@@ -42,6 +42,30 @@ public:
     return vtkm::cont::DeviceAdapterTagOpenMP{};
   }
 
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetHostMemoryPool(
+    const vtkm::Id& value) override final
+  {
+    return this->SetSharedHostMemoryPool(value);
+  }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetHostMemoryPoolMaxMB(
+    const vtkm::Id& value) override final
+  {
+    return this->SetSharedHostMemoryPoolMaxMB(value);
+  }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetHostMemoryPool(
+    vtkm::Id& value) const override final
+  {
+    return this->GetSharedHostMemoryPool(value);
+  }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetHostMemoryPoolMaxMB(
+    vtkm::Id& value) const override final
+  {
+    return this->GetSharedHostMemoryPoolMaxMB(value);
+  }
+
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetThreads(const vtkm::Id& value) override final
   {
     if (omp_in_parallel())
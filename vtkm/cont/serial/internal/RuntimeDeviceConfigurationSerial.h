@@ -24,10 +24,35 @@ template <>
 class RuntimeDeviceConfiguration<vtkm::cont::DeviceAdapterTagSerial>
   : public vtkm::cont::internal::RuntimeDeviceConfigurationBase
 {
+public:
   VTKM_CONT vtkm::cont::DeviceAdapterId GetDevice() const override final
   {
     return vtkm::cont::DeviceAdapterTagSerial{};
   }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetHostMemoryPool(
+    const vtkm::Id& value) override final
+  {
+    return this->SetSharedHostMemoryPool(value);
+  }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetHostMemoryPoolMaxMB(
+    const vtkm::Id& value) override final
+  {
+    return this->SetSharedHostMemoryPoolMaxMB(value);
+  }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetHostMemoryPool(
+    vtkm::Id& value) const override final
+  {
+    return this->GetSharedHostMemoryPool(value);
+  }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetHostMemoryPoolMaxMB(
+    vtkm::Id& value) const override final
+  {
+    return this->GetSharedHostMemoryPoolMaxMB(value);
+  }
 };
 }
 }
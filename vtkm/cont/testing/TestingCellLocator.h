@@ -0,0 +1,94 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_testing_TestingCellLocator_h
+#define vtk_m_cont_testing_TestingCellLocator_h
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace vtkm
+{
+namespace cont
+{
+namespace testing
+{
+
+/// Finds the cells of points using the `LastCell` hint of a cell locator. Each point is first
+/// searched for with the hint left by some other point, which is probably in a different cell,
+/// and then again with its own hint. Both searches must find the same cell.
+class FindCellWithHintWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn points,
+                                WholeArrayIn allPoints,
+                                ExecObject locator,
+                                FieldOut cellIds,
+                                FieldOut pcoords);
+  using ExecutionSignature = void(InputIndex, _1, _2, _3, _4, _5);
+
+  template <typename PointsPortalType, typename LocatorType>
+  VTKM_EXEC void operator()(vtkm::Id index,
+                            const vtkm::Vec3f& point,
+                            const PointsPortalType& allPoints,
+                            const LocatorType& locator,
+                            vtkm::Id& cellId,
+                            vtkm::Vec3f& pcoords) const
+  {
+    // Start with the hint from some other point, which is probably in a different cell.
+    typename LocatorType::LastCell lastCell;
+    vtkm::Id otherCellId;
+    vtkm::Vec3f otherPCoords;
+    locator.FindCell(allPoints.Get((index + 1) % allPoints.GetNumberOfValues()),
+                     otherCellId,
+                     otherPCoords,
+                     lastCell);
+
+    vtkm::ErrorCode status = locator.FindCell(point, cellId, pcoords, lastCell);
+    if (status != vtkm::ErrorCode::Success)
+    {
+      this->RaiseError(vtkm::ErrorString(status));
+      return;
+    }
+
+    // Now the hint holds the cell of this point.
+    status = locator.FindCell(point, otherCellId, otherPCoords, lastCell);
+    if ((status != vtkm::ErrorCode::Success) || (otherCellId != cellId))
+    {
+      this->RaiseError("Found a different cell with the last cell hint.");
+    }
+  }
+};
+
+/// Checks the cell ids and parametric coordinates found by a cell locator against the
+/// expected ones.
+inline void CheckCellLocatorResults(const vtkm::cont::ArrayHandle<vtkm::Id>& cellIds,
+                                    const vtkm::cont::ArrayHandle<vtkm::Vec3f>& pcoords,
+                                    const vtkm::cont::ArrayHandle<vtkm::Id>& expCellIds,
+                                    const vtkm::cont::ArrayHandle<vtkm::Vec3f>& expPCoords)
+{
+  auto cellIdsPortal = cellIds.ReadPortal();
+  auto expCellIdsPortal = expCellIds.ReadPortal();
+  auto pcoordsPortal = pcoords.ReadPortal();
+  auto expPCoordsPortal = expPCoords.ReadPortal();
+  for (vtkm::Id i = 0; i < cellIds.GetNumberOfValues(); ++i)
+  {
+    VTKM_TEST_ASSERT(cellIdsPortal.Get(i) == expCellIdsPortal.Get(i), "Incorrect cell ids");
+    VTKM_TEST_ASSERT(test_equal(pcoordsPortal.Get(i), expPCoordsPortal.Get(i), 1e-3),
+                     "Incorrect parameteric coordinates");
+  }
+}
+
+}
+}
+} // namespace vtkm::cont::testing
+
+#endif //vtk_m_cont_testing_TestingCellLocator_h
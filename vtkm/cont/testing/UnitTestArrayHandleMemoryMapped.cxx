@@ -0,0 +1,192 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleMemoryMapped.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+
+constexpr vtkm::Id ARRAY_SIZE = 5000;
+constexpr vtkm::Id HEADER_SIZE = 16;
+
+using ValueType = vtkm::Vec3f_64;
+
+std::string WriteTestFile()
+{
+  std::string fileName = vtkm::cont::testing::Testing::WriteDirPath("MemoryMappedTest.raw");
+  std::ofstream file(fileName, std::ios::binary);
+
+  // Put some junk at the beginning of the file to make sure mapping at an offset not aligned
+  // to a page works. The values still need to be aligned for their type.
+  std::vector<char> header(HEADER_SIZE, 'x');
+  file.write(header.data(), HEADER_SIZE);
+
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; ++index)
+  {
+    ValueType value = TestValue(index, ValueType{});
+    file.write(reinterpret_cast<const char*>(&value), sizeof(ValueType));
+  }
+  return fileName;
+}
+
+void CheckFileContents(const std::string& fileName)
+{
+  auto array =
+    vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(fileName, ARRAY_SIZE, HEADER_SIZE);
+  VTKM_TEST_ASSERT(array.GetNumberOfValues() == ARRAY_SIZE);
+  CheckPortal(array.ReadPortal());
+}
+
+void TestReadOnly(const std::string& fileName)
+{
+  std::cout << "Test read only mapping" << std::endl;
+  CheckFileContents(fileName);
+
+  // Map the whole file as bytes.
+  auto bytes = vtkm::cont::make_ArrayHandleMemoryMapped<vtkm::UInt8>(fileName);
+  VTKM_TEST_ASSERT(bytes.GetNumberOfValues() ==
+                   HEADER_SIZE + ARRAY_SIZE * static_cast<vtkm::Id>(sizeof(ValueType)));
+  VTKM_TEST_ASSERT(bytes.ReadPortal().Get(0) == 'x');
+
+  // Map the rest of the file after the header.
+  auto rest = vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(fileName, -1, HEADER_SIZE);
+  VTKM_TEST_ASSERT(rest.GetNumberOfValues() == ARRAY_SIZE);
+
+  // Writing to the mapped pages is an error rather than a crash.
+  try
+  {
+    rest.WritePortal();
+    VTKM_TEST_FAIL("Did not throw for writing a read only mapping.");
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+  try
+  {
+    vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleConstant<ValueType>(ValueType(1), ARRAY_SIZE),
+                          rest);
+    VTKM_TEST_FAIL("Did not throw for copying into a read only mapping.");
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+  CheckFileContents(fileName);
+}
+
+void TestCopyOnWrite(const std::string& fileName)
+{
+  std::cout << "Test copy on write mapping" << std::endl;
+  auto array = vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(
+    fileName, ARRAY_SIZE, HEADER_SIZE, vtkm::cont::MemoryMapMode::CopyOnWrite);
+  CheckPortal(array.ReadPortal());
+
+  SetPortal(array.WritePortal());
+  array.WritePortal().Set(0, ValueType(-1));
+  VTKM_TEST_ASSERT(array.ReadPortal().Get(0) == ValueType(-1));
+
+  // The file should not have changed.
+  CheckFileContents(fileName);
+}
+
+void TestResize(const std::string& fileName)
+{
+  std::cout << "Test resizing a mapped array" << std::endl;
+  auto array = vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(
+    fileName, ARRAY_SIZE, HEADER_SIZE, vtkm::cont::MemoryMapMode::ReadOnly);
+
+  // Resizing copies the data to regular memory, so it is OK to write even though it was
+  // mapped read only.
+  array.Allocate(ARRAY_SIZE * 2, vtkm::CopyFlag::On);
+  VTKM_TEST_ASSERT(array.GetNumberOfValues() == ARRAY_SIZE * 2);
+  auto portal = array.WritePortal();
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; ++index)
+  {
+    VTKM_TEST_ASSERT(test_equal(portal.Get(index), TestValue(index, ValueType{})));
+  }
+  portal.Set(ARRAY_SIZE, ValueType(10));
+  VTKM_TEST_ASSERT(array.ReadPortal().Get(ARRAY_SIZE) == ValueType(10));
+
+  CheckFileContents(fileName);
+}
+
+void TestErrors(const std::string& fileName)
+{
+  std::cout << "Test mapping errors" << std::endl;
+
+  try
+  {
+    vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(fileName + ".does-not-exist");
+    VTKM_TEST_FAIL("Did not throw for missing file.");
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  try
+  {
+    vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(fileName, ARRAY_SIZE + 1, HEADER_SIZE);
+    VTKM_TEST_FAIL("Did not throw for file that is too small.");
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  try
+  {
+    vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(fileName, ARRAY_SIZE - 1, HEADER_SIZE + 4);
+    VTKM_TEST_FAIL("Did not throw for offset not aligned for the value type.");
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  try
+  {
+    // With the header, the file is not a multiple of the value size.
+    vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(fileName);
+    VTKM_TEST_FAIL("Did not throw for file that is not a multiple of the value size.");
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void Run()
+{
+  std::string fileName = WriteTestFile();
+
+  TestReadOnly(fileName);
+  TestCopyOnWrite(fileName);
+  TestResize(fileName);
+  TestErrors(fileName);
+
+  std::remove(fileName.c_str());
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleMemoryMapped(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(Run, argc, argv);
+}
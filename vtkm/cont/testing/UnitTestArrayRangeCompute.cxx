@@ -20,6 +20,7 @@
 #include <vtkm/cont/ArrayHandleStride.h>
 #include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
 #include <vtkm/cont/ArrayRangeCompute.h>
+#include <vtkm/cont/ArrayRangeComputeTemplate.h>
 
 #include <vtkm/Math.h>
 
@@ -205,6 +206,80 @@ void TestUniformPointCoords()
     vtkm::cont::ArrayHandleUniformPointCoordinates(vtkm::Id3(ARRAY_SIZE, ARRAY_SIZE, ARRAY_SIZE)));
 }
 
+void TestRangeCache()
+{
+  std::cout << "Checking cached ranges" << std::endl;
+  auto isCached = [](const vtkm::cont::ArrayHandle<vtkm::Float32>& array) {
+    return array.GetBuffers()[0].GetCachedData(
+             vtkm::cont::detail::ArrayRangeCacheKey<vtkm::Float32,
+                                                    vtkm::cont::StorageTagBasic>()) != nullptr;
+  };
+
+  // Arrays written in the execution environment or through a token keep their ranges.
+  vtkm::cont::ArrayHandleBasic<vtkm::Float32> array;
+  vtkm::cont::ArrayCopyDevice(vtkm::cont::ArrayHandleCounting<vtkm::Float32>(0, 1, ARRAY_SIZE),
+                              array);
+  VTKM_TEST_ASSERT(test_equal(vtkm::cont::ArrayRangeCompute(array).ReadPortal().Get(0),
+                              vtkm::Range(0, ARRAY_SIZE - 1)));
+  VTKM_TEST_ASSERT(isCached(array));
+  VTKM_TEST_ASSERT(test_equal(
+    vtkm::cont::ArrayRangeCompute(vtkm::cont::UnknownArrayHandle(array)).ReadPortal().Get(0),
+    vtkm::Range(0, ARRAY_SIZE - 1)));
+
+  {
+    vtkm::cont::Token token;
+    array.GetWritePointer(token)[1] = 1000.0f;
+  }
+  VTKM_TEST_ASSERT(!isCached(array));
+  VTKM_TEST_ASSERT(test_equal(vtkm::cont::ArrayRangeCompute(array).ReadPortal().Get(0),
+                              vtkm::Range(0, 1000)));
+  VTKM_TEST_ASSERT(isCached(array));
+
+  // So does resizing.
+  array.Allocate(2, vtkm::CopyFlag::On);
+  VTKM_TEST_ASSERT(test_equal(vtkm::cont::ArrayRangeCompute(array).ReadPortal().Get(0),
+                              vtkm::Range(0, 1000)));
+
+  // Writes through a portal held across range computations are picked up.
+  vtkm::cont::ArrayHandle<vtkm::Float32> heldArray;
+  heldArray.AllocateAndFill(ARRAY_SIZE, 0.0f);
+  auto writePortal = heldArray.WritePortal();
+  writePortal.Set(ARRAY_SIZE - 1, 10.0f);
+  VTKM_TEST_ASSERT(test_equal(vtkm::cont::ArrayRangeCompute(heldArray).ReadPortal().Get(0),
+                              vtkm::Range(0, 10)));
+  writePortal.Set(0, -1000.0f);
+  VTKM_TEST_ASSERT(test_equal(vtkm::cont::ArrayRangeCompute(heldArray).ReadPortal().Get(0),
+                              vtkm::Range(-1000, 10)));
+  VTKM_TEST_ASSERT(!isCached(heldArray));
+
+  // So are writes to memory that the array does not own.
+  std::vector<vtkm::Float32> userMemory(ARRAY_SIZE, 1.0f);
+  auto userArray = vtkm::cont::make_ArrayHandle(userMemory, vtkm::CopyFlag::Off);
+  VTKM_TEST_ASSERT(test_equal(vtkm::cont::ArrayRangeCompute(userArray).ReadPortal().Get(0),
+                              vtkm::Range(1, 1)));
+  userMemory[3] = 5.0f;
+  VTKM_TEST_ASSERT(test_equal(vtkm::cont::ArrayRangeCompute(userArray).ReadPortal().Get(0),
+                              vtkm::Range(1, 5)));
+  vtkm::cont::ArrayHandleBasic<vtkm::Float32> wrappedArray(
+    userMemory.data(), ARRAY_SIZE, [](void*) {});
+  VTKM_TEST_ASSERT(test_equal(vtkm::cont::ArrayRangeCompute(wrappedArray).ReadPortal().Get(0),
+                              vtkm::Range(1, 5)));
+  userMemory[4] = 7.0f;
+  VTKM_TEST_ASSERT(test_equal(vtkm::cont::ArrayRangeCompute(wrappedArray).ReadPortal().Get(0),
+                              vtkm::Range(1, 7)));
+  VTKM_TEST_ASSERT(!isCached(wrappedArray));
+
+  // The same buffer viewed as another type has its own range.
+  vtkm::cont::ArrayHandle<vtkm::Int32> intArray;
+  intArray.AllocateAndFill(ARRAY_SIZE, -1);
+  VTKM_TEST_ASSERT(test_equal(vtkm::cont::ArrayRangeCompute(intArray).ReadPortal().Get(0),
+                              vtkm::Range(-1, -1)));
+  vtkm::cont::ArrayHandle<vtkm::UInt32> uintArray(intArray.GetBuffers());
+  vtkm::Float64 uintMax = static_cast<vtkm::Float64>(std::numeric_limits<vtkm::UInt32>::max());
+  VTKM_TEST_ASSERT(test_equal(vtkm::cont::ArrayRangeCompute(uintArray).ReadPortal().Get(0),
+                              vtkm::Range(uintMax, uintMax)));
+}
+
 struct DoTestFunctor
 {
   template <typename T>
@@ -226,6 +301,7 @@ void DoTest()
   std::cout << "*** Specific arrays *****************" << std::endl;
   TestIndex();
   TestUniformPointCoords();
+  TestRangeCache();
 }
 
 } // anonymous namespace
@@ -13,6 +13,7 @@
 #include <vtkm/cont/DataSetBuilderRectilinear.h>
 #include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/testing/Testing.h>
+#include <vtkm/cont/testing/TestingCellLocator.h>
 #include <vtkm/exec/CellInterpolate.h>
 #include <vtkm/worklet/DispatcherMapField.h>
 #include <vtkm/worklet/DispatcherMapTopology.h>
@@ -186,17 +187,11 @@ void TestWithDataSet(vtkm::cont::CellLocatorGeneral& locator, const vtkm::cont::
 
   vtkm::worklet::DispatcherMapField<FindCellWorklet> dispatcher;
   dispatcher.Invoke(points, locator, cellIds, pcoords);
+  vtkm::cont::testing::CheckCellLocatorResults(cellIds, pcoords, expCellIds, expPCoords);
 
-  auto cellIdPortal = cellIds.ReadPortal();
-  auto expCellIdsPortal = expCellIds.ReadPortal();
-  auto pcoordsPortal = pcoords.ReadPortal();
-  auto expPCoordsPortal = expPCoords.ReadPortal();
-  for (vtkm::Id i = 0; i < 64; ++i)
-  {
-    VTKM_TEST_ASSERT(cellIdPortal.Get(i) == expCellIdsPortal.Get(i), "Incorrect cell ids");
-    VTKM_TEST_ASSERT(test_equal(pcoordsPortal.Get(i), expPCoordsPortal.Get(i), 1e-3),
-                     "Incorrect parameteric coordinates");
-  }
+  vtkm::worklet::DispatcherMapField<vtkm::cont::testing::FindCellWithHintWorklet> hintDispatcher;
+  hintDispatcher.Invoke(points, points, locator, cellIds, pcoords);
+  vtkm::cont::testing::CheckCellLocatorResults(cellIds, pcoords, expCellIds, expPCoords);
 }
 
 void TestCellLocatorGeneral()
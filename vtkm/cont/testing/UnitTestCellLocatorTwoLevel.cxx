@@ -11,7 +11,9 @@
 #include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/CellLocatorTwoLevel.h>
 #include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/ErrorBadValue.h>
 #include <vtkm/cont/testing/Testing.h>
+#include <vtkm/cont/testing/TestingCellLocator.h>
 
 #include <vtkm/exec/ParametricCoordinates.h>
 
@@ -25,8 +27,12 @@
 
 #include <vtkm/CellShape.h>
 
+#include <cstdio>
 #include <ctime>
+#include <fstream>
+#include <iterator>
 #include <random>
+#include <string>
 
 namespace
 {
@@ -204,17 +210,114 @@ void TestCellLocator(const vtkm::Vec<vtkm::Id, DIMENSIONS>& dim, vtkm::Id number
 
   vtkm::worklet::DispatcherMapField<FindCellWorklet> dispatcher;
   dispatcher.Invoke(points, locator, cellIds, pcoords);
+  vtkm::cont::testing::CheckCellLocatorResults(cellIds, pcoords, expCellIds, expPCoords);
+
+  std::cout << "Finding cells with last cell hints\n";
+  vtkm::worklet::DispatcherMapField<vtkm::cont::testing::FindCellWithHintWorklet> hintDispatcher;
+  hintDispatcher.Invoke(points, points, locator, cellIds, pcoords);
+  vtkm::cont::testing::CheckCellLocatorResults(cellIds, pcoords, expCellIds, expPCoords);
+
+  std::cout << "Finding cells with a second locator for the same data set\n";
+  // Arrays written through portals are never shared, so use coordinates written by a copy.
+  vtkm::cont::ArrayHandleBasic<PointType> sharedCoords;
+  vtkm::cont::ArrayCopy(ds.GetCoordinateSystem().GetData(), sharedCoords);
+  vtkm::cont::DataSet sharedDs;
+  sharedDs.SetCellSet(ds.GetCellSet());
+  sharedDs.AddCoordinateSystem(vtkm::cont::CoordinateSystem("coords", sharedCoords));
+  ds = sharedDs;
+  vtkm::cont::CellLocatorTwoLevel firstLocator;
+  firstLocator.SetDensityL1(64.0f);
+  firstLocator.SetDensityL2(1.0f);
+  firstLocator.SetCellSet(ds.GetCellSet());
+  firstLocator.SetCoordinates(ds.GetCoordinateSystem());
+  firstLocator.Update();
+  vtkm::cont::CellLocatorTwoLevel cachedLocator;
+  cachedLocator.SetDensityL1(64.0f);
+  cachedLocator.SetDensityL2(1.0f);
+  cachedLocator.SetCellSet(ds.GetCellSet());
+  cachedLocator.SetCoordinates(ds.GetCoordinateSystem());
+  cachedLocator.Update();
+  VTKM_TEST_ASSERT(cachedLocator.GetCellIds() == firstLocator.GetCellIds(),
+                   "Cell ids not shared");
+  VTKM_TEST_ASSERT(cachedLocator.GetCellStartIndex() == firstLocator.GetCellStartIndex(),
+                   "Cell start indices not shared");
+  dispatcher.Invoke(points, cachedLocator, cellIds, pcoords);
+  vtkm::cont::testing::CheckCellLocatorResults(cellIds, pcoords, expCellIds, expPCoords);
+
+  std::cout << "Finding cells with a locator read from a file\n";
+  const std::string fileName = "TwoLevelLocator" + std::to_string(DIMENSIONS) + "D.bin";
+  locator.WriteSearchStructure(fileName);
+  vtkm::cont::CellLocatorTwoLevel readLocator;
+  readLocator.SetCellSet(ds.GetCellSet());
+  readLocator.SetCoordinates(ds.GetCoordinateSystem());
+  readLocator.ReadSearchStructure(fileName);
+  VTKM_TEST_ASSERT(readLocator.GetDensityL1() == 64.0f, "Density not read");
+  dispatcher.Invoke(points, readLocator, cellIds, pcoords);
+  vtkm::cont::testing::CheckCellLocatorResults(cellIds, pcoords, expCellIds, expPCoords);
+
+  std::cout << "Reading truncated and foreign locator files\n";
+  {
+    std::ifstream file(fileName, std::ios::binary);
+    const std::string contents{ std::istreambuf_iterator<char>(file),
+                                std::istreambuf_iterator<char>() };
+    const std::string badFileName = "Bad" + fileName;
+    for (const std::string& badContents : { contents.substr(0, contents.size() / 2),
+                                            contents.substr(0, 4),
+                                            std::string{},
+                                            std::string(16, '\xff') })
+    {
+      std::ofstream(badFileName, std::ios::binary) << badContents;
+      vtkm::cont::CellLocatorTwoLevel badLocator;
+      badLocator.SetCellSet(ds.GetCellSet());
+      badLocator.SetCoordinates(ds.GetCoordinateSystem());
+      bool rejected = false;
+      try
+      {
+        badLocator.ReadSearchStructure(badFileName);
+      }
+      catch (const vtkm::cont::ErrorBadValue&)
+      {
+        rejected = true;
+      }
+      std::remove(badFileName.c_str());
+      VTKM_TEST_ASSERT(rejected, "Bad cell locator file not rejected");
+    }
+  }
 
-  auto cellIdsPortal = cellIds.ReadPortal();
-  auto expCellIdsPortal = expCellIds.ReadPortal();
-  auto pcoordsPortal = pcoords.ReadPortal();
-  auto expPCoordsPortal = expPCoords.ReadPortal();
-  for (vtkm::Id i = 0; i < numberOfPoints; ++i)
+  std::cout << "Finding cells after moving the points\n";
+  // A locator for the modified coordinates must not use the search structure of the old ones.
+  const PointType offset(10.0f);
   {
-    VTKM_TEST_ASSERT(cellIdsPortal.Get(i) == expCellIdsPortal.Get(i), "Incorrect cell ids");
-    VTKM_TEST_ASSERT(test_equal(pcoordsPortal.Get(i), expPCoordsPortal.Get(i), 1e-3),
-                     "Incorrect parameteric coordinates");
+    vtkm::cont::ArrayHandleBasic<PointType> coords;
+    ds.GetCoordinateSystem().GetData().AsArrayHandle(coords);
+    vtkm::cont::Token token;
+    PointType* coordsPointer = coords.GetWritePointer(token);
+    for (vtkm::Id i = 0; i < coords.GetNumberOfValues(); ++i)
+    {
+      coordsPointer[i] = coordsPointer[i] + offset;
+    }
+    auto pointsPortal = points.WritePortal();
+    for (vtkm::Id i = 0; i < pointsPortal.GetNumberOfValues(); ++i)
+    {
+      pointsPortal.Set(i, pointsPortal.Get(i) + offset);
+    }
   }
+  // The file still holds the structure of the old points. It is not checked against the
+  // points, so it must not be shared with other locators.
+  vtkm::cont::CellLocatorTwoLevel staleLocator;
+  staleLocator.SetCellSet(ds.GetCellSet());
+  staleLocator.SetCoordinates(ds.GetCoordinateSystem());
+  staleLocator.ReadSearchStructure(fileName);
+  staleLocator.Update();
+  std::remove(fileName.c_str());
+
+  vtkm::cont::CellLocatorTwoLevel movedLocator;
+  movedLocator.SetDensityL1(64.0f);
+  movedLocator.SetDensityL2(1.0f);
+  movedLocator.SetCellSet(ds.GetCellSet());
+  movedLocator.SetCoordinates(ds.GetCoordinateSystem());
+  dispatcher.Invoke(points, movedLocator, cellIds, pcoords);
+  vtkm::cont::testing::CheckCellLocatorResults(cellIds, pcoords, expCellIds, expPCoords);
 }
 
 void TestingCellLocatorTwoLevel()
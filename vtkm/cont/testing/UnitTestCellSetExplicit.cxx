@@ -9,6 +9,7 @@
 //============================================================================
 #include <vtkm/cont/CellSetExplicit.h>
 
+#include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/RuntimeDeviceTracker.h>
 #include <vtkm/cont/testing/Testing.h>
@@ -188,6 +189,64 @@ void TestCellSetExplicit()
   vtkm::worklet::DispatcherMapTopology<WorkletCellToPoint>().Invoke(cellset, result);
   VTKM_TEST_ASSERT(VTKM_PASS_COMMAS(cellset.HasConnectivity(PointTag{}, CellTag{})),
                    "CellToPoint table missing after CellToPoint worklet exec.");
+
+  std::cout << "\tTesting CellToPoint table reuse across cell sets\n";
+  vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+  vtkm::cont::ArrayCopy(
+    vtkm::cont::make_ArrayHandle(g_connectivity, ArrayLength(g_connectivity), vtkm::CopyFlag::Off),
+    connectivity);
+  auto shapes = vtkm::cont::make_ArrayHandle(g_shapes, ArrayLength(g_shapes), vtkm::CopyFlag::Off);
+  vtkm::cont::ArrayHandle<vtkm::Id> offsets;
+  vtkm::cont::ArrayCopy(
+    vtkm::cont::make_ArrayHandle(g_offsets, ArrayLength(g_offsets), vtkm::CopyFlag::Off),
+    offsets);
+  vtkm::cont::CellSetExplicit<> step1;
+  step1.Fill(numberOfPoints, shapes, connectivity, offsets);
+  vtkm::cont::CellSetExplicit<> step2;
+  step2.Fill(numberOfPoints, shapes, connectivity, offsets);
+
+  auto reverse1 = step1.GetConnectivityArray(PointTag{}, CellTag{});
+  VTKM_TEST_ASSERT(!step2.HasConnectivity(PointTag{}, CellTag{}), "Unexpected CellToPoint table.");
+  auto reverse2 = step2.GetConnectivityArray(PointTag{}, CellTag{});
+  VTKM_TEST_ASSERT(reverse1 == reverse2, "CellToPoint table not shared for same connectivity.");
+
+  vtkm::cont::CellSetExplicit<> otherPoints;
+  otherPoints.Fill(numberOfPoints + 1, shapes, connectivity, offsets);
+  VTKM_TEST_ASSERT(otherPoints.GetConnectivityArray(PointTag{}, CellTag{}) != reverse1,
+                   "CellToPoint table shared for different number of points.");
+
+  step2.ResetConnectivity(PointTag{}, CellTag{});
+  VTKM_TEST_ASSERT(step2.GetConnectivityArray(PointTag{}, CellTag{}) != reverse1,
+                   "CellToPoint table not rebuilt after reset.");
+
+  // The table is only kept alive by the cell sets using it.
+  {
+    vtkm::cont::CellSetExplicit<> temporary;
+    temporary.Fill(numberOfPoints + 2, shapes, connectivity, offsets);
+    reverse2 = temporary.GetConnectivityArray(PointTag{}, CellTag{});
+  }
+  vtkm::cont::CellSetExplicit<> afterTemporary;
+  afterTemporary.Fill(numberOfPoints + 2, shapes, connectivity, offsets);
+  VTKM_TEST_ASSERT(afterTemporary.GetConnectivityArray(PointTag{}, CellTag{}) != reverse2,
+                   "CellToPoint table kept after its cell sets were destroyed.");
+
+  // Swap the points of the first cell, and swap them back through the same portal. The table
+  // must be rebuilt each time.
+  auto connPortal = connectivity.WritePortal();
+  connPortal.Set(0, 1);
+  connPortal.Set(1, 0);
+  vtkm::cont::CellSetExplicit<> modified;
+  modified.Fill(numberOfPoints, shapes, connectivity, offsets);
+  auto reverse3 = modified.GetConnectivityArray(PointTag{}, CellTag{});
+  VTKM_TEST_ASSERT(reverse3 != reverse1, "Stale CellToPoint table after modification.");
+  connPortal.Set(0, 0);
+  connPortal.Set(1, 1);
+  vtkm::cont::CellSetExplicit<> modifiedBack;
+  modifiedBack.Fill(numberOfPoints, shapes, connectivity, offsets);
+  VTKM_TEST_ASSERT(modifiedBack.GetConnectivityArray(PointTag{}, CellTag{}) != reverse3,
+                   "Stale CellToPoint table after write through a held portal.");
+  VTKM_TEST_ASSERT(step1.GetConnectivityArray(PointTag{}, CellTag{}) == reverse1,
+                   "Existing CellToPoint table should not change.");
 }
 
 } // anonymous namespace
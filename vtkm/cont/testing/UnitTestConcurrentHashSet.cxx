@@ -0,0 +1,137 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ConcurrentHashSet.h>
+
+#include <vtkm/cont/ArrayHandleZip.h>
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace
+{
+
+constexpr vtkm::Id ARRAY_SIZE = 5000;
+
+template <typename KeyType, typename KeyStorage>
+void CheckHashSet(const vtkm::cont::ArrayHandle<KeyType, KeyStorage>& keys)
+{
+  vtkm::cont::ConcurrentHashSet<KeyType, KeyStorage> hashSet(keys);
+  VTKM_TEST_ASSERT(hashSet.GetNumberOfSlots() >= 2 * keys.GetNumberOfValues());
+
+  // Expected first occurrence of every key.
+  auto keysPortal = keys.ReadPortal();
+  std::vector<KeyType> keyValues;
+  std::vector<vtkm::Id> expectedFirst;
+  for (vtkm::Id i = 0; i < keysPortal.GetNumberOfValues(); ++i)
+  {
+    const KeyType key = keysPortal.Get(i);
+    vtkm::Id first = i;
+    for (std::size_t u = 0; u < keyValues.size(); ++u)
+    {
+      if (keyValues[u] == key)
+      {
+        first = expectedFirst[u];
+        break;
+      }
+    }
+    if (first == i)
+    {
+      keyValues.push_back(key);
+      expectedFirst.push_back(i);
+    }
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> uniqueIndices;
+  vtkm::cont::ArrayHandle<vtkm::Id> keyToUnique;
+  const vtkm::Id numberOfUniqueKeys = hashSet.GetUniqueKeyIds(uniqueIndices, keyToUnique);
+  VTKM_TEST_ASSERT(numberOfUniqueKeys == static_cast<vtkm::Id>(expectedFirst.size()),
+                   "Wrong number of unique keys: ",
+                   numberOfUniqueKeys);
+  auto expectedArray = vtkm::cont::make_ArrayHandle(expectedFirst, vtkm::CopyFlag::Off);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(uniqueIndices, expectedArray), "Wrong unique keys");
+
+  auto representatives = hashSet.GetRepresentatives().ReadPortal();
+  auto keyToUniquePortal = keyToUnique.ReadPortal();
+  for (vtkm::Id i = 0; i < keysPortal.GetNumberOfValues(); ++i)
+  {
+    const vtkm::Id unique = keyToUniquePortal.Get(i);
+    VTKM_TEST_ASSERT(keysPortal.Get(expectedFirst[static_cast<std::size_t>(unique)]) ==
+                       keysPortal.Get(i),
+                     "Key mapped to a different key");
+    VTKM_TEST_ASSERT(representatives.Get(i) == expectedFirst[static_cast<std::size_t>(unique)],
+                     "Representative is not the first equal key");
+  }
+
+  // Every key is found, and keys that were not inserted are not.
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(hashSet.Find(keys), hashSet.GetRepresentatives()));
+}
+
+void TestIdKeys()
+{
+  std::cout << "Testing vtkm::Id keys" << std::endl;
+  std::vector<vtkm::Id> keys(ARRAY_SIZE);
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    keys[i] = static_cast<vtkm::Id>((i * 7919) % 1237);
+  }
+  auto keysArray = vtkm::cont::make_ArrayHandle(keys, vtkm::CopyFlag::On);
+  CheckHashSet(keysArray);
+
+  vtkm::cont::ConcurrentHashSet<vtkm::Id> hashSet(keysArray);
+  auto missing = hashSet.Find(vtkm::cont::make_ArrayHandle<vtkm::Id>({ -5, 1237, 5000 }));
+  VTKM_TEST_ASSERT(
+    test_equal_ArrayHandles(missing, vtkm::cont::make_ArrayHandle<vtkm::Id>({ -1, -1, -1 })));
+
+  std::cout << "Testing empty set" << std::endl;
+  CheckHashSet(vtkm::cont::ArrayHandle<vtkm::Id>{});
+}
+
+void TestId2Keys()
+{
+  std::cout << "Testing vtkm::Id2 keys" << std::endl;
+  std::vector<vtkm::Id2> keys(ARRAY_SIZE);
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    const vtkm::Id a = static_cast<vtkm::Id>(i % 97);
+    const vtkm::Id b = static_cast<vtkm::Id>((i * 31) % 53);
+    keys[i] = vtkm::Id2(vtkm::Min(a, b), vtkm::Max(a, b));
+  }
+  CheckHashSet(vtkm::cont::make_ArrayHandle(keys, vtkm::CopyFlag::On));
+}
+
+void TestPairKeys()
+{
+  std::cout << "Testing zipped keys" << std::endl;
+  std::vector<vtkm::Id> first(ARRAY_SIZE);
+  std::vector<vtkm::Id2> second(ARRAY_SIZE);
+  for (std::size_t i = 0; i < first.size(); ++i)
+  {
+    first[i] = static_cast<vtkm::Id>(i % 3);
+    second[i] = vtkm::Id2(static_cast<vtkm::Id>(i % 41), static_cast<vtkm::Id>(i % 7));
+  }
+  CheckHashSet(
+    vtkm::cont::make_ArrayHandleZip(vtkm::cont::make_ArrayHandle(first, vtkm::CopyFlag::On),
+                                    vtkm::cont::make_ArrayHandle(second, vtkm::CopyFlag::On)));
+}
+
+void TestConcurrentHashSet()
+{
+  TestIdKeys();
+  TestId2Keys();
+  TestPairKeys();
+}
+
+} // anonymous namespace
+
+int UnitTestConcurrentHashSet(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestConcurrentHashSet, argc, argv);
+}
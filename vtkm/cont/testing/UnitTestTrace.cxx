@@ -0,0 +1,163 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/Trace.h>
+#include <vtkm/cont/testing/Testing.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct Event
+{
+  std::string Name;
+  int Tid;
+  double Start;
+  double Duration;
+};
+
+void InnerScope()
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "Inner scope %d", 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+}
+
+void OuterScope()
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "Outer scope");
+  InnerScope();
+  InnerScope();
+}
+
+std::string GetValue(const std::string& line, const std::string& key)
+{
+  const std::string pattern = "\"" + key + "\":";
+  std::size_t start = line.find(pattern);
+  VTKM_TEST_ASSERT(start != std::string::npos, "No ", key, " in ", line);
+  start += pattern.size();
+  if (line[start] == '"')
+  {
+    ++start;
+    return line.substr(start, line.find('"', start) - start);
+  }
+  return line.substr(start, line.find_first_of(",}", start) - start);
+}
+
+std::vector<Event> ReadEvents(const std::string& fileName, std::vector<std::string>& threadNames)
+{
+  std::ifstream file(fileName);
+  VTKM_TEST_ASSERT(file.good(), "Trace file not written.");
+  std::string line;
+  std::getline(file, line);
+  VTKM_TEST_ASSERT(line == "{\"traceEvents\":[", "Bad start of trace: ", line);
+
+  std::vector<Event> events;
+  while (std::getline(file, line))
+  {
+    if (line.find("\"ph\":\"M\"") != std::string::npos)
+    {
+      threadNames.push_back(GetValue(line.substr(line.find("\"args\"")), "name"));
+    }
+    else if (line.find("\"ph\":\"X\"") != std::string::npos)
+    {
+      events.push_back({ GetValue(line, "name"),
+                         std::stoi(GetValue(line, "tid")),
+                         std::stod(GetValue(line, "ts")),
+                         std::stod(GetValue(line, "dur")) });
+    }
+    else
+    {
+      VTKM_TEST_ASSERT(line == "],\"displayTimeUnit\":\"ms\"}", "Unexpected line: ", line);
+    }
+  }
+  return events;
+}
+
+void TestTrace()
+{
+  const std::string fileName = vtkm::cont::testing::Testing::WriteDirPath("UnitTestTrace.json");
+
+  VTKM_TEST_ASSERT(!vtkm::cont::IsTraceEnabled());
+  vtkm::cont::StartTrace(fileName);
+  VTKM_TEST_ASSERT(vtkm::cont::IsTraceEnabled());
+
+  OuterScope();
+  std::thread worker([]() {
+    vtkm::cont::SetLogThreadName("trace worker");
+    OuterScope();
+  });
+  worker.join();
+
+  // Moving data to a device is traced.
+  vtkm::cont::ArrayHandle<vtkm::Id> array = vtkm::cont::make_ArrayHandle<vtkm::Id>({ 1, 2, 3 });
+  {
+    vtkm::cont::Token token;
+    array.PrepareForInput(vtkm::cont::DeviceAdapterTagSerial{}, token);
+  }
+
+  vtkm::cont::StopTrace();
+  VTKM_TEST_ASSERT(!vtkm::cont::IsTraceEnabled());
+  // Not recorded.
+  OuterScope();
+
+  std::vector<std::string> threadNames;
+  std::vector<Event> events = ReadEvents(fileName, threadNames);
+  std::cout << "Read " << events.size() << " events from " << threadNames.size() << " threads"
+            << std::endl;
+  VTKM_TEST_ASSERT(threadNames.size() == 2);
+  VTKM_TEST_ASSERT(threadNames[1] == "trace worker");
+
+  vtkm::IdComponent numOuter = 0;
+  vtkm::IdComponent numInner = 0;
+  vtkm::IdComponent numTransfers = 0;
+  for (const Event& event : events)
+  {
+    VTKM_TEST_ASSERT(event.Start >= 0 && event.Duration >= 0);
+    if (event.Name == "Outer scope")
+    {
+      ++numOuter;
+    }
+    else if (event.Name == "Inner scope 1")
+    {
+      ++numInner;
+      VTKM_TEST_ASSERT(event.Duration >= 1000, "Inner scope too short.");
+      // Every inner scope is inside an outer scope of the same thread.
+      bool nested = false;
+      for (const Event& outer : events)
+      {
+        nested |= ((outer.Name == "Outer scope") && (outer.Tid == event.Tid) &&
+                   (outer.Start <= event.Start) &&
+                   (event.Start + event.Duration <= outer.Start + outer.Duration));
+      }
+      VTKM_TEST_ASSERT(nested, "Inner scope not nested in outer scope.");
+    }
+    else if (event.Name.find("from host to device") != std::string::npos)
+    {
+      ++numTransfers;
+    }
+  }
+  VTKM_TEST_ASSERT(numOuter == 2);
+  VTKM_TEST_ASSERT(numInner == 4);
+  VTKM_TEST_ASSERT(numTransfers == 1);
+}
+
+} // anonymous namespace
+
+int UnitTestTrace(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestTrace, argc, argv);
+}
@@ -84,12 +84,78 @@ public:
   }
 
 
+  /// \brief Hint for finding a cell near the last one found.
+  ///
+  /// Passing the same `LastCell` to consecutive calls to `FindCell` lets the locator check the
+  /// previous cell and the other cells in its leaf before searching the hierarchy. A
+  /// `LastCell` should only be used by one thread at a time.
+  ///
+  struct LastCell
+  {
+    vtkm::Id CellId = -1;
+    vtkm::Id NodeIdx = -1;
+  };
+
   VTKM_EXEC
   vtkm::ErrorCode FindCell(const vtkm::Vec3f& point,
                            vtkm::Id& cellId,
                            vtkm::Vec3f& parametric) const
+  {
+    LastCell lastCell;
+    return this->FindCellImpl(point, cellId, parametric, lastCell);
+  }
+
+  VTKM_EXEC
+  vtkm::ErrorCode FindCell(const vtkm::Vec3f& point,
+                           vtkm::Id& cellId,
+                           vtkm::Vec3f& parametric,
+                           LastCell& lastCell) const
+  {
+    if ((lastCell.CellId >= 0) && (lastCell.CellId < this->CellSet.GetNumberOfElements()))
+    {
+      bool found;
+      VTKM_RETURN_ON_ERROR(this->IsPointInCell(lastCell.CellId, point, parametric, found));
+      if (found)
+      {
+        cellId = lastCell.CellId;
+        return vtkm::ErrorCode::Success;
+      }
+    }
+
+    // Check the rest of the leaf that held the last cell.
+    if ((lastCell.NodeIdx >= 0) && (lastCell.NodeIdx < this->Nodes.GetNumberOfValues()))
+    {
+      const vtkm::exec::CellLocatorBoundingIntervalHierarchyNode& node =
+        this->Nodes.Get(lastCell.NodeIdx);
+      if (node.ChildIndex < 0)
+      {
+        VTKM_RETURN_ON_ERROR(this->FindInLeaf(point, parametric, node, cellId));
+        if (cellId >= 0)
+        {
+          lastCell.CellId = cellId;
+          return vtkm::ErrorCode::Success;
+        }
+      }
+    }
+
+    return this->FindCellImpl(point, cellId, parametric, lastCell);
+  }
+
+  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
+  VTKM_EXEC CellLocatorBoundingIntervalHierarchy* operator->() { return this; }
+  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
+  VTKM_EXEC const CellLocatorBoundingIntervalHierarchy* operator->() const { return this; }
+
+private:
+  VTKM_EXEC
+  vtkm::ErrorCode FindCellImpl(const vtkm::Vec3f& point,
+                               vtkm::Id& cellId,
+                               vtkm::Vec3f& parametric,
+                               LastCell& lastCell) const
   {
     cellId = -1;
+    lastCell.CellId = -1;
+    lastCell.NodeIdx = -1;
     vtkm::Id nodeIndex = 0;
     FindCellState state = FindCellState::EnterNode;
 
@@ -114,6 +180,9 @@ public:
 
     if (cellId >= 0)
     {
+      // The search stops in the leaf that holds the cell.
+      lastCell.CellId = cellId;
+      lastCell.NodeIdx = nodeIndex;
       return vtkm::ErrorCode::Success;
     }
     else
@@ -122,12 +191,6 @@ public:
     }
   }
 
-  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
-  VTKM_EXEC CellLocatorBoundingIntervalHierarchy* operator->() { return this; }
-  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
-  VTKM_EXEC const CellLocatorBoundingIntervalHierarchy* operator->() const { return this; }
-
-private:
   enum struct FindCellState
   {
     EnterNode,
@@ -230,16 +293,11 @@ private:
     const vtkm::exec::CellLocatorBoundingIntervalHierarchyNode& node,
     vtkm::Id& containingCellId) const
   {
-    using IndicesType = typename CellSetPortal::IndicesType;
     for (vtkm::Id i = node.Leaf.Start; i < node.Leaf.Start + node.Leaf.Size; ++i)
     {
       vtkm::Id cellId = this->CellIds.Get(i);
-      IndicesType cellPointIndices = this->CellSet.GetIndices(cellId);
-      vtkm::VecFromPortalPermute<IndicesType, CoordsPortal> cellPoints(&cellPointIndices,
-                                                                       this->Coords);
       bool found;
-      VTKM_RETURN_ON_ERROR(this->IsPointInCell(
-        point, parametric, this->CellSet.GetCellShape(cellId), cellPoints, found));
+      VTKM_RETURN_ON_ERROR(this->IsPointInCell(cellId, point, parametric, found));
       if (found)
       {
         containingCellId = cellId;
@@ -250,6 +308,19 @@ private:
     return vtkm::ErrorCode::Success;
   }
 
+  VTKM_EXEC vtkm::ErrorCode IsPointInCell(vtkm::Id cellId,
+                                          const vtkm::Vec3f& point,
+                                          vtkm::Vec3f& parametric,
+                                          bool& isInside) const
+  {
+    using IndicesType = typename CellSetPortal::IndicesType;
+    IndicesType cellPointIndices = this->CellSet.GetIndices(cellId);
+    vtkm::VecFromPortalPermute<IndicesType, CoordsPortal> cellPoints(&cellPointIndices,
+                                                                     this->Coords);
+    return this->IsPointInCell(
+      point, parametric, this->CellSet.GetCellShape(cellId), cellPoints, isInside);
+  }
+
   template <typename CoordsType, typename CellShapeTag>
   VTKM_EXEC static vtkm::ErrorCode IsPointInCell(const vtkm::Vec3f& point,
                                                  vtkm::Vec3f& parametric,
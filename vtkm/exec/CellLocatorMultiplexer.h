@@ -15,6 +15,8 @@
 
 #include <vtkm/exec/internal/Variant.h>
 
+#include <type_traits>
+
 namespace vtkm
 {
 namespace exec
@@ -33,6 +35,21 @@ struct FindCellFunctor
   {
     return locator.FindCell(point, cellId, parametric);
   }
+
+  template <typename Locator, typename LastCell>
+  VTKM_EXEC vtkm::ErrorCode operator()(Locator&& locator,
+                                       const vtkm::Vec3f& point,
+                                       vtkm::Id& cellId,
+                                       vtkm::Vec3f& parametric,
+                                       LastCell& lastCell) const
+  {
+    using ConcreteLastCell = typename std::decay<Locator>::type::LastCell;
+    if (!lastCell.template IsType<ConcreteLastCell>())
+    {
+      lastCell = ConcreteLastCell{};
+    }
+    return locator.FindCell(point, cellId, parametric, lastCell.template Get<ConcreteLastCell>());
+  }
 };
 
 } // namespace detail
@@ -43,6 +60,13 @@ class VTKM_ALWAYS_EXPORT CellLocatorMultiplexer
   vtkm::exec::internal::Variant<LocatorTypes...> Locators;
 
 public:
+  /// \brief Hint for finding a cell near the last one found.
+  ///
+  /// Holds the `LastCell` of whichever locator is in use. See the `LastCell` of each locator
+  /// for how it is used.
+  ///
+  using LastCell = vtkm::exec::internal::Variant<typename LocatorTypes::LastCell...>;
+
   CellLocatorMultiplexer() = default;
 
   template <typename Locator>
@@ -58,6 +82,15 @@ public:
     return this->Locators.CastAndCall(detail::FindCellFunctor{}, point, cellId, parametric);
   }
 
+  VTKM_EXEC vtkm::ErrorCode FindCell(const vtkm::Vec3f& point,
+                                     vtkm::Id& cellId,
+                                     vtkm::Vec3f& parametric,
+                                     LastCell& lastCell) const
+  {
+    return this->Locators.CastAndCall(
+      detail::FindCellFunctor{}, point, cellId, parametric, lastCell);
+  }
+
   VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
   VTKM_EXEC CellLocatorMultiplexer* operator->() { return this; }
   VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
@@ -87,6 +87,22 @@ public:
     return inside;
   }
 
+  /// Finding a cell in a rectilinear grid only searches the coordinates along each axis, so no
+  /// hint is needed. This empty `LastCell` is provided for interface compatibility with the
+  /// other locators.
+  struct LastCell
+  {
+  };
+
+  VTKM_EXEC
+  vtkm::ErrorCode FindCell(const vtkm::Vec3f& point,
+                           vtkm::Id& cellId,
+                           vtkm::Vec3f& parametric,
+                           LastCell& vtkmNotUsed(lastCell)) const
+  {
+    return this->FindCell(point, cellId, parametric);
+  }
+
   VTKM_EXEC
   vtkm::ErrorCode FindCell(const vtkm::Vec3f& point,
                            vtkm::Id& cellId,
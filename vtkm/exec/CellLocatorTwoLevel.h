@@ -153,12 +153,119 @@ public:
   {
   }
 
+  /// \brief Hint for finding a cell near the last one found.
+  ///
+  /// Queries such as particle advection usually look for a point in the same cell as, or a
+  /// cell near, the previous point. Passing the same `LastCell` to consecutive calls to
+  /// `FindCell` lets the locator check the previous cell and the cells in its leaf bin before
+  /// searching the grid. A `LastCell` should only be used by one thread at a time.
+  ///
+  struct LastCell
+  {
+    vtkm::Id CellId = -1;
+    vtkm::Id LeafIdx = -1;
+  };
+
   VTKM_EXEC
   vtkm::ErrorCode FindCell(const FloatVec3& point, vtkm::Id& cellId, FloatVec3& parametric) const
+  {
+    LastCell lastCell;
+    return this->FindCellImpl(point, cellId, parametric, lastCell);
+  }
+
+  VTKM_EXEC
+  vtkm::ErrorCode FindCell(const FloatVec3& point,
+                           vtkm::Id& cellId,
+                           FloatVec3& parametric,
+                           LastCell& lastCell) const
+  {
+    vtkm::Id numCells = this->CellSet.GetNumberOfElements();
+    if ((lastCell.CellId >= 0) && (lastCell.CellId < numCells))
+    {
+      bool inside;
+      VTKM_RETURN_ON_ERROR(this->PointInCell(point, lastCell.CellId, parametric, inside));
+      if (inside)
+      {
+        cellId = lastCell.CellId;
+        return vtkm::ErrorCode::Success;
+      }
+    }
+
+    // The point is likely in a neighbor of the last cell, which is probably in the same leaf.
+    if ((lastCell.LeafIdx >= 0) && (lastCell.LeafIdx < this->CellCount.GetNumberOfValues()))
+    {
+      VTKM_RETURN_ON_ERROR(
+        this->FindInLeaf(point, lastCell.LeafIdx, lastCell.CellId, cellId, parametric));
+      if (cellId >= 0)
+      {
+        lastCell.CellId = cellId;
+        return vtkm::ErrorCode::Success;
+      }
+    }
+
+    return this->FindCellImpl(point, cellId, parametric, lastCell);
+  }
+
+  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
+  VTKM_EXEC CellLocatorTwoLevel* operator->() { return this; }
+  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
+  VTKM_EXEC const CellLocatorTwoLevel* operator->() const { return this; }
+
+private:
+  VTKM_EXEC
+  vtkm::ErrorCode PointInCell(const FloatVec3& point,
+                              vtkm::Id cid,
+                              FloatVec3& parametric,
+                              bool& inside) const
+  {
+    auto indices = this->CellSet.GetIndices(cid);
+    auto pts = vtkm::make_VecFromPortalPermute(&indices, this->Coords);
+    return PointInsideCell(point, this->CellSet.GetCellShape(cid), pts, parametric, inside);
+  }
+
+  // Looks for the cell containing the point in the given leaf, skipping `skipCellId` (which
+  // has already been checked). `cellId` is set to -1 if no cell is found.
+  VTKM_EXEC
+  vtkm::ErrorCode FindInLeaf(const FloatVec3& point,
+                             vtkm::Id leafId,
+                             vtkm::Id skipCellId,
+                             vtkm::Id& cellId,
+                             FloatVec3& parametric) const
+  {
+    cellId = -1;
+    vtkm::Id start = this->CellStartIndex.Get(leafId);
+    vtkm::Id end = start + this->CellCount.Get(leafId);
+    for (vtkm::Id i = start; i < end; ++i)
+    {
+      vtkm::Id cid = this->CellIds.Get(i);
+      if (cid == skipCellId)
+      {
+        continue;
+      }
+      FloatVec3 pc;
+      bool inside;
+      VTKM_RETURN_ON_ERROR(this->PointInCell(point, cid, pc, inside));
+      if (inside)
+      {
+        cellId = cid;
+        parametric = pc;
+        break;
+      }
+    }
+    return vtkm::ErrorCode::Success;
+  }
+
+  VTKM_EXEC
+  vtkm::ErrorCode FindCellImpl(const FloatVec3& point,
+                               vtkm::Id& cellId,
+                               FloatVec3& parametric,
+                               LastCell& lastCell) const
   {
     using namespace vtkm::internal::cl_uniform_bins;
 
     cellId = -1;
+    lastCell.CellId = -1;
+    lastCell.LeafIdx = -1;
 
     DimVec3 binId3 = static_cast<DimVec3>((point - this->TopLevel.Origin) / this->TopLevel.BinSize);
     if (binId3[0] >= 0 && binId3[0] < this->TopLevel.Dimensions[0] && binId3[1] >= 0 &&
@@ -182,35 +289,18 @@ public:
       vtkm::Id leafStart = this->LeafStartIndex.Get(binId);
       vtkm::Id leafId = leafStart + ComputeFlatIndex(leafId3, leafGrid.Dimensions);
 
-      vtkm::Id start = this->CellStartIndex.Get(leafId);
-      vtkm::Id end = start + this->CellCount.Get(leafId);
-      for (vtkm::Id i = start; i < end; ++i)
+      VTKM_RETURN_ON_ERROR(this->FindInLeaf(point, leafId, -1, cellId, parametric));
+      if (cellId >= 0)
       {
-        vtkm::Id cid = this->CellIds.Get(i);
-        auto indices = this->CellSet.GetIndices(cid);
-        auto pts = vtkm::make_VecFromPortalPermute(&indices, this->Coords);
-        FloatVec3 pc;
-        bool inside;
-        VTKM_RETURN_ON_ERROR(
-          PointInsideCell(point, this->CellSet.GetCellShape(cid), pts, pc, inside));
-        if (inside)
-        {
-          cellId = cid;
-          parametric = pc;
-          return vtkm::ErrorCode::Success;
-        }
+        lastCell.CellId = cellId;
+        lastCell.LeafIdx = leafId;
+        return vtkm::ErrorCode::Success;
       }
     }
 
     return vtkm::ErrorCode::CellNotFound;
   }
 
-  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
-  VTKM_EXEC CellLocatorTwoLevel* operator->() { return this; }
-  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
-  VTKM_EXEC const CellLocatorTwoLevel* operator->() const { return this; }
-
-private:
   vtkm::internal::cl_uniform_bins::Grid TopLevel;
 
   ReadPortal<DimVec3> LeafDimensions;
@@ -55,6 +55,21 @@ public:
     return inside;
   }
 
+  /// Finding a cell in a uniform grid is a direct computation, so no hint is needed. This
+  /// empty `LastCell` is provided for interface compatibility with the other locators.
+  struct LastCell
+  {
+  };
+
+  VTKM_EXEC
+  vtkm::ErrorCode FindCell(const vtkm::Vec3f& point,
+                           vtkm::Id& cellId,
+                           vtkm::Vec3f& parametric,
+                           LastCell& vtkmNotUsed(lastCell)) const
+  {
+    return this->FindCell(point, cellId, parametric);
+  }
+
   VTKM_EXEC
   vtkm::ErrorCode FindCell(const vtkm::Vec3f& point,
                            vtkm::Id& cellId,
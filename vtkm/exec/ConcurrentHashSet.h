@@ -0,0 +1,155 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_exec_ConcurrentHashSet_h
+#define vtk_m_exec_ConcurrentHashSet_h
+
+#include <vtkm/Hash.h>
+#include <vtkm/Pair.h>
+#include <vtkm/exec/AtomicArrayExecutionObject.h>
+
+#include <type_traits>
+
+namespace vtkm
+{
+namespace exec
+{
+
+namespace detail
+{
+
+template <typename T>
+VTKM_EXEC_CONT inline vtkm::HashType HashKeyImpl(const T& key, std::false_type)
+{
+  return vtkm::Hash(key);
+}
+
+// vtkm::Hash only takes 32 and 64 bit integers.
+template <typename T>
+VTKM_EXEC_CONT inline vtkm::HashType HashKeyImpl(const T& key, std::true_type)
+{
+  return vtkm::Hash(static_cast<vtkm::UInt32>(key));
+}
+
+template <typename T>
+VTKM_EXEC_CONT inline vtkm::HashType HashKey(const T& key)
+{
+  using IsSmallInteger =
+    std::integral_constant<bool, std::is_integral<T>::value && (sizeof(T) < 4)>;
+  return HashKeyImpl(key, IsSmallInteger{});
+}
+
+template <typename T, typename U>
+VTKM_EXEC_CONT inline vtkm::HashType HashKey(const vtkm::Pair<T, U>& key)
+{
+  return (HashKey(key.first) * vtkm::detail::FNV1A_PRIME) ^ HashKey(key.second);
+}
+
+// Final mix of MurmurHash3, so that the low bits used to pick a slot depend on all the bits
+// of the hash.
+VTKM_EXEC_CONT inline vtkm::HashType MixHash(vtkm::HashType hash)
+{
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6b;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+} // namespace detail
+
+/// \brief Execution object of `vtkm::cont::ConcurrentHashSet`.
+///
+/// The set stores the indices of keys in an open addressing table with linear probing.
+/// Keys are inserted by index with an atomic compare and exchange, so many threads can insert
+/// keys at the same time. When several keys are equal, their slot ends up holding the
+/// smallest of their indices.
+///
+template <typename KeyPortalType>
+class ConcurrentHashSet
+{
+public:
+  using KeyType = typename KeyPortalType::ValueType;
+
+  static constexpr vtkm::Id EmptySlot = -1;
+
+  ConcurrentHashSet() = default;
+
+  VTKM_CONT ConcurrentHashSet(const KeyPortalType& keys,
+                              const vtkm::exec::AtomicArrayExecutionObject<vtkm::Id>& slots)
+    : Keys(keys)
+    , Slots(slots)
+    , Mask(slots.GetNumberOfValues() - 1)
+  {
+  }
+
+  VTKM_EXEC vtkm::Id GetNumberOfSlots() const { return this->Mask + 1; }
+
+  /// Inserts the key at `index` and returns the slot of the key. The slot holds the
+  /// smallest index inserted so far of the keys equal to it.
+  VTKM_EXEC vtkm::Id Insert(vtkm::Id index) const
+  {
+    const KeyType key = this->Keys.Get(index);
+    vtkm::Id slot = this->FirstSlot(key);
+    while (true)
+    {
+      vtkm::Id current = this->Slots.Get(slot);
+      if (current == EmptySlot)
+      {
+        if (this->Slots.CompareExchange(slot, &current, index))
+        {
+          return slot;
+        }
+        // Another thread filled the slot, and current now holds its index.
+      }
+      if (this->Keys.Get(current) == key)
+      {
+        while ((index < current) && !this->Slots.CompareExchange(slot, &current, index))
+        {
+        }
+        return slot;
+      }
+      slot = (slot + 1) & this->Mask;
+    }
+  }
+
+  /// Returns the index held by the slot of a key equal to `key`, or -1 if there is none.
+  VTKM_EXEC vtkm::Id Find(const KeyType& key) const
+  {
+    vtkm::Id slot = this->FirstSlot(key);
+    while (true)
+    {
+      const vtkm::Id current = this->Slots.Get(slot);
+      if ((current == EmptySlot) || (this->Keys.Get(current) == key))
+      {
+        return current;
+      }
+      slot = (slot + 1) & this->Mask;
+    }
+  }
+
+private:
+  VTKM_EXEC vtkm::Id FirstSlot(const KeyType& key) const
+  {
+    return static_cast<vtkm::Id>(detail::MixHash(detail::HashKey(key))) & this->Mask;
+  }
+
+  KeyPortalType Keys;
+  vtkm::exec::AtomicArrayExecutionObject<vtkm::Id> Slots;
+  vtkm::Id Mask = 0;
+};
+
+template <typename KeyPortalType>
+constexpr vtkm::Id ConcurrentHashSet<KeyPortalType>::EmptySlot;
+
+}
+} // namespace vtkm::exec
+
+#endif //vtk_m_exec_ConcurrentHashSet_h
@@ -0,0 +1,360 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/ActiveCellIndex.h>
+
+#include <vtkm/VectorAnalysis.h>
+#include <vtkm/cont/ArrayCopyDevice.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/CellSetList.h>
+#include <vtkm/cont/CellSetPermutation.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/internal/Fingerprint.h>
+#include <vtkm/filter/MapFieldPermutation.h>
+#include <vtkm/worklet/CellDeepCopy.h>
+#include <vtkm/worklet/ScatterCounting.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace
+{
+
+class ComputeMetacellRanges : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn metacell,
+                                WholeCellSetIn<Cell, Point> cellSet,
+                                WholeArrayIn values,
+                                FieldOut range);
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  ComputeMetacellRanges(vtkm::Id cellsPerMetacell, vtkm::Id numberOfCells, bool pointValues)
+    : CellsPerMetacell(cellsPerMetacell)
+    , NumberOfCells(numberOfCells)
+    , PointValues(pointValues)
+  {
+  }
+
+  template <typename CellSetType, typename ValuesPortal>
+  VTKM_EXEC void operator()(vtkm::Id metacell,
+                            const CellSetType& cellSet,
+                            const ValuesPortal& values,
+                            vtkm::Range& range) const
+  {
+    range = vtkm::Range{};
+    const vtkm::Id begin = metacell * this->CellsPerMetacell;
+    const vtkm::Id end = vtkm::Min(begin + this->CellsPerMetacell, this->NumberOfCells);
+    for (vtkm::Id cell = begin; cell < end; ++cell)
+    {
+      if (this->PointValues)
+      {
+        auto indices = cellSet.GetIndices(cell);
+        for (vtkm::IdComponent i = 0; i < indices.GetNumberOfComponents(); ++i)
+        {
+          range.Include(values.Get(indices[i]));
+        }
+      }
+      else
+      {
+        range.Include(values.Get(cell));
+      }
+    }
+  }
+
+private:
+  vtkm::Id CellsPerMetacell;
+  vtkm::Id NumberOfCells;
+  bool PointValues;
+};
+
+class CountCandidateCells : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn metacellRange, WholeArrayIn ranges, FieldOut count);
+  using ExecutionSignature = void(InputIndex, _1, _2, _3);
+
+  CountCandidateCells(vtkm::Id cellsPerMetacell, vtkm::Id numberOfCells)
+    : CellsPerMetacell(cellsPerMetacell)
+    , NumberOfCells(numberOfCells)
+  {
+  }
+
+  template <typename RangesPortal>
+  VTKM_EXEC void operator()(vtkm::Id metacell,
+                            const vtkm::Range& metacellRange,
+                            const RangesPortal& ranges,
+                            vtkm::IdComponent& count) const
+  {
+    count = 0;
+    for (vtkm::Id r = 0; r < ranges.GetNumberOfValues(); ++r)
+    {
+      const vtkm::Range range = ranges.Get(r);
+      if ((metacellRange.Min <= range.Max) && (metacellRange.Max >= range.Min))
+      {
+        const vtkm::Id begin = metacell * this->CellsPerMetacell;
+        count = static_cast<vtkm::IdComponent>(
+          vtkm::Min(this->CellsPerMetacell, this->NumberOfCells - begin));
+        return;
+      }
+    }
+  }
+
+private:
+  vtkm::Id CellsPerMetacell;
+  vtkm::Id NumberOfCells;
+};
+
+class WriteCandidateCells : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn metacellRange, FieldOut cellId);
+  using ExecutionSignature = void(InputIndex, VisitIndex, _2);
+  using ScatterType = vtkm::worklet::ScatterCounting;
+
+  explicit WriteCandidateCells(vtkm::Id cellsPerMetacell)
+    : CellsPerMetacell(cellsPerMetacell)
+  {
+  }
+
+  VTKM_EXEC void operator()(vtkm::Id metacell,
+                            vtkm::IdComponent visitIndex,
+                            vtkm::Id& cellId) const
+  {
+    cellId = metacell * this->CellsPerMetacell + visitIndex;
+  }
+
+private:
+  vtkm::Id CellsPerMetacell;
+};
+
+bool FieldFingerprint(const vtkm::cont::DataSet& input,
+                      const std::string& fieldName,
+                      std::vector<vtkm::UInt64>& fingerprint)
+{
+  fingerprint.clear();
+  if (!input.HasField(fieldName) ||
+      !vtkm::cont::internal::AppendCellSetFingerprint(fingerprint, input.GetCellSet()))
+  {
+    return false;
+  }
+  const vtkm::cont::Field& field = input.GetField(fieldName);
+  fingerprint.push_back(static_cast<vtkm::UInt64>(field.GetAssociation()));
+  return vtkm::cont::internal::AppendArrayFingerprint(fingerprint, field.GetData());
+}
+
+bool PlaneFingerprint(const vtkm::cont::DataSet& input,
+                      vtkm::IdComponent coordinateSystemIndex,
+                      std::vector<vtkm::UInt64>& fingerprint)
+{
+  fingerprint.clear();
+  if ((coordinateSystemIndex >= input.GetNumberOfCoordinateSystems()) ||
+      !vtkm::cont::internal::AppendCellSetFingerprint(fingerprint, input.GetCellSet()))
+  {
+    return false;
+  }
+  fingerprint.push_back(0);
+  return vtkm::cont::internal::AppendArrayFingerprint(
+    fingerprint, input.GetCoordinateSystem(coordinateSystemIndex).GetData());
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace filter
+{
+
+void ActiveCellIndex::Build(const vtkm::cont::DataSet& input, const std::string& fieldName)
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "ActiveCellIndex::Build");
+
+  std::vector<vtkm::UInt64> fingerprint;
+  if (!FieldFingerprint(input, fieldName, fingerprint))
+  {
+    throw vtkm::cont::ErrorBadValue("ActiveCellIndex: field " + fieldName +
+                                    " not found or not stored in memory.");
+  }
+  this->BuildMetacells(input.GetCellSet(), input.GetField(fieldName));
+  this->Fingerprint = std::move(fingerprint);
+  this->FieldName = fieldName;
+  this->ForPlane = false;
+}
+
+void ActiveCellIndex::Build(const vtkm::cont::DataSet& input,
+                            const vtkm::Plane& plane,
+                            vtkm::IdComponent coordinateSystemIndex)
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "ActiveCellIndex::Build");
+
+  std::vector<vtkm::UInt64> fingerprint;
+  if (!PlaneFingerprint(input, coordinateSystemIndex, fingerprint))
+  {
+    throw vtkm::cont::ErrorBadValue("ActiveCellIndex: unsupported cell set or coordinates.");
+  }
+
+  const auto& coords = input.GetCoordinateSystem(coordinateSystemIndex);
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> values;
+  vtkm::cont::ArrayCopyDevice(
+    vtkm::cont::make_ArrayHandleTransform(coords.GetDataAsMultiplexer(),
+                                          vtkm::ImplicitFunctionValueFunctor<vtkm::Plane>(plane)),
+    values);
+  this->BuildMetacells(input.GetCellSet(),
+                       vtkm::cont::Field("", vtkm::cont::Field::Association::Points, values));
+  this->Fingerprint = std::move(fingerprint);
+  this->FieldName.clear();
+  this->ForPlane = true;
+  this->Plane = plane;
+  this->PlaneBounds = coords.GetBounds();
+}
+
+void ActiveCellIndex::BuildMetacells(const vtkm::cont::UnknownCellSet& cellSet,
+                                     const vtkm::cont::Field& field)
+{
+  if (this->CellsPerMetacell < 1)
+  {
+    throw vtkm::cont::ErrorBadValue("ActiveCellIndex: metacells must have at least one cell.");
+  }
+  if (!field.IsFieldPoint() && !field.IsFieldCell())
+  {
+    throw vtkm::cont::ErrorBadValue("ActiveCellIndex: point or cell field expected.");
+  }
+  if (field.GetData().GetNumberOfComponentsFlat() != 1)
+  {
+    throw vtkm::cont::ErrorBadValue("ActiveCellIndex: scalar field expected.");
+  }
+
+  this->NumberOfCells = cellSet.GetNumberOfCells();
+  const vtkm::Id numberOfMetacells =
+    (this->NumberOfCells + this->CellsPerMetacell - 1) / this->CellsPerMetacell;
+
+  vtkm::cont::Invoker invoke;
+  ComputeMetacellRanges worklet(this->CellsPerMetacell, this->NumberOfCells, field.IsFieldPoint());
+  auto resolveType = [&](const auto& values) {
+    cellSet.CastAndCallForTypes<VTKM_DEFAULT_CELL_SET_LIST>([&](const auto& concreteCells) {
+      invoke(worklet,
+             vtkm::cont::ArrayHandleIndex(numberOfMetacells),
+             concreteCells,
+             values,
+             this->MetacellRanges);
+    });
+  };
+  field.GetData().CastAndCallForTypesWithFloatFallback<vtkm::TypeListFieldScalar,
+                                                        VTKM_DEFAULT_STORAGE_LIST>(resolveType);
+}
+
+bool ActiveCellIndex::IsValidFor(const vtkm::cont::DataSet& input,
+                                 const std::string& fieldName) const
+{
+  if (this->ForPlane || (fieldName != this->FieldName) || this->Fingerprint.empty())
+  {
+    return false;
+  }
+  std::vector<vtkm::UInt64> fingerprint;
+  return FieldFingerprint(input, fieldName, fingerprint) && (fingerprint == this->Fingerprint);
+}
+
+bool ActiveCellIndex::IsValidFor(const vtkm::cont::DataSet& input,
+                                 const vtkm::Plane& plane,
+                                 vtkm::IdComponent coordinateSystemIndex) const
+{
+  if (!this->ForPlane || (plane.GetNormal() != this->Plane.GetNormal()))
+  {
+    return false;
+  }
+  std::vector<vtkm::UInt64> fingerprint;
+  return PlaneFingerprint(input, coordinateSystemIndex, fingerprint) &&
+    (fingerprint == this->Fingerprint);
+}
+
+vtkm::Range ActiveCellIndex::GetPlaneRange(const vtkm::Plane& plane) const
+{
+  using Vec3 = vtkm::Vec3f_64;
+  const Vec3 normal = this->Plane.GetNormal();
+  const Vec3 indexOrigin = this->Plane.GetOrigin();
+  const Vec3 origin = plane.GetOrigin();
+  const vtkm::Float64 offset = vtkm::Dot(origin - indexOrigin, normal);
+
+  // Both the indexed values and the values of `plane` are computed in vtkm::FloatDefault,
+  // with errors relative to the distances between the points and the plane origins.
+  const Vec3 center = this->PlaneBounds.Center();
+  const vtkm::Float64 extent =
+    vtkm::Magnitude(Vec3(this->PlaneBounds.X.Length(),
+                         this->PlaneBounds.Y.Length(),
+                         this->PlaneBounds.Z.Length())) +
+    vtkm::Magnitude(center - indexOrigin) + vtkm::Magnitude(center - origin);
+  const vtkm::Float64 tolerance = 8 * vtkm::Epsilon<vtkm::FloatDefault>() * extent *
+    vtkm::Magnitude(normal);
+  return vtkm::Range(offset - tolerance, offset + tolerance);
+}
+
+vtkm::cont::ArrayHandle<vtkm::Id> ActiveCellIndex::GetCandidateCells(
+  const std::vector<vtkm::Range>& ranges) const
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "ActiveCellIndex::GetCandidateCells");
+
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::IdComponent> counts;
+  invoke(CountCandidateCells(this->CellsPerMetacell, this->NumberOfCells),
+         this->MetacellRanges,
+         vtkm::cont::make_ArrayHandle(ranges, vtkm::CopyFlag::Off),
+         counts);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+  invoke(WriteCandidateCells(this->CellsPerMetacell),
+         vtkm::worklet::ScatterCounting(counts),
+         this->MetacellRanges,
+         cellIds);
+  return cellIds;
+}
+
+vtkm::cont::DataSet ActiveCellIndex::ExtractCandidates(const vtkm::cont::DataSet& input,
+                                                       const std::vector<vtkm::Range>& ranges) const
+{
+  const vtkm::cont::ArrayHandle<vtkm::Id> cellIds = this->GetCandidateCells(ranges);
+  VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+             "ActiveCellIndex: " << cellIds.GetNumberOfValues() << " of "
+                                 << this->NumberOfCells << " cells are candidates.");
+
+  vtkm::cont::CellSetExplicit<> cellSet;
+  input.GetCellSet().CastAndCallForTypes<VTKM_DEFAULT_CELL_SET_LIST>(
+    [&](const auto& concreteCells) {
+      vtkm::worklet::CellDeepCopy::Run(vtkm::cont::make_CellSetPermutation(cellIds, concreteCells),
+                                       cellSet);
+    });
+
+  vtkm::cont::DataSet output;
+  output.SetCellSet(cellSet);
+  for (vtkm::IdComponent i = 0; i < input.GetNumberOfCoordinateSystems(); ++i)
+  {
+    output.AddCoordinateSystem(input.GetCoordinateSystem(i));
+  }
+  for (vtkm::IdComponent i = 0; i < input.GetNumberOfFields(); ++i)
+  {
+    const vtkm::cont::Field& field = input.GetField(i);
+    if (field.IsFieldCell())
+    {
+      vtkm::filter::MapFieldPermutation(field, cellIds, output);
+    }
+    else
+    {
+      output.AddField(field);
+    }
+  }
+  if (input.HasGhostCellField() && output.HasCellField(input.GetGhostCellFieldName()))
+  {
+    output.AddGhostCellField(output.GetCellField(input.GetGhostCellFieldName()));
+  }
+  return output;
+}
+
+} // namespace filter
+} // namespace vtkm
@@ -0,0 +1,133 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_filter_ActiveCellIndex_h
+#define vtk_m_filter_ActiveCellIndex_h
+
+#include <vtkm/Bounds.h>
+#include <vtkm/ImplicitFunction.h>
+#include <vtkm/Range.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/filter/vtkm_filter_core_export.h>
+
+#include <string>
+#include <vector>
+
+namespace vtkm
+{
+namespace filter
+{
+
+/// \brief Finds the cells of a data set whose scalar values may lie in a range.
+///
+/// Filters such as `contour::Contour` or `entity_extraction::Threshold` classify every
+/// cell of their input, although a query often produces output for a small part of the
+/// cells. `ActiveCellIndex` is built once for a scalar field. It groups the cells in
+/// metacells of consecutive cell ids and stores the range of the field over each metacell.
+/// Every query then only visits the metacells and the cells of the metacells whose range
+/// overlaps the queried values.
+///
+/// Filters that accept an index (`Contour`, `Slice`, `ClipWithField` and `Threshold`)
+/// run on the candidate cells only. `Contour` and `Slice` do not use it for structured cell
+/// sets, which they contour with flying edges. The index records the state of the cell set
+/// and the field it was built for. If either was modified, or the filter runs on another
+/// field or data set, the index is ignored and the filter processes all cells.
+///
+/// The index is not updated by edits of the cells or the field. Call `Build` again after
+/// editing them in place. Edits are detected with the modified stamps of their arrays (see
+/// `vtkm::cont::internal::Buffer::GetModifiedStamp`). Arrays that can be written without
+/// their buffers knowing, such as arrays whose `WritePortal` was taken or that wrap user
+/// memory, never match, so an index built for them is never used.
+///
+/// An index can also be built for a plane rather than for a field (see
+/// `Build(const vtkm::cont::DataSet&, const vtkm::Plane&)`). `contour::Slice` uses it for
+/// every plane parallel to that plane, which makes sweeping a slice through a data set
+/// cheap.
+///
+class VTKM_FILTER_CORE_EXPORT ActiveCellIndex
+{
+public:
+  /// Number of consecutive cells grouped in a metacell. Smaller metacells give fewer
+  /// candidates but more metacells to check per query. The default is 64.
+  VTKM_CONT void SetCellsPerMetacell(vtkm::Id cellsPerMetacell)
+  {
+    this->CellsPerMetacell = cellsPerMetacell;
+  }
+  VTKM_CONT vtkm::Id GetCellsPerMetacell() const { return this->CellsPerMetacell; }
+
+  /// \brief Builds the index for a scalar point or cell field of `input`.
+  ///
+  /// Throws `vtkm::cont::ErrorBadValue` if the field does not have one component or is not
+  /// stored in memory.
+  VTKM_CONT void Build(const vtkm::cont::DataSet& input, const std::string& fieldName);
+
+  /// \brief Builds the index for the signed distances of the points of `input` to a plane.
+  ///
+  /// The values are those of `vtkm::Plane::Value`, computed from the coordinate system
+  /// with the given index.
+  VTKM_CONT void Build(const vtkm::cont::DataSet& input,
+                       const vtkm::Plane& plane,
+                       vtkm::IdComponent coordinateSystemIndex = 0);
+
+  /// Returns true if the index was built for the field `fieldName` of `input`, and the
+  /// field and cells were not modified since.
+  VTKM_CONT bool IsValidFor(const vtkm::cont::DataSet& input, const std::string& fieldName) const;
+
+  /// Returns true if the index was built for a plane with the same normal as `plane`, and
+  /// the coordinates and cells of `input` were not modified since.
+  VTKM_CONT bool IsValidFor(const vtkm::cont::DataSet& input,
+                            const vtkm::Plane& plane,
+                            vtkm::IdComponent coordinateSystemIndex = 0) const;
+
+  /// \brief Returns the values of the indexed plane at the points of `plane`.
+  ///
+  /// Querying this range gives the cells intersected by `plane`, which must be parallel to
+  /// the plane used to build the index. The range is widened to cover rounding errors.
+  VTKM_CONT vtkm::Range GetPlaneRange(const vtkm::Plane& plane) const;
+
+  VTKM_CONT vtkm::Id GetNumberOfMetacells() const
+  {
+    return this->MetacellRanges.GetNumberOfValues();
+  }
+
+  /// \brief Returns the ids, in increasing order, of the cells whose values may overlap
+  /// any of the ranges.
+  ///
+  /// A cell intersects the iso-surface of value `v` only if it is a candidate for the range
+  /// `[v, v]`.
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Id> GetCandidateCells(
+    const std::vector<vtkm::Range>& ranges) const;
+
+  /// \brief Extracts the candidate cells of `input` for the ranges.
+  ///
+  /// The output has the candidate cells in a `vtkm::cont::CellSetExplicit`, even for
+  /// structured inputs, with the cell fields permuted to match. The points, point fields and
+  /// coordinate systems are shared with `input`.
+  VTKM_CONT vtkm::cont::DataSet ExtractCandidates(const vtkm::cont::DataSet& input,
+                                                  const std::vector<vtkm::Range>& ranges) const;
+
+private:
+  VTKM_CONT void BuildMetacells(const vtkm::cont::UnknownCellSet& cellSet,
+                                const vtkm::cont::Field& field);
+
+  vtkm::Id CellsPerMetacell = 64;
+  vtkm::Id NumberOfCells = 0;
+  std::string FieldName;
+  bool ForPlane = false;
+  vtkm::Plane Plane;
+  vtkm::Bounds PlaneBounds;
+  std::vector<vtkm::UInt64> Fingerprint;
+  vtkm::cont::ArrayHandle<vtkm::Range> MetacellRanges;
+};
+
+} // namespace filter
+} // namespace vtkm
+
+#endif // vtk_m_filter_ActiveCellIndex_h
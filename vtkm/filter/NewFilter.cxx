@@ -12,31 +12,12 @@
 #include <vtkm/cont/RuntimeDeviceTracker.h>
 
 #include <vtkm/filter/NewFilter.h>
-#include <vtkm/filter/TaskQueue.h>
-
-#include <future>
+#include <vtkm/filter/TaskScheduler.h>
 
 namespace vtkm
 {
 namespace filter
 {
-namespace
-{
-void RunFilter(NewFilter* self,
-               vtkm::filter::DataSetQueue& input,
-               vtkm::filter::DataSetQueue& output)
-{
-  std::pair<vtkm::Id, vtkm::cont::DataSet> task;
-  while (input.GetTask(task))
-  {
-    auto outDS = self->Execute(task.second);
-    output.Push(std::make_pair(task.first, std::move(outDS)));
-  }
-
-  vtkm::cont::Algorithm::Synchronize();
-}
-} // anonymous namespace
-
 NewFilter::~NewFilter() = default;
 
 bool NewFilter::CanThread() const
@@ -52,25 +33,24 @@ vtkm::cont::PartitionedDataSet NewFilter::DoExecutePartitions(
 
   if (this->GetRunMultiThreadedFilter())
   {
-    vtkm::filter::DataSetQueue inputQueue(input);
-    vtkm::filter::DataSetQueue outputQueue;
-
-    vtkm::Id numThreads = this->DetermineNumberOfThreads(input);
-
-    //Run 'numThreads' filters.
-    std::vector<std::future<void>> futures(static_cast<std::size_t>(numThreads));
-    for (std::size_t i = 0; i < static_cast<std::size_t>(numThreads); i++)
+    std::size_t numPartitions = static_cast<std::size_t>(input.GetNumberOfPartitions());
+    std::vector<vtkm::cont::DataSet> outBlocks(numPartitions);
+    std::vector<vtkm::filter::TaskScheduler::TaskType> tasks;
+    std::vector<vtkm::Id> costs;
+    tasks.reserve(numPartitions);
+    costs.reserve(numPartitions);
+    for (std::size_t i = 0; i < numPartitions; ++i)
     {
-      auto f = std::async(
-        std::launch::async, RunFilter, this, std::ref(inputQueue), std::ref(outputQueue));
-      futures[i] = std::move(f);
+      const vtkm::cont::DataSet& inBlock = input.GetPartition(static_cast<vtkm::Id>(i));
+      tasks.emplace_back([this, &inBlock, &outBlocks, i]() {
+        outBlocks[i] = this->Execute(inBlock);
+        vtkm::cont::Algorithm::Synchronize();
+      });
+      costs.push_back(this->EstimatePartitionCost(inBlock));
     }
 
-    for (auto& f : futures)
-      f.get();
-
-    //Get results from the outputQueue.
-    output = outputQueue.Get();
+    vtkm::filter::GetTaskScheduler().Run(tasks, costs, this->DetermineNumberOfThreads(input));
+    output.AppendPartitions(outBlocks);
   }
   else
   {
@@ -86,6 +66,9 @@ vtkm::cont::PartitionedDataSet NewFilter::DoExecutePartitions(
 
 vtkm::cont::DataSet NewFilter::Execute(const vtkm::cont::DataSet& input)
 {
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf,
+                 "NewFilter: '%s'",
+                 vtkm::cont::TypeToString(typeid(*this)).c_str());
   return this->DoExecute(input);
 }
 
@@ -111,10 +94,22 @@ vtkm::cont::DataSet NewFilter::CreateResult(const vtkm::cont::DataSet& inDataSet
   return clone;
 }
 
+vtkm::Id NewFilter::EstimatePartitionCost(const vtkm::cont::DataSet& input)
+{
+  return input.GetNumberOfCells() + input.GetNumberOfPoints();
+}
+
 vtkm::Id NewFilter::DetermineNumberOfThreads(const vtkm::cont::PartitionedDataSet& input)
 {
   vtkm::Id numDS = input.GetNumberOfPartitions();
 
+  // A filter run from within another filter's partition is already running in parallel with
+  // the other partitions. Running its partitions on more threads would oversubscribe the device.
+  if (vtkm::filter::TaskScheduler::InTask())
+  {
+    return 1;
+  }
+
   //Aribitrary constants.
   const vtkm::Id threadsPerGPU = 8;
   const vtkm::Id threadsPerCPU = 4;
@@ -137,7 +132,8 @@ vtkm::Id NewFilter::DetermineNumberOfThreads(const vtkm::cont::PartitionedDataSe
   else if (tracker.CanRunOn(vtkm::cont::DeviceAdapterTagSerial{}))
     availThreads = 1;
   else
-    availThreads = threadsPerCPU;
+    availThreads =
+      std::min(threadsPerCPU, vtkm::filter::GetTaskScheduler().GetMaximumConcurrency());
 
   vtkm::Id numThreads = std::min<vtkm::Id>(numDS, availThreads);
   return numThreads;
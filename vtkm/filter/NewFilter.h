@@ -206,13 +206,18 @@ namespace filter
 /// `Execute(PartitionedDataSet&)` implementation will fallback to a serial for loop execution.
 ///
 /// \subsection FilterThreadScheduling DoExecute
-/// The default multi-threaded execution of `Execute(PartitionedDataSet&)` uses a simple FIFO queue
-/// of DataSet and pool of *worker* threads. Implementation of Filter subclass can override the
+/// The default multi-threaded execution of `Execute(PartitionedDataSet&)` runs each DataSet as a
+/// task on a `TaskScheduler`, a persistent pool of *worker* threads shared by all filters. The
+/// tasks are ordered by the cost estimated with the `EstimatePartitionCost()` virtual method so
+/// that the most expensive DataSets start first, and idle workers steal tasks from busy ones.
+/// Implementation of Filter subclass can override the
 /// `DoExecutePartitions(PartitionedDataSet)` virtual method to provide implementation specific
-/// scheduling policy. The default number of *worker* threads in the pool are determined by the
-/// `DetermineNumberOfThreads()` virtual method using several backend dependent heuristic.
+/// scheduling policy. The default number of *worker* threads used is determined by the
+/// `DetermineNumberOfThreads()` virtual method using several backend dependent heuristic. A
+/// filter executed from within a task of another filter runs its partitions on one thread.
 /// Implementations of Filter subclass can also override
-/// `DetermineNumberOfThreads()` to provide implementation specific heuristic.
+/// `DetermineNumberOfThreads()` and `EstimatePartitionCost()` to provide implementation
+/// specific heuristics.
 ///
 class VTKM_FILTER_CORE_EXPORT NewFilter
 {
@@ -438,6 +443,13 @@ private:
   VTKM_CONT
   virtual vtkm::Id DetermineNumberOfThreads(const vtkm::cont::PartitionedDataSet& input);
 
+  /// \brief Estimates the relative amount of work to run the filter on one partition.
+  ///
+  /// The multi-threaded execution of `Execute(PartitionedDataSet&)` starts the most expensive
+  /// partitions first. The default estimate is the number of cells plus the number of points.
+  VTKM_CONT
+  virtual vtkm::Id EstimatePartitionCost(const vtkm::cont::DataSet& input);
+
 
   vtkm::filter::FieldSelection FieldsToPass = vtkm::filter::FieldSelection::Mode::All;
   bool RunFilterWithMultipleThreads = false;
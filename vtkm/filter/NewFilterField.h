@@ -51,6 +51,14 @@ public:
     this->ActiveFieldAssociation[index_st] = association;
   }
 
+  /// Number of active field slots that have been set with `SetActiveField`,
+  /// `SetActiveCoordinateSystem` or `SetUseCoordinateSystemAsField`.
+  VTKM_CONT vtkm::IdComponent GetNumberOfActiveFields() const
+  {
+    VTKM_ASSERT(this->ActiveFieldNames.size() == this->UseCoordinateSystemAsField.size());
+    return static_cast<vtkm::IdComponent>(this->ActiveFieldNames.size());
+  }
+
   VTKM_CONT const std::string& GetActiveFieldName(vtkm::IdComponent index = 0) const
   {
     VTKM_ASSERT((index >= 0) &&
@@ -0,0 +1,181 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/PieceSource.h>
+
+#include <vtkm/CellClassification.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <cmath>
+
+namespace
+{
+
+struct MarkGhostCells : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn cellIndex, FieldOut ghost);
+  using ExecutionSignature = void(_1, _2);
+
+  // All values are in the cell index space of the brick. Flat dimensions have one cell
+  // that is considered owned.
+  vtkm::Id3 CellDimensions;
+  vtkm::Id3 OwnedBegin;
+  vtkm::Id3 OwnedEnd;
+
+  VTKM_EXEC void operator()(vtkm::Id cellIndex, vtkm::UInt8& ghost) const
+  {
+    const vtkm::Id3 ijk{ cellIndex % this->CellDimensions[0],
+                         (cellIndex / this->CellDimensions[0]) % this->CellDimensions[1],
+                         cellIndex / (this->CellDimensions[0] * this->CellDimensions[1]) };
+    bool owned = true;
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      owned = owned && (ijk[d] >= this->OwnedBegin[d]) && (ijk[d] < this->OwnedEnd[d]);
+    }
+    ghost = owned ? vtkm::UInt8{ vtkm::CellClassification::Normal }
+                  : vtkm::UInt8{ vtkm::CellClassification::Ghost };
+  }
+};
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace filter
+{
+
+PieceSource::~PieceSource() = default;
+
+//-----------------------------------------------------------------------------
+UniformBrickSource::UniformBrickSource(const vtkm::Id3& minExtent,
+                                       const vtkm::Id3& maxExtent,
+                                       const GeneratorType& generator)
+  : MinimumExtent(minExtent)
+  , MaximumExtent(maxExtent)
+  , Generator(generator)
+{
+  for (vtkm::IdComponent d = 0; d < 3; ++d)
+  {
+    if (maxExtent[d] < minExtent[d])
+    {
+      throw vtkm::cont::ErrorBadValue("UniformBrickSource: invalid extent.");
+    }
+  }
+}
+
+void UniformBrickSource::SetBrickDimensionsForBudget(vtkm::UInt64 bytes,
+                                                     vtkm::UInt64 bytesPerPoint)
+{
+  const vtkm::Id3 cells = this->MaximumExtent - this->MinimumExtent;
+  int numberOfDimensions = 0;
+  for (vtkm::IdComponent d = 0; d < 3; ++d)
+  {
+    numberOfDimensions += (cells[d] > 0) ? 1 : 0;
+  }
+
+  const double maxPoints =
+    static_cast<double>(bytes) / static_cast<double>(vtkm::Max(bytesPerPoint, vtkm::UInt64{ 1 }));
+  const vtkm::Id pointsPerSide = (numberOfDimensions > 0)
+    ? static_cast<vtkm::Id>(std::floor(std::pow(maxPoints, 1.0 / numberOfDimensions) + 1e-9))
+    : 1;
+  const vtkm::Id cellsPerSide = pointsPerSide - 1 - 2 * this->GhostLayers;
+  if (numberOfDimensions > 0 && cellsPerSide < 1)
+  {
+    throw vtkm::cont::ErrorBadValue(
+      "UniformBrickSource: memory budget is too small for a brick with ghost layers.");
+  }
+  for (vtkm::IdComponent d = 0; d < 3; ++d)
+  {
+    this->BrickDimensions[d] = vtkm::Max(vtkm::Min(cellsPerSide, cells[d]), vtkm::Id{ 1 });
+  }
+}
+
+vtkm::Id3 UniformBrickSource::GetNumberOfBricks() const
+{
+  vtkm::Id3 numberOfBricks;
+  for (vtkm::IdComponent d = 0; d < 3; ++d)
+  {
+    const vtkm::Id cells = this->MaximumExtent[d] - this->MinimumExtent[d];
+    const vtkm::Id brickCells = vtkm::Max(this->BrickDimensions[d], vtkm::Id{ 1 });
+    numberOfBricks[d] = (cells > 0) ? (cells + brickCells - 1) / brickCells : 1;
+  }
+  return numberOfBricks;
+}
+
+vtkm::Id UniformBrickSource::GetNumberOfPieces() const
+{
+  const vtkm::Id3 numberOfBricks = this->GetNumberOfBricks();
+  return numberOfBricks[0] * numberOfBricks[1] * numberOfBricks[2];
+}
+
+vtkm::cont::DataSet UniformBrickSource::GetPiece(vtkm::Id pieceIndex) const
+{
+  const vtkm::Id3 numberOfBricks = this->GetNumberOfBricks();
+  if (pieceIndex < 0 || pieceIndex >= this->GetNumberOfPieces())
+  {
+    throw vtkm::cont::ErrorBadValue("UniformBrickSource: piece index out of range.");
+  }
+  const vtkm::Id3 brick{ pieceIndex % numberOfBricks[0],
+                         (pieceIndex / numberOfBricks[0]) % numberOfBricks[1],
+                         pieceIndex / (numberOfBricks[0] * numberOfBricks[1]) };
+
+  vtkm::Id3 minExtent;
+  vtkm::Id3 maxExtent;
+  vtkm::Id3 cellDimensions;
+  vtkm::Id3 ownedBegin;
+  vtkm::Id3 ownedEnd;
+  vtkm::Id numberOfCells = 1;
+  for (vtkm::IdComponent d = 0; d < 3; ++d)
+  {
+    const vtkm::Id cells = this->MaximumExtent[d] - this->MinimumExtent[d];
+    if (cells == 0)
+    {
+      minExtent[d] = maxExtent[d] = this->MinimumExtent[d];
+      cellDimensions[d] = 1;
+      ownedBegin[d] = 0;
+      ownedEnd[d] = 1;
+      continue;
+    }
+    const vtkm::Id brickCells = vtkm::Max(this->BrickDimensions[d], vtkm::Id{ 1 });
+    const vtkm::Id owned0 = brick[d] * brickCells;
+    const vtkm::Id owned1 = vtkm::Min(owned0 + brickCells, cells);
+    const vtkm::Id data0 = vtkm::Max(owned0 - this->GhostLayers, vtkm::Id{ 0 });
+    const vtkm::Id data1 = vtkm::Min(owned1 + this->GhostLayers, cells);
+    minExtent[d] = this->MinimumExtent[d] + data0;
+    maxExtent[d] = this->MinimumExtent[d] + data1;
+    cellDimensions[d] = data1 - data0;
+    ownedBegin[d] = owned0 - data0;
+    ownedEnd[d] = owned1 - data0;
+    numberOfCells *= cellDimensions[d];
+  }
+
+  vtkm::cont::DataSet piece = this->Generator(minExtent, maxExtent);
+  if (piece.GetNumberOfCells() != numberOfCells)
+  {
+    throw vtkm::cont::ErrorBadValue(
+      "UniformBrickSource: generator returned the wrong number of cells for a brick.");
+  }
+
+  MarkGhostCells worklet;
+  worklet.CellDimensions = cellDimensions;
+  worklet.OwnedBegin = ownedBegin;
+  worklet.OwnedEnd = ownedEnd;
+  vtkm::cont::ArrayHandle<vtkm::UInt8> ghosts;
+  vtkm::cont::Invoker invoke;
+  invoke(worklet, vtkm::cont::ArrayHandleIndex(numberOfCells), ghosts);
+  piece.AddGhostCellField(ghosts);
+  return piece;
+}
+
+} // namespace filter
+} // namespace vtkm
@@ -0,0 +1,94 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_filter_PieceSource_h
+#define vtk_m_filter_PieceSource_h
+
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/filter/vtkm_filter_core_export.h>
+
+#include <functional>
+
+namespace vtkm
+{
+namespace filter
+{
+
+/// \brief Produces a data set one piece at a time.
+///
+/// A `PieceSource` describes a data set that is too large to be resident all at once. Each
+/// piece is created (loaded, generated, ...) only when `GetPiece` is called. Pieces may
+/// overlap by ghost layers; cells that are owned by another piece should be marked in the
+/// ghost cell field (see `vtkm::cont::GetGlobalGhostCellFieldName`) as
+/// `vtkm::CellClassification::Ghost`. `StreamingExecutor` uses a `PieceSource` as input.
+///
+class VTKM_FILTER_CORE_EXPORT PieceSource
+{
+public:
+  virtual ~PieceSource();
+
+  VTKM_CONT virtual vtkm::Id GetNumberOfPieces() const = 0;
+
+  VTKM_CONT virtual vtkm::cont::DataSet GetPiece(vtkm::Id pieceIndex) const = 0;
+};
+
+/// \brief Splits a uniform grid into bricks with ghost layers.
+///
+/// The grid is described by an inclusive point extent, as used by `vtkm::source::Wavelet`.
+/// Its cells are partitioned into bricks of at most `BrickDimensions` cells. For each brick,
+/// the generator is called with the inclusive point extent of the brick grown by
+/// `NumberOfGhostLayers` cells on every side (clipped to the grid), and must return the
+/// data for exactly those points. The generator has to produce values that agree where
+/// bricks overlap; that is, the data of a sub-extent must be the corresponding part of the
+/// whole data set. `UniformBrickSource` adds a ghost cell field that marks the cells in the
+/// ghost layers.
+///
+class VTKM_FILTER_CORE_EXPORT UniformBrickSource : public PieceSource
+{
+public:
+  using GeneratorType =
+    std::function<vtkm::cont::DataSet(const vtkm::Id3& minExtent, const vtkm::Id3& maxExtent)>;
+
+  VTKM_CONT UniformBrickSource(const vtkm::Id3& minExtent,
+                               const vtkm::Id3& maxExtent,
+                               const GeneratorType& generator);
+
+  VTKM_CONT void SetBrickDimensions(const vtkm::Id3& cellDimensions)
+  {
+    this->BrickDimensions = cellDimensions;
+  }
+  VTKM_CONT const vtkm::Id3& GetBrickDimensions() const { return this->BrickDimensions; }
+
+  /// \brief Chooses cubic bricks that fit in a memory budget.
+  ///
+  /// `bytesPerPoint` is the memory needed for each point of a brick, counting everything
+  /// the filter chain creates. The ghost layers are taken into account.
+  VTKM_CONT void SetBrickDimensionsForBudget(vtkm::UInt64 bytes, vtkm::UInt64 bytesPerPoint);
+
+  VTKM_CONT void SetNumberOfGhostLayers(vtkm::IdComponent layers) { this->GhostLayers = layers; }
+  VTKM_CONT vtkm::IdComponent GetNumberOfGhostLayers() const { return this->GhostLayers; }
+
+  VTKM_CONT vtkm::Id GetNumberOfPieces() const override;
+
+  VTKM_CONT vtkm::cont::DataSet GetPiece(vtkm::Id pieceIndex) const override;
+
+private:
+  VTKM_CONT vtkm::Id3 GetNumberOfBricks() const;
+
+  vtkm::Id3 MinimumExtent;
+  vtkm::Id3 MaximumExtent;
+  GeneratorType Generator;
+  vtkm::Id3 BrickDimensions = { 64, 64, 64 };
+  vtkm::IdComponent GhostLayers = 1;
+};
+
+} // namespace filter
+} // namespace vtkm
+
+#endif // vtk_m_filter_PieceSource_h
@@ -0,0 +1,169 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/StreamingExecutor.h>
+
+#include <vtkm/cont/ArrayHandleSOA.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/MergePartitionedDataSet.h>
+
+namespace
+{
+
+vtkm::UInt64 ComponentSize(const vtkm::cont::UnknownArrayHandle& array)
+{
+  if (array.IsBaseComponentType<vtkm::Int8>() || array.IsBaseComponentType<vtkm::UInt8>())
+  {
+    return 1;
+  }
+  if (array.IsBaseComponentType<vtkm::Int16>() || array.IsBaseComponentType<vtkm::UInt16>())
+  {
+    return 2;
+  }
+  if (array.IsBaseComponentType<vtkm::Int32>() || array.IsBaseComponentType<vtkm::UInt32>() ||
+      array.IsBaseComponentType<vtkm::Float32>())
+  {
+    return 4;
+  }
+  return 8;
+}
+
+vtkm::UInt64 ArrayMemoryUsage(const vtkm::cont::UnknownArrayHandle& array)
+{
+  if (!array.IsStorageType<vtkm::cont::StorageTagBasic>() &&
+      !array.IsStorageType<vtkm::cont::StorageTagSOA>())
+  {
+    return 0;
+  }
+  return static_cast<vtkm::UInt64>(array.GetNumberOfValues()) *
+    static_cast<vtkm::UInt64>(array.GetNumberOfComponentsFlat()) * ComponentSize(array);
+}
+
+void ReleaseResourcesExecution(const vtkm::cont::DataSet& dataSet)
+{
+  for (vtkm::IdComponent i = 0; i < dataSet.GetNumberOfFields(); ++i)
+  {
+    dataSet.GetField(i).GetData().ReleaseResourcesExecution();
+  }
+  for (vtkm::IdComponent i = 0; i < dataSet.GetNumberOfCoordinateSystems(); ++i)
+  {
+    dataSet.GetCoordinateSystem(i).GetData().ReleaseResourcesExecution();
+  }
+  vtkm::cont::UnknownCellSet cellSet = dataSet.GetCellSet();
+  if (cellSet.IsValid())
+  {
+    cellSet.ReleaseResourcesExecution();
+  }
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace filter
+{
+
+vtkm::UInt64 StreamingExecutor::EstimateMemoryUsage(const vtkm::cont::DataSet& dataSet)
+{
+  vtkm::UInt64 bytes = 0;
+  for (vtkm::IdComponent i = 0; i < dataSet.GetNumberOfFields(); ++i)
+  {
+    bytes += ArrayMemoryUsage(dataSet.GetField(i).GetData());
+  }
+  for (vtkm::IdComponent i = 0; i < dataSet.GetNumberOfCoordinateSystems(); ++i)
+  {
+    bytes += ArrayMemoryUsage(dataSet.GetCoordinateSystem(i).GetData());
+  }
+
+  const vtkm::cont::UnknownCellSet& cellSet = dataSet.GetCellSet();
+  if (cellSet.IsType<vtkm::cont::CellSetExplicit<>>())
+  {
+    auto explicitCells = cellSet.AsCellSet<vtkm::cont::CellSetExplicit<>>();
+    const auto numberOfCells = static_cast<vtkm::UInt64>(explicitCells.GetNumberOfCells());
+    const auto connectivitySize = static_cast<vtkm::UInt64>(
+      explicitCells
+        .GetConnectivityArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{})
+        .GetNumberOfValues());
+    bytes += numberOfCells * sizeof(vtkm::UInt8) + (numberOfCells + 1) * sizeof(vtkm::Id) +
+      connectivitySize * sizeof(vtkm::Id);
+  }
+  else if (cellSet.IsType<vtkm::cont::CellSetSingleType<>>())
+  {
+    auto singleTypeCells = cellSet.AsCellSet<vtkm::cont::CellSetSingleType<>>();
+    bytes += static_cast<vtkm::UInt64>(
+               singleTypeCells
+                 .GetConnectivityArray(vtkm::TopologyElementTagCell{},
+                                       vtkm::TopologyElementTagPoint{})
+                 .GetNumberOfValues()) *
+      sizeof(vtkm::Id);
+  }
+  return bytes;
+}
+
+vtkm::cont::DataSet StreamingExecutor::ExecutePiece(const vtkm::filter::PieceSource& source,
+                                                    vtkm::Id pieceIndex)
+{
+  VTKM_LOG_SCOPE(
+    vtkm::cont::LogLevel::Perf, "StreamingExecutor piece %lld", static_cast<long long>(pieceIndex));
+
+  vtkm::cont::DataSet data = source.GetPiece(pieceIndex);
+  if (EstimateMemoryUsage(data) > this->MemoryBudget)
+  {
+    throw vtkm::cont::ErrorBadValue(
+      "StreamingExecutor: input piece exceeds the memory budget. Use smaller pieces.");
+  }
+
+  for (const auto& filter : this->Filters)
+  {
+    data = filter->Execute(data);
+    if (EstimateMemoryUsage(data) > this->MemoryBudget)
+    {
+      throw vtkm::cont::ErrorBadValue(
+        "StreamingExecutor: filter output exceeds the memory budget. Use smaller pieces.");
+    }
+  }
+  return data;
+}
+
+vtkm::cont::PartitionedDataSet StreamingExecutor::Execute(const vtkm::filter::PieceSource& source)
+{
+  vtkm::cont::PartitionedDataSet output;
+  vtkm::UInt64 keptBytes = 0;
+
+  // Merging copies all the kept outputs, so the outputs and their merged copy must fit.
+  const vtkm::Id numberOfPieces = source.GetNumberOfPieces();
+  const bool merge = this->MergeOutput && (numberOfPieces > 1);
+  const vtkm::UInt64 keptBudget = merge ? this->MemoryBudget / 2 : this->MemoryBudget;
+  for (vtkm::Id pieceIndex = 0; pieceIndex < numberOfPieces; ++pieceIndex)
+  {
+    vtkm::cont::DataSet result = this->ExecutePiece(source, pieceIndex);
+    keptBytes += EstimateMemoryUsage(result);
+    if (keptBytes > keptBudget)
+    {
+      throw vtkm::cont::ErrorBadValue(
+        "StreamingExecutor: output exceeds the memory budget. Use Reduce instead of Execute.");
+    }
+    // Only the piece being processed needs device memory.
+    ReleaseResourcesExecution(result);
+    output.AppendPartition(result);
+  }
+
+  if (merge)
+  {
+    return vtkm::cont::PartitionedDataSet(vtkm::cont::MergePartitionedDataSet(output));
+  }
+  return output;
+}
+
+} // namespace filter
+} // namespace vtkm
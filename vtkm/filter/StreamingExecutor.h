@@ -0,0 +1,109 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_filter_StreamingExecutor_h
+#define vtk_m_filter_StreamingExecutor_h
+
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/PartitionedDataSet.h>
+#include <vtkm/filter/NewFilter.h>
+#include <vtkm/filter/PieceSource.h>
+#include <vtkm/filter/vtkm_filter_core_export.h>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace vtkm
+{
+namespace filter
+{
+
+/// \brief Runs a chain of filters over a `PieceSource` one piece at a time.
+///
+/// Only one input piece and its intermediate results are resident at any time, so a
+/// filter chain can process data sets that do not fit in memory as a whole. The pieces
+/// usually carry ghost layers (see `UniformBrickSource`). Filters that need neighbors,
+/// such as gradients, then produce correct values on the owned cells. Append
+/// `entity_extraction::GhostCellRemove` to the chain to drop the duplicated ghost
+/// cells from the output.
+///
+/// The output of every piece is either kept (`Execute(const PieceSource&)`) or folded
+/// into a user-defined result and discarded (`Reduce`). Kept outputs have their
+/// execution (device) memory released, and their estimated size must stay within the
+/// memory budget. Reductions keep nothing, so their memory use is bounded by the
+/// largest piece.
+///
+class VTKM_FILTER_CORE_EXPORT StreamingExecutor
+{
+public:
+  /// Adds a filter to the end of the chain. The output of each filter is the input of
+  /// the next one.
+  VTKM_CONT void AddFilter(const std::shared_ptr<vtkm::filter::NewFilter>& filter)
+  {
+    this->Filters.push_back(filter);
+  }
+
+  VTKM_CONT std::size_t GetNumberOfFilters() const { return this->Filters.size(); }
+
+  /// \brief Maximum number of bytes for a piece or for the kept output.
+  ///
+  /// Sizes are estimated with `EstimateMemoryUsage`. A piece, an intermediate result or
+  /// the kept output exceeding the budget raises `vtkm::cont::ErrorBadValue`. When the
+  /// output is merged, the kept outputs and their merged copy are held at the same time, so
+  /// the kept output may only take half of the budget.
+  VTKM_CONT void SetMemoryBudget(vtkm::UInt64 bytes) { this->MemoryBudget = bytes; }
+  VTKM_CONT vtkm::UInt64 GetMemoryBudget() const { return this->MemoryBudget; }
+
+  /// When on, `Execute` merges the outputs of all pieces into a single `DataSet` with
+  /// `vtkm::cont::MergePartitionedDataSet`. Otherwise each piece is its own partition.
+  VTKM_CONT void SetMergeOutput(bool merge) { this->MergeOutput = merge; }
+  VTKM_CONT bool GetMergeOutput() const { return this->MergeOutput; }
+
+  /// Runs the chain on every piece and keeps the outputs.
+  VTKM_CONT vtkm::cont::PartitionedDataSet Execute(const vtkm::filter::PieceSource& source);
+
+  /// \brief Runs the chain on every piece and folds the outputs into a result.
+  ///
+  /// `reduce` is called as `result = reduce(result, pieceOutput)` in piece order, after
+  /// which the piece output is discarded.
+  template <typename ResultType, typename ReduceFunctor>
+  VTKM_CONT ResultType Reduce(const vtkm::filter::PieceSource& source,
+                              ResultType initialValue,
+                              ReduceFunctor&& reduce)
+  {
+    ResultType result = std::move(initialValue);
+    const vtkm::Id numberOfPieces = source.GetNumberOfPieces();
+    for (vtkm::Id pieceIndex = 0; pieceIndex < numberOfPieces; ++pieceIndex)
+    {
+      result = reduce(std::move(result), this->ExecutePiece(source, pieceIndex));
+    }
+    return result;
+  }
+
+  /// \brief Estimate of the memory held by the arrays of a data set.
+  ///
+  /// Only arrays stored in memory count; implicit arrays such as uniform point coordinates
+  /// are free. Components of a type other than the basic integer and floating point types
+  /// are assumed to take 8 bytes.
+  VTKM_CONT static vtkm::UInt64 EstimateMemoryUsage(const vtkm::cont::DataSet& dataSet);
+
+private:
+  VTKM_CONT vtkm::cont::DataSet ExecutePiece(const vtkm::filter::PieceSource& source,
+                                             vtkm::Id pieceIndex);
+
+  std::vector<std::shared_ptr<vtkm::filter::NewFilter>> Filters;
+  vtkm::UInt64 MemoryBudget = std::numeric_limits<vtkm::UInt64>::max();
+  bool MergeOutput = true;
+};
+
+} // namespace filter
+} // namespace vtkm
+
+#endif // vtk_m_filter_StreamingExecutor_h
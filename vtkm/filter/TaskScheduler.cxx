@@ -0,0 +1,325 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/TaskScheduler.h>
+
+#include <vtkm/cont/ErrorBadValue.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+
+namespace vtkm
+{
+namespace filter
+{
+
+namespace
+{
+
+thread_local bool RunningTask = false;
+
+// Sets `RunningTask` for the lifetime of the object and restores the previous value, which
+// is already true for a nested batch.
+struct RunningTaskScope
+{
+  bool Previous;
+  RunningTaskScope()
+    : Previous(RunningTask)
+  {
+    RunningTask = true;
+  }
+  ~RunningTaskScope() { RunningTask = this->Previous; }
+};
+
+// The state of one call to `TaskScheduler::Run`. It is shared between the calling thread and
+// the pool threads that join in, and it stays alive until the last of them is done with it.
+struct Batch
+{
+  struct WorkQueue
+  {
+    std::mutex Lock;
+    // Indices into `Tasks`, ordered from most to least expensive.
+    std::deque<std::size_t> Indices;
+  };
+
+  const std::vector<TaskScheduler::TaskType>& Tasks;
+  const std::vector<vtkm::Id>& Costs;
+  std::vector<WorkQueue> Queues;
+  std::atomic<std::size_t> NextQueue{ 0 };
+
+  std::mutex DoneLock;
+  std::condition_variable DoneCondition;
+  std::size_t NumberRemaining;
+  std::exception_ptr FirstError;
+
+  Batch(const std::vector<TaskScheduler::TaskType>& tasks,
+        const std::vector<vtkm::Id>& costs,
+        std::size_t numQueues)
+    : Tasks(tasks)
+    , Costs(costs)
+    , Queues(numQueues)
+    , NumberRemaining(tasks.size())
+  {
+    std::vector<std::size_t> order(tasks.size());
+    std::iota(order.begin(), order.end(), std::size_t{ 0 });
+    if (!costs.empty())
+    {
+      std::stable_sort(order.begin(), order.end(), [&costs](std::size_t a, std::size_t b) {
+        return costs[a] > costs[b];
+      });
+    }
+
+    // Deal the tasks out round-robin so that each queue starts with a similar amount of work
+    // and each queue is sorted from most to least expensive.
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+      this->Queues[i % numQueues].Indices.push_back(order[i]);
+    }
+  }
+
+  vtkm::Id GetCost(std::size_t taskIndex) const
+  {
+    return this->Costs.empty() ? 0 : this->Costs[taskIndex];
+  }
+
+  bool PopOwn(std::size_t queueIndex, std::size_t& taskIndex)
+  {
+    WorkQueue& queue = this->Queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.Lock);
+    if (queue.Indices.empty())
+    {
+      return false;
+    }
+    taskIndex = queue.Indices.front();
+    queue.Indices.pop_front();
+    return true;
+  }
+
+  // Takes the most expensive task waiting in any other queue. Because a long task started
+  // late determines when the batch finishes, it is better to steal big tasks than small ones.
+  bool Steal(std::size_t thiefIndex, std::size_t& taskIndex)
+  {
+    while (true)
+    {
+      std::size_t victim = this->Queues.size();
+      vtkm::Id victimCost = -1;
+      for (std::size_t queueIndex = 0; queueIndex < this->Queues.size(); ++queueIndex)
+      {
+        if (queueIndex == thiefIndex)
+        {
+          continue;
+        }
+        WorkQueue& queue = this->Queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.Lock);
+        if (!queue.Indices.empty() && (this->GetCost(queue.Indices.front()) > victimCost))
+        {
+          victim = queueIndex;
+          victimCost = this->GetCost(queue.Indices.front());
+        }
+      }
+      if (victim == this->Queues.size())
+      {
+        return false;
+      }
+      // The task might have been taken since it was found. If so, look again.
+      if (this->PopOwn(victim, taskIndex))
+      {
+        return true;
+      }
+    }
+  }
+
+  void RunTask(std::size_t taskIndex)
+  {
+    try
+    {
+      this->Tasks[taskIndex]();
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(this->DoneLock);
+      if (!this->FirstError)
+      {
+        this->FirstError = std::current_exception();
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(this->DoneLock);
+    --this->NumberRemaining;
+    if (this->NumberRemaining == 0)
+    {
+      this->DoneCondition.notify_all();
+    }
+  }
+
+  // Run by each thread that works on the batch. Each participant gets its own queue.
+  void Participate()
+  {
+    std::size_t queueIndex = this->NextQueue.fetch_add(1);
+    if (queueIndex >= this->Queues.size())
+    {
+      return;
+    }
+
+    RunningTaskScope scope;
+    std::size_t taskIndex;
+    while (this->PopOwn(queueIndex, taskIndex) || this->Steal(queueIndex, taskIndex))
+    {
+      this->RunTask(taskIndex);
+    }
+  }
+
+  void WaitUntilDone()
+  {
+    std::unique_lock<std::mutex> lock(this->DoneLock);
+    this->DoneCondition.wait(lock, [this]() { return this->NumberRemaining == 0; });
+  }
+};
+
+} // anonymous namespace
+
+namespace detail
+{
+
+struct TaskSchedulerInternals
+{
+  std::vector<std::thread> Threads;
+
+  std::mutex JobLock;
+  std::condition_variable JobCondition;
+  std::deque<std::shared_ptr<Batch>> Jobs;
+  bool Stopping = false;
+
+  void WorkerLoop()
+  {
+    while (true)
+    {
+      std::shared_ptr<Batch> job;
+      {
+        std::unique_lock<std::mutex> lock(this->JobLock);
+        this->JobCondition.wait(lock, [this]() { return this->Stopping || !this->Jobs.empty(); });
+        if (this->Jobs.empty())
+        {
+          return;
+        }
+        job = std::move(this->Jobs.front());
+        this->Jobs.pop_front();
+      }
+      job->Participate();
+    }
+  }
+};
+
+} // namespace detail
+
+TaskScheduler::TaskScheduler()
+  : Internals(new detail::TaskSchedulerInternals)
+{
+  // The thread calling `Run` also does work, so one fewer thread than cores is needed.
+  unsigned int numThreads = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+  this->Internals->Threads.reserve(numThreads);
+  for (unsigned int i = 0; i < numThreads; ++i)
+  {
+    this->Internals->Threads.emplace_back(&detail::TaskSchedulerInternals::WorkerLoop,
+                                          this->Internals.get());
+  }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->JobLock);
+    this->Internals->Stopping = true;
+  }
+  this->Internals->JobCondition.notify_all();
+  for (auto& thread : this->Internals->Threads)
+  {
+    thread.join();
+  }
+}
+
+void TaskScheduler::Run(const std::vector<TaskType>& tasks,
+                        const std::vector<vtkm::Id>& costs,
+                        vtkm::Id maxConcurrency)
+{
+  if (!costs.empty() && (costs.size() != tasks.size()))
+  {
+    throw vtkm::cont::ErrorBadValue("TaskScheduler given " + std::to_string(costs.size()) +
+                                    " costs for " + std::to_string(tasks.size()) + " tasks.");
+  }
+  if (tasks.empty())
+  {
+    return;
+  }
+
+  std::size_t numParticipants = static_cast<std::size_t>(
+    std::max<vtkm::Id>(std::min(maxConcurrency, this->GetMaximumConcurrency()), 1));
+  numParticipants = std::min(numParticipants, tasks.size());
+
+  auto batch = std::make_shared<Batch>(tasks, costs, numParticipants);
+  if (numParticipants > 1)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Internals->JobLock);
+      for (std::size_t i = 1; i < numParticipants; ++i)
+      {
+        this->Internals->Jobs.push_back(batch);
+      }
+    }
+    this->Internals->JobCondition.notify_all();
+  }
+
+  // Pool threads may all be busy (for example, running the tasks that called this nested
+  // `Run`). The calling thread can steal all the work, so waiting on the tasks rather than on
+  // the pool threads cannot deadlock.
+  batch->Participate();
+  batch->WaitUntilDone();
+
+  // Jobs that no pool thread picked up are no longer needed. Remove them so that idle threads
+  // do not wake up for them.
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->JobLock);
+    auto& jobs = this->Internals->Jobs;
+    jobs.erase(std::remove(jobs.begin(), jobs.end(), batch), jobs.end());
+  }
+
+  if (batch->FirstError)
+  {
+    std::rethrow_exception(batch->FirstError);
+  }
+}
+
+vtkm::Id TaskScheduler::GetMaximumConcurrency() const
+{
+  return static_cast<vtkm::Id>(this->Internals->Threads.size()) + 1;
+}
+
+bool TaskScheduler::InTask()
+{
+  return RunningTask;
+}
+
+vtkm::filter::TaskScheduler& GetTaskScheduler()
+{
+  // The scheduler is intentionally never destroyed. Joining threads during static
+  // destruction can hang on some platforms.
+  static vtkm::filter::TaskScheduler* scheduler = new vtkm::filter::TaskScheduler;
+  return *scheduler;
+}
+
+}
+} // namespace vtkm::filter
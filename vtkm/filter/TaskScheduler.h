@@ -0,0 +1,84 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_filter_TaskScheduler_h
+#define vtk_m_filter_TaskScheduler_h
+
+#include <vtkm/Types.h>
+#include <vtkm/filter/vtkm_filter_core_export.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace vtkm
+{
+namespace filter
+{
+
+namespace detail
+{
+struct TaskSchedulerInternals;
+}
+
+/// \brief A persistent pool of threads that runs batches of tasks with work stealing.
+///
+/// `TaskScheduler` is used by `NewFilter` to execute the partitions of a `PartitionedDataSet`
+/// concurrently. The threads are created once and reused across filter invocations, so
+/// running a filter on a `PartitionedDataSet` does not pay for spawning threads.
+///
+/// Each batch of tasks is given an estimated cost per task. The tasks are sorted so that the
+/// most expensive run first and are dealt out to a queue for each participating thread. A
+/// thread that runs out of work steals the most expensive remaining task from another
+/// thread's queue. This keeps all threads busy when the costs of the tasks are very uneven.
+///
+/// The thread that calls `Run` participates in executing the batch. Thus, a task may itself
+/// call `Run` (for example, a filter that runs another filter on a `PartitionedDataSet`)
+/// without risk of deadlock. Use `InTask` to detect this nesting.
+///
+class VTKM_FILTER_CORE_EXPORT TaskScheduler
+{
+public:
+  using TaskType = std::function<void()>;
+
+  VTKM_CONT TaskScheduler();
+  VTKM_CONT ~TaskScheduler();
+
+  TaskScheduler(const TaskScheduler&) = delete;
+  TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+  /// \brief Runs all of the given tasks and returns once they have all completed.
+  ///
+  /// `costs` must either be empty or have an estimated cost for each task. At most
+  /// `maxConcurrency` threads (including the calling thread) work on the batch. If a task
+  /// throws an exception, the remaining tasks are still run, and the first exception is
+  /// rethrown from `Run`.
+  ///
+  VTKM_CONT void Run(const std::vector<TaskType>& tasks,
+                     const std::vector<vtkm::Id>& costs,
+                     vtkm::Id maxConcurrency);
+
+  /// \brief The number of threads that can run tasks, including the calling thread.
+  VTKM_CONT vtkm::Id GetMaximumConcurrency() const;
+
+  /// \brief Returns true if the current thread is running a task from a `TaskScheduler`.
+  VTKM_CONT static bool InTask();
+
+private:
+  std::unique_ptr<detail::TaskSchedulerInternals> Internals;
+};
+
+/// \brief Returns the `TaskScheduler` shared by all filters.
+///
+VTKM_FILTER_CORE_EXPORT VTKM_CONT vtkm::filter::TaskScheduler& GetTaskScheduler();
+
+}
+} // namespace vtkm::filter
+
+#endif //vtk_m_filter_TaskScheduler_h
@@ -0,0 +1,168 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#include <vtkm/cont/ArrayCopyDevice.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetPermutation.h>
+#include <vtkm/filter/MapFieldPermutation.h>
+#include <vtkm/filter/clean_grid/ReorderForLocality.h>
+#include <vtkm/filter/clean_grid/worklet/SpaceFillingCurve.h>
+#include <vtkm/worklet/CellDeepCopy.h>
+#include <vtkm/worklet/StableSortIndices.h>
+
+namespace
+{
+
+struct InvertPermutation : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn newToOld, WholeArrayOut oldToNew);
+  using ExecutionSignature = void(_1, _2, WorkIndex);
+
+  template <typename PortalType>
+  VTKM_EXEC void operator()(vtkm::Id oldIndex, const PortalType& oldToNew, vtkm::Id newIndex) const
+  {
+    oldToNew.Set(oldIndex, newIndex);
+  }
+};
+
+// The new order of the points and of the cells. Elements that are not reordered keep their
+// order, and their fields are passed through unchanged.
+struct Orders
+{
+  bool ReorderPoints = false;
+  bool ReorderCells = false;
+  vtkm::cont::ArrayHandle<vtkm::Id> NewToOldPoints;
+  vtkm::cont::ArrayHandle<vtkm::Id> NewToOldCells;
+};
+
+bool DoMapField(vtkm::cont::DataSet& result, const vtkm::cont::Field& field, const Orders& orders)
+{
+  if (field.IsFieldPoint() && orders.ReorderPoints)
+  {
+    return vtkm::filter::MapFieldPermutation(field, orders.NewToOldPoints, result);
+  }
+  else if (field.IsFieldCell() && orders.ReorderCells)
+  {
+    return vtkm::filter::MapFieldPermutation(field, orders.NewToOldCells, result);
+  }
+  else
+  {
+    result.AddField(field);
+    return true;
+  }
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace filter
+{
+namespace clean_grid
+{
+
+vtkm::cont::DataSet ReorderForLocality::DoExecute(const vtkm::cont::DataSet& inData)
+{
+  using CellSetType = vtkm::cont::CellSetExplicit<>;
+  using SpaceFillingCurve = vtkm::worklet::SpaceFillingCurve;
+
+  const vtkm::cont::UnknownCellSet& inCellSet = inData.GetCellSet();
+  CellSetType cells;
+  if (inCellSet.IsType<CellSetType>())
+  {
+    cells = inCellSet.AsCellSet<CellSetType>();
+  }
+  else
+  {
+    cells = vtkm::worklet::CellDeepCopy::Run(inCellSet);
+  }
+  const vtkm::Id numberOfPoints = cells.GetNumberOfPoints();
+
+  const vtkm::cont::CoordinateSystem& coords =
+    inData.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
+  const SpaceFillingCurve::Quantizer quantizer(coords.GetBounds());
+  const bool hilbert = (this->CurveType == Curve::Hilbert);
+
+  // Sorting the indices stably makes the order the same on every device even when several
+  // elements fall in the same position of the curve.
+  Orders orders;
+  orders.ReorderPoints = this->ReorderPoints;
+  orders.ReorderCells = this->ReorderCells;
+  if (this->ReorderPoints)
+  {
+    vtkm::cont::ArrayHandle<vtkm::UInt64> curveIndices;
+    this->Invoke(SpaceFillingCurve::PointIndex{ quantizer, hilbert },
+                 coords.GetDataAsMultiplexer(),
+                 curveIndices);
+    orders.NewToOldPoints = vtkm::worklet::StableSortIndices::Sort(curveIndices);
+  }
+
+  if (this->ReorderCells)
+  {
+    vtkm::cont::ArrayHandle<vtkm::UInt64> curveIndices;
+    this->Invoke(SpaceFillingCurve::CellIndex{ quantizer, hilbert },
+                 cells,
+                 coords.GetDataAsMultiplexer(),
+                 curveIndices);
+    orders.NewToOldCells = vtkm::worklet::StableSortIndices::Sort(curveIndices);
+
+    CellSetType reorderedCells;
+    vtkm::worklet::CellDeepCopy::Run(
+      vtkm::cont::CellSetPermutation<CellSetType>(orders.NewToOldCells, cells), reorderedCells);
+    cells = reorderedCells;
+  }
+
+  if (this->ReorderPoints)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> oldToNewPoints;
+    oldToNewPoints.Allocate(numberOfPoints);
+    this->Invoke(InvertPermutation{}, orders.NewToOldPoints, oldToNewPoints);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+    vtkm::cont::ArrayCopyDevice(
+      vtkm::cont::make_ArrayHandlePermutation(
+        cells.GetConnectivityArray(vtkm::TopologyElementTagCell{},
+                                   vtkm::TopologyElementTagPoint{}),
+        oldToNewPoints),
+      connectivity);
+
+    CellSetType renumberedCells;
+    renumberedCells.Fill(
+      numberOfPoints,
+      cells.GetShapesArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{}),
+      connectivity,
+      cells.GetOffsetsArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{}));
+    cells = renumberedCells;
+  }
+
+  std::vector<vtkm::cont::CoordinateSystem> outputCoordinateSystems;
+  for (vtkm::IdComponent coordSystemIndex = 0;
+       coordSystemIndex < inData.GetNumberOfCoordinateSystems();
+       ++coordSystemIndex)
+  {
+    const vtkm::cont::CoordinateSystem& inCoords = inData.GetCoordinateSystem(coordSystemIndex);
+    vtkm::cont::Field outCoords;
+    if (!this->ReorderPoints)
+    {
+      outputCoordinateSystems.push_back(inCoords);
+    }
+    else if (vtkm::filter::MapFieldPermutation(inCoords, orders.NewToOldPoints, outCoords))
+    {
+      outputCoordinateSystems.emplace_back(outCoords.GetName(), outCoords.GetData());
+    }
+  }
+
+  auto mapper = [&](auto& outDataSet, const auto& f) { DoMapField(outDataSet, f, orders); };
+  return this->CreateResult(inData, cells, outputCoordinateSystems, mapper);
+}
+
+} // namespace clean_grid
+} // namespace filter
+} // namespace vtkm
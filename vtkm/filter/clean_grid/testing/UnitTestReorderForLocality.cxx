@@ -0,0 +1,241 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/clean_grid/ReorderForLocality.h>
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/filter/clean_grid/CleanGrid.h>
+#include <vtkm/filter/clean_grid/worklet/SpaceFillingCurve.h>
+#include <vtkm/filter/contour/Contour.h>
+#include <vtkm/source/Tangle.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+using ReorderForLocality = vtkm::filter::clean_grid::ReorderForLocality;
+
+void TestCurves()
+{
+  std::cout << "Testing space filling curve indices" << std::endl;
+  using SpaceFillingCurve = vtkm::worklet::SpaceFillingCurve;
+
+  VTKM_TEST_ASSERT(SpaceFillingCurve::MortonIndex({ 1, 0, 0 }) == 4);
+  VTKM_TEST_ASSERT(SpaceFillingCurve::MortonIndex({ 0, 1, 0 }) == 2);
+  VTKM_TEST_ASSERT(SpaceFillingCurve::MortonIndex({ 0, 0, 1 }) == 1);
+  VTKM_TEST_ASSERT(SpaceFillingCurve::MortonIndex({ 0x1fffff, 0x1fffff, 0x1fffff }) ==
+                   0x7fffffffffffffffULL);
+
+  // Consecutive positions of the Hilbert curve are neighbors in the grid.
+  constexpr vtkm::UInt32 size = 8;
+  std::vector<std::pair<vtkm::UInt64, vtkm::Vec<vtkm::UInt32, 3>>> positions;
+  for (vtkm::UInt32 k = 0; k < size; ++k)
+  {
+    for (vtkm::UInt32 j = 0; j < size; ++j)
+    {
+      for (vtkm::UInt32 i = 0; i < size; ++i)
+      {
+        // Use the coarsest cells of the curve, which is where it is the most folded.
+        const vtkm::UInt32 shift = SpaceFillingCurve::BitsPerAxis - 3;
+        const vtkm::Vec<vtkm::UInt32, 3> position(i << shift, j << shift, k << shift);
+        positions.emplace_back(SpaceFillingCurve::HilbertIndex(position),
+                               vtkm::Vec<vtkm::UInt32, 3>(i, j, k));
+      }
+    }
+  }
+  std::sort(positions.begin(),
+            positions.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  for (std::size_t n = 1; n < positions.size(); ++n)
+  {
+    VTKM_TEST_ASSERT(positions[n - 1].first != positions[n].first, "Repeated Hilbert index");
+    vtkm::UInt32 distance = 0;
+    for (vtkm::IdComponent c = 0; c < 3; ++c)
+    {
+      const vtkm::UInt32 a = positions[n - 1].second[c];
+      const vtkm::UInt32 b = positions[n].second[c];
+      distance += (a > b) ? (a - b) : (b - a);
+    }
+    VTKM_TEST_ASSERT(distance == 1,
+                     "Hilbert curve jumps from ",
+                     positions[n - 1].second,
+                     " to ",
+                     positions[n].second);
+  }
+}
+
+vtkm::cont::DataSet MakeInput()
+{
+  vtkm::cont::DataSet tangle = vtkm::source::Tangle(vtkm::Id3(12, 10, 8)).Execute();
+  vtkm::filter::clean_grid::CleanGrid clean;
+  vtkm::cont::DataSet input = clean.Execute(tangle);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> pointIds;
+  vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(input.GetNumberOfPoints()), pointIds);
+  input.AddPointField("pointIds", pointIds);
+  vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+  vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(input.GetNumberOfCells()), cellIds);
+  input.AddCellField("cellIds", cellIds);
+  return input;
+}
+
+void CheckIsPermutation(const vtkm::cont::ArrayHandle<vtkm::Id>& ids)
+{
+  std::vector<bool> found(static_cast<std::size_t>(ids.GetNumberOfValues()), false);
+  auto portal = ids.ReadPortal();
+  for (vtkm::Id i = 0; i < portal.GetNumberOfValues(); ++i)
+  {
+    const vtkm::Id id = portal.Get(i);
+    VTKM_TEST_ASSERT((id >= 0) && (id < portal.GetNumberOfValues()), "Bad id ", id);
+    VTKM_TEST_ASSERT(!found[static_cast<std::size_t>(id)], "Repeated id ", id);
+    found[static_cast<std::size_t>(id)] = true;
+  }
+}
+
+void CheckReordered(const vtkm::cont::DataSet& input, const vtkm::cont::DataSet& output)
+{
+  VTKM_TEST_ASSERT(output.GetNumberOfPoints() == input.GetNumberOfPoints());
+  VTKM_TEST_ASSERT(output.GetNumberOfCells() == input.GetNumberOfCells());
+
+  vtkm::cont::ArrayHandle<vtkm::Id> pointIds;
+  output.GetPointField("pointIds").GetData().AsArrayHandle(pointIds);
+  vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+  output.GetCellField("cellIds").GetData().AsArrayHandle(cellIds);
+  CheckIsPermutation(pointIds);
+  CheckIsPermutation(cellIds);
+
+  // Every field follows the points.
+  auto pointIdsPortal = pointIds.ReadPortal();
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> inCoords;
+  vtkm::cont::ArrayCopy(input.GetCoordinateSystem().GetData(), inCoords);
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> outCoords;
+  vtkm::cont::ArrayCopy(output.GetCoordinateSystem().GetData(), outCoords);
+  vtkm::cont::ArrayHandle<vtkm::Float32> inValues;
+  input.GetPointField("tangle").GetData().AsArrayHandle(inValues);
+  vtkm::cont::ArrayHandle<vtkm::Float32> outValues;
+  output.GetPointField("tangle").GetData().AsArrayHandle(outValues);
+  for (vtkm::Id i = 0; i < output.GetNumberOfPoints(); ++i)
+  {
+    const vtkm::Id oldId = pointIdsPortal.Get(i);
+    VTKM_TEST_ASSERT(test_equal(outCoords.ReadPortal().Get(i), inCoords.ReadPortal().Get(oldId)));
+    VTKM_TEST_ASSERT(test_equal(outValues.ReadPortal().Get(i), inValues.ReadPortal().Get(oldId)));
+  }
+
+  // Every cell connects the same points as before.
+  vtkm::cont::CellSetExplicit<> inCells;
+  input.GetCellSet().AsCellSet(inCells);
+  vtkm::cont::CellSetExplicit<> outCells;
+  output.GetCellSet().AsCellSet(outCells);
+  auto cellIdsPortal = cellIds.ReadPortal();
+  for (vtkm::Id c = 0; c < output.GetNumberOfCells(); ++c)
+  {
+    const vtkm::Id oldCell = cellIdsPortal.Get(c);
+    VTKM_TEST_ASSERT(outCells.GetCellShape(c) == inCells.GetCellShape(oldCell));
+    vtkm::Vec<vtkm::Id, 8> inPoints;
+    inCells.GetIndices(oldCell, inPoints);
+    vtkm::Vec<vtkm::Id, 8> outPoints;
+    outCells.GetIndices(c, outPoints);
+    for (vtkm::IdComponent p = 0; p < outCells.GetNumberOfPointsInCell(c); ++p)
+    {
+      VTKM_TEST_ASSERT(pointIdsPortal.Get(outPoints[p]) == inPoints[p], "Bad connectivity");
+    }
+  }
+}
+
+void TestReorder(ReorderForLocality::Curve curve)
+{
+  std::cout << "Testing reordering along the "
+            << ((curve == ReorderForLocality::Curve::Hilbert) ? "Hilbert" : "Morton") << " curve"
+            << std::endl;
+  vtkm::cont::DataSet input = MakeInput();
+
+  ReorderForLocality reorder;
+  reorder.SetCurve(curve);
+  vtkm::cont::DataSet output = reorder.Execute(input);
+  CheckReordered(input, output);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> pointIds;
+  output.GetPointField("pointIds").GetData().AsArrayHandle(pointIds);
+  VTKM_TEST_ASSERT(!test_equal_ArrayHandles(pointIds, input.GetPointField("pointIds").GetData()),
+                   "Points were not reordered");
+
+  // Algorithms on the reordered mesh give the same results.
+  vtkm::filter::contour::Contour contour;
+  contour.SetActiveField("tangle");
+  contour.SetIsoValue(1.0);
+  VTKM_TEST_ASSERT(contour.Execute(output).GetNumberOfCells() ==
+                   contour.Execute(input).GetNumberOfCells());
+}
+
+void TestReorderOnlyCells()
+{
+  std::cout << "Testing reordering only the cells of a structured grid" << std::endl;
+  vtkm::cont::DataSet input = vtkm::source::Tangle(vtkm::Id3(6, 5, 4)).Execute();
+  vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+  vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(input.GetNumberOfCells()), cellIds);
+  input.AddCellField("cellIds", cellIds);
+
+  ReorderForLocality reorder;
+  reorder.SetReorderPoints(false);
+  vtkm::cont::DataSet output = reorder.Execute(input);
+  VTKM_TEST_ASSERT(output.GetCellSet().IsType<vtkm::cont::CellSetExplicit<>>());
+  VTKM_TEST_ASSERT(output.GetNumberOfCells() == input.GetNumberOfCells());
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(output.GetCoordinateSystem().GetData(),
+                                           input.GetCoordinateSystem().GetData()));
+  vtkm::cont::ArrayHandle<vtkm::Id> outCellIds;
+  output.GetCellField("cellIds").GetData().AsArrayHandle(outCellIds);
+  CheckIsPermutation(outCellIds);
+  VTKM_TEST_ASSERT(!test_equal_ArrayHandles(outCellIds, cellIds), "Cells were not reordered");
+
+  // The points keep their order, so their arrays are passed through without a copy.
+  vtkm::cont::ArrayHandle<vtkm::Float32> inValues;
+  input.GetPointField("tangle").GetData().AsArrayHandle(inValues);
+  vtkm::cont::ArrayHandle<vtkm::Float32> outValues;
+  output.GetPointField("tangle").GetData().AsArrayHandle(outValues);
+  VTKM_TEST_ASSERT(outValues == inValues, "Point field was copied");
+}
+
+void TestReorderOnlyPoints()
+{
+  std::cout << "Testing reordering only the points" << std::endl;
+  vtkm::cont::DataSet input = MakeInput();
+
+  ReorderForLocality reorder;
+  reorder.SetReorderCells(false);
+  vtkm::cont::DataSet output = reorder.Execute(input);
+  CheckReordered(input, output);
+
+  // The cells keep their order, so their arrays are passed through without a copy.
+  vtkm::cont::ArrayHandle<vtkm::Id> inCellIds;
+  input.GetCellField("cellIds").GetData().AsArrayHandle(inCellIds);
+  vtkm::cont::ArrayHandle<vtkm::Id> outCellIds;
+  output.GetCellField("cellIds").GetData().AsArrayHandle(outCellIds);
+  VTKM_TEST_ASSERT(outCellIds == inCellIds, "Cell field was copied");
+}
+
+void TestReorderForLocality()
+{
+  TestCurves();
+  TestReorder(ReorderForLocality::Curve::Hilbert);
+  TestReorder(ReorderForLocality::Curve::Morton);
+  TestReorderOnlyCells();
+  TestReorderOnlyPoints();
+}
+
+} // anonymous namespace
+
+int UnitTestReorderForLocality(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestReorderForLocality, argc, argv);
+}
@@ -0,0 +1,197 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_worklet_SpaceFillingCurve_h
+#define vtk_m_worklet_SpaceFillingCurve_h
+
+#include <vtkm/Bounds.h>
+#include <vtkm/Math.h>
+#include <vtkm/VecTraits.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/worklet/WorkletMapTopology.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+
+/// Worklets that compute the index of points and cells along a space filling curve. Sorting
+/// the points or cells by these indices puts elements that are close in space close in
+/// memory.
+///
+struct SpaceFillingCurve
+{
+  /// Number of bits per axis of the curve indices. Three axes fit in 63 bits.
+  static constexpr vtkm::UInt32 BitsPerAxis = 21;
+
+  /// Spreads the low 21 bits of `x` so that there are 2 zero bits between each of them.
+  VTKM_EXEC_CONT static vtkm::UInt64 ExpandBits(vtkm::UInt32 x)
+  {
+    vtkm::UInt64 bits = x & 0x1fffff;
+    bits = (bits | bits << 32) & 0x1f00000000ffffULL;
+    bits = (bits | bits << 16) & 0x1f0000ff0000ffULL;
+    bits = (bits | bits << 8) & 0x100f00f00f00f00fULL;
+    bits = (bits | bits << 4) & 0x10c30c30c30c30c3ULL;
+    bits = (bits | bits << 2) & 0x1249249249249249ULL;
+    return bits;
+  }
+
+  /// Index of a grid position along the Morton (Z-order) curve.
+  VTKM_EXEC_CONT static vtkm::UInt64 MortonIndex(const vtkm::Vec<vtkm::UInt32, 3>& position)
+  {
+    return (ExpandBits(position[0]) << 2) | (ExpandBits(position[1]) << 1) |
+      ExpandBits(position[2]);
+  }
+
+  /// \brief Index of a grid position along the Hilbert curve.
+  ///
+  /// Converts the position to the "transpose" form of the Hilbert index with the algorithm of
+  /// J. Skilling, Programming the Hilbert curve, AIP Conference Proceedings 707, 2004, and
+  /// interleaves its bits. Unlike the Morton curve, consecutive Hilbert indices are always
+  /// neighbors in the grid.
+  VTKM_EXEC_CONT static vtkm::UInt64 HilbertIndex(vtkm::Vec<vtkm::UInt32, 3> x)
+  {
+    constexpr vtkm::UInt32 highBit = 1u << (BitsPerAxis - 1);
+    for (vtkm::UInt32 q = highBit; q > 1; q >>= 1)
+    {
+      const vtkm::UInt32 p = q - 1;
+      for (vtkm::IdComponent i = 0; i < 3; ++i)
+      {
+        if (x[i] & q)
+        {
+          x[0] ^= p;
+        }
+        else
+        {
+          const vtkm::UInt32 t = (x[0] ^ x[i]) & p;
+          x[0] ^= t;
+          x[i] ^= t;
+        }
+      }
+    }
+
+    x[1] ^= x[0];
+    x[2] ^= x[1];
+    vtkm::UInt32 t = 0;
+    for (vtkm::UInt32 q = highBit; q > 1; q >>= 1)
+    {
+      if (x[2] & q)
+      {
+        t ^= q - 1;
+      }
+    }
+    x[0] ^= t;
+    x[1] ^= t;
+    x[2] ^= t;
+    return MortonIndex(x);
+  }
+
+  /// Maps points inside bounds to the grid of the curve.
+  class Quantizer
+  {
+  public:
+    Quantizer() = default;
+
+    VTKM_CONT explicit Quantizer(const vtkm::Bounds& bounds)
+      : Origin(bounds.X.Min, bounds.Y.Min, bounds.Z.Min)
+    {
+      const vtkm::Vec3f_64 lengths(bounds.X.Length(), bounds.Y.Length(), bounds.Z.Length());
+      constexpr vtkm::Float64 maxPosition = static_cast<vtkm::Float64>((1u << BitsPerAxis) - 1);
+      for (vtkm::IdComponent i = 0; i < 3; ++i)
+      {
+        this->Scale[i] = (lengths[i] > 0) ? maxPosition / lengths[i] : 0;
+      }
+    }
+
+    template <typename PointType>
+    VTKM_EXEC_CONT vtkm::Vec<vtkm::UInt32, 3> operator()(const PointType& point) const
+    {
+      constexpr vtkm::Float64 maxPosition = static_cast<vtkm::Float64>((1u << BitsPerAxis) - 1);
+      vtkm::Vec<vtkm::UInt32, 3> position;
+      for (vtkm::IdComponent i = 0; i < 3; ++i)
+      {
+        const vtkm::Float64 scaled =
+          (static_cast<vtkm::Float64>(point[i]) - this->Origin[i]) * this->Scale[i];
+        position[i] = static_cast<vtkm::UInt32>(vtkm::Max(0.0, vtkm::Min(maxPosition, scaled)));
+      }
+      return position;
+    }
+
+  private:
+    vtkm::Vec3f_64 Origin;
+    vtkm::Vec3f_64 Scale;
+  };
+
+  /// Computes the curve index of every point.
+  class PointIndex : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn points, FieldOut curveIndex);
+    using ExecutionSignature = void(_1, _2);
+
+    PointIndex(const Quantizer& quantizer, bool hilbert)
+      : Quantize(quantizer)
+      , Hilbert(hilbert)
+    {
+    }
+
+    template <typename PointType>
+    VTKM_EXEC void operator()(const PointType& point, vtkm::UInt64& curveIndex) const
+    {
+      const vtkm::Vec<vtkm::UInt32, 3> position = this->Quantize(point);
+      curveIndex = this->Hilbert ? HilbertIndex(position) : MortonIndex(position);
+    }
+
+  private:
+    Quantizer Quantize;
+    bool Hilbert;
+  };
+
+  /// Computes the curve index of the centroid of the points of every cell.
+  class CellIndex : public vtkm::worklet::WorkletVisitCellsWithPoints
+  {
+  public:
+    using ControlSignature = void(CellSetIn cellSet, FieldInPoint points, FieldOutCell curveIndex);
+    using ExecutionSignature = void(PointCount, _2, _3);
+
+    CellIndex(const Quantizer& quantizer, bool hilbert)
+      : Quantize(quantizer)
+      , Hilbert(hilbert)
+    {
+    }
+
+    template <typename PointVecType>
+    VTKM_EXEC void operator()(vtkm::IdComponent numPoints,
+                              const PointVecType& points,
+                              vtkm::UInt64& curveIndex) const
+    {
+      vtkm::Vec3f_64 centroid(0);
+      for (vtkm::IdComponent i = 0; i < numPoints; ++i)
+      {
+        centroid = centroid + vtkm::Vec3f_64(points[i]);
+      }
+      if (numPoints > 0)
+      {
+        centroid = centroid / static_cast<vtkm::Float64>(numPoints);
+      }
+      const vtkm::Vec<vtkm::UInt32, 3> position = this->Quantize(centroid);
+      curveIndex = this->Hilbert ? HilbertIndex(position) : MortonIndex(position);
+    }
+
+  private:
+    Quantizer Quantize;
+    bool Hilbert;
+  };
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_SpaceFillingCurve_h
@@ -10,6 +10,7 @@
 
 #include <vtkm/cont/CoordinateSystem.h>
 #include <vtkm/cont/ErrorFilterExecution.h>
+#include <vtkm/cont/Logging.h>
 
 #include <vtkm/filter/MapFieldPermutation.h>
 #include <vtkm/filter/contour/ClipWithField.h>
@@ -75,8 +76,27 @@ bool DoMapField(vtkm::cont::DataSet& result,
 } // anonymous
 
 //-----------------------------------------------------------------------------
-vtkm::cont::DataSet ClipWithField::DoExecute(const vtkm::cont::DataSet& input)
+vtkm::cont::DataSet ClipWithField::DoExecute(const vtkm::cont::DataSet& inDataSet)
 {
+  vtkm::cont::DataSet input = inDataSet;
+  if (this->CellIndex)
+  {
+    if (this->CellIndex->IsValidFor(inDataSet, this->GetActiveFieldName()))
+    {
+      // Cells with all their values on the clipped side of the value produce no output.
+      const vtkm::Range kept = this->Invert
+        ? vtkm::Range(vtkm::NegativeInfinity64(), this->ClipValue)
+        : vtkm::Range(this->ClipValue, vtkm::Infinity64());
+      input = this->CellIndex->ExtractCandidates(inDataSet, { kept });
+    }
+    else
+    {
+      VTKM_LOG_S(vtkm::cont::LogLevel::Info,
+                 "ClipWithField: active cell index not valid for field "
+                   << this->GetActiveFieldName());
+    }
+  }
+
   const auto& field = this->GetFieldFromDataSet(input);
   if (!field.IsFieldPoint())
   {
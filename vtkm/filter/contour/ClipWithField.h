@@ -11,9 +11,12 @@
 #ifndef vtk_m_filter_contour_ClipWithField_h
 #define vtk_m_filter_contour_ClipWithField_h
 
+#include <vtkm/filter/ActiveCellIndex.h>
 #include <vtkm/filter/NewFilterField.h>
 #include <vtkm/filter/contour/vtkm_filter_contour_export.h>
 
+#include <memory>
+
 namespace vtkm
 {
 namespace filter
@@ -38,11 +41,25 @@ public:
   VTKM_CONT
   vtkm::Float64 GetClipValue() const { return this->ClipValue; }
 
+  /// Set/Get an index of the cells of the input. When the index is valid for the active
+  /// field, only the cells that may keep some of their volume are processed.
+  VTKM_CONT
+  void SetActiveCellIndex(const std::shared_ptr<vtkm::filter::ActiveCellIndex>& index)
+  {
+    this->CellIndex = index;
+  }
+  VTKM_CONT
+  const std::shared_ptr<vtkm::filter::ActiveCellIndex>& GetActiveCellIndex() const
+  {
+    return this->CellIndex;
+  }
+
 private:
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
   vtkm::Float64 ClipValue = 0;
   bool Invert = false;
+  std::shared_ptr<vtkm::filter::ActiveCellIndex> CellIndex;
 };
 } // namespace contour
 class VTKM_DEPRECATED(1.8, "Use vtkm::filter::contour::ClipWithField.") ClipWithField
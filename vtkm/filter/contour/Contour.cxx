@@ -11,6 +11,7 @@
 #include <vtkm/cont/CellSetSingleType.h>
 #include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/ErrorFilterExecution.h>
+#include <vtkm/cont/Logging.h>
 #include <vtkm/cont/UnknownCellSet.h>
 
 #include <vtkm/filter/MapFieldPermutation.h>
@@ -87,11 +88,68 @@ bool Contour::GetMergeDuplicatePoints() const
   return MergeDuplicatedPoints;
 }
 
+//-----------------------------------------------------------------------------
+bool Contour::UseHighQualityNormals(const vtkm::cont::UnknownCellSet& cells) const
+{
+  return this->GenerateNormals &&
+    (IsCellSetStructured(cells) ? !this->ComputeFastNormalsForStructured
+                                : !this->ComputeFastNormalsForUnstructured);
+}
+
+//-----------------------------------------------------------------------------
+bool Contour::UseActiveCellIndex(const vtkm::cont::UnknownCellSet& cells,
+                                 bool generateHighQualityNormals) const
+{
+  if (!this->CellIndex)
+  {
+    return false;
+  }
+  if (generateHighQualityNormals)
+  {
+    VTKM_LOG_S(vtkm::cont::LogLevel::Info,
+               "Contour: active cell index not used to compute normals from gradients.");
+    return false;
+  }
+  if (IsCellSetStructured(cells))
+  {
+    // The candidate cells are explicit, which would lose flying edges and change the output.
+    VTKM_LOG_S(vtkm::cont::LogLevel::Info,
+               "Contour: active cell index not used for structured cells.");
+    return false;
+  }
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 vtkm::cont::DataSet Contour::DoExecute(const vtkm::cont::DataSet& inDataSet)
+{
+  const bool generateHighQualityNormals = this->UseHighQualityNormals(inDataSet.GetCellSet());
+  if (this->UseActiveCellIndex(inDataSet.GetCellSet(), generateHighQualityNormals))
+  {
+    if (this->CellIndex->IsValidFor(inDataSet, this->GetActiveFieldName()))
+    {
+      std::vector<vtkm::Range> ranges;
+      for (vtkm::Float64 isoValue : this->IsoValues)
+      {
+        ranges.emplace_back(isoValue, isoValue);
+      }
+      return this->ComputeContour(this->CellIndex->ExtractCandidates(inDataSet, ranges), false);
+    }
+    else
+    {
+      VTKM_LOG_S(vtkm::cont::LogLevel::Info,
+                 "Contour: active cell index not valid for field " << this->GetActiveFieldName());
+    }
+  }
+  return this->ComputeContour(inDataSet, generateHighQualityNormals);
+}
+
+vtkm::cont::DataSet Contour::ComputeContour(const vtkm::cont::DataSet& inDataSet,
+                                            bool generateHighQualityNormals)
 {
   vtkm::worklet::Contour worklet;
   worklet.SetMergeDuplicatePoints(this->GetMergeDuplicatePoints());
+  worklet.SetMergeWithHash(this->MergeWithHash);
 
   if (!this->GetFieldFromDataSet(inDataSet).IsFieldPoint())
   {
@@ -114,10 +172,6 @@ vtkm::cont::DataSet Contour::DoExecute(const vtkm::cont::DataSet& inDataSet)
 
   vtkm::cont::CellSetSingleType<> outputCells;
 
-  bool generateHighQualityNormals = IsCellSetStructured(inputCells)
-    ? !this->ComputeFastNormalsForStructured
-    : !this->ComputeFastNormalsForUnstructured;
-
   auto resolveFieldType = [&](const auto& concrete) {
     // use std::decay to remove const ref from the decltype of concrete.
     using T = typename std::decay_t<decltype(concrete)>::ValueType;
@@ -127,7 +181,7 @@ vtkm::cont::DataSet Contour::DoExecute(const vtkm::cont::DataSet& inDataSet)
       ivalues[i] = static_cast<T>(this->IsoValues[i]);
     }
 
-    if (this->GenerateNormals && generateHighQualityNormals)
+    if (generateHighQualityNormals)
     {
       outputCells =
         worklet.Run(ivalues, inputCells, inputCoords.GetData(), concrete, vertices, normals);
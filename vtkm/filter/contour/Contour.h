@@ -11,9 +11,12 @@
 #ifndef vtk_m_filter_contour_Contour_h
 #define vtk_m_filter_contour_Contour_h
 
+#include <vtkm/filter/ActiveCellIndex.h>
 #include <vtkm/filter/NewFilterField.h>
 #include <vtkm/filter/contour/vtkm_filter_contour_export.h>
 
+#include <memory>
+
 namespace vtkm
 {
 namespace filter
@@ -69,6 +72,16 @@ public:
   VTKM_CONT
   bool GetMergeDuplicatePoints() const;
 
+  /// Set/Get whether duplicate points are found with a concurrent hash set instead of by
+  /// sorting the ids of the edges they come from. Hashing takes linear time, but the merged
+  /// points are ordered by first occurrence rather than by edge. Off by default. Only used
+  /// when duplicate points are merged on data sets that are not contoured with flying edges.
+  ///
+  VTKM_CONT
+  void SetMergeWithHash(bool on) { this->MergeWithHash = on; }
+  VTKM_CONT
+  bool GetMergeWithHash() const { return this->MergeWithHash; }
+
   /// Set/Get whether normals should be generated. Off by default. If enabled,
   /// the default behaviour is to generate high quality normals for structured
   /// datasets, using gradients, and generate fast normals for unstructured
@@ -111,21 +124,50 @@ public:
   VTKM_CONT
   const std::string& GetNormalArrayName() const { return this->NormalArrayName; }
 
-private:
+  /// Set/Get an index of the cells of the input that may intersect the iso-values. When the
+  /// index is valid for the active field, only its candidate cells are contoured. The index
+  /// is not used when normals are computed from the gradients of the field, since they need
+  /// all the cells around the contour. It is not used for structured cell sets either, so
+  /// that they are still contoured with flying edges and give the same points in the same
+  /// order.
   VTKM_CONT
+  void SetActiveCellIndex(const std::shared_ptr<vtkm::filter::ActiveCellIndex>& index)
+  {
+    this->CellIndex = index;
+  }
+  VTKM_CONT
+  const std::shared_ptr<vtkm::filter::ActiveCellIndex>& GetActiveCellIndex() const
+  {
+    return this->CellIndex;
+  }
 
+private:
   std::vector<vtkm::Float64> IsoValues;
   bool GenerateNormals = false;
   bool AddInterpolationEdgeIds = false;
   bool ComputeFastNormalsForStructured = false;
   bool ComputeFastNormalsForUnstructured = true;
   bool MergeDuplicatedPoints = true;
+  bool MergeWithHash = false;
   std::string NormalArrayName = "normals";
   std::string InterpolationEdgeIdsArrayName = "edgeIds";
+  std::shared_ptr<vtkm::filter::ActiveCellIndex> CellIndex;
 
 protected:
   // Needed by the subclass Slice
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& result) override;
+
+  /// Returns true if normals are computed from the gradients of the field for `cells`.
+  VTKM_CONT bool UseHighQualityNormals(const vtkm::cont::UnknownCellSet& cells) const;
+
+  /// Returns true if the candidate cells of the active cell index can be contoured instead of
+  /// `cells`. Whether the index is valid for the input is not checked.
+  VTKM_CONT bool UseActiveCellIndex(const vtkm::cont::UnknownCellSet& cells,
+                                    bool generateHighQualityNormals) const;
+
+  /// Contours all the cells of `input`, which may be the candidate cells of another data set.
+  VTKM_CONT vtkm::cont::DataSet ComputeContour(const vtkm::cont::DataSet& input,
+                                               bool generateHighQualityNormals);
 };
 } // namespace contour
 class VTKM_DEPRECATED(1.8, "Use vtkm::filter::contour::Contour.") Contour
@@ -10,6 +10,7 @@
 
 #include <vtkm/cont/ArrayCopyDevice.h>
 #include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/Logging.h>
 #include <vtkm/filter/contour/Slice.h>
 
 namespace vtkm
@@ -20,24 +21,38 @@ namespace contour
 {
 vtkm::cont::DataSet Slice::DoExecute(const vtkm::cont::DataSet& input)
 {
-  const auto& coords = input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
+  const vtkm::IdComponent coordsIndex = this->GetActiveCoordinateSystemIndex();
+  const bool generateHighQualityNormals = this->UseHighQualityNormals(input.GetCellSet());
 
-  vtkm::cont::DataSet result;
+  // input is a const, we can not AddField to it.
+  vtkm::cont::DataSet clone = input;
+  const auto& index = this->GetActiveCellIndex();
+  if (this->Function.GetVariant().IsType<vtkm::Plane>() &&
+      this->UseActiveCellIndex(input.GetCellSet(), generateHighQualityNormals))
+  {
+    const auto& plane = this->Function.GetVariant().Get<vtkm::Plane>();
+    if (index->IsValidFor(input, plane, coordsIndex))
+    {
+      clone = index->ExtractCandidates(input, { index->GetPlaneRange(plane) });
+    }
+    else
+    {
+      VTKM_LOG_S(vtkm::cont::LogLevel::Info, "Slice: active cell index not valid for plane.");
+    }
+  }
+
+  const auto& coords = clone.GetCoordinateSystem(coordsIndex);
   auto impFuncEval =
     vtkm::ImplicitFunctionValueFunctor<vtkm::ImplicitFunctionGeneral>(this->Function);
   auto coordTransform =
     vtkm::cont::make_ArrayHandleTransform(coords.GetDataAsMultiplexer(), impFuncEval);
   vtkm::cont::ArrayHandle<vtkm::FloatDefault> sliceScalars;
   vtkm::cont::ArrayCopyDevice(coordTransform, sliceScalars);
-  // input is a const, we can not AddField to it.
-  vtkm::cont::DataSet clone = input;
   clone.AddField(vtkm::cont::make_FieldPoint("sliceScalars", sliceScalars));
 
   this->Contour::SetIsoValue(0.0);
   this->Contour::SetActiveField("sliceScalars");
-  result = this->Contour::DoExecute(clone);
-
-  return result;
+  return this->ComputeContour(clone, generateHighQualityNormals);
 }
 } // namespace contour
 } // namespace filter
@@ -21,6 +21,10 @@ namespace filter
 {
 namespace contour
 {
+/// \brief Intersects a data set with an implicit function.
+///
+/// An active cell index (see `Contour::SetActiveCellIndex`) built for a `vtkm::Plane`
+/// accelerates slicing with any plane parallel to it.
 class VTKM_FILTER_CONTOUR_EXPORT Slice : public vtkm::filter::contour::Contour
 {
 public:
@@ -9,11 +9,17 @@
 //============================================================================
 
 #include <vtkm/Math.h>
+#include <vtkm/VectorAnalysis.h>
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/DataSetBuilderRectilinear.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 
+#include <vtkm/filter/clean_grid/CleanGrid.h>
 #include <vtkm/filter/contour/Contour.h>
 #include <vtkm/filter/field_transform/GenerateIds.h>
 
@@ -143,6 +149,241 @@ public:
     VTKM_TEST_ASSERT(outputData.GetNumberOfPoints() == 9);
   }
 
+  void TestContourCellIdMap() const
+  {
+    std::cout << "Testing Contour filter cell mapping with trimmed rows" << std::endl;
+
+    // A sphere in the middle of the grid, so that flying edges trims the rows on both sides.
+    const vtkm::Id3 dims(12, 12, 12);
+    vtkm::cont::DataSet dataSet =
+      vtkm::cont::DataSetBuilderUniform::Create(dims, vtkm::Vec3f(0), vtkm::Vec3f(1));
+    std::vector<vtkm::Float32> distance;
+    for (vtkm::Id k = 0; k < dims[2]; ++k)
+    {
+      for (vtkm::Id j = 0; j < dims[1]; ++j)
+      {
+        for (vtkm::Id i = 0; i < dims[0]; ++i)
+        {
+          const vtkm::Vec3f p(i - 5.5f, j - 5.5f, k - 5.5f);
+          distance.push_back(vtkm::Magnitude(p));
+        }
+      }
+    }
+    dataSet.AddPointField("distance", distance);
+    vtkm::filter::field_transform::GenerateIds genIds;
+    genIds.SetGeneratePointIds(false);
+    genIds.SetCellFieldName("cellid");
+    dataSet = genIds.Execute(dataSet);
+
+    vtkm::filter::contour::Contour mc;
+    mc.SetGenerateNormals(false);
+    mc.SetIsoValue(0, 3.2);
+    mc.SetActiveField("distance");
+    auto result = mc.Execute(dataSet);
+    VTKM_TEST_ASSERT(result.GetNumberOfCells() > 0, "Contour is empty");
+
+    vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+    result.GetCellField("cellid").GetData().AsArrayHandle(cellIds);
+    vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+    result.GetCoordinateSystem().GetData().AsArrayHandle(points);
+    auto cells = result.GetCellSet().AsCellSet<vtkm::cont::CellSetSingleType<>>();
+    auto connectivity =
+      cells.GetConnectivityArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{})
+        .ReadPortal();
+    auto pointsPortal = points.ReadPortal();
+    auto cellIdsPortal = cellIds.ReadPortal();
+    for (vtkm::Id tri = 0; tri < result.GetNumberOfCells(); ++tri)
+    {
+      // The centroid of a triangle lies in the cell that produced it.
+      const vtkm::Vec3f centroid = (pointsPortal.Get(connectivity.Get(3 * tri)) +
+                                    pointsPortal.Get(connectivity.Get(3 * tri + 1)) +
+                                    pointsPortal.Get(connectivity.Get(3 * tri + 2))) /
+        3.0f;
+      const vtkm::Id expected = static_cast<vtkm::Id>(centroid[0]) +
+        (dims[0] - 1) *
+          (static_cast<vtkm::Id>(centroid[1]) +
+           (dims[1] - 1) * static_cast<vtkm::Id>(centroid[2]));
+      VTKM_TEST_ASSERT(cellIdsPortal.Get(tri) == expected,
+                       "Triangle ",
+                       tri,
+                       " mapped to cell ",
+                       cellIdsPortal.Get(tri),
+                       " instead of ",
+                       expected);
+    }
+  }
+
+  void TestContourMergeWithHash() const
+  {
+    std::cout << "Testing Contour filter merging points with a hash set" << std::endl;
+
+    vtkm::filter::clean_grid::CleanGrid clean;
+    vtkm::cont::DataSet dataSet = clean.Execute(vtkm::source::Tangle(vtkm::Id3(16)).Execute());
+
+    for (std::size_t numberOfIsoValues : { 1, 3 })
+    {
+      vtkm::filter::contour::Contour contour;
+      contour.SetActiveField("tangle");
+      for (std::size_t i = 0; i < numberOfIsoValues; ++i)
+      {
+        contour.SetIsoValue(static_cast<vtkm::Id>(i), 0.1 + 0.3 * static_cast<vtkm::Float64>(i));
+      }
+      auto sorted = contour.Execute(dataSet);
+      contour.SetMergeWithHash(true);
+      auto hashed = contour.Execute(dataSet);
+
+      VTKM_TEST_ASSERT(sorted.GetNumberOfCells() > 0, "Contour is empty");
+      VTKM_TEST_ASSERT(hashed.GetNumberOfCells() == sorted.GetNumberOfCells(),
+                       "Wrong number of cells");
+      VTKM_TEST_ASSERT(hashed.GetNumberOfPoints() == sorted.GetNumberOfPoints(),
+                       "Wrong number of points");
+
+      // Only the numbering of the points differs.
+      auto trianglePoints = [](const vtkm::cont::DataSet& result) {
+        auto cells = result.GetCellSet().AsCellSet<vtkm::cont::CellSetSingleType<>>();
+        vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+        result.GetCoordinateSystem().GetData().AsArrayHandle(points);
+        vtkm::cont::ArrayHandle<vtkm::Vec3f> corners;
+        vtkm::cont::ArrayCopy(
+          vtkm::cont::make_ArrayHandlePermutation(
+            cells.GetConnectivityArray(vtkm::TopologyElementTagCell{},
+                                       vtkm::TopologyElementTagPoint{}),
+            points),
+          corners);
+        return corners;
+      };
+      VTKM_TEST_ASSERT(test_equal_ArrayHandles(trianglePoints(hashed), trianglePoints(sorted)),
+                       "Wrong triangles");
+    }
+  }
+
+  void TestContourRectilinearAndCurvilinear() const
+  {
+    std::cout << "Testing Contour filter on rectilinear and curvilinear grids" << std::endl;
+
+    // The same grid with uniform, rectilinear and explicit coordinates. All of them use flying
+    // edges, so the outputs should be identical. The spacing is isotropic because the uniform
+    // normals are computed in index space.
+    const vtkm::Id3 dims(14, 16, 11);
+    const vtkm::Vec3f origin(-3.0f, -4.0f, -2.5f);
+    const vtkm::Vec3f spacing(0.5f, 0.5f, 0.5f);
+    vtkm::cont::DataSet uniform = vtkm::cont::DataSetBuilderUniform::Create(dims, origin, spacing);
+
+    std::vector<vtkm::FloatDefault> xCoords, yCoords, zCoords;
+    for (vtkm::Id i = 0; i < dims[0]; ++i)
+    {
+      xCoords.push_back(origin[0] + static_cast<vtkm::FloatDefault>(i) * spacing[0]);
+    }
+    for (vtkm::Id j = 0; j < dims[1]; ++j)
+    {
+      yCoords.push_back(origin[1] + static_cast<vtkm::FloatDefault>(j) * spacing[1]);
+    }
+    for (vtkm::Id k = 0; k < dims[2]; ++k)
+    {
+      zCoords.push_back(origin[2] + static_cast<vtkm::FloatDefault>(k) * spacing[2]);
+    }
+    vtkm::cont::DataSet rectilinear =
+      vtkm::cont::DataSetBuilderRectilinear::Create(xCoords, yCoords, zCoords);
+
+    vtkm::cont::ArrayHandle<vtkm::Vec3f> explicitCoords;
+    vtkm::cont::ArrayCopy(uniform.GetCoordinateSystem().GetData(), explicitCoords);
+    vtkm::cont::DataSet curvilinear;
+    curvilinear.SetCellSet(uniform.GetCellSet());
+    curvilinear.AddCoordinateSystem(vtkm::cont::CoordinateSystem("coords", explicitCoords));
+
+    std::vector<vtkm::Float32> distance;
+    auto coordsPortal = explicitCoords.ReadPortal();
+    for (vtkm::Id i = 0; i < coordsPortal.GetNumberOfValues(); ++i)
+    {
+      distance.push_back(static_cast<vtkm::Float32>(vtkm::Magnitude(coordsPortal.Get(i))));
+    }
+    uniform.AddPointField("distance", distance);
+    rectilinear.AddPointField("distance", distance);
+    curvilinear.AddPointField("distance", distance);
+
+    vtkm::filter::contour::Contour filter;
+    filter.SetGenerateNormals(true);
+    filter.SetIsoValue(0, 4.1);
+    filter.SetIsoValue(1, 6.3);
+    filter.SetActiveField("distance");
+    auto expected = filter.Execute(uniform);
+    VTKM_TEST_ASSERT(expected.GetNumberOfCells() > 0, "Contour is empty");
+
+    for (const auto& input : { rectilinear, curvilinear })
+    {
+      auto result = filter.Execute(input);
+      VTKM_TEST_ASSERT(result.GetNumberOfCells() == expected.GetNumberOfCells(),
+                       "Wrong number of cells");
+      VTKM_TEST_ASSERT(result.GetNumberOfPoints() == expected.GetNumberOfPoints(),
+                       "Wrong number of points");
+      auto connectivity = [](const vtkm::cont::DataSet& dataSet) {
+        return dataSet.GetCellSet()
+          .AsCellSet<vtkm::cont::CellSetSingleType<>>()
+          .GetConnectivityArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{});
+      };
+      VTKM_TEST_ASSERT(test_equal_ArrayHandles(connectivity(result), connectivity(expected)),
+                       "Wrong connectivity");
+      VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetCoordinateSystem().GetData(),
+                                               expected.GetCoordinateSystem().GetData()),
+                       "Wrong points");
+      VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetPointField("normals").GetData(),
+                                               expected.GetPointField("normals").GetData()),
+                       "Wrong normals");
+    }
+  }
+
+  void TestContourMaxZBoundary() const
+  {
+    std::cout << "Testing Contour filter on the max z boundary of a flat grid" << std::endl;
+
+    // Flying edges generates the edges on the +z face of the grid only for the cells flagged
+    // as being on the max z boundary. The grid has fewer points in z than in y, so a wrong
+    // flag leaves the points on that face unset and reads past the end of the field. The
+    // field is linear, so every point of the contour lies exactly on the plane of the iso
+    // value.
+    const vtkm::Id3 dims(7, 10, 5);
+    vtkm::cont::DataSet dataSet =
+      vtkm::cont::DataSetBuilderUniform::Create(dims, vtkm::Vec3f(0), vtkm::Vec3f(1));
+    auto planeValue = [](const vtkm::Vec3f& p) { return p[0] + p[1] + p[2]; };
+    std::vector<vtkm::Float32> plane;
+    for (vtkm::Id k = 0; k < dims[2]; ++k)
+    {
+      for (vtkm::Id j = 0; j < dims[1]; ++j)
+      {
+        for (vtkm::Id i = 0; i < dims[0]; ++i)
+        {
+          plane.push_back(static_cast<vtkm::Float32>(i + j + k));
+        }
+      }
+    }
+    dataSet.AddPointField("plane", plane);
+
+    for (bool generateNormals : { false, true })
+    {
+      vtkm::filter::contour::Contour mc;
+      mc.SetGenerateNormals(generateNormals);
+      mc.SetIsoValue(0, 8.5);
+      mc.SetActiveField("plane");
+      auto result = mc.Execute(dataSet);
+      VTKM_TEST_ASSERT(result.GetNumberOfPoints() > 0, "Contour is empty");
+
+      vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+      result.GetCoordinateSystem().GetData().AsArrayHandle(points);
+      auto pointsPortal = points.ReadPortal();
+      vtkm::Id numberOfTopPoints = 0;
+      for (vtkm::Id i = 0; i < pointsPortal.GetNumberOfValues(); ++i)
+      {
+        const vtkm::Vec3f p = pointsPortal.Get(i);
+        VTKM_TEST_ASSERT(test_equal(planeValue(p), 8.5f, 1e-5), "Point ", p, " not on the contour");
+        if (test_equal(p[2], static_cast<vtkm::FloatDefault>(dims[2] - 1)))
+        {
+          ++numberOfTopPoints;
+        }
+      }
+      VTKM_TEST_ASSERT(numberOfTopPoints > 0, "Contour does not cross the max z boundary");
+    }
+  }
+
   void TestContourWedges() const
   {
     std::cout << "Testing Contour filter on wedge cells" << std::endl;
@@ -171,6 +412,10 @@ public:
   {
     this->Test3DUniformDataSet0();
     this->TestContourUniformGrid();
+    this->TestContourCellIdMap();
+    this->TestContourMergeWithHash();
+    this->TestContourRectilinearAndCurvilinear();
+    this->TestContourMaxZBoundary();
     this->TestContourWedges();
   }
 
@@ -49,6 +49,17 @@ struct DeduceCoordType
   {
     result = flying_edges::execute(cells, coords, std::forward<Args>(args)...);
   }
+
+  // Rectilinear and curvilinear structured grids also use flying edges. The points are
+  // interpolated from the coordinates instead of from an origin and spacing.
+  template <typename CoordinateType, typename StorageTag, typename... Args>
+  void operator()(const vtkm::cont::ArrayHandle<vtkm::Vec<CoordinateType, 3>, StorageTag>& coords,
+                  const vtkm::cont::CellSetStructured<3>& cells,
+                  vtkm::cont::CellSetSingleType<>& result,
+                  Args&&... args) const
+  {
+    result = flying_edges::execute(cells, coords, std::forward<Args>(args)...);
+  }
 };
 
 struct DeduceCellType
@@ -85,6 +96,12 @@ public:
   //----------------------------------------------------------------------------
   bool GetMergeDuplicatePoints() const { return this->SharedState.MergeDuplicatePoints; }
 
+  //----------------------------------------------------------------------------
+  void SetMergeWithHash(bool on) { this->SharedState.MergeWithHash = on; }
+
+  //----------------------------------------------------------------------------
+  bool GetMergeWithHash() const { return this->SharedState.MergeWithHash; }
+
   //----------------------------------------------------------------------------
   vtkm::cont::ArrayHandle<vtkm::Id> GetCellIdMap() const { return this->SharedState.CellIdMap; }
 
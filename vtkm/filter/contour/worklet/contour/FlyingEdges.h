@@ -19,6 +19,7 @@
 
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayHandleGroupVec.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
 #include <vtkm/cont/Invoker.h>
 
 namespace vtkm
@@ -47,6 +48,28 @@ vtkm::Id extend_by(vtkm::cont::ArrayHandle<T, S>& handle, vtkm::Id size)
   }
   return oldLen;
 }
+
+// Uniform points are interpolated in Pass4 from their origin and spacing.
+inline bool uniform_origin_and_spacing(
+  const vtkm::cont::ArrayHandle<vtkm::Vec3f, vtkm::cont::StorageTagUniformPoints>& coords,
+  vtkm::Vec3f& origin,
+  vtkm::Vec3f& spacing)
+{
+  auto portal = coords.ReadPortal();
+  origin = portal.GetOrigin();
+  spacing = portal.GetSpacing();
+  return true;
+}
+
+// Rectilinear and curvilinear points are interpolated from the coordinates in Pass5.
+// Pass4 works in index space.
+template <typename CoordsType>
+bool uniform_origin_and_spacing(const CoordsType&, vtkm::Vec3f& origin, vtkm::Vec3f& spacing)
+{
+  origin = vtkm::Vec3f(0);
+  spacing = vtkm::Vec3f(1);
+  return false;
+}
 }
 
 //----------------------------------------------------------------------------
@@ -55,10 +78,13 @@ template <typename ValueType,
           typename StorageTagVertices,
           typename StorageTagNormals,
           typename CoordinateType,
-          typename NormalType>
+          typename NormalType,
+          typename InputCoordinateType,
+          typename StorageTagCoordinates>
 vtkm::cont::CellSetSingleType<> execute(
   const vtkm::cont::CellSetStructured<3>& cells,
-  const vtkm::cont::ArrayHandleUniformPointCoordinates& coordinateSystem,
+  const vtkm::cont::ArrayHandle<vtkm::Vec<InputCoordinateType, 3>, StorageTagCoordinates>&
+    coordinateSystem,
   const std::vector<ValueType>& isovalues,
   const vtkm::cont::ArrayHandle<ValueType, StorageTagField>& inputField,
   vtkm::cont::ArrayHandle<vtkm::Vec<CoordinateType, 3>, StorageTagVertices>& points,
@@ -67,13 +93,10 @@ vtkm::cont::CellSetSingleType<> execute(
 {
   vtkm::cont::Invoker invoke;
 
+  //extract out the origin and spacing as these are needed for Pass4 to properly
+  //interpolate the new points
   vtkm::Vec3f origin, spacing;
-  { //extract out the origin and spacing as these are needed for Pass4 to properly
-    //interpolate the new points
-    auto portal = coordinateSystem.ReadPortal();
-    origin = portal.GetOrigin();
-    spacing = portal.GetSpacing();
-  }
+  const bool uniformPoints = detail::uniform_origin_and_spacing(coordinateSystem, origin, spacing);
   auto pdims = cells.GetPointDimensions();
 
   vtkm::cont::ArrayHandle<vtkm::UInt8> edgeCases;
@@ -169,7 +192,7 @@ vtkm::cont::CellSetSingleType<> execute(
         VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "FlyingEdges Pass4");
 
         launchComputePass4 pass4(
-          pdims, origin, spacing, multiContourCellOffset, multiContourPointOffset);
+          pdims, origin, spacing, multiContourCellOffset, multiContourPointOffset, uniformPoints);
 
         detail::extend_by(points, newPointSize);
         if (sharedState.GenerateNormals)
@@ -191,7 +214,8 @@ vtkm::cont::CellSetSingleType<> execute(
                                        sharedState,
                                        triangle_topology,
                                        points,
-                                       normals);
+                                       normals,
+                                       coordinateSystem);
       }
     }
   }
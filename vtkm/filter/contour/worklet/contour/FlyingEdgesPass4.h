@@ -34,16 +34,23 @@ struct launchComputePass4
   vtkm::Id CellWriteOffset;
   vtkm::Id PointWriteOffset;
 
+  // When false the coordinates are not uniform. Points and normals are then
+  // interpolated from the coordinates array in Pass5 instead of from the
+  // origin and spacing.
+  bool UniformPoints;
+
   launchComputePass4(const vtkm::Id3& pdims,
                      const vtkm::Vec3f& origin,
                      const vtkm::Vec3f& spacing,
                      vtkm::Id multiContourCellOffset,
-                     vtkm::Id multiContourPointOffset)
+                     vtkm::Id multiContourPointOffset,
+                     bool uniformPoints = true)
     : PointDims(pdims)
     , Origin(origin)
     , Spacing(spacing)
     , CellWriteOffset(multiContourCellOffset)
     , PointWriteOffset(multiContourPointOffset)
+    , UniformPoints(uniformPoints)
   {
   }
 
@@ -52,9 +59,10 @@ struct launchComputePass4
             typename StorageTagField,
             typename MeshSums,
             typename PointType,
-            typename NormalType>
+            typename NormalType,
+            typename CoordsType>
   VTKM_CONT bool LaunchXAxis(DeviceAdapterTag device,
-                             vtkm::Id vtkmNotUsed(newPointSize),
+                             vtkm::Id newPointSize,
                              T isoval,
                              const vtkm::cont::ArrayHandle<T, StorageTagField>& inputField,
                              vtkm::cont::ArrayHandle<vtkm::UInt8> edgeCases,
@@ -66,10 +74,11 @@ struct launchComputePass4
                              vtkm::worklet::contour::CommonState& sharedState,
                              vtkm::cont::ArrayHandle<vtkm::Id>& triangle_topology,
                              PointType& points,
-                             NormalType& normals) const
+                             NormalType& normals,
+                             const CoordsType& coordinates) const
   {
     vtkm::cont::Invoker invoke(device);
-    if (sharedState.GenerateNormals)
+    if (sharedState.GenerateNormals && this->UniformPoints)
     {
       ComputePass4XWithNormals<T> worklet4(isoval,
                                            this->PointDims,
@@ -115,6 +124,11 @@ struct launchComputePass4
              points);
     }
 
+    if (!this->UniformPoints)
+    {
+      this->LaunchPass5(
+        invoke, newPointSize, inputField, sharedState, points, normals, coordinates);
+    }
     return true;
   }
 
@@ -123,7 +137,8 @@ struct launchComputePass4
             typename StorageTagField,
             typename MeshSums,
             typename PointType,
-            typename NormalType>
+            typename NormalType,
+            typename CoordsType>
   VTKM_CONT bool LaunchYAxis(DeviceAdapterTag device,
                              vtkm::Id newPointSize,
                              T isoval,
@@ -137,7 +152,8 @@ struct launchComputePass4
                              vtkm::worklet::contour::CommonState& sharedState,
                              vtkm::cont::ArrayHandle<vtkm::Id>& triangle_topology,
                              PointType& points,
-                             NormalType& normals) const
+                             NormalType& normals,
+                             const CoordsType& coordinates) const
   {
     vtkm::cont::Invoker invoke(device);
 
@@ -156,22 +172,34 @@ struct launchComputePass4
            sharedState.InterpolationWeights,
            sharedState.CellIdMap);
 
+    this->LaunchPass5(invoke, newPointSize, inputField, sharedState, points, normals, coordinates);
+    return true;
+  }
+
+  template <typename T,
+            typename StorageTagField,
+            typename PointType,
+            typename NormalType,
+            typename CoordsType>
+  VTKM_CONT void LaunchPass5(vtkm::cont::Invoker& invoke,
+                             vtkm::Id newPointSize,
+                             const vtkm::cont::ArrayHandle<T, StorageTagField>& inputField,
+                             vtkm::worklet::contour::CommonState& sharedState,
+                             PointType& points,
+                             NormalType& normals,
+                             const CoordsType& coordinates) const
+  {
     //This needs to be done on array handle view ( start = this->PointWriteOffset, len = newPointSize)
-    ComputePass5Y<T> worklet5(this->PointDims,
-                              this->Origin,
-                              this->Spacing,
-                              this->PointWriteOffset,
-                              sharedState.GenerateNormals);
+    ComputePass5Y<T> worklet5(this->PointDims, this->PointWriteOffset, sharedState.GenerateNormals);
     invoke(worklet5,
            vtkm::cont::make_ArrayHandleView(
              sharedState.InterpolationEdgeIds, this->PointWriteOffset, newPointSize),
            vtkm::cont::make_ArrayHandleView(
              sharedState.InterpolationWeights, this->PointWriteOffset, newPointSize),
            vtkm::cont::make_ArrayHandleView(points, this->PointWriteOffset, newPointSize),
+           coordinates,
            inputField,
            normals);
-
-    return true;
   }
 
   template <typename DeviceAdapterTag, typename... Args>
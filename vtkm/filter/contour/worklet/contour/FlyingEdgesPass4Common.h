@@ -156,7 +156,9 @@ struct Pass4TrimState
     }
 
 
+    //compute the cellId of the first cell of the trimmed row
     cellId = compute_start(AxisToSum{}, ijk, pdims - vtkm::Id3{ 1, 1, 1 });
+    cellId += left * increment_cellId(AxisToSum{}, 0, axis_inc);
 
     //update our ijk
     ijk[AxisToSum::xindex] = left;
@@ -185,7 +187,7 @@ struct Pass4TrimState
     {
       boundaryStatus[AxisToSum::zindex] += FlyingEdges3D::MinBoundary;
     }
-    if (ijk[AxisToSum::zindex] >= (pdims[AxisToSum::yindex] - 2))
+    if (ijk[AxisToSum::zindex] >= (pdims[AxisToSum::zindex] - 2))
     {
       boundaryStatus[AxisToSum::zindex] += FlyingEdges3D::MaxBoundary;
     }
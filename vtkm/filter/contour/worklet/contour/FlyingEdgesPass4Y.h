@@ -273,20 +273,20 @@ struct ComputePass4Y : public vtkm::worklet::WorkletVisitCellsWithPoints
   }
 };
 
+// Interpolates the output points and normals from the edges and weights of Pass4. The
+// points are interpolated from the coordinates array, so this works for uniform,
+// rectilinear and curvilinear coordinates. Normals of non-uniform coordinates are
+// computed from the Jacobian of the coordinates.
 template <typename T>
 struct ComputePass5Y : public vtkm::worklet::WorkletMapField
 {
 
-  vtkm::internal::ArrayPortalUniformPointCoordinates Coordinates;
+  vtkm::Id3 PointDims;
   vtkm::Id NormalWriteOffset;
 
   ComputePass5Y() {}
-  ComputePass5Y(const vtkm::Id3& pdims,
-                const vtkm::Vec3f& origin,
-                const vtkm::Vec3f& spacing,
-                vtkm::Id normalWriteOffset,
-                bool generateNormals)
-    : Coordinates(pdims, origin, spacing)
+  ComputePass5Y(const vtkm::Id3& pdims, vtkm::Id normalWriteOffset, bool generateNormals)
+    : PointDims(pdims)
     , NormalWriteOffset(normalWriteOffset)
   {
     if (!generateNormals)
@@ -298,21 +298,26 @@ struct ComputePass5Y : public vtkm::worklet::WorkletMapField
   using ControlSignature = void(FieldIn interpEdgeIds,
                                 FieldIn interpWeight,
                                 FieldOut points,
+                                WholeArrayIn coordinates,
                                 WholeArrayIn field,
                                 WholeArrayOut normals);
-  using ExecutionSignature = void(_1, _2, _3, _4, _5, WorkIndex);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, WorkIndex);
 
-  template <typename PT, typename WholeInputField, typename WholeNormalField>
+  template <typename PT,
+            typename WholeCoordsField,
+            typename WholeInputField,
+            typename WholeNormalField>
   VTKM_EXEC void operator()(const vtkm::Id2& interpEdgeIds,
                             vtkm::FloatDefault weight,
                             vtkm::Vec<PT, 3>& outPoint,
+                            const WholeCoordsField& coordinates,
                             const WholeInputField& field,
                             WholeNormalField& normals,
                             vtkm::Id oidx) const
   {
     {
-      vtkm::Vec3f point1 = this->Coordinates.Get(interpEdgeIds[0]);
-      vtkm::Vec3f point2 = this->Coordinates.Get(interpEdgeIds[1]);
+      vtkm::Vec3f point1 = coordinates.Get(interpEdgeIds[0]);
+      vtkm::Vec3f point2 = coordinates.Get(interpEdgeIds[1]);
       outPoint = vtkm::Lerp(point1, point2, weight);
     }
 
@@ -320,15 +325,14 @@ struct ComputePass5Y : public vtkm::worklet::WorkletMapField
     if (this->NormalWriteOffset >= 0)
     {
       vtkm::Vec<T, 3> g0, g1;
-      const vtkm::Id3& dims = this->Coordinates.GetDimensions();
+      const vtkm::Id3& dims = this->PointDims;
       vtkm::Id3 ijk{ interpEdgeIds[0] % dims[0],
                      (interpEdgeIds[0] / dims[0]) % dims[1],
                      interpEdgeIds[0] / (dims[0] * dims[1]) };
 
       vtkm::worklet::gradient::StructuredPointGradient gradient;
       vtkm::exec::BoundaryState boundary(ijk, dims);
-      vtkm::exec::FieldNeighborhood<vtkm::internal::ArrayPortalUniformPointCoordinates>
-        coord_neighborhood(this->Coordinates, boundary);
+      vtkm::exec::FieldNeighborhood<WholeCoordsField> coord_neighborhood(coordinates, boundary);
 
       vtkm::exec::FieldNeighborhood<WholeInputField> field_neighborhood(field, boundary);
 
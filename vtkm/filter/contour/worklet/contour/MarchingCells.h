@@ -22,7 +22,9 @@
 #include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/ArrayHandleZip.h>
+#include <vtkm/cont/ConcurrentHashSet.h>
 #include <vtkm/cont/Invoker.h>
 
 #include <vtkm/worklet/Keys.h>
@@ -382,6 +384,36 @@ void MergeDuplicates(const vtkm::cont::Invoker& invoker,
   invoker(CopyEdgeIds{}, uniqueKeys, edgeIds);
 }
 
+// ---------------------------------------------------------------------------
+// Same as MergeDuplicates, but finds the duplicates with a hash set instead of sorting the
+// keys. The merged points are ordered by their first occurrence rather than by key.
+template <typename KeyType, typename KeyStorage>
+void MergeDuplicatesWithHash(const vtkm::cont::ArrayHandle<KeyType, KeyStorage>& original_keys,
+                             vtkm::cont::ArrayHandle<vtkm::FloatDefault>& weights,
+                             vtkm::cont::ArrayHandle<vtkm::Id2>& edgeIds,
+                             vtkm::cont::ArrayHandle<vtkm::Id>& cellids,
+                             vtkm::cont::ArrayHandle<vtkm::Id>& connectivity)
+{
+  vtkm::cont::ConcurrentHashSet<KeyType, KeyStorage> hashSet(original_keys);
+  vtkm::cont::ArrayHandle<vtkm::Id> uniqueIds;
+  hashSet.GetUniqueKeyIds(uniqueIds, connectivity);
+
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> writeWeights;
+  vtkm::cont::ArrayCopyDevice(vtkm::cont::make_ArrayHandlePermutation(uniqueIds, weights),
+                              writeWeights);
+  weights = writeWeights;
+
+  vtkm::cont::ArrayHandle<vtkm::Id2> writeEdgeIds;
+  vtkm::cont::ArrayCopyDevice(vtkm::cont::make_ArrayHandlePermutation(uniqueIds, edgeIds),
+                              writeEdgeIds);
+  edgeIds = writeEdgeIds;
+
+  vtkm::cont::ArrayHandle<vtkm::Id> writeCells;
+  vtkm::cont::ArrayCopyDevice(vtkm::cont::make_ArrayHandlePermutation(uniqueIds, cellids),
+                              writeCells);
+  cellids = writeCells;
+}
+
 // -----------------------------------------------------------------------------
 template <vtkm::IdComponent Comp>
 struct EdgeVertex
@@ -672,7 +704,24 @@ vtkm::cont::CellSetSingleType<> execute(
     // are updated. That is because MergeDuplicates will internally update
     // the InterpolationWeights and InterpolationOriginCellIds arrays to be the correct for the
     // output. But for InterpolationEdgeIds we need to do it manually once done
-    if (isovalues.size() == 1)
+    if (sharedState.MergeWithHash && (isovalues.size() == 1))
+    {
+      marching_cells::MergeDuplicatesWithHash(sharedState.InterpolationEdgeIds,
+                                              sharedState.InterpolationWeights,
+                                              sharedState.InterpolationEdgeIds,
+                                              originalCellIdsForPoints,
+                                              connectivity);
+    }
+    else if (sharedState.MergeWithHash)
+    {
+      marching_cells::MergeDuplicatesWithHash(
+        vtkm::cont::make_ArrayHandleZip(contourIds, sharedState.InterpolationEdgeIds),
+        sharedState.InterpolationWeights,
+        sharedState.InterpolationEdgeIds,
+        originalCellIdsForPoints,
+        connectivity);
+    }
+    else if (isovalues.size() == 1)
     {
       marching_cells::MergeDuplicates(invoker,
                                       sharedState.InterpolationEdgeIds, //keys
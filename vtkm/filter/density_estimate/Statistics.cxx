@@ -0,0 +1,149 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/density_estimate/Statistics.h>
+#include <vtkm/filter/density_estimate/worklet/StatisticsHistogram.h>
+
+#include <vtkm/cont/EnvironmentTracker.h>
+
+#include <vtkm/thirdparty/diy/diy.h>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace density_estimate
+{
+namespace
+{
+using SummaryType = vtkm::worklet::StatisticsHistogram::Result;
+
+/// Merge the summaries of all ranks. Every rank receives every summary and merges
+/// them in rank order, so all ranks end up with identical results.
+SummaryType MergeAcrossRanks(const SummaryType& local, bool fixedRange)
+{
+  auto comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  if (comm.size() == 1)
+  {
+    return local;
+  }
+
+  vtkmdiy::MemoryBuffer localBuffer;
+  vtkmdiy::save(localBuffer, local.Statistics);
+  vtkmdiy::save(localBuffer, local.Bins);
+  vtkmdiy::save(localBuffer, local.BinMin);
+  vtkmdiy::save(localBuffer, local.BinDelta);
+
+  std::vector<std::vector<char>> allBuffers;
+  vtkmdiy::mpi::all_gather(comm, localBuffer.buffer, allBuffers);
+
+  std::vector<SummaryType> summaries(allBuffers.size());
+  for (std::size_t rank = 0; rank < allBuffers.size(); ++rank)
+  {
+    vtkmdiy::MemoryBuffer buffer;
+    buffer.buffer = std::move(allBuffers[rank]);
+    buffer.reset();
+    vtkmdiy::load(buffer, summaries[rank].Statistics);
+    vtkmdiy::load(buffer, summaries[rank].Bins);
+    vtkmdiy::load(buffer, summaries[rank].BinMin);
+    vtkmdiy::load(buffer, summaries[rank].BinDelta);
+  }
+  return vtkm::worklet::StatisticsHistogram::Merge(std::move(summaries), fixedRange);
+}
+
+vtkm::cont::ArrayHandle<vtkm::Float64> MakeValue(vtkm::Float64 value)
+{
+  return vtkm::cont::make_ArrayHandle({ value });
+}
+
+void AddSummaryFields(vtkm::cont::DataSet& output,
+                      const std::string& name,
+                      const SummaryType& summary)
+{
+  const auto& stats = summary.Statistics;
+  const bool empty = stats.N() == 0;
+  const auto assoc = vtkm::cont::Field::Association::WholeMesh;
+  output.AddField({ name + "_N", assoc, MakeValue(stats.N()) });
+  output.AddField({ name + "_Min", assoc, MakeValue(empty ? 0 : stats.Min()) });
+  output.AddField({ name + "_Max", assoc, MakeValue(empty ? 0 : stats.Max()) });
+  output.AddField({ name + "_Sum", assoc, MakeValue(stats.Sum()) });
+  output.AddField({ name + "_Mean", assoc, MakeValue(stats.Mean()) });
+  output.AddField(
+    { name + "_Variance", assoc, MakeValue(stats.N() > 1 ? stats.SampleVariance() : 0) });
+  output.AddField({ name + "_Skewness", assoc, MakeValue(empty ? 0 : stats.Skewness()) });
+  output.AddField({ name + "_Kurtosis", assoc, MakeValue(empty ? 0 : stats.Kurtosis()) });
+
+  if (!summary.Bins.empty())
+  {
+    const vtkm::Range binRange = summary.GetBinRange();
+    output.AddField({ name + "_Histogram",
+                      assoc,
+                      vtkm::cont::make_ArrayHandle(summary.Bins, vtkm::CopyFlag::On) });
+    output.AddField({ name + "_HistogramRange",
+                      assoc,
+                      vtkm::cont::make_ArrayHandle({ binRange.Min, binRange.Max }) });
+  }
+}
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+VTKM_CONT vtkm::cont::DataSet Statistics::DoExecute(const vtkm::cont::DataSet& input)
+{
+  // A single data set is just a partitioned data set with one partition. Going through
+  // the partitioned path keeps the distributed merge in one place.
+  auto result = this->DoExecutePartitions(vtkm::cont::PartitionedDataSet(input));
+  return result.GetPartition(0);
+}
+
+VTKM_CONT vtkm::cont::PartitionedDataSet Statistics::DoExecutePartitions(
+  const vtkm::cont::PartitionedDataSet& input)
+{
+  const bool fixedRange = this->Range.IsNonEmpty();
+  vtkm::cont::DataSet output;
+
+  for (vtkm::IdComponent fieldIndex = 0; fieldIndex < this->GetNumberOfActiveFields();
+       ++fieldIndex)
+  {
+    std::string name;
+    std::vector<SummaryType> summaries;
+    for (const auto& partition : input)
+    {
+      const auto& field = this->GetFieldFromDataSet(fieldIndex, partition);
+      name = field.GetName();
+
+      auto resolveType = [&](const auto& concrete) {
+        summaries.push_back(
+          vtkm::worklet::StatisticsHistogram::Run(concrete, this->NumberOfBins, this->Range));
+      };
+      this->CastAndCallScalarField(field, resolveType);
+    }
+    if (name.empty())
+    {
+      // No local partitions; take part in the exchange with an empty summary.
+      name = this->GetUseCoordinateSystemAsField(fieldIndex)
+        ? std::string("coordinates")
+        : this->GetActiveFieldName(fieldIndex);
+    }
+
+    SummaryType local = vtkm::worklet::StatisticsHistogram::Merge(summaries, fixedRange);
+    if (summaries.empty())
+    {
+      local = vtkm::worklet::StatisticsHistogram::Run(
+        vtkm::cont::ArrayHandle<vtkm::Float64>{}, this->NumberOfBins, this->Range);
+    }
+    AddSummaryFields(output, name, MergeAcrossRanks(local, fixedRange));
+  }
+
+  // The output is a "summary" of the input, no need to map fields
+  return vtkm::cont::PartitionedDataSet(output);
+}
+} // namespace density_estimate
+} // namespace filter
+} // namespace vtkm
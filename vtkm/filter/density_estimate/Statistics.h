@@ -0,0 +1,70 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_filter_density_estimate_Statistics_h
+#define vtk_m_filter_density_estimate_Statistics_h
+
+#include <vtkm/filter/NewFilterField.h>
+#include <vtkm/filter/density_estimate/vtkm_filter_density_estimate_export.h>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace density_estimate
+{
+/// \brief Compute descriptive statistics and a histogram for several fields at once.
+///
+/// Every active field (set with `SetActiveField(index, name)`) is read exactly once to
+/// produce its count, min, max, sum, mean, sample variance, skewness, kurtosis and,
+/// unless the number of bins is 0, a histogram. When no histogram range is given, the
+/// bins are placed on a power-of-two aligned grid chosen during the same pass, so no
+/// separate range computation is needed; the range actually covered is reported in the
+/// `<field>_HistogramRange` output.
+///
+/// The output contains only whole-mesh fields named `<field>_N`, `<field>_Min`,
+/// `<field>_Max`, `<field>_Sum`, `<field>_Mean`, `<field>_Variance`, `<field>_Skewness`,
+/// `<field>_Kurtosis`, `<field>_Histogram` and `<field>_HistogramRange`. For a
+/// `PartitionedDataSet` the partitions (and ranks, when running with MPI) are merged
+/// into a single result.
+///
+class VTKM_FILTER_DENSITY_ESTIMATE_EXPORT Statistics : public vtkm::filter::NewFilterField
+{
+public:
+  VTKM_CONT
+  void SetNumberOfBins(vtkm::Id count) { this->NumberOfBins = count; }
+
+  VTKM_CONT
+  vtkm::Id GetNumberOfBins() const { return this->NumberOfBins; }
+
+  //@{
+  /// Get/Set the range to use for all histograms. If range is set to empty (the
+  /// default), each histogram chooses its bins from its field's values. A range that is
+  /// not empty must have a positive length.
+  VTKM_CONT
+  void SetRange(const vtkm::Range& range) { this->Range = range; }
+
+  VTKM_CONT
+  const vtkm::Range& GetRange() const { return this->Range; }
+  //@}
+
+private:
+  VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
+  VTKM_CONT vtkm::cont::PartitionedDataSet DoExecutePartitions(
+    const vtkm::cont::PartitionedDataSet& input) override;
+
+  vtkm::Id NumberOfBins = 10;
+  vtkm::Range Range;
+};
+} // namespace density_estimate
+} // namespace filter
+} // namespace vtkm
+
+#endif // vtk_m_filter_density_estimate_Statistics_h
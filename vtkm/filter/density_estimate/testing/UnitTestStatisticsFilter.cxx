@@ -0,0 +1,210 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/density_estimate/Histogram.h>
+#include <vtkm/filter/density_estimate/Statistics.h>
+
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/PartitionedDataSet.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/worklet/DescriptiveStatistics.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+
+template <typename T>
+std::vector<T> MakeValues(vtkm::Id numValues, double min, double max, unsigned int seed)
+{
+  std::mt19937 gen(seed);
+  std::normal_distribution<double> dis((min + max) / 2, (max - min) / 6);
+  std::vector<T> values(static_cast<std::size_t>(numValues));
+  for (auto& v : values)
+  {
+    v = static_cast<T>(vtkm::Min(max, vtkm::Max(min, dis(gen))));
+  }
+  return values;
+}
+
+vtkm::Float64 GetValue(const vtkm::cont::DataSet& result, const std::string& name)
+{
+  return result.GetField(name)
+    .GetData()
+    .AsArrayHandle<vtkm::cont::ArrayHandle<vtkm::Float64>>()
+    .ReadPortal()
+    .Get(0);
+}
+
+std::vector<vtkm::Id> GetBins(const vtkm::cont::DataSet& result, const std::string& name)
+{
+  auto bins = result.GetField(name + "_Histogram")
+                .GetData()
+                .AsArrayHandle<vtkm::cont::ArrayHandle<vtkm::Id>>();
+  auto portal = bins.ReadPortal();
+  return std::vector<vtkm::Id>(vtkm::cont::ArrayPortalToIteratorBegin(portal),
+                               vtkm::cont::ArrayPortalToIteratorEnd(portal));
+}
+
+template <typename T>
+void CheckStatistics(const vtkm::cont::DataSet& result,
+                     const std::string& name,
+                     const std::vector<T>& values)
+{
+  std::vector<vtkm::Float64> asDouble(values.begin(), values.end());
+  auto expected = vtkm::worklet::DescriptiveStatistics::Run(
+    vtkm::cont::make_ArrayHandle(asDouble, vtkm::CopyFlag::Off));
+
+  VTKM_TEST_ASSERT(GetValue(result, name + "_N") == expected.N(), "Wrong N");
+  VTKM_TEST_ASSERT(test_equal(GetValue(result, name + "_Min"), expected.Min()), "Wrong min");
+  VTKM_TEST_ASSERT(test_equal(GetValue(result, name + "_Max"), expected.Max()), "Wrong max");
+  VTKM_TEST_ASSERT(test_equal(GetValue(result, name + "_Sum"), expected.Sum()), "Wrong sum");
+  VTKM_TEST_ASSERT(test_equal(GetValue(result, name + "_Mean"), expected.Mean()), "Wrong mean");
+  VTKM_TEST_ASSERT(test_equal(GetValue(result, name + "_Variance"), expected.SampleVariance()),
+                   "Wrong variance");
+  VTKM_TEST_ASSERT(test_equal(GetValue(result, name + "_Skewness"), expected.Skewness()),
+                   "Wrong skewness");
+  VTKM_TEST_ASSERT(test_equal(GetValue(result, name + "_Kurtosis"), expected.Kurtosis()),
+                   "Wrong kurtosis");
+}
+
+// Bin the values on the host using the grid reported by the filter.
+template <typename T>
+void CheckAutoHistogram(const vtkm::cont::DataSet& result,
+                        const std::string& name,
+                        const std::vector<T>& values,
+                        vtkm::Id numberOfBins)
+{
+  auto bins = GetBins(result, name);
+  VTKM_TEST_ASSERT(static_cast<vtkm::Id>(bins.size()) == numberOfBins, "Wrong number of bins");
+
+  auto range = result.GetField(name + "_HistogramRange")
+                 .GetData()
+                 .AsArrayHandle<vtkm::cont::ArrayHandle<vtkm::Float64>>()
+                 .ReadPortal();
+  const vtkm::Float64 binMin = range.Get(0);
+  const vtkm::Float64 binDelta = (range.Get(1) - binMin) / static_cast<vtkm::Float64>(numberOfBins);
+  VTKM_TEST_ASSERT(binMin <= GetValue(result, name + "_Min"), "Histogram misses minimum");
+  VTKM_TEST_ASSERT(range.Get(1) > GetValue(result, name + "_Max"), "Histogram misses maximum");
+
+  std::vector<vtkm::Id> expected(bins.size(), 0);
+  for (T v : values)
+  {
+    auto bin = static_cast<std::size_t>(
+      vtkm::Floor((static_cast<vtkm::Float64>(v) - binMin) / binDelta));
+    ++expected[bin];
+  }
+  VTKM_TEST_ASSERT(bins == expected, "Wrong histogram for ", name);
+}
+
+void TestSingleDataSet()
+{
+  std::cout << "Testing statistics of several fields in one data set." << std::endl;
+  const vtkm::Id numValues = 50000;
+  auto pressure = MakeValues<vtkm::Float64>(numValues, -3.0, 17.0, 1);
+  auto temperature = MakeValues<vtkm::Float32>(numValues, 250.0, 320.0, 2);
+  auto count = MakeValues<vtkm::Int32>(numValues, 0.0, 1000.0, 3);
+
+  vtkm::cont::DataSet dataSet;
+  dataSet.AddPointField("pressure", pressure);
+  dataSet.AddPointField("temperature", temperature);
+  dataSet.AddCellField("count", count);
+
+  vtkm::filter::density_estimate::Statistics filter;
+  filter.SetActiveField(0, "pressure");
+  filter.SetActiveField(1, "temperature");
+  filter.SetActiveField(2, "count", vtkm::cont::Field::Association::Cells);
+  filter.SetNumberOfBins(16);
+  auto result = filter.Execute(dataSet);
+
+  CheckStatistics(result, "pressure", pressure);
+  CheckStatistics(result, "temperature", temperature);
+  CheckStatistics(result, "count", count);
+  CheckAutoHistogram(result, "pressure", pressure, 16);
+  CheckAutoHistogram(result, "temperature", temperature, 16);
+  CheckAutoHistogram(result, "count", count, 16);
+
+  std::cout << "Testing fixed range against the Histogram filter." << std::endl;
+  filter.SetRange(vtkm::Range(-3.0, 17.0));
+  result = filter.Execute(dataSet);
+
+  vtkm::filter::density_estimate::Histogram histogram;
+  histogram.SetActiveField("pressure");
+  histogram.SetNumberOfBins(16);
+  histogram.SetRange(vtkm::Range(-3.0, 17.0));
+  auto expected = histogram.Execute(dataSet)
+                    .GetField("histogram")
+                    .GetData()
+                    .AsArrayHandle<vtkm::cont::ArrayHandle<vtkm::Id>>();
+  auto expectedPortal = expected.ReadPortal();
+  VTKM_TEST_ASSERT(GetBins(result, "pressure") ==
+                     std::vector<vtkm::Id>(vtkm::cont::ArrayPortalToIteratorBegin(expectedPortal),
+                                           vtkm::cont::ArrayPortalToIteratorEnd(expectedPortal)),
+                   "Fixed range histogram does not match Histogram filter");
+
+  std::cout << "Testing fixed range of length 0." << std::endl;
+  filter.SetRange(vtkm::Range(5.0, 5.0));
+  bool caught = false;
+  try
+  {
+    filter.Execute(dataSet);
+  }
+  catch (const vtkm::cont::ErrorBadValue&)
+  {
+    caught = true;
+  }
+  VTKM_TEST_ASSERT(caught, "Fixed range of length 0 not rejected");
+
+  std::cout << "Testing statistics without histogram." << std::endl;
+  filter.SetNumberOfBins(0);
+  result = filter.Execute(dataSet);
+  CheckStatistics(result, "pressure", pressure);
+  VTKM_TEST_ASSERT(!result.HasField("pressure_Histogram"), "Unexpected histogram");
+}
+
+void TestPartitionedDataSet()
+{
+  std::cout << "Testing merge of partitions with different ranges." << std::endl;
+  vtkm::cont::PartitionedDataSet input;
+  std::vector<vtkm::Float64> all;
+  const double ranges[3][2] = { { 0.0, 1.0 }, { 100.0, 1000.0 }, { -5.0, 5.0 } };
+  for (unsigned int p = 0; p < 3; ++p)
+  {
+    auto values = MakeValues<vtkm::Float64>(10000 + 1234 * p, ranges[p][0], ranges[p][1], 10 + p);
+    all.insert(all.end(), values.begin(), values.end());
+    vtkm::cont::DataSet partition;
+    partition.AddPointField("scalars", values);
+    input.AppendPartition(partition);
+  }
+
+  vtkm::filter::density_estimate::Statistics filter;
+  filter.SetActiveField("scalars");
+  filter.SetNumberOfBins(32);
+  auto result = filter.Execute(input);
+  VTKM_TEST_ASSERT(result.GetNumberOfPartitions() == 1, "Expecting 1 partition.");
+
+  CheckStatistics(result.GetPartition(0), "scalars", all);
+  CheckAutoHistogram(result.GetPartition(0), "scalars", all, 32);
+}
+
+void TestStatistics()
+{
+  TestSingleDataSet();
+  TestPartitionedDataSet();
+}
+
+} // anonymous namespace
+
+int UnitTestStatisticsFilter(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestStatistics, argc, argv);
+}
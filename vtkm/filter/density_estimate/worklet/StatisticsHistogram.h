@@ -0,0 +1,344 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_StatisticsHistogram_h
+#define vtk_m_worklet_StatisticsHistogram_h
+
+#include <vtkm/Math.h>
+#include <vtkm/Range.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/worklet/DescriptiveStatistics.h>
+#include <vtkm/worklet/DispatcherMapField.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <vector>
+
+namespace vtkm
+{
+namespace worklet
+{
+
+/// \brief Descriptive statistics and a histogram of a scalar array in a single pass.
+///
+/// The array is split into contiguous chunks. Each chunk is summarized by one
+/// invocation that owns a private `StatState` and a private set of histogram bins,
+/// so no atomics are needed and every value is read from memory only once (the
+/// histogram sweep reuses the chunk while it is still in cache). The per-chunk
+/// summaries are then merged pairwise in a tree.
+///
+/// When no fixed range is given, each chunk bins its values on a grid whose bin width
+/// is a power of two and whose bin edges are multiples of that width. Any two such
+/// grids can be merged exactly by coarsening the finer one, which is what makes a
+/// histogram without a prior range pass possible. The resulting bins cover the data,
+/// but `BinMin` and `BinDelta` are generally not the exact data range divided evenly.
+class StatisticsHistogram
+{
+public:
+  using StatStateType = vtkm::worklet::DescriptiveStatistics::StatState<vtkm::Float64>;
+
+  /// Summary of a set of values. `Bins` is empty when no histogram was requested.
+  struct Result
+  {
+    StatStateType Statistics;
+    std::vector<vtkm::Id> Bins;
+    vtkm::Float64 BinMin = 0;
+    vtkm::Float64 BinDelta = 0;
+
+    VTKM_CONT vtkm::Range GetBinRange() const
+    {
+      return vtkm::Range(
+        this->BinMin,
+        this->BinMin + this->BinDelta * static_cast<vtkm::Float64>(this->Bins.size()));
+    }
+  };
+
+  /// Width of the smallest power-of-two, edge-aligned grid that covers
+  /// `[minValue, maxValue]` with at most `numberOfBins` bins.
+  VTKM_EXEC_CONT static vtkm::Float64 AlignedBinDelta(vtkm::Float64 minValue,
+                                                      vtkm::Float64 maxValue,
+                                                      vtkm::Id numberOfBins)
+  {
+    const vtkm::Float64 span = maxValue - minValue;
+    vtkm::Float64 delta;
+    if (span > 0)
+    {
+      const vtkm::Float64 width = span / static_cast<vtkm::Float64>(numberOfBins);
+      delta = vtkm::Pow(2.0, vtkm::Ceil(vtkm::Log2(width)));
+    }
+    else
+    {
+      // Constant data: pick a width well below the magnitude of the value so that
+      // merging with other chunks can coarsen it as needed.
+      const vtkm::Float64 magnitude = vtkm::Max(vtkm::Abs(minValue), 1.0e-300);
+      delta = vtkm::Pow(2.0, vtkm::Floor(vtkm::Log2(magnitude)) - 40.0);
+    }
+    while (vtkm::Floor(maxValue / delta) - vtkm::Floor(minValue / delta) >=
+           static_cast<vtkm::Float64>(numberOfBins))
+    {
+      delta *= 2;
+    }
+    return delta;
+  }
+
+  class SummarizeChunk : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn chunkIndex,
+                                  WholeArrayIn values,
+                                  FieldOut statistics,
+                                  FieldOut binMin,
+                                  FieldOut binDelta,
+                                  WholeArrayOut bins);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5, _6);
+    using InputDomain = _1;
+
+    VTKM_CONT
+    SummarizeChunk(vtkm::Id chunkSize,
+                   vtkm::Id numberOfBins,
+                   const vtkm::Range& fixedRange)
+      : ChunkSize(chunkSize)
+      , NumberOfBins(numberOfBins)
+      , FixedMin(fixedRange.Min)
+      , FixedDelta(fixedRange.Length() /
+                   static_cast<vtkm::Float64>(vtkm::Max(numberOfBins, vtkm::Id(1))))
+      , AutoRange(!fixedRange.IsNonEmpty())
+    {
+    }
+
+    template <typename ValuesPortal, typename BinsPortal>
+    VTKM_EXEC void operator()(vtkm::Id chunk,
+                              const ValuesPortal& values,
+                              StatStateType& statistics,
+                              vtkm::Float64& binMin,
+                              vtkm::Float64& binDelta,
+                              const BinsPortal& bins) const
+    {
+      const vtkm::Id begin = chunk * this->ChunkSize;
+      const vtkm::Id end = vtkm::Min(begin + this->ChunkSize, values.GetNumberOfValues());
+
+      StatStateType state;
+      for (vtkm::Id i = begin; i < end; ++i)
+      {
+        state = state + StatStateType(static_cast<vtkm::Float64>(values.Get(i)));
+      }
+      statistics = state;
+
+      if (this->NumberOfBins <= 0)
+      {
+        binMin = binDelta = 0;
+        return;
+      }
+
+      vtkm::Float64 origin;
+      if (this->AutoRange)
+      {
+        binDelta = AlignedBinDelta(state.Min(), state.Max(), this->NumberOfBins);
+        binMin = vtkm::Floor(state.Min() / binDelta) * binDelta;
+        origin = vtkm::Floor(state.Min() / binDelta);
+      }
+      else
+      {
+        binMin = this->FixedMin;
+        binDelta = this->FixedDelta;
+        origin = 0;
+      }
+
+      const vtkm::Id offset = chunk * this->NumberOfBins;
+      for (vtkm::Id b = 0; b < this->NumberOfBins; ++b)
+      {
+        bins.Set(offset + b, 0);
+      }
+      for (vtkm::Id i = begin; i < end; ++i)
+      {
+        const vtkm::Float64 value = static_cast<vtkm::Float64>(values.Get(i));
+        vtkm::Id bin = this->AutoRange
+          ? static_cast<vtkm::Id>(vtkm::Floor(value / binDelta) - origin)
+          : static_cast<vtkm::Id>((value - binMin) / binDelta);
+        if (bin < 0)
+          bin = 0;
+        else if (bin >= this->NumberOfBins)
+          bin = this->NumberOfBins - 1;
+        bins.Set(offset + bin, bins.Get(offset + bin) + 1);
+      }
+    }
+
+  private:
+    vtkm::Id ChunkSize;
+    vtkm::Id NumberOfBins;
+    vtkm::Float64 FixedMin;
+    vtkm::Float64 FixedDelta;
+    bool AutoRange;
+  };
+
+  /// Summarize `field`. With `numberOfBins` of 0 only the statistics are computed.
+  /// If `range` is non-empty it fixes the histogram range (values outside it go to
+  /// the end bins) and must have a positive length; otherwise the grid is chosen as
+  /// described above.
+  template <typename FieldType, typename Storage>
+  VTKM_CONT static Result Run(const vtkm::cont::ArrayHandle<FieldType, Storage>& field,
+                              vtkm::Id numberOfBins,
+                              const vtkm::Range& range = vtkm::Range{})
+  {
+    if (numberOfBins < 0)
+    {
+      throw vtkm::cont::ErrorBadValue("Number of histogram bins must not be negative.");
+    }
+    // A fixed range of length 0 would make the bins 0 wide.
+    if ((numberOfBins > 0) && range.IsNonEmpty() && !(range.Length() > 0))
+    {
+      throw vtkm::cont::ErrorBadValue("Fixed histogram range must have a positive length.");
+    }
+
+    const vtkm::Id numberOfValues = field.GetNumberOfValues();
+    Result result;
+    result.Bins.assign(static_cast<std::size_t>(numberOfBins), 0);
+    if (range.IsNonEmpty())
+    {
+      result.BinMin = range.Min;
+      result.BinDelta =
+        range.Length() / static_cast<vtkm::Float64>(vtkm::Max(numberOfBins, vtkm::Id(1)));
+    }
+    if (numberOfValues == 0)
+    {
+      return result;
+    }
+
+    // Chunks should be large enough to amortize the per-chunk bins, while leaving
+    // enough of them to keep every thread busy.
+    const vtkm::Id minimumChunkSize = 4096;
+    const vtkm::Id maximumChunks = 1024;
+    const vtkm::Id chunkSize = vtkm::Max(minimumChunkSize, numberOfValues / maximumChunks + 1);
+    const vtkm::Id numberOfChunks = (numberOfValues + chunkSize - 1) / chunkSize;
+
+    vtkm::cont::ArrayHandle<StatStateType> chunkStatistics;
+    vtkm::cont::ArrayHandle<vtkm::Float64> chunkBinMin;
+    vtkm::cont::ArrayHandle<vtkm::Float64> chunkBinDelta;
+    vtkm::cont::ArrayHandle<vtkm::Id> chunkBins;
+    chunkBins.Allocate(numberOfChunks * numberOfBins);
+
+    vtkm::worklet::DispatcherMapField<SummarizeChunk> dispatcher(
+      SummarizeChunk(chunkSize, numberOfBins, range));
+    dispatcher.Invoke(vtkm::cont::ArrayHandleIndex(numberOfChunks),
+                      field,
+                      chunkStatistics,
+                      chunkBinMin,
+                      chunkBinDelta,
+                      chunkBins);
+
+    std::vector<Result> partial(static_cast<std::size_t>(numberOfChunks));
+    {
+      auto statPortal = chunkStatistics.ReadPortal();
+      auto minPortal = chunkBinMin.ReadPortal();
+      auto deltaPortal = chunkBinDelta.ReadPortal();
+      auto binsPortal = chunkBins.ReadPortal();
+      for (vtkm::Id chunk = 0; chunk < numberOfChunks; ++chunk)
+      {
+        Result& r = partial[static_cast<std::size_t>(chunk)];
+        r.Statistics = statPortal.Get(chunk);
+        r.BinMin = minPortal.Get(chunk);
+        r.BinDelta = deltaPortal.Get(chunk);
+        r.Bins.resize(static_cast<std::size_t>(numberOfBins));
+        for (vtkm::Id b = 0; b < numberOfBins; ++b)
+        {
+          r.Bins[static_cast<std::size_t>(b)] = binsPortal.Get(chunk * numberOfBins + b);
+        }
+      }
+    }
+
+    return Merge(partial, range.IsNonEmpty());
+  }
+
+  /// Merge summaries pairwise in a tree. Pass `fixedRange` as true when all summaries
+  /// were binned over the same fixed range; the bins are then simply added.
+  VTKM_CONT static Result Merge(std::vector<Result> parts, bool fixedRange)
+  {
+    if (parts.empty())
+    {
+      return Result{};
+    }
+    for (std::size_t stride = 1; stride < parts.size(); stride *= 2)
+    {
+      for (std::size_t i = 0; i + stride < parts.size(); i += 2 * stride)
+      {
+        parts[i] = Merge(parts[i], parts[i + stride], fixedRange);
+      }
+    }
+    return parts[0];
+  }
+
+  VTKM_CONT static Result Merge(const Result& x, const Result& y, bool fixedRange)
+  {
+    if (x.Statistics.N() == 0)
+    {
+      return y;
+    }
+    if (y.Statistics.N() == 0)
+    {
+      return x;
+    }
+
+    Result result;
+    result.Statistics = x.Statistics + y.Statistics;
+    const std::size_t numberOfBins = x.Bins.size();
+    result.Bins.assign(numberOfBins, 0);
+    if (numberOfBins == 0)
+    {
+      return result;
+    }
+
+    if (fixedRange)
+    {
+      result.BinMin = x.BinMin;
+      result.BinDelta = x.BinDelta;
+      for (std::size_t b = 0; b < numberOfBins; ++b)
+      {
+        result.Bins[b] = x.Bins[b] + y.Bins[b];
+      }
+      return result;
+    }
+
+    // Both grids have power-of-two widths with edges on multiples of the width, so
+    // every bin of the finer grid falls entirely inside one bin of the coarser one.
+    const vtkm::Float64 minValue = result.Statistics.Min();
+    const vtkm::Float64 maxValue = result.Statistics.Max();
+    vtkm::Float64 delta = vtkm::Max(x.BinDelta, y.BinDelta);
+    while (vtkm::Floor(maxValue / delta) - vtkm::Floor(minValue / delta) >=
+           static_cast<vtkm::Float64>(numberOfBins))
+    {
+      delta *= 2;
+    }
+    const vtkm::Float64 origin = vtkm::Floor(minValue / delta);
+    result.BinMin = origin * delta;
+    result.BinDelta = delta;
+
+    for (const Result* part : { &x, &y })
+    {
+      const vtkm::Float64 partOrigin = part->BinMin / part->BinDelta;
+      const vtkm::Float64 scale = part->BinDelta / delta;
+      for (std::size_t b = 0; b < numberOfBins; ++b)
+      {
+        if (part->Bins[b] == 0)
+        {
+          continue;
+        }
+        const vtkm::Float64 fine = partOrigin + static_cast<vtkm::Float64>(b);
+        auto bin = static_cast<std::size_t>(vtkm::Floor(fine * scale) - origin);
+        result.Bins[vtkm::Min(bin, numberOfBins - 1)] += part->Bins[b];
+      }
+    }
+    return result;
+  }
+};
+}
+} // namespace vtkm::worklet
+
+#endif // vtk_m_worklet_StatisticsHistogram_h
@@ -7,6 +7,7 @@
 //  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
+#include <vtkm/cont/Logging.h>
 #include <vtkm/filter/MapFieldPermutation.h>
 #include <vtkm/filter/entity_extraction/Threshold.h>
 #include <vtkm/filter/entity_extraction/worklet/Threshold.h>
@@ -72,8 +73,23 @@ namespace filter
 namespace entity_extraction
 {
 //-----------------------------------------------------------------------------
-vtkm::cont::DataSet Threshold::DoExecute(const vtkm::cont::DataSet& input)
+vtkm::cont::DataSet Threshold::DoExecute(const vtkm::cont::DataSet& inDataSet)
 {
+  vtkm::cont::DataSet input = inDataSet;
+  if (this->CellIndex)
+  {
+    if (this->CellIndex->IsValidFor(inDataSet, this->GetActiveFieldName()))
+    {
+      input = this->CellIndex->ExtractCandidates(
+        inDataSet, { vtkm::Range(this->GetLowerThreshold(), this->GetUpperThreshold()) });
+    }
+    else
+    {
+      VTKM_LOG_S(vtkm::cont::LogLevel::Info,
+                 "Threshold: active cell index not valid for field " << this->GetActiveFieldName());
+    }
+  }
+
   //get the cells and coordinates of the dataset
   const vtkm::cont::UnknownCellSet& cells = input.GetCellSet();
   const auto& field = this->GetFieldFromDataSet(input);
@@ -11,9 +11,12 @@
 #ifndef vtk_m_filter_entity_extraction_Threshold_h
 #define vtk_m_filter_entity_extraction_Threshold_h
 
+#include <vtkm/filter/ActiveCellIndex.h>
 #include <vtkm/filter/NewFilterField.h>
 #include <vtkm/filter/entity_extraction/vtkm_filter_entity_extraction_export.h>
 
+#include <memory>
+
 namespace vtkm
 {
 namespace filter
@@ -51,6 +54,19 @@ public:
   VTKM_CONT
   bool GetAllInRange() const { return this->ReturnAllInRange; }
 
+  /// Set/Get an index of the cells of the input. When the index is valid for the active
+  /// field, only the cells that may pass the threshold are processed.
+  VTKM_CONT
+  void SetActiveCellIndex(const std::shared_ptr<vtkm::filter::ActiveCellIndex>& index)
+  {
+    this->CellIndex = index;
+  }
+  VTKM_CONT
+  const std::shared_ptr<vtkm::filter::ActiveCellIndex>& GetActiveCellIndex() const
+  {
+    return this->CellIndex;
+  }
+
 private:
   VTKM_CONT
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
@@ -58,6 +74,7 @@ private:
   double LowerValue = 0;
   double UpperValue = 0;
   bool ReturnAllInRange = false;
+  std::shared_ptr<vtkm::filter::ActiveCellIndex> CellIndex;
 };
 } // namespace entity_extraction
 class VTKM_DEPRECATED(1.8, "Use vtkm::filter::entity_extraction::Threshold.") Threshold
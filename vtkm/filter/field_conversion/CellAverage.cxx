@@ -10,8 +10,32 @@
 #include <vtkm/cont/ErrorFilterExecution.h>
 #include <vtkm/cont/UnknownCellSet.h>
 #include <vtkm/filter/field_conversion/CellAverage.h>
+#include <vtkm/filter/field_conversion/worklet/AverageFields.h>
 #include <vtkm/filter/field_conversion/worklet/CellAverage.h>
 
+namespace
+{
+
+vtkm::cont::UnknownArrayHandle AverageField(const vtkm::cont::UnknownCellSet& inputCellSet,
+                                            const vtkm::cont::Field& field)
+{
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::UnknownArrayHandle outArray;
+
+  auto resolveType = [&](const auto& concrete) {
+    using T = typename std::decay_t<decltype(concrete)>::ValueType;
+    vtkm::cont::ArrayHandle<T> result;
+    invoke(vtkm::worklet::CellAverage{}, inputCellSet, concrete, result);
+    outArray = result;
+  };
+  field.GetData()
+    .CastAndCallForTypesWithFloatFallback<vtkm::TypeListField, VTKM_DEFAULT_STORAGE_LIST>(
+      resolveType);
+  return outArray;
+}
+
+} // anonymous namespace
+
 namespace vtkm
 {
 namespace filter
@@ -21,24 +45,48 @@ namespace field_conversion
 //-----------------------------------------------------------------------------
 vtkm::cont::DataSet CellAverage::DoExecute(const vtkm::cont::DataSet& input)
 {
+  vtkm::cont::UnknownCellSet inputCellSet = input.GetCellSet();
+
+  if (this->FieldsToAverage.GetMode() != vtkm::filter::FieldSelection::Mode::None)
+  {
+    std::vector<vtkm::cont::Field> fields;
+    std::vector<vtkm::cont::UnknownArrayHandle> arrays;
+    for (vtkm::IdComponent fieldIndex = 0; fieldIndex < input.GetNumberOfFields(); ++fieldIndex)
+    {
+      const vtkm::cont::Field& field = input.GetField(fieldIndex);
+      if (field.IsFieldPoint() && this->FieldsToAverage.IsFieldSelected(field))
+      {
+        fields.push_back(field);
+        arrays.push_back(field.GetData());
+      }
+    }
+
+    std::vector<vtkm::cont::UnknownArrayHandle> averages =
+      vtkm::worklet::AverageFields::Run(vtkm::worklet::CellAverageComponents{},
+                                        inputCellSet,
+                                        arrays,
+                                        inputCellSet.GetNumberOfCells());
+
+    vtkm::cont::DataSet output = this->CreateResult(input);
+    for (std::size_t fieldIndex = 0; fieldIndex < fields.size(); ++fieldIndex)
+    {
+      if (!averages[fieldIndex].IsValid())
+      {
+        // Fields of other types are converted like the active field.
+        averages[fieldIndex] = AverageField(inputCellSet, fields[fieldIndex]);
+      }
+      output.AddCellField(fields[fieldIndex].GetName(), averages[fieldIndex]);
+    }
+    return output;
+  }
+
   const auto& field = GetFieldFromDataSet(input);
   if (!field.IsFieldPoint())
   {
     throw vtkm::cont::ErrorFilterExecution("Point field expected.");
   }
 
-  vtkm::cont::UnknownCellSet inputCellSet = input.GetCellSet();
-  vtkm::cont::UnknownArrayHandle outArray;
-
-  auto resolveType = [&](const auto& concrete) {
-    using T = typename std::decay_t<decltype(concrete)>::ValueType;
-    vtkm::cont::ArrayHandle<T> result;
-    this->Invoke(vtkm::worklet::CellAverage{}, inputCellSet, concrete, result);
-    outArray = result;
-  };
-  field.GetData()
-    .CastAndCallForTypesWithFloatFallback<vtkm::TypeListField, VTKM_DEFAULT_STORAGE_LIST>(
-      resolveType);
+  vtkm::cont::UnknownArrayHandle outArray = AverageField(inputCellSet, field);
 
   std::string outputName = this->GetOutputFieldName();
   if (outputName.empty())
@@ -12,35 +12,28 @@
 #include <vtkm/cont/UncertainCellSet.h>
 #include <vtkm/cont/UnknownCellSet.h>
 #include <vtkm/filter/field_conversion/PointAverage.h>
+#include <vtkm/filter/field_conversion/worklet/AverageFields.h>
 #include <vtkm/filter/field_conversion/worklet/PointAverage.h>
 
-namespace vtkm
-{
-namespace filter
-{
-namespace field_conversion
+namespace
 {
-vtkm::cont::DataSet PointAverage::DoExecute(const vtkm::cont::DataSet& input)
-{
-  const auto& field = GetFieldFromDataSet(input);
-  if (!field.IsFieldCell())
-  {
-    throw vtkm::cont::ErrorFilterExecution("Cell field expected.");
-  }
 
-  vtkm::cont::UnknownCellSet cellSet = input.GetCellSet();
+using SupportedCellSets =
+  vtkm::ListAppend<vtkm::List<vtkm::cont::CellSetExtrude>, VTKM_DEFAULT_CELL_SET_LIST>;
+
+vtkm::cont::UnknownArrayHandle AverageField(const vtkm::cont::UnknownCellSet& cellSet,
+                                            const vtkm::cont::Field& field)
+{
+  vtkm::cont::Invoker invoke;
   vtkm::cont::UnknownArrayHandle outArray;
 
   auto resolveType = [&](const auto& concrete) {
     using T = typename std::decay_t<decltype(concrete)>::ValueType;
-    using SupportedCellSets =
-      vtkm::ListAppend<vtkm::List<vtkm::cont::CellSetExtrude>, VTKM_DEFAULT_CELL_SET_LIST>;
-
     vtkm::cont::ArrayHandle<T> result;
-    this->Invoke(vtkm::worklet::PointAverage{},
-                 cellSet.ResetCellSetList<SupportedCellSets>(),
-                 concrete,
-                 result);
+    invoke(vtkm::worklet::PointAverage{},
+           cellSet.ResetCellSetList<SupportedCellSets>(),
+           concrete,
+           result);
     outArray = result;
   };
   // TODO: Do we need to deal with XCG storage type explicitly?
@@ -48,6 +41,61 @@ vtkm::cont::DataSet PointAverage::DoExecute(const vtkm::cont::DataSet& input)
   field.GetData()
     .CastAndCallForTypesWithFloatFallback<vtkm::TypeListField, VTKM_DEFAULT_STORAGE_LIST>(
       resolveType);
+  return outArray;
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace filter
+{
+namespace field_conversion
+{
+vtkm::cont::DataSet PointAverage::DoExecute(const vtkm::cont::DataSet& input)
+{
+  vtkm::cont::UnknownCellSet cellSet = input.GetCellSet();
+
+  if (this->FieldsToAverage.GetMode() != vtkm::filter::FieldSelection::Mode::None)
+  {
+    std::vector<vtkm::cont::Field> fields;
+    std::vector<vtkm::cont::UnknownArrayHandle> arrays;
+    for (vtkm::IdComponent fieldIndex = 0; fieldIndex < input.GetNumberOfFields(); ++fieldIndex)
+    {
+      const vtkm::cont::Field& field = input.GetField(fieldIndex);
+      if (field.IsFieldCell() && this->FieldsToAverage.IsFieldSelected(field))
+      {
+        fields.push_back(field);
+        arrays.push_back(field.GetData());
+      }
+    }
+
+    std::vector<vtkm::cont::UnknownArrayHandle> averages =
+      vtkm::worklet::AverageFields::Run(vtkm::worklet::PointAverageComponents{},
+                                        cellSet.ResetCellSetList<SupportedCellSets>(),
+                                        arrays,
+                                        cellSet.GetNumberOfPoints());
+
+    vtkm::cont::DataSet output = this->CreateResult(input);
+    for (std::size_t fieldIndex = 0; fieldIndex < fields.size(); ++fieldIndex)
+    {
+      if (!averages[fieldIndex].IsValid())
+      {
+        // Fields of other types are converted like the active field.
+        averages[fieldIndex] = AverageField(cellSet, fields[fieldIndex]);
+      }
+      output.AddPointField(fields[fieldIndex].GetName(), averages[fieldIndex]);
+    }
+    return output;
+  }
+
+  const auto& field = GetFieldFromDataSet(input);
+  if (!field.IsFieldCell())
+  {
+    throw vtkm::cont::ErrorFilterExecution("Cell field expected.");
+  }
+
+  vtkm::cont::UnknownArrayHandle outArray = AverageField(cellSet, field);
 
   std::string outputName = this->GetOutputFieldName();
   if (outputName.empty())
@@ -26,10 +26,31 @@ namespace field_conversion
 /// specified per cell) into point data (i.e., data specified at cell
 /// points). The method of transformation is based on averaging the data
 /// values of all cells using a particular point.
+///
+/// By default only the active field is averaged. Setting a selection with
+/// `SetFieldsToAverage` instead averages every cell field it selects, keeping the
+/// name of each field (the output field name is ignored). All the fields are averaged
+/// in one traversal of the points per base component type.
+///
 class VTKM_FILTER_FIELD_CONVERSION_EXPORT PointAverage : public vtkm::filter::NewFilterField
 {
+public:
+  /// The cell fields averaged when the selection is not in `FieldSelection::Mode::None`
+  /// (the default, which averages only the active field).
+  ///
+  VTKM_CONT const vtkm::filter::FieldSelection& GetFieldsToAverage() const
+  {
+    return this->FieldsToAverage;
+  }
+  VTKM_CONT void SetFieldsToAverage(const vtkm::filter::FieldSelection& fields)
+  {
+    this->FieldsToAverage = fields;
+  }
+
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
+
+  vtkm::filter::FieldSelection FieldsToAverage{ vtkm::filter::FieldSelection::Mode::None };
 };
 } // namespace field_conversion
 class VTKM_DEPRECATED(1.8, "Use vtkm::filter::field_conversion::PointAverage.") PointAverage
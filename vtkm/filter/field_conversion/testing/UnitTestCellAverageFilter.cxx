@@ -12,6 +12,8 @@
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/field_conversion/CellAverage.h>
 
+#include <vector>
+
 namespace
 {
 
@@ -116,11 +118,53 @@ void TestCellAverageExplicit()
   }
 }
 
+void TestCellAverageMultipleFields()
+{
+  std::cout << "Testing CellAverage Filter on multiple fields" << std::endl;
+
+  vtkm::cont::testing::MakeTestDataSet testDataSet;
+  vtkm::cont::DataSet dataSet = testDataSet.Make3DUniformDataSet0();
+  const vtkm::Id numPoints = dataSet.GetNumberOfPoints();
+  std::vector<vtkm::Vec3f_64> vectors(static_cast<std::size_t>(numPoints));
+  std::vector<vtkm::Int32> ints(static_cast<std::size_t>(numPoints));
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+  {
+    const vtkm::Float64 value = static_cast<vtkm::Float64>(i);
+    vectors[i] = vtkm::Vec3f_64(0.5 * value, 1.0, -2.0 * value);
+    ints[i] = static_cast<vtkm::Int32>(3 * i);
+  }
+  dataSet.AddPointField("vectors", vectors);
+  dataSet.AddPointField("ints", ints);
+
+  vtkm::filter::field_conversion::CellAverage cellAverage;
+  cellAverage.SetFieldsToAverage({ "pointvar", "vectors", "ints", "cellvar" });
+  vtkm::cont::DataSet result = cellAverage.Execute(dataSet);
+
+  // The selected cell field is not a point field, so it is passed instead of averaged.
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetCellField("cellvar").GetData(),
+                                           dataSet.GetCellField("cellvar").GetData()));
+
+  for (const std::string name : { "pointvar", "vectors", "ints" })
+  {
+    VTKM_TEST_ASSERT(result.HasCellField(name), "Field ", name, " missing.");
+    vtkm::filter::field_conversion::CellAverage single;
+    single.SetActiveField(name);
+    vtkm::cont::DataSet expected = single.Execute(dataSet);
+    VTKM_TEST_ASSERT(result.GetCellField(name).GetData().GetValueTypeName() ==
+                     expected.GetCellField(name).GetData().GetValueTypeName());
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetCellField(name).GetData(),
+                                             expected.GetCellField(name).GetData()),
+                     "Wrong average of ",
+                     name);
+  }
+}
+
 void TestCellAverage()
 {
   TestCellAverageRegular2D();
   TestCellAverageRegular3D();
   TestCellAverageExplicit();
+  TestCellAverageMultipleFields();
 }
 }
 
@@ -12,6 +12,8 @@
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/field_conversion/PointAverage.h>
 
+#include <vector>
+
 namespace
 {
 
@@ -113,12 +115,54 @@ void TestPointAverageExplicit2()
   }
 }
 
+void TestPointAverageMultipleFields()
+{
+  std::cout << "Testing PointAverage Filter on multiple fields" << std::endl;
+
+  vtkm::cont::testing::MakeTestDataSet testDataSet;
+  vtkm::cont::DataSet dataSet = testDataSet.Make3DExplicitDataSet1();
+  const vtkm::Id numCells = dataSet.GetNumberOfCells();
+  std::vector<vtkm::Vec2f_32> vectors(static_cast<std::size_t>(numCells));
+  std::vector<vtkm::Float64> doubles(static_cast<std::size_t>(numCells));
+  std::vector<vtkm::UInt8> bytes(static_cast<std::size_t>(numCells));
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+  {
+    const vtkm::Float32 value = static_cast<vtkm::Float32>(i);
+    vectors[i] = vtkm::Vec2f_32(value, 10.0f - value);
+    doubles[i] = 0.25 * static_cast<vtkm::Float64>(i);
+    bytes[i] = static_cast<vtkm::UInt8>(7 * i);
+  }
+  dataSet.AddCellField("vectors", vectors);
+  dataSet.AddCellField("doubles", doubles);
+  dataSet.AddCellField("bytes", bytes);
+
+  vtkm::filter::field_conversion::PointAverage pointAverage;
+  pointAverage.SetFieldsToAverage(
+    vtkm::filter::FieldSelection("pointvar", vtkm::filter::FieldSelection::Mode::Exclude));
+  vtkm::cont::DataSet result = pointAverage.Execute(dataSet);
+
+  for (const std::string name : { "cellvar", "vectors", "doubles", "bytes" })
+  {
+    VTKM_TEST_ASSERT(result.HasPointField(name), "Field ", name, " missing.");
+    vtkm::filter::field_conversion::PointAverage single;
+    single.SetActiveField(name);
+    vtkm::cont::DataSet expected = single.Execute(dataSet);
+    VTKM_TEST_ASSERT(result.GetPointField(name).GetData().GetValueTypeName() ==
+                     expected.GetPointField(name).GetData().GetValueTypeName());
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetPointField(name).GetData(),
+                                             expected.GetPointField(name).GetData()),
+                     "Wrong average of ",
+                     name);
+  }
+}
+
 void TestPointAverage()
 {
   TestPointAverageUniform3D();
   TestPointAverageRegular3D();
   TestPointAverageExplicit1();
   TestPointAverageExplicit2();
+  TestPointAverageMultipleFields();
 }
 }
 
@@ -0,0 +1,86 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_AverageFields_h
+#define vtk_m_worklet_AverageFields_h
+
+#include <vtkm/TypeList.h>
+#include <vtkm/cont/ArrayHandleRecombineVec.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/UnknownArrayHandle.h>
+
+#include <vector>
+
+namespace vtkm
+{
+namespace worklet
+{
+
+/// \brief Averages many fields with one traversal of the topology.
+///
+/// The components of all the input arrays that share a base component type are gathered in a
+/// single `ArrayHandleRecombineVec` (one strided array per component, so no data are copied
+/// for basic and SOA arrays). A worklet such as `CellAverageComponents` is then invoked once
+/// per base component type, so the connectivity is read once for all the fields of that type
+/// rather than once per field.
+///
+struct AverageFields
+{
+  /// Invokes `worklet` on `cellSet` for all the `inputs`. The result for each input has the
+  /// same value type as the input and `numberOfOutputValues` values. Inputs with a base
+  /// component type outside of `vtkm::TypeListFieldScalar` are not averaged, and their
+  /// result is an invalid `UnknownArrayHandle`.
+  template <typename WorkletType, typename CellSetType>
+  VTKM_CONT static std::vector<vtkm::cont::UnknownArrayHandle> Run(
+    const WorkletType& worklet,
+    const CellSetType& cellSet,
+    const std::vector<vtkm::cont::UnknownArrayHandle>& inputs,
+    vtkm::Id numberOfOutputValues)
+  {
+    std::vector<vtkm::cont::UnknownArrayHandle> outputs(inputs.size());
+    vtkm::ListForEach(
+      [&](auto componentExample) {
+        using ComponentType = decltype(componentExample);
+        vtkm::cont::ArrayHandleRecombineVec<ComponentType> inComponents;
+        vtkm::cont::ArrayHandleRecombineVec<ComponentType> outComponents;
+        for (std::size_t fieldIndex = 0; fieldIndex < inputs.size(); ++fieldIndex)
+        {
+          const vtkm::cont::UnknownArrayHandle& input = inputs[fieldIndex];
+          if (!input.IsBaseComponentType<ComponentType>())
+          {
+            continue;
+          }
+          vtkm::cont::UnknownArrayHandle output = input.NewInstanceBasic();
+          output.Allocate(numberOfOutputValues);
+          for (vtkm::IdComponent componentIndex = 0;
+               componentIndex < input.GetNumberOfComponentsFlat();
+               ++componentIndex)
+          {
+            inComponents.AppendComponentArray(
+              input.ExtractComponent<ComponentType>(componentIndex, vtkm::CopyFlag::On));
+            outComponents.AppendComponentArray(
+              output.ExtractComponent<ComponentType>(componentIndex, vtkm::CopyFlag::Off));
+          }
+          outputs[fieldIndex] = output;
+        }
+        if (inComponents.GetNumberOfComponents() > 0)
+        {
+          vtkm::cont::Invoker invoke;
+          invoke(worklet, cellSet, inComponents, outComponents);
+        }
+      },
+      vtkm::TypeListFieldScalar{});
+    return outputs;
+  }
+};
+}
+} // namespace vtkm::worklet
+
+#endif // vtk_m_worklet_AverageFields_h
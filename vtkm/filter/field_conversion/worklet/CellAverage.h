@@ -74,6 +74,36 @@ private:
     this->RaiseError("CellAverage called with mismatched Vec sizes for CellAverage.");
   }
 };
+
+//functor that averages every component of the point values of a cell. It is used with
+//ArrayHandleRecombineVec to average the components of many fields in one pass.
+class CellAverageComponents : public vtkm::worklet::WorkletVisitCellsWithPoints
+{
+public:
+  using ControlSignature = void(CellSetIn cellset, FieldInPoint inPoints, FieldOutCell outCells);
+  using ExecutionSignature = void(PointCount, _2, _3);
+  using InputDomain = _1;
+
+  template <typename PointValueVecType, typename OutType>
+  VTKM_EXEC void operator()(const vtkm::IdComponent& numPoints,
+                            const PointValueVecType& pointValues,
+                            OutType& average) const
+  {
+    using OutComponentType = typename vtkm::VecTraits<OutType>::ComponentType;
+    const vtkm::IdComponent numComponents =
+      vtkm::VecTraits<OutType>::GetNumberOfComponents(average);
+    for (vtkm::IdComponent componentIndex = 0; componentIndex < numComponents; ++componentIndex)
+    {
+      OutComponentType sum = static_cast<OutComponentType>(pointValues[0][componentIndex]);
+      for (vtkm::IdComponent pointIndex = 1; pointIndex < numPoints; ++pointIndex)
+      {
+        sum = static_cast<OutComponentType>(sum + pointValues[pointIndex][componentIndex]);
+      }
+      average[componentIndex] =
+        static_cast<OutComponentType>(sum / static_cast<OutComponentType>(numPoints));
+    }
+  }
+};
 }
 } // namespace vtkm::worklet
 
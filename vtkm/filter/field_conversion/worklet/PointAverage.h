@@ -81,6 +81,41 @@ private:
     this->RaiseError("PointAverage called with mismatched Vec sizes for PointAverage.");
   }
 };
+
+//functor that averages every component of the cell values of a point. It is used with
+//ArrayHandleRecombineVec to average the components of many fields in one pass.
+class PointAverageComponents : public vtkm::worklet::WorkletVisitPointsWithCells
+{
+public:
+  using ControlSignature = void(CellSetIn cellset,
+                                FieldInCell inCellField,
+                                FieldOutPoint outPointField);
+  using ExecutionSignature = void(CellCount, _2, _3);
+  using InputDomain = _1;
+
+  template <typename CellValueVecType, typename OutType>
+  VTKM_EXEC void operator()(const vtkm::IdComponent& numCells,
+                            const CellValueVecType& cellValues,
+                            OutType& average) const
+  {
+    using OutComponentType = typename vtkm::VecTraits<OutType>::ComponentType;
+    const vtkm::IdComponent numComponents =
+      vtkm::VecTraits<OutType>::GetNumberOfComponents(average);
+    for (vtkm::IdComponent componentIndex = 0; componentIndex < numComponents; ++componentIndex)
+    {
+      OutComponentType sum = vtkm::TypeTraits<OutComponentType>::ZeroInitialization();
+      for (vtkm::IdComponent cellIndex = 0; cellIndex < numCells; ++cellIndex)
+      {
+        sum = static_cast<OutComponentType>(sum + cellValues[cellIndex][componentIndex]);
+      }
+      if (numCells != 0)
+      {
+        sum = static_cast<OutComponentType>(sum / static_cast<OutComponentType>(numCells));
+      }
+      average[componentIndex] = sum;
+    }
+  }
+};
 }
 } // namespace vtkm::worklet
 
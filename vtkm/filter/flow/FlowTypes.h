@@ -10,6 +10,8 @@
 #ifndef vtk_m_filter_flow_FlowTypes_h
 #define vtk_m_filter_flow_FlowTypes_h
 
+#include <vtkm/Math.h>
+
 namespace vtkm
 {
 namespace filter
@@ -20,6 +22,16 @@ enum class IntegrationSolverType
 {
   RK4_TYPE = 0,
   EULER_TYPE,
+  RK45_TYPE,
+};
+
+/// Error tolerances and step length bounds of the adaptive `RK45_TYPE` solver.
+struct AdaptiveStepParameters
+{
+  vtkm::FloatDefault Tolerance = static_cast<vtkm::FloatDefault>(1e-6);
+  vtkm::FloatDefault RelativeTolerance = static_cast<vtkm::FloatDefault>(1e-6);
+  vtkm::FloatDefault MinimumStepLength = 0;
+  vtkm::FloatDefault MaximumStepLength = vtkm::Infinity<vtkm::FloatDefault>();
 };
 
 enum class VectorFieldType
@@ -47,6 +47,14 @@ VTKM_CONT void NewFilterParticleAdvection::ValidateOptions() const
     throw vtkm::cont::ErrorFilterExecution("NumberOfSteps cannot be negative");
   if (this->StepSize < 0)
     throw vtkm::cont::ErrorFilterExecution("StepSize cannot be negative");
+  if (this->SolverType == vtkm::filter::flow::IntegrationSolverType::RK45_TYPE)
+  {
+    if (this->AdaptiveStep.Tolerance <= 0 && this->AdaptiveStep.RelativeTolerance <= 0)
+      throw vtkm::cont::ErrorFilterExecution("RK45 solver needs a positive tolerance");
+    if (this->AdaptiveStep.MinimumStepLength < 0 ||
+        this->AdaptiveStep.MaximumStepLength < this->AdaptiveStep.MinimumStepLength)
+      throw vtkm::cont::ErrorFilterExecution("Invalid RK45 step size range");
+  }
 }
 
 }
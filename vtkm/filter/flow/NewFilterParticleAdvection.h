@@ -57,6 +57,28 @@ public:
     this->SolverType = vtkm::filter::flow::IntegrationSolverType::EULER_TYPE;
   }
 
+  /// Use the adaptive Dormand-Prince RK45 solver. The step size is the length of the first
+  /// step of each particle and the number of steps counts the accepted steps. A step is
+  /// accepted when its error estimate is at most `tolerance` plus `relativeTolerance` times
+  /// the distance of the particle from the origin.
+  VTKM_CONT
+  void SetSolverRK45(vtkm::FloatDefault tolerance = static_cast<vtkm::FloatDefault>(1e-6),
+                     vtkm::FloatDefault relativeTolerance = static_cast<vtkm::FloatDefault>(1e-6))
+  {
+    this->SolverType = vtkm::filter::flow::IntegrationSolverType::RK45_TYPE;
+    this->AdaptiveStep.Tolerance = tolerance;
+    this->AdaptiveStep.RelativeTolerance = relativeTolerance;
+  }
+
+  /// Bounds of the step lengths chosen by the RK45 solver. A minimum of 0 (the default)
+  /// stands for a thousandth of the step size.
+  VTKM_CONT
+  void SetStepSizeRange(vtkm::FloatDefault minimum, vtkm::FloatDefault maximum)
+  {
+    this->AdaptiveStep.MinimumStepLength = minimum;
+    this->AdaptiveStep.MaximumStepLength = maximum;
+  }
+
   VTKM_CONT
   bool GetUseThreadedAlgorithm() { return this->UseThreadedAlgorithm; }
 
@@ -68,6 +90,7 @@ protected:
 
   VTKM_CONT virtual vtkm::filter::flow::FlowResultType GetResultType() const = 0;
 
+  vtkm::filter::flow::AdaptiveStepParameters AdaptiveStep;
   vtkm::Id NumberOfSteps = 0;
   vtkm::cont::UnknownArrayHandle Seeds;
   vtkm::filter::flow::IntegrationSolverType SolverType =
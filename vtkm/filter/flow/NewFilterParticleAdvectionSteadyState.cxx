@@ -61,6 +61,8 @@ VTKM_CONT vtkm::cont::PartitionedDataSet NewFilterParticleAdvectionSteadyState::
                                       this->SolverType,
                                       this->VecFieldType,
                                       this->GetResultType());
+  for (auto& integrator : dsi)
+    integrator.SetAdaptiveStepParameters(this->AdaptiveStep);
 
   vtkm::filter::flow::internal::ParticleAdvector<DSIType> pav(
     boundsMap, dsi, this->UseThreadedAlgorithm, this->GetResultType());
@@ -75,6 +75,8 @@ NewFilterParticleAdvectionUnsteadyState::DoExecutePartitions(
                                       this->SolverType,
                                       this->VecFieldType,
                                       this->GetResultType());
+  for (auto& integrator : dsi)
+    integrator.SetAdaptiveStepParameters(this->AdaptiveStep);
 
   vtkm::filter::flow::internal::ParticleAdvector<DSIType> pav(
     boundsMap, dsi, this->UseThreadedAlgorithm, this->GetResultType());
@@ -90,13 +90,16 @@ public:
   //Advect all the particles.
   virtual void Go()
   {
-    vtkm::filter::flow::internal::ParticleMessenger<ParticleType> messenger(
-      this->Comm, this->BoundsMap, 1, 128);
-
     vtkm::Id nLocal = static_cast<vtkm::Id>(this->Active.size() + this->Inactive.size());
     this->ComputeTotalNumParticles(nLocal);
 
-    while (this->TotalNumTerminatedParticles < this->TotalNumParticles)
+    vtkm::filter::flow::internal::ParticleMessenger<ParticleType> messenger(
+      this->Comm, this->BoundsMap, 1, 128);
+    messenger.SetTotalNumberOfParticles(this->TotalNumParticles);
+
+    //Only the messenger knows when all the ranks are done. A rank that terminated all the
+    //particles itself must still pass the done message on to the ranks below it.
+    while (!messenger.IsDone())
     {
       std::vector<ParticleType> v;
       vtkm::Id numTerm = 0, blockId = -1;
@@ -245,20 +248,12 @@ public:
     return numTerm;
   }
 
-  virtual bool GetBlockAndWait(const vtkm::Id& numLocalTerm)
+  virtual bool GetBlockAndWait(const vtkm::Id& vtkmNotUsed(numLocalTerm))
   {
-    //There are only two cases where blocking would deadlock.
-    //1. There are active particles.
-    //2. numLocalTerm + this->TotalNumberOfTerminatedParticles == this->TotalNumberOfParticles
-    //So, if neither are true, we can safely block and wait for communication to come in.
-
-    if (this->Active.empty() && this->Inactive.empty() &&
-        (numLocalTerm + this->TotalNumTerminatedParticles < this->TotalNumParticles))
-    {
-      return true;
-    }
-
-    return false;
+    //Blocking would deadlock if there are particles to advect or send. Otherwise, either
+    //particles or the done message will arrive. (The messenger does not block once it is
+    //done.)
+    return this->Active.empty() && this->Inactive.empty();
   }
 
   //Member data
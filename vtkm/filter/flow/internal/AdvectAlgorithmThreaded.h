@@ -11,12 +11,18 @@
 #ifndef vtk_m_filter_flow_internal_AdvectAlgorithmThreaded_h
 #define vtk_m_filter_flow_internal_AdvectAlgorithmThreaded_h
 
+#include <vtkm/cont/Logging.h>
 #include <vtkm/cont/PartitionedDataSet.h>
 #include <vtkm/filter/flow/internal/AdvectAlgorithm.h>
 #include <vtkm/filter/flow/internal/BoundsMap.h>
 #include <vtkm/filter/flow/internal/DataSetIntegrator.h>
+#include <vtkm/filter/flow/internal/LockFreeQueue.h>
 #include <vtkm/filter/flow/internal/ParticleMessenger.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <thread>
 
 namespace vtkm
@@ -28,21 +34,41 @@ namespace flow
 namespace internal
 {
 
+/// \brief Advects particles with worker threads while the calling thread communicates.
+///
+/// The blocks of the rank are divided round-robin among the worker threads, so a block is
+/// only ever advected by one thread. The communication thread owns all the bookkeeping of
+/// active, inactive and terminated particles. It hands work to the workers and receives
+/// their results through lock-free queues, and nobody waits on a mutex or condition
+/// variable: idle threads back off by spinning, yielding and sleeping briefly.
 template <typename DSIType, template <typename> class ResultType, typename ParticleType>
 class AdvectAlgorithmThreaded : public AdvectAlgorithm<DSIType, ResultType, ParticleType>
 {
+  using Superclass = AdvectAlgorithm<DSIType, ResultType, ParticleType>;
+  using Clock = std::chrono::steady_clock;
+
 public:
   AdvectAlgorithmThreaded(const vtkm::filter::flow::internal::BoundsMap& bm,
                           std::vector<DSIType>& blocks)
-    : AdvectAlgorithm<DSIType, ResultType, ParticleType>(bm, blocks)
+    : Superclass(bm, blocks)
     , Done(false)
-    , WorkerActivate(false)
+    , Results(ResultQueueSize)
   {
     //For threaded algorithm, the particles go out of scope in the Work method.
     //When this happens, they are destructed by the time the Manage thread gets them.
     //Set the copy flag so the std::vector is copied into the ArrayHandle
     for (auto& block : this->Blocks)
       block.SetCopySeedFlag(true);
+
+    //One worker per group of blocks. Leave a core for the communication thread.
+    std::size_t numCores = static_cast<std::size_t>(std::thread::hardware_concurrency());
+    std::size_t numWorkers = std::min(this->Blocks.size(), numCores > 1 ? numCores - 1 : 1);
+    numWorkers = std::max(numWorkers, std::size_t{ 1 });
+    for (std::size_t i = 0; i < numWorkers; i++)
+      this->WorkQueues.emplace_back(new LockFreeQueue<WorkItem>(WorkQueueSize));
+    this->WorkerTimes.resize(numWorkers);
+    for (std::size_t i = 0; i < this->Blocks.size(); i++)
+      this->BlockWorker[this->Blocks[i].GetID()] = i % numWorkers;
   }
 
   void Go() override
@@ -51,141 +77,178 @@ public:
     this->ComputeTotalNumParticles(nLocal);
 
     std::vector<std::thread> workerThreads;
-    workerThreads.emplace_back(std::thread(AdvectAlgorithmThreaded::Worker, this));
+    for (std::size_t i = 0; i < this->WorkQueues.size(); i++)
+      workerThreads.emplace_back(std::thread(AdvectAlgorithmThreaded::Worker, this, i));
     this->Manage();
 
-    //This will only work for 1 thread. For > 1, the Blocks will need a mutex.
-    VTKM_ASSERT(workerThreads.size() == 1);
     for (auto& t : workerThreads)
       t.join();
+
+    this->LogTimes();
   }
 
 protected:
-  bool GetActiveParticles(std::vector<ParticleType>& particles, vtkm::Id& blockId) override
-  {
-    std::lock_guard<std::mutex> lock(this->Mutex);
-    bool val = this->AdvectAlgorithm<DSIType, ResultType, ParticleType>::GetActiveParticles(
-      particles, blockId);
-    this->WorkerActivate = val;
-    return val;
-  }
+  static constexpr std::size_t WorkQueueSize = 64;
+  static constexpr std::size_t ResultQueueSize = 256;
 
-  void UpdateActive(const std::vector<ParticleType>& particles,
-                    const std::unordered_map<vtkm::Id, std::vector<vtkm::Id>>& idsMap) override
+  //Particles to advect in one block, with the candidate blocks of each particle.
+  struct WorkItem
   {
-    if (!particles.empty())
-    {
-      std::lock_guard<std::mutex> lock(this->Mutex);
-      this->AdvectAlgorithm<DSIType, ResultType, ParticleType>::UpdateActive(particles, idsMap);
+    vtkm::Id BlockId = -1;
+    std::vector<ParticleType> Particles;
+    std::unordered_map<vtkm::Id, std::vector<vtkm::Id>> BlockIDs;
+  };
 
-      //Let workers know there is new work
-      this->WorkerActivateCondition.notify_all();
-      this->WorkerActivate = true;
-    }
-  }
+  struct ResultItem
+  {
+    std::unique_ptr<DSIHelperInfoType> Info;
+  };
 
-  bool CheckDone()
+  //Seconds spent by a thread in each activity.
+  struct Times
   {
-    std::lock_guard<std::mutex> lock(this->Mutex);
-    return this->Done;
-  }
+    double Advect = 0;
+    double Communicate = 0;
+    double Wait = 0;
+  };
 
-  void SetDone()
+  static double Seconds(const Clock::time_point& start, const Clock::time_point& end)
   {
-    std::lock_guard<std::mutex> lock(this->Mutex);
-    this->Done = true;
-    this->WorkerActivateCondition.notify_all();
+    return std::chrono::duration<double>(end - start).count();
   }
 
-  static void Worker(AdvectAlgorithmThreaded* algo) { algo->Work(); }
+  static void Worker(AdvectAlgorithmThreaded* algo, std::size_t worker) { algo->Work(worker); }
 
-  void WorkerWait()
+  void Work(std::size_t worker)
   {
-    std::unique_lock<std::mutex> lock(this->Mutex);
-    this->WorkerActivateCondition.wait(lock, [this] { return WorkerActivate || Done; });
-  }
+    auto& queue = *this->WorkQueues[worker];
+    auto& times = this->WorkerTimes[worker];
+    SpinBackoff backoff;
+    WorkItem item;
 
-  void UpdateWorkerResult(vtkm::Id blockId, DSIHelperInfoType& b)
-  {
-    std::lock_guard<std::mutex> lock(this->Mutex);
-    auto& it = this->WorkerResults[blockId];
-    it.emplace_back(b);
+    auto waitStart = Clock::now();
+    while (!this->Done.load(std::memory_order_acquire))
+    {
+      if (!queue.TryPop(item))
+      {
+        backoff.Wait();
+        continue;
+      }
+      backoff.Reset();
+
+      auto start = Clock::now();
+      times.Wait += Seconds(waitStart, start);
+
+      auto& block = this->GetDataSet(item.BlockId);
+      std::unique_ptr<DSIHelperInfoType> bb(new DSIHelperInfoType(
+        DSIHelperInfo<ParticleType>(item.Particles, this->BoundsMap, item.BlockIDs)));
+      block.Advect(*bb, this->StepSize, this->NumberOfSteps);
+
+      waitStart = Clock::now();
+      times.Advect += Seconds(start, waitStart);
+      this->Results.Push(ResultItem{ std::move(bb) });
+    }
+    times.Wait += Seconds(waitStart, Clock::now());
   }
 
-  void Work()
+  //Hand the active particles to the workers that own their blocks. Particles whose
+  //worker queue is full stay active and are handed over in a later round.
+  bool DispatchActive()
   {
-    while (!this->CheckDone())
+    bool dispatched = false;
+    std::vector<ParticleType> notDispatched;
+    WorkItem item;
+    while (this->GetActiveParticles(item.Particles, item.BlockId))
     {
-      std::vector<ParticleType> v;
-      vtkm::Id blockId = -1;
-      if (this->GetActiveParticles(v, blockId))
+      item.BlockIDs.clear();
+      for (const auto& p : item.Particles)
+        item.BlockIDs[p.ID] = this->ParticleBlockIDsMap[p.ID];
+
+      if (this->WorkQueues[this->BlockWorker[item.BlockId]]->TryPush(std::move(item)))
       {
-        auto& block = this->GetDataSet(blockId);
-        DSIHelperInfoType bb =
-          DSIHelperInfo<ParticleType>(v, this->BoundsMap, this->ParticleBlockIDsMap);
-        block.Advect(bb, this->StepSize, this->NumberOfSteps);
-        this->UpdateWorkerResult(blockId, bb);
+        this->NumInFlight++;
+        dispatched = true;
+        item = WorkItem{};
       }
       else
-        this->WorkerWait();
+        notDispatched.insert(notDispatched.end(), item.Particles.begin(), item.Particles.end());
     }
+    this->Active = std::move(notDispatched);
+    return dispatched;
   }
 
   void Manage()
   {
     vtkm::filter::flow::internal::ParticleMessenger<ParticleType> messenger(
       this->Comm, this->BoundsMap, 1, 128);
+    messenger.SetTotalNumberOfParticles(this->TotalNumParticles);
+    SpinBackoff backoff;
 
-    while (this->TotalNumTerminatedParticles < this->TotalNumParticles)
+    //Only the messenger knows when all the ranks are done. A rank that terminated all the
+    //particles itself must still pass the done message on to the ranks below it.
+    while (!messenger.IsDone())
     {
-      std::unordered_map<vtkm::Id, std::vector<DSIHelperInfoType>> workerResults;
-      this->GetWorkerResults(workerResults);
-
       vtkm::Id numTerm = 0;
-      for (auto& it : workerResults)
+      bool progress = false;
+      ResultItem result;
+      while (this->Results.TryPop(result))
       {
-        for (auto& r : it.second)
-          numTerm += this->UpdateResult(r.Get<DSIHelperInfo<ParticleType>>());
+        numTerm += this->UpdateResult(result.Info->template Get<DSIHelperInfo<ParticleType>>());
+        this->NumInFlight--;
+        progress = true;
       }
+      progress |= this->DispatchActive();
 
+      auto start = Clock::now();
       vtkm::Id numTermMessages = 0;
       this->Communicate(messenger, numTerm, numTermMessages);
+      this->ManagerTimes.Communicate += Seconds(start, Clock::now());
+      progress |= (numTermMessages > 0) || !this->Active.empty();
 
       this->TotalNumTerminatedParticles += (numTerm + numTermMessages);
       if (this->TotalNumTerminatedParticles > this->TotalNumParticles)
         throw vtkm::cont::ErrorFilterExecution("Particle count error");
+
+      //Nothing happened: the workers are busy, so give them the core for a while.
+      if (progress)
+        backoff.Reset();
+      else
+      {
+        start = Clock::now();
+        backoff.Wait();
+        this->ManagerTimes.Wait += Seconds(start, Clock::now());
+      }
     }
 
     //Let the workers know that we are done.
-    this->SetDone();
+    this->Done.store(true, std::memory_order_release);
   }
 
   bool GetBlockAndWait(const vtkm::Id& numLocalTerm) override
   {
-    std::lock_guard<std::mutex> lock(this->Mutex);
-
-    return (
-      this->AdvectAlgorithm<DSIType, ResultType, ParticleType>::GetBlockAndWait(numLocalTerm) &&
-      !this->WorkerActivate && this->WorkerResults.empty());
+    return this->Superclass::GetBlockAndWait(numLocalTerm) && this->NumInFlight == 0;
   }
 
-  void GetWorkerResults(std::unordered_map<vtkm::Id, std::vector<DSIHelperInfoType>>& results)
+  void LogTimes() const
   {
-    results.clear();
-
-    std::lock_guard<std::mutex> lock(this->Mutex);
-    if (!this->WorkerResults.empty())
-    {
-      results = this->WorkerResults;
-      this->WorkerResults.clear();
-    }
+    VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+               "Rank " << this->Rank << " communication thread: communicate "
+                       << this->ManagerTimes.Communicate << "s, wait "
+                       << this->ManagerTimes.Wait << "s");
+    for (std::size_t i = 0; i < this->WorkerTimes.size(); i++)
+      VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+                 "Rank " << this->Rank << " worker " << i << ": advect "
+                         << this->WorkerTimes[i].Advect << "s, wait " << this->WorkerTimes[i].Wait
+                         << "s");
   }
 
   std::atomic<bool> Done;
-  std::mutex Mutex;
-  bool WorkerActivate;
-  std::condition_variable WorkerActivateCondition;
-  std::unordered_map<vtkm::Id, std::vector<DSIHelperInfoType>> WorkerResults;
+  std::unordered_map<vtkm::Id, std::size_t> BlockWorker;
+  Times ManagerTimes;
+  vtkm::Id NumInFlight = 0;
+  LockFreeQueue<ResultItem> Results;
+  std::vector<std::unique_ptr<LockFreeQueue<WorkItem>>> WorkQueues;
+  std::vector<Times> WorkerTimes;
 };
 
 }
@@ -19,6 +19,7 @@
 #include <vtkm/filter/flow/worklet/EulerIntegrator.h>
 #include <vtkm/filter/flow/worklet/IntegratorStatus.h>
 #include <vtkm/filter/flow/worklet/ParticleAdvection.h>
+#include <vtkm/filter/flow/worklet/RK45Integrator.h>
 #include <vtkm/filter/flow/worklet/RK4Integrator.h>
 #include <vtkm/filter/flow/worklet/Stepper.h>
 
@@ -90,6 +91,11 @@ public:
 
   VTKM_CONT vtkm::Id GetID() const { return this->Id; }
   VTKM_CONT void SetCopySeedFlag(bool val) { this->CopySeedArray = val; }
+  VTKM_CONT void SetAdaptiveStepParameters(
+    const vtkm::filter::flow::AdaptiveStepParameters& parameters)
+  {
+    this->AdaptiveStep = parameters;
+  }
 
   VTKM_CONT
   void Advect(DSIHelperInfoType& b,
@@ -130,6 +136,7 @@ protected:
 
   vtkm::Id Id;
   vtkm::filter::flow::IntegrationSolverType SolverType;
+  vtkm::filter::flow::AdaptiveStepParameters AdaptiveStep;
   vtkm::filter::flow::VectorFieldType VecFieldType;
   vtkm::filter::flow::FlowResultType AdvectionResType =
     vtkm::filter::flow::FlowResultType::UNKNOWN_TYPE;
@@ -287,6 +294,19 @@ VTKM_CONT inline bool DataSetIntegrator<Derived>::GetOutput(vtkm::cont::DataSet&
       vtkm::cont::ArrayCopy(conn, connectivity);
       cells.Fill(numPoints, vtkm::CELL_SHAPE_VERTEX, 1, connectivity);
       ds.SetCellSet(cells);
+
+      //Number of steps each particle took, mostly of interest for adaptive solvers.
+      vtkm::cont::ArrayHandle<vtkm::Id> numSteps;
+      numSteps.Allocate(numPoints);
+      auto stepsPortal = numSteps.WritePortal();
+      vtkm::Id index = 0;
+      for (const auto& particles : allParticles)
+      {
+        auto portal = particles.ReadPortal();
+        for (vtkm::Id i = 0; i < portal.GetNumberOfValues(); i++)
+          stepsPortal.Set(index++, portal.Get(i).NumSteps);
+      }
+      ds.AddPointField("NumberOfSteps", numSteps);
     }
   }
   else if (this->IsStreamlineResult())
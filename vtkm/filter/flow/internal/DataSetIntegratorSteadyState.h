@@ -92,6 +92,7 @@ public:
                      vtkm::FloatDefault stepSize,
                      vtkm::Id maxSteps,
                      const IntegrationSolverType& solverType,
+                     const AdaptiveStepParameters& adaptiveStep,
                      vtkm::worklet::flow::ParticleAdvectionResult<ParticleType>& result)
   {
     if (solverType == IntegrationSolverType::RK4_TYPE)
@@ -99,14 +100,21 @@ public:
       DoAdvect<vtkm::worklet::flow::ParticleAdvection,
                vtkm::worklet::flow::ParticleAdvectionResult,
                vtkm::worklet::flow::RK4Integrator>(
-        velField, ds, seedArray, stepSize, maxSteps, result);
+        velField, ds, seedArray, stepSize, maxSteps, adaptiveStep, result);
     }
     else if (solverType == IntegrationSolverType::EULER_TYPE)
     {
       DoAdvect<vtkm::worklet::flow::ParticleAdvection,
                vtkm::worklet::flow::ParticleAdvectionResult,
                vtkm::worklet::flow::EulerIntegrator>(
-        velField, ds, seedArray, stepSize, maxSteps, result);
+        velField, ds, seedArray, stepSize, maxSteps, adaptiveStep, result);
+    }
+    else if (solverType == IntegrationSolverType::RK45_TYPE)
+    {
+      DoAdvect<vtkm::worklet::flow::ParticleAdvection,
+               vtkm::worklet::flow::ParticleAdvectionResult,
+               vtkm::worklet::flow::RK45Integrator>(
+        velField, ds, seedArray, stepSize, maxSteps, adaptiveStep, result);
     }
     else
       throw vtkm::cont::ErrorFilterExecution("Unsupported Integrator type");
@@ -118,6 +126,7 @@ public:
                      vtkm::FloatDefault stepSize,
                      vtkm::Id maxSteps,
                      const IntegrationSolverType& solverType,
+                     const AdaptiveStepParameters& adaptiveStep,
                      vtkm::worklet::flow::StreamlineResult<ParticleType>& result)
   {
     if (solverType == IntegrationSolverType::RK4_TYPE)
@@ -125,14 +134,21 @@ public:
       DoAdvect<vtkm::worklet::flow::Streamline,
                vtkm::worklet::flow::StreamlineResult,
                vtkm::worklet::flow::RK4Integrator>(
-        velField, ds, seedArray, stepSize, maxSteps, result);
+        velField, ds, seedArray, stepSize, maxSteps, adaptiveStep, result);
     }
     else if (solverType == IntegrationSolverType::EULER_TYPE)
     {
       DoAdvect<vtkm::worklet::flow::Streamline,
                vtkm::worklet::flow::StreamlineResult,
                vtkm::worklet::flow::EulerIntegrator>(
-        velField, ds, seedArray, stepSize, maxSteps, result);
+        velField, ds, seedArray, stepSize, maxSteps, adaptiveStep, result);
+    }
+    else if (solverType == IntegrationSolverType::RK45_TYPE)
+    {
+      DoAdvect<vtkm::worklet::flow::Streamline,
+               vtkm::worklet::flow::StreamlineResult,
+               vtkm::worklet::flow::RK45Integrator>(
+        velField, ds, seedArray, stepSize, maxSteps, adaptiveStep, result);
     }
     else
       throw vtkm::cont::ErrorFilterExecution("Unsupported Integrator type");
@@ -148,6 +164,7 @@ public:
                        vtkm::cont::ArrayHandle<ParticleType>& seedArray,
                        vtkm::FloatDefault stepSize,
                        vtkm::Id maxSteps,
+                       const AdaptiveStepParameters& adaptiveStep,
                        ResultType<ParticleType>& result)
   {
     using StepperType =
@@ -156,6 +173,9 @@ public:
     WorkletType worklet;
     SteadyStateGridEvalType eval(ds, velField);
     StepperType stepper(eval, stepSize);
+    stepper.SetTolerance(adaptiveStep.Tolerance);
+    stepper.SetRelativeTolerance(adaptiveStep.RelativeTolerance);
+    stepper.SetStepLengthRange(adaptiveStep.MinimumStepLength, adaptiveStep.MaximumStepLength);
     result = worklet.Run(stepper, seedArray, maxSteps);
   }
 };
@@ -181,15 +201,27 @@ VTKM_CONT inline void DataSetIntegratorSteadyState::DoAdvect(DSIHelperInfo<vtkm:
     if (this->IsParticleAdvectionResult())
     {
       vtkm::worklet::flow::ParticleAdvectionResult<vtkm::Particle> result;
-      AHType::Advect(
-        velField, this->DataSet, seedArray, stepSize, maxSteps, this->SolverType, result);
+      AHType::Advect(velField,
+                     this->DataSet,
+                     seedArray,
+                     stepSize,
+                     maxSteps,
+                     this->SolverType,
+                     this->AdaptiveStep,
+                     result);
       this->UpdateResult(result, b);
     }
     else if (this->IsStreamlineResult())
     {
       vtkm::worklet::flow::StreamlineResult<vtkm::Particle> result;
-      AHType::Advect(
-        velField, this->DataSet, seedArray, stepSize, maxSteps, this->SolverType, result);
+      AHType::Advect(velField,
+                     this->DataSet,
+                     seedArray,
+                     stepSize,
+                     maxSteps,
+                     this->SolverType,
+                     this->AdaptiveStep,
+                     result);
       this->UpdateResult(result, b);
     }
     else
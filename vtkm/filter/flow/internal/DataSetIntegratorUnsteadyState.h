@@ -115,6 +115,7 @@ public:
                      vtkm::FloatDefault stepSize,
                      vtkm::Id maxSteps,
                      const IntegrationSolverType& solverType,
+                     const AdaptiveStepParameters& adaptiveStep,
                      vtkm::worklet::flow::ParticleAdvectionResult<ParticleType>& result)
   {
     if (solverType == IntegrationSolverType::RK4_TYPE)
@@ -122,14 +123,51 @@ public:
       DoAdvect<vtkm::worklet::flow::ParticleAdvection,
                vtkm::worklet::flow::ParticleAdvectionResult,
                vtkm::worklet::flow::RK4Integrator>(
-        velField1, ds1, t1, velField2, ds2, t2, seedArray, stepSize, maxSteps, result);
+        velField1,
+        ds1,
+        t1,
+        velField2,
+        ds2,
+        t2,
+        seedArray,
+        stepSize,
+        maxSteps,
+        adaptiveStep,
+        result);
     }
     else if (solverType == IntegrationSolverType::EULER_TYPE)
     {
       DoAdvect<vtkm::worklet::flow::ParticleAdvection,
                vtkm::worklet::flow::ParticleAdvectionResult,
                vtkm::worklet::flow::EulerIntegrator>(
-        velField1, ds1, t1, velField2, ds2, t2, seedArray, stepSize, maxSteps, result);
+        velField1,
+        ds1,
+        t1,
+        velField2,
+        ds2,
+        t2,
+        seedArray,
+        stepSize,
+        maxSteps,
+        adaptiveStep,
+        result);
+    }
+    else if (solverType == IntegrationSolverType::RK45_TYPE)
+    {
+      DoAdvect<vtkm::worklet::flow::ParticleAdvection,
+               vtkm::worklet::flow::ParticleAdvectionResult,
+               vtkm::worklet::flow::RK45Integrator>(
+        velField1,
+        ds1,
+        t1,
+        velField2,
+        ds2,
+        t2,
+        seedArray,
+        stepSize,
+        maxSteps,
+        adaptiveStep,
+        result);
     }
     else
       throw vtkm::cont::ErrorFilterExecution("Unsupported Integrator type");
@@ -145,6 +183,7 @@ public:
                      vtkm::FloatDefault stepSize,
                      vtkm::Id maxSteps,
                      const IntegrationSolverType& solverType,
+                     const AdaptiveStepParameters& adaptiveStep,
                      vtkm::worklet::flow::StreamlineResult<ParticleType>& result)
   {
     if (solverType == IntegrationSolverType::RK4_TYPE)
@@ -152,14 +191,51 @@ public:
       DoAdvect<vtkm::worklet::flow::Streamline,
                vtkm::worklet::flow::StreamlineResult,
                vtkm::worklet::flow::RK4Integrator>(
-        velField1, ds1, t1, velField2, ds2, t2, seedArray, stepSize, maxSteps, result);
+        velField1,
+        ds1,
+        t1,
+        velField2,
+        ds2,
+        t2,
+        seedArray,
+        stepSize,
+        maxSteps,
+        adaptiveStep,
+        result);
     }
     else if (solverType == IntegrationSolverType::EULER_TYPE)
     {
       DoAdvect<vtkm::worklet::flow::Streamline,
                vtkm::worklet::flow::StreamlineResult,
                vtkm::worklet::flow::EulerIntegrator>(
-        velField1, ds1, t1, velField2, ds2, t2, seedArray, stepSize, maxSteps, result);
+        velField1,
+        ds1,
+        t1,
+        velField2,
+        ds2,
+        t2,
+        seedArray,
+        stepSize,
+        maxSteps,
+        adaptiveStep,
+        result);
+    }
+    else if (solverType == IntegrationSolverType::RK45_TYPE)
+    {
+      DoAdvect<vtkm::worklet::flow::Streamline,
+               vtkm::worklet::flow::StreamlineResult,
+               vtkm::worklet::flow::RK45Integrator>(
+        velField1,
+        ds1,
+        t1,
+        velField2,
+        ds2,
+        t2,
+        seedArray,
+        stepSize,
+        maxSteps,
+        adaptiveStep,
+        result);
     }
     else
       throw vtkm::cont::ErrorFilterExecution("Unsupported Integrator type");
@@ -179,6 +255,7 @@ public:
                        vtkm::cont::ArrayHandle<ParticleType>& seedArray,
                        vtkm::FloatDefault stepSize,
                        vtkm::Id maxSteps,
+                       const AdaptiveStepParameters& adaptiveStep,
                        ResultType<ParticleType>& result)
   {
     using StepperType = vtkm::worklet::flow::Stepper<SolverType<UnsteadyStateGridEvalType>,
@@ -187,6 +264,9 @@ public:
     WorkletType worklet;
     UnsteadyStateGridEvalType eval(ds1, t1, velField1, ds2, t2, velField2);
     StepperType stepper(eval, stepSize);
+    stepper.SetTolerance(adaptiveStep.Tolerance);
+    stepper.SetRelativeTolerance(adaptiveStep.RelativeTolerance);
+    stepper.SetStepLengthRange(adaptiveStep.MinimumStepLength, adaptiveStep.MaximumStepLength);
     result = worklet.Run(stepper, seedArray, maxSteps);
   }
 };
@@ -223,6 +303,7 @@ VTKM_CONT inline void DataSetIntegratorUnsteadyState::DoAdvect(DSIHelperInfo<vtk
                      stepSize,
                      maxSteps,
                      this->SolverType,
+                     this->AdaptiveStep,
                      result);
       this->UpdateResult(result, b);
     }
@@ -239,6 +320,7 @@ VTKM_CONT inline void DataSetIntegratorUnsteadyState::DoAdvect(DSIHelperInfo<vtk
                      stepSize,
                      maxSteps,
                      this->SolverType,
+                     this->AdaptiveStep,
                      result);
       this->UpdateResult(result, b);
     }
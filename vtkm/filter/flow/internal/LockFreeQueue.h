@@ -0,0 +1,166 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_filter_flow_internal_LockFreeQueue_h
+#define vtk_m_filter_flow_internal_LockFreeQueue_h
+
+#include <vtkm/Types.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace flow
+{
+namespace internal
+{
+
+/// Waits without a condition variable: spins briefly, then yields, then sleeps for
+/// increasingly long (but short) periods.
+class SpinBackoff
+{
+public:
+  void Wait()
+  {
+    if (this->Count < 16)
+    {
+      // Spin.
+    }
+    else if (this->Count < 64)
+      std::this_thread::yield();
+    else
+    {
+      vtkm::Id micro = vtkm::Id{ 1 } << std::min<vtkm::Id>((this->Count - 64) / 16, 8);
+      std::this_thread::sleep_for(std::chrono::microseconds(micro));
+    }
+    this->Count++;
+  }
+
+  void Reset() { this->Count = 0; }
+
+private:
+  vtkm::Id Count = 0;
+};
+
+/// \brief Bounded multi-producer multi-consumer queue that does not lock.
+///
+/// Every slot of the ring buffer has a sequence number that tells producers and consumers
+/// whether the slot is free or full for their position, so a push or pop only needs one
+/// compare-and-swap on the enqueue or dequeue position (Vyukov's bounded MPMC queue).
+/// `TryPush` and `TryPop` never block and return `false` when the queue is full or empty.
+template <typename T>
+class LockFreeQueue
+{
+public:
+  /// The capacity is rounded up to a power of two.
+  explicit LockFreeQueue(std::size_t capacity)
+  {
+    std::size_t size = 2;
+    while (size < capacity)
+      size *= 2;
+    this->Mask = size - 1;
+    this->Cells.reset(new Cell[size]);
+    for (std::size_t i = 0; i < size; i++)
+      this->Cells[i].Sequence.store(i, std::memory_order_relaxed);
+  }
+
+  LockFreeQueue(const LockFreeQueue&) = delete;
+  LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+  bool TryPush(T&& value)
+  {
+    std::size_t pos = this->EnqueuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true)
+    {
+      cell = &this->Cells[pos & this->Mask];
+      std::size_t seq = cell->Sequence.load(std::memory_order_acquire);
+      std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if (diff == 0)
+      {
+        if (this->EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+        return false;
+      else
+        pos = this->EnqueuePos.load(std::memory_order_relaxed);
+    }
+
+    cell->Data = std::move(value);
+    cell->Sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPop(T& value)
+  {
+    std::size_t pos = this->DequeuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true)
+    {
+      cell = &this->Cells[pos & this->Mask];
+      std::size_t seq = cell->Sequence.load(std::memory_order_acquire);
+      std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+      if (diff == 0)
+      {
+        if (this->DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+        return false;
+      else
+        pos = this->DequeuePos.load(std::memory_order_relaxed);
+    }
+
+    value = std::move(cell->Data);
+    cell->Data = T{};
+    cell->Sequence.store(pos + this->Mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Pushes `value`, backing off while the queue is full.
+  void Push(T&& value)
+  {
+    SpinBackoff backoff;
+    while (!this->TryPush(std::move(value)))
+      backoff.Wait();
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<std::size_t> Sequence;
+    T Data;
+  };
+
+  std::unique_ptr<Cell[]> Cells;
+  std::size_t Mask;
+  // Keep the positions on separate cache lines, as producers and consumers update them
+  // from different threads.
+  char Pad0[64];
+  std::atomic<std::size_t> EnqueuePos{ 0 };
+  char Pad1[64];
+  std::atomic<std::size_t> DequeuePos{ 0 };
+  char Pad2[64];
+};
+
+}
+}
+}
+} //vtkm::filter::flow::internal
+
+#endif //vtk_m_filter_flow_internal_LockFreeQueue_h
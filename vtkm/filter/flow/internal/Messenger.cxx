@@ -91,13 +91,40 @@ void Messenger::CleanupRequests(int tag)
     for (auto& v : delKeys)
     {
       char* buff = this->RecvBuffers[v];
-      MPI_Cancel(&(v.first));
+      MPI_Request req = v.first;
+      MPI_Cancel(&req);
+      MPI_Wait(&req, MPI_STATUS_IGNORE);
+      MPI_Request_free(&req);
       delete[] buff;
       this->RecvBuffers.erase(v);
     }
   }
 }
 
+char* Messenger::GetBuffer(std::size_t sz)
+{
+  auto it = this->BufferPool.find(sz);
+  if (it == this->BufferPool.end() || it->second.empty())
+    return new char[sz];
+
+  char* buff = it->second.back();
+  it->second.pop_back();
+  return buff;
+}
+
+void Messenger::ReleaseBuffer(char* buff, std::size_t sz)
+{
+  this->BufferPool[sz].emplace_back(buff);
+}
+
+void Messenger::FreeBufferPool()
+{
+  for (auto& it : this->BufferPool)
+    for (auto& buff : it.second)
+      delete[] buff;
+  this->BufferPool.clear();
+}
+
 void Messenger::PostRecv(int tag)
 {
   auto it = this->MessageTagInfo.find(tag);
@@ -111,11 +138,13 @@ void Messenger::PostRecv(int tag, std::size_t sz, int src)
   char* buff = new char[sz];
   memset(buff, 0, sz);
 
+  //The receives are persistent: they are restarted on the same buffer after every message.
   MPI_Request req;
   if (src == -1)
-    MPI_Irecv(buff, sz, MPI_BYTE, MPI_ANY_SOURCE, tag, this->MPIComm, &req);
+    MPI_Recv_init(buff, sz, MPI_BYTE, MPI_ANY_SOURCE, tag, this->MPIComm, &req);
   else
-    MPI_Irecv(buff, sz, MPI_BYTE, src, tag, this->MPIComm, &req);
+    MPI_Recv_init(buff, sz, MPI_BYTE, src, tag, this->MPIComm, &req);
+  MPI_Start(&req);
 
   RequestTagPair entry(req, tag);
   this->RecvBuffers[entry] = buff;
@@ -132,7 +161,9 @@ void Messenger::CheckPendingSendRequests()
     auto entry = this->SendBuffers.find(rt);
     if (entry != this->SendBuffers.end())
     {
-      delete[] entry->second;
+      Messenger::Header header;
+      memcpy(&header, entry->second, sizeof(header));
+      this->ReleaseBuffer(entry->second, header.packetSz);
       this->SendBuffers.erase(entry);
     }
   }
@@ -228,7 +259,7 @@ void Messenger::PrepareForSend(int tag,
       header.dataSz = maxDataLen;
 
     header.packetSz = header.dataSz + sizeof(header);
-    char* b = new char[header.packetSz];
+    char* b = this->GetBuffer(header.packetSz);
 
     //Write the header.
     char* bPtr = b;
@@ -304,14 +335,16 @@ bool Messenger::RecvData(const std::set<int>& tags,
       throw vtkm::cont::ErrorFilterExecution("receive buffer not found");
 
     incomingBuffers.emplace_back(it->second);
-    this->RecvBuffers.erase(it);
   }
 
   this->ProcessReceivedBuffers(incomingBuffers, buffers);
 
-  //Re-post receives
+  //Restart the receives on their buffers.
   for (const auto& rt : reqTags)
-    this->PostRecv(rt.second);
+  {
+    MPI_Request req = rt.first;
+    MPI_Start(&req);
+  }
 
   return !buffers.empty();
 }
@@ -333,13 +366,15 @@ void Messenger::ProcessReceivedBuffers(std::vector<char*>& incomingBuffers,
       entry.second.save_binary((char*)(buff + sizeof(header)), header.dataSz);
       entry.second.reset();
       buffers.emplace_back(std::move(entry));
-
-      delete[] buff;
     }
 
     //Multi packet....
     else
     {
+      //The receive buffer is reused, so keep a copy of the packet until the message is complete.
+      char* packet = this->GetBuffer(header.packetSz);
+      memcpy(packet, buff, header.packetSz);
+
       RankIdPair k(header.rank, header.id);
       auto i2 = this->RecvPackets.find(k);
 
@@ -347,12 +382,12 @@ void Messenger::ProcessReceivedBuffers(std::vector<char*>& incomingBuffers,
       if (i2 == this->RecvPackets.end())
       {
         std::list<char*> l;
-        l.emplace_back(buff);
+        l.emplace_back(packet);
         this->RecvPackets[k] = l;
       }
       else
       {
-        i2->second.emplace_back(buff);
+        i2->second.emplace_back(packet);
 
         // The last packet came in, merge into one MemStream.
         if (i2->second.size() == header.numPackets)
@@ -369,7 +404,7 @@ void Messenger::ProcessReceivedBuffers(std::vector<char*>& incomingBuffers,
             Messenger::Header header2;
             memcpy(&header2, bi, sizeof(header2));
             entry.second.save_binary((char*)(bi + sizeof(header2)), header2.dataSz);
-            delete[] bi;
+            this->ReleaseBuffer(bi, header2.packetSz);
           }
 
           entry.second.reset();
@@ -41,6 +41,7 @@ public:
   {
 #ifdef VTKM_ENABLE_MPI
     this->CleanupRequests();
+    this->FreeBufferPool();
 #endif
   }
 
@@ -65,6 +66,11 @@ private:
   void PostRecv(int tag);
   void PostRecv(int tag, std::size_t sz, int src = -1);
 
+  // Send buffers and the packets of partially received messages are recycled through a pool,
+  // so that a steady stream of messages does not allocate.
+  char* GetBuffer(std::size_t sz);
+  void ReleaseBuffer(char* buff, std::size_t sz);
+  void FreeBufferPool();
 
   //Message headers.
   typedef struct
@@ -89,6 +95,7 @@ private:
   std::map<int, std::pair<std::size_t, std::size_t>> MessageTagInfo;
   MPI_Comm MPIComm;
   std::size_t MsgID;
+  std::map<std::size_t, std::vector<char*>> BufferPool;
   int NumRanks;
   int Rank;
   std::map<RequestTagPair, char*> RecvBuffers;
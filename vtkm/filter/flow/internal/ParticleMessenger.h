@@ -16,6 +16,8 @@
 #include <vtkm/filter/flow/internal/Messenger.h>
 #include <vtkm/filter/flow/vtkm_filter_flow_export.h>
 
+#include <algorithm>
+#include <chrono>
 #include <list>
 #include <map>
 #include <set>
@@ -30,6 +32,18 @@ namespace flow
 namespace internal
 {
 
+/// \brief Exchanges particles and termination counts between ranks.
+///
+/// Outgoing particles are aggregated per destination rank and sent in batches. The batch size
+/// of each destination adapts to the traffic: it doubles when a batch fills up and halves when
+/// particles wait too long for a batch to fill. Pending particles are always sent before the
+/// rank blocks waiting for messages.
+///
+/// Termination is detected without involving all the ranks: the number of terminated particles
+/// is summed up a tree of ranks rooted at rank 0, and once rank 0 has counted all the particles
+/// (see `SetTotalNumberOfParticles`) it sends a done message down the tree. A rank is only done
+/// (see `IsDone`) once the done message reached it, even if it terminated all the particles
+/// itself, so that every rank passes the message on to its children.
 template <typename ParticleType>
 class VTKM_FILTER_FLOW_EXPORT ParticleMessenger : public vtkm::filter::flow::internal::Messenger
 {
@@ -50,6 +64,18 @@ public:
                               int numBlockIds = 2);
   VTKM_CONT ~ParticleMessenger() {}
 
+  /// The number of particles advected by all the ranks. Must be set before `Exchange` is called
+  /// on more than one rank.
+  VTKM_CONT void SetTotalNumberOfParticles(vtkm::Id num) { this->TotalNumberOfParticles = num; }
+
+  /// Whether all the particles have terminated. With more than one rank, this becomes true
+  /// when `Exchange` receives the done message, which it has passed on to the children of this
+  /// rank before returning. Advection should continue to call `Exchange` until then.
+  VTKM_CONT bool IsDone() const { return this->Done; }
+
+  /// How long a particle can wait for its batch to fill before it is sent anyway.
+  VTKM_CONT void SetMaximumDelay(std::chrono::microseconds delay) { this->MaximumDelay = delay; }
+
   VTKM_CONT void Exchange(const std::vector<ParticleType>& outData,
                           const std::unordered_map<vtkm::Id, std::vector<vtkm::Id>>& outBlockIDsMap,
                           vtkm::Id numLocalTerm,
@@ -60,7 +86,11 @@ public:
 
 protected:
 #ifdef VTKM_ENABLE_MPI
+  using Clock = std::chrono::steady_clock;
+
   static constexpr int MSG_TERMINATE = 1;
+  static constexpr int MSG_DONE = 2;
+  static constexpr int TERMINATION_TREE_FANOUT = 8;
 
   enum { MESSAGE_TAG = 0x42000, PARTICLE_TAG = 0x42001 };
 
@@ -90,10 +120,35 @@ protected:
   VTKM_CONT bool RecvAny(std::vector<MsgCommType>* msgs,
                          std::vector<ParticleRecvCommType>* recvParticles,
                          bool blockAndWait);
+
+  // Aggregation of outgoing particles.
+  VTKM_CONT void SendPendingParticles(bool sendAll);
+
+  // Termination detection.
+  VTKM_CONT void ReportTerminations();
+  VTKM_CONT int GetParentRank() const { return (this->GetRank() - 1) / TERMINATION_TREE_FANOUT; }
+
   const vtkm::filter::flow::internal::BoundsMap& BoundsMap;
 
+  struct PendingParticlesType
+  {
+    std::vector<ParticleCommType> Particles;
+    std::size_t BatchSize = 1;
+    Clock::time_point Since;
+  };
+  std::unordered_map<int, PendingParticlesType> PendingParticles;
+  std::size_t MaximumBatchSize;
+
+  bool DoneReported = false;
+  vtkm::Id NumTerminated = 0;
+  vtkm::Id NumUnreportedTerminated = 0;
 #endif
 
+  std::chrono::microseconds MaximumDelay{ 1000 };
+  vtkm::Id TotalNumberOfParticles = 0;
+  bool Done = false;
+  vtkm::Id NumLocalTerminated = 0;
+
   VTKM_CONT void SerialExchange(
     const std::vector<ParticleType>& outData,
     const std::unordered_map<vtkm::Id, std::vector<vtkm::Id>>& outBlockIDsMap,
@@ -118,6 +173,7 @@ ParticleMessenger<ParticleType>::ParticleMessenger(
   : Messenger(comm)
 #ifdef VTKM_ENABLE_MPI
   , BoundsMap(boundsMap)
+  , MaximumBatchSize(static_cast<std::size_t>(std::max(numParticles, 1)))
 #endif
 {
 #ifdef VTKM_ENABLE_MPI
@@ -193,27 +249,35 @@ void ParticleMessenger<ParticleType>::Exchange(
 {
   numTerminateMessages = 0;
   inDataBlockIDsMap.clear();
+  this->NumLocalTerminated += numLocalTerm;
 
   if (this->GetNumRanks() == 1)
+  {
+    this->Done = (this->NumLocalTerminated >= this->TotalNumberOfParticles);
     return this->SerialExchange(
       outData, outBlockIDsMap, numLocalTerm, inData, inDataBlockIDsMap, blockAndWait);
+  }
 
 #ifdef VTKM_ENABLE_MPI
 
-  //dstRank, vector of (particles,blockIDs)
-  std::unordered_map<int, std::vector<ParticleCommType>> sendData;
-
+  auto now = Clock::now();
   for (const auto& p : outData)
   {
     const auto& bids = outBlockIDsMap.find(p.ID)->second;
     int dstRank = this->BoundsMap.FindRank(bids[0]);
-    sendData[dstRank].emplace_back(std::make_pair(p, bids));
+    auto& pending = this->PendingParticles[dstRank];
+    if (pending.Particles.empty())
+      pending.Since = now;
+    pending.Particles.emplace_back(std::make_pair(p, bids));
   }
 
-  //Do all the sends first.
-  if (numLocalTerm > 0)
-    this->SendAllMsg({ MSG_TERMINATE, static_cast<int>(numLocalTerm) });
-  this->SendParticles(sendData);
+  this->NumUnreportedTerminated += numLocalTerm;
+  this->ReportTerminations();
+
+  if (this->Done)
+    blockAndWait = false;
+  //Never hold on to particles while waiting: the receivers might be waiting for them.
+  this->SendPendingParticles(blockAndWait);
   this->CheckPendingSendRequests();
 
   //Check if we have anything coming in.
@@ -233,13 +297,30 @@ void ParticleMessenger<ParticleType>::Exchange(
     for (const auto& m : msgData)
     {
       if (m.second[0] == MSG_TERMINATE)
-        numTerminateMessages += static_cast<vtkm::Id>(m.second[1]);
+        this->NumUnreportedTerminated += static_cast<vtkm::Id>(m.second[1]);
+      else if (m.second[0] == MSG_DONE)
+        this->Done = true;
     }
+    this->ReportTerminations();
+  }
+
+  //Pass the done message down the tree and account for the particles terminated elsewhere.
+  //This is the only place where the done message is reported, so every rank passes it on
+  //before it stops.
+  if (this->Done && !this->DoneReported)
+  {
+    for (int i = 1; i <= TERMINATION_TREE_FANOUT; i++)
+    {
+      int child = this->GetRank() * TERMINATION_TREE_FANOUT + i;
+      if (child < this->GetNumRanks())
+        this->SendMsg(child, { MSG_DONE });
+    }
+    this->DoneReported = true;
+    numTerminateMessages = this->TotalNumberOfParticles - this->NumLocalTerminated;
   }
 #endif
 }
 
-
 #ifdef VTKM_ENABLE_MPI
 
 VTKM_CONT
@@ -279,6 +360,51 @@ void ParticleMessenger<ParticleType>::SendAllMsg(const std::vector<int>& msg)
       this->SendMsg(i, msg);
 }
 
+VTKM_CONT
+template <typename ParticleType>
+void ParticleMessenger<ParticleType>::SendPendingParticles(bool sendAll)
+{
+  auto now = Clock::now();
+  for (auto& it : this->PendingParticles)
+  {
+    auto& pending = it.second;
+    if (pending.Particles.empty())
+      continue;
+
+    bool full = pending.Particles.size() >= pending.BatchSize;
+    bool late = (now - pending.Since) >= this->MaximumDelay;
+    if (!full && !late && !sendAll)
+      continue;
+
+    //Traffic to this rank is heavy enough to fill batches: make them bigger. Otherwise
+    //particles would wait for nothing, so make them smaller.
+    if (full)
+      pending.BatchSize = std::min(2 * pending.BatchSize, this->MaximumBatchSize);
+    else
+      pending.BatchSize = std::max(pending.BatchSize / 2, std::size_t{ 1 });
+
+    this->SendParticles(it.first, pending.Particles);
+    pending.Particles.clear();
+  }
+}
+
+VTKM_CONT
+template <typename ParticleType>
+void ParticleMessenger<ParticleType>::ReportTerminations()
+{
+  //The root also checks when nothing terminated, in case there are no particles at all.
+  if (this->GetRank() == 0)
+  {
+    this->NumTerminated += this->NumUnreportedTerminated;
+    if (this->NumTerminated >= this->TotalNumberOfParticles)
+      this->Done = true;
+  }
+  else if (this->NumUnreportedTerminated > 0)
+    this->SendMsg(this->GetParentRank(),
+                  { MSG_TERMINATE, static_cast<int>(this->NumUnreportedTerminated) });
+  this->NumUnreportedTerminated = 0;
+}
+
 VTKM_CONT
 template <typename ParticleType>
 bool ParticleMessenger<ParticleType>::RecvAny(std::vector<MsgCommType>* msgs,
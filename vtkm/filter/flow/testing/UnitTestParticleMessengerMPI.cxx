@@ -8,6 +8,7 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/Serialization.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/flow/internal/ParticleMessenger.h>
@@ -240,6 +241,110 @@ void TestParticleMessenger()
   comm.barrier();
 }
 
+void TestExchange()
+{
+  auto comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  if (comm.size() == 1)
+    return;
+
+  //One block per rank.
+  vtkm::cont::DataSet ds = vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(2, 2, 2));
+  vtkm::filter::flow::internal::BoundsMap boundsMap(ds);
+
+  //Every particle hops to other ranks a few times before it terminates. The hops are
+  //aggregated into batches, and every rank must learn when all the particles terminated.
+  constexpr vtkm::Id numParticlesPerRank = 200;
+  constexpr vtkm::IdComponent numHops = 5;
+  const vtkm::Id numRanks = comm.size();
+  const vtkm::Id rank = comm.rank();
+
+  vtkm::filter::flow::internal::ParticleMessenger<vtkm::Particle> messenger(comm, boundsMap);
+  messenger.SetTotalNumberOfParticles(numParticlesPerRank * numRanks);
+
+  std::vector<vtkm::Particle> active;
+  for (vtkm::Id i = 0; i < numParticlesPerRank; i++)
+    active.emplace_back(vtkm::Vec3f(0), rank * numParticlesPerRank + i);
+
+  vtkm::Id numTerminated = 0, numLocalTerminated = 0;
+  while (!messenger.IsDone())
+  {
+    std::vector<vtkm::Particle> outData;
+    std::unordered_map<vtkm::Id, std::vector<vtkm::Id>> outBlockIDs;
+    vtkm::Id numTerm = 0;
+    for (auto& p : active)
+    {
+      if (p.NumSteps == numHops)
+      {
+        numTerm++;
+        continue;
+      }
+      p.NumSteps++;
+      vtkm::Id dst = (rank + 1 + (p.ID + p.NumSteps) % (numRanks - 1)) % numRanks;
+      outData.emplace_back(p);
+      outBlockIDs[p.ID] = { dst };
+    }
+    numLocalTerminated += numTerm;
+
+    std::vector<vtkm::Particle> inData;
+    std::unordered_map<vtkm::Id, std::vector<vtkm::Id>> inBlockIDs;
+    vtkm::Id numTermMessages = 0;
+    bool blockAndWait = outData.empty();
+    messenger.Exchange(
+      outData, outBlockIDs, numTerm, inData, inBlockIDs, numTermMessages, blockAndWait);
+
+    for (const auto& p : inData)
+    {
+      VTKM_TEST_ASSERT(inBlockIDs[p.ID].size() == 1 && inBlockIDs[p.ID][0] == rank,
+                       "Particle received by the wrong rank.");
+      VTKM_TEST_ASSERT(p.NumSteps > 0 && p.NumSteps <= numHops, "Wrong number of hops.");
+    }
+    active = inData;
+    numTerminated += numTerm + numTermMessages;
+  }
+
+  VTKM_TEST_ASSERT(numTerminated == numParticlesPerRank * numRanks, "Wrong termination count.");
+  VTKM_TEST_ASSERT(active.empty(), "Particles left after termination.");
+
+  //Every particle terminates on the rank it hopped to last.
+  vtkm::Id totalLocalTerminated = 0;
+  vtkmdiy::mpi::all_reduce(comm, numLocalTerminated, totalLocalTerminated, std::plus<vtkm::Id>{});
+  VTKM_TEST_ASSERT(totalLocalTerminated == numParticlesPerRank * numRanks,
+                   "Particles terminated more than once.");
+  comm.barrier();
+}
+
+void TestExchangeLocalTermination()
+{
+  auto comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  if (comm.size() == 1)
+    return;
+
+  //All the particles start and terminate on rank 1, which counts all of them itself. It
+  //must still wait for the done message and pass it on to the ranks below it in the tree.
+  vtkm::cont::DataSet ds = vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(2, 2, 2));
+  vtkm::filter::flow::internal::BoundsMap boundsMap(ds);
+
+  constexpr vtkm::Id numParticles = 100;
+  vtkm::filter::flow::internal::ParticleMessenger<vtkm::Particle> messenger(comm, boundsMap);
+  messenger.SetTotalNumberOfParticles(numParticles);
+
+  vtkm::Id numLocal = (comm.rank() == 1) ? numParticles : 0;
+  vtkm::Id numTerminated = 0;
+  while (!messenger.IsDone())
+  {
+    std::vector<vtkm::Particle> inData;
+    std::unordered_map<vtkm::Id, std::vector<vtkm::Id>> inBlockIDs;
+    vtkm::Id numTermMessages = 0;
+    messenger.Exchange({}, {}, numLocal, inData, inBlockIDs, numTermMessages, true);
+    VTKM_TEST_ASSERT(inData.empty(), "No particles should be sent.");
+    numTerminated += numLocal + numTermMessages;
+    numLocal = 0;
+  }
+
+  VTKM_TEST_ASSERT(numTerminated == numParticles, "Wrong termination count.");
+  comm.barrier();
+}
+
 void TestBufferSizes()
 {
   //Make sure the buffer sizes are correct.
@@ -287,6 +392,8 @@ void TestParticleMessengerMPI()
 {
   TestBufferSizes();
   TestParticleMessenger();
+  TestExchange();
+  TestExchangeLocalTermination();
 }
 }
 
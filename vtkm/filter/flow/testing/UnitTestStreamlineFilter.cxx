@@ -87,6 +87,55 @@ void TestStreamline()
   }
 }
 
+void TestAdaptiveStep()
+{
+  // Rotation around the z axis, so particles move on circles at unit angular speed.
+  const vtkm::Id3 dims(21, 21, 3);
+  auto ds = vtkm::cont::DataSetBuilderUniform::Create(
+    dims, vtkm::Vec3f(-2, -2, 0), vtkm::Vec3f(0.2f, 0.2f, 0.5f));
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> vecField;
+  vecField.Allocate(ds.GetNumberOfPoints());
+  auto coords = ds.GetCoordinateSystem().GetDataAsMultiplexer().ReadPortal();
+  auto vecPortal = vecField.WritePortal();
+  for (vtkm::Id i = 0; i < ds.GetNumberOfPoints(); i++)
+    vecPortal.Set(i, vtkm::Vec3f(-coords.Get(i)[1], coords.Get(i)[0], 0));
+  ds.AddPointField("vec", vecField);
+
+  const vtkm::Id numSteps = 20;
+  const vtkm::FloatDefault stepSize = 0.001f;
+  auto Advect = [&](bool useRK45) {
+    vtkm::filter::flow::ParticleAdvection filter;
+    filter.SetStepSize(stepSize);
+    filter.SetNumberOfSteps(numSteps);
+    vtkm::cont::ArrayHandle<vtkm::Particle> seeds =
+      vtkm::cont::make_ArrayHandle({ vtkm::Particle(vtkm::Vec3f(1, 0, .5f), 0) });
+    filter.SetSeeds(seeds);
+    filter.SetActiveField("vec");
+    if (useRK45)
+    {
+      filter.SetSolverRK45(1e-7f, 0);
+      filter.SetStepSizeRange(0, 0.1f);
+    }
+    auto output = filter.Execute(ds);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> steps;
+    output.GetPointField("NumberOfSteps").GetData().AsArrayHandle(steps);
+    VTKM_TEST_ASSERT(steps.GetNumberOfValues() == 1 && steps.ReadPortal().Get(0) == numSteps,
+                     "Wrong number of steps");
+
+    vtkm::Vec3f pt = output.GetCoordinateSystem().GetDataAsMultiplexer().ReadPortal().Get(0);
+    VTKM_TEST_ASSERT(test_equal(vtkm::Magnitude(vtkm::Vec2f(pt[0], pt[1])), 1.0f, 1e-4),
+                     "Particle left the circle");
+    return vtkm::ATan2(pt[1], pt[0]);
+  };
+
+  // The fixed steps cover an angle of 0.02, while RK45 takes much longer steps.
+  auto rk4Angle = Advect(false);
+  VTKM_TEST_ASSERT(test_equal(rk4Angle, numSteps * stepSize), "Wrong RK4 end point");
+  auto rk45Angle = Advect(true);
+  VTKM_TEST_ASSERT(vtkm::Abs(rk45Angle) > 10 * rk4Angle, "RK45 did not increase step size");
+}
+
 void TestPathline()
 {
   const vtkm::Id3 dims(5, 5, 5);
@@ -326,7 +375,7 @@ void TestAMRStreamline(bool useSL)
   }
 }
 
-void TestPartitionedDataSet(vtkm::Id num, bool useGhost, FilterType fType)
+void TestPartitionedDataSet(vtkm::Id num, bool useGhost, FilterType fType, bool useThreaded)
 {
   vtkm::Id numDims = 5;
   vtkm::FloatDefault x0 = 0;
@@ -382,6 +431,7 @@ void TestPartitionedDataSet(vtkm::Id num, bool useGhost, FilterType fType)
         streamline.SetStepSize(0.1f);
         streamline.SetNumberOfSteps(100000);
         streamline.SetSeeds(seedArray);
+        streamline.SetUseThreadedAlgorithm(useThreaded);
 
         streamline.SetActiveField(fieldName);
         out = streamline.Execute(pds);
@@ -398,6 +448,7 @@ void TestPartitionedDataSet(vtkm::Id num, bool useGhost, FilterType fType)
         pathline.SetStepSize(0.1f);
         pathline.SetNumberOfSteps(100000);
         pathline.SetSeeds(seedArray);
+        pathline.SetUseThreadedAlgorithm(useThreaded);
 
         pathline.SetActiveField(fieldName);
         out = pathline.Execute(pds);
@@ -447,6 +498,7 @@ void TestPartitionedDataSet(vtkm::Id num, bool useGhost, FilterType fType)
         particleAdvection.SetStepSize(0.1f);
         particleAdvection.SetNumberOfSteps(100000);
         particleAdvection.SetSeeds(seedArray);
+        particleAdvection.SetUseThreadedAlgorithm(useThreaded);
 
         particleAdvection.SetActiveField(fieldName);
         out = particleAdvection.Execute(pds);
@@ -463,6 +515,7 @@ void TestPartitionedDataSet(vtkm::Id num, bool useGhost, FilterType fType)
         pathParticle.SetStepSize(0.1f);
         pathParticle.SetNumberOfSteps(100000);
         pathParticle.SetSeeds(seedArray);
+        pathParticle.SetUseThreadedAlgorithm(useThreaded);
 
         pathParticle.SetActiveField(fieldName);
         out = pathParticle.Execute(pds);
@@ -595,10 +648,12 @@ void TestStreamlineFilters()
   {
     for (auto useGhost : flags)
       for (auto ft : fTypes)
-        TestPartitionedDataSet(n, useGhost, ft);
+        for (auto useThreaded : flags)
+          TestPartitionedDataSet(n, useGhost, ft, useThreaded);
   }
 
   TestStreamline();
+  TestAdaptiveStep();
   TestPathline();
 
   for (auto useSL : flags)
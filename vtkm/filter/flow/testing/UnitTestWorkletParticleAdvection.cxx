@@ -19,6 +19,7 @@
 #include <vtkm/filter/flow/worklet/GridEvaluators.h>
 #include <vtkm/filter/flow/worklet/ParticleAdvection.h>
 #include <vtkm/filter/flow/worklet/Particles.h>
+#include <vtkm/filter/flow/worklet/RK45Integrator.h>
 #include <vtkm/filter/flow/worklet/RK4Integrator.h>
 #include <vtkm/filter/flow/worklet/Stepper.h>
 #include <vtkm/filter/mesh_info/GhostCellClassify.h>
@@ -510,6 +511,15 @@ void TestIntegrators()
       res = pa.Run(euler, seeds, maxSteps);
       ValidateParticleAdvectionResult(res, nSeeds, maxSteps);
     }
+    {
+      auto seeds = vtkm::cont::make_ArrayHandle(points, vtkm::CopyFlag::On);
+      using IntegratorType = vtkm::worklet::flow::RK45Integrator<GridEvalType>;
+      using Stepper = vtkm::worklet::flow::Stepper<IntegratorType, GridEvalType>;
+      Stepper rk45(eval, stepSize);
+      rk45.SetTolerance(1e-6f);
+      res = pa.Run(rk45, seeds, maxSteps);
+      ValidateParticleAdvectionResult(res, nSeeds, maxSteps);
+    }
   }
 }
 
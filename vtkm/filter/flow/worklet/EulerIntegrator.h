@@ -33,15 +33,27 @@ public:
   {
   }
 
+  using LastCell = typename EvaluatorType::LastCell;
+
   template <typename Particle>
   VTKM_EXEC IntegratorStatus CheckStep(Particle& particle,
                                        vtkm::FloatDefault stepLength,
                                        vtkm::Vec3f& velocity) const
+  {
+    LastCell lastCell;
+    return this->CheckStep(particle, stepLength, velocity, lastCell);
+  }
+
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus CheckStep(Particle& particle,
+                                       vtkm::FloatDefault stepLength,
+                                       vtkm::Vec3f& velocity,
+                                       LastCell& lastCell) const
   {
     auto time = particle.Time;
     auto inpos = particle.GetEvaluationPosition(stepLength);
     vtkm::VecVariable<vtkm::Vec3f, 2> vectors;
-    GridEvaluatorStatus status = this->Evaluator.Evaluate(inpos, time, vectors);
+    GridEvaluatorStatus status = this->Evaluator.Evaluate(inpos, time, vectors, lastCell);
     if (status.CheckOk())
       velocity = particle.Velocity(vectors, stepLength);
     return IntegratorStatus(status);
@@ -85,10 +85,24 @@ public:
                          : vtkm::NegativeInfinity<vtkm::FloatDefault>();
   }
 
+  /// Hint passed to the cell locator so that evaluating points near the previous point
+  /// (such as consecutive points of one particle) is fast.
+  using LastCell = typename vtkm::cont::CellLocatorGeneral::ExecObjType::LastCell;
+
   template <typename Point>
   VTKM_EXEC GridEvaluatorStatus Evaluate(const Point& point,
                                          const vtkm::FloatDefault& time,
                                          vtkm::VecVariable<Point, 2>& out) const
+  {
+    LastCell lastCell;
+    return this->Evaluate(point, time, out, lastCell);
+  }
+
+  template <typename Point>
+  VTKM_EXEC GridEvaluatorStatus Evaluate(const Point& point,
+                                         const vtkm::FloatDefault& time,
+                                         vtkm::VecVariable<Point, 2>& out,
+                                         LastCell& lastCell) const
   {
     vtkm::Id cellId = -1;
     Point parametric;
@@ -101,7 +115,7 @@ public:
       status.SetTemporalBounds();
     }
 
-    this->Locator.FindCell(point, cellId, parametric);
+    this->Locator.FindCell(point, cellId, parametric, lastCell);
     if (cellId == -1)
     {
       status.SetFail();
@@ -50,6 +50,10 @@ public:
     auto particle = integralCurve.GetParticle(idx);
     vtkm::FloatDefault time = particle.Time;
     bool tookAnySteps = false;
+    // Consecutive steps of a particle are usually in the same or neighboring cells.
+    typename IntegratorType::LastCell lastCell;
+    // Adaptive integrators change the step length from one step to the next.
+    vtkm::FloatDefault stepLength = integrator.GetStepLength();
 
     //the integrator status needs to be more robust:
     // 1. you could have success AND at temporal boundary.
@@ -60,7 +64,7 @@ public:
     {
       particle = integralCurve.GetParticle(idx);
       vtkm::Vec3f outpos;
-      auto status = integrator.Step(particle, time, outpos);
+      auto status = integrator.Step(particle, time, outpos, lastCell, stepLength);
       if (status.CheckOk())
       {
         integralCurve.StepUpdate(idx, particle, time, outpos);
@@ -71,7 +75,7 @@ public:
       //Try and take a step just past the boundary.
       else if (status.CheckSpatialBounds())
       {
-        status = integrator.SmallStep(particle, time, outpos);
+        status = integrator.SmallStep(particle, time, outpos, lastCell, stepLength);
         if (status.CheckOk())
         {
           integralCurve.StepUpdate(idx, particle, time, outpos);
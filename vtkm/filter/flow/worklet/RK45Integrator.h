@@ -0,0 +1,185 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+
+#ifndef vtk_m_filter_flow_worklet_RK45Integrator_h
+#define vtk_m_filter_flow_worklet_RK45Integrator_h
+
+#include <vtkm/filter/flow/worklet/GridEvaluatorStatus.h>
+#include <vtkm/filter/flow/worklet/IntegratorStatus.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace flow
+{
+
+/// Dormand-Prince Runge-Kutta integrator of order 5 with an embedded order 4 solution.
+/// The difference between the two solutions estimates the error of a step, which `Stepper`
+/// uses to adapt the step length of each particle to its tolerance.
+template <typename ExecEvaluatorType>
+class ExecRK45Integrator
+{
+public:
+  VTKM_EXEC_CONT
+  ExecRK45Integrator(const ExecEvaluatorType& evaluator)
+    : Evaluator(evaluator)
+  {
+  }
+
+  using LastCell = typename ExecEvaluatorType::LastCell;
+
+  /// Tells `Stepper` to choose the step length from the error estimate.
+  static constexpr bool IsAdaptive = true;
+
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus CheckStep(Particle& particle,
+                                       vtkm::FloatDefault stepLength,
+                                       vtkm::Vec3f& velocity) const
+  {
+    LastCell lastCell;
+    return this->CheckStep(particle, stepLength, velocity, lastCell);
+  }
+
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus CheckStep(Particle& particle,
+                                       vtkm::FloatDefault stepLength,
+                                       vtkm::Vec3f& velocity,
+                                       LastCell& lastCell) const
+  {
+    vtkm::Vec3f error;
+    return this->CheckStep(particle, stepLength, velocity, error, lastCell);
+  }
+
+  /// Computes the order 5 velocity of a step and `error`, the difference between the order 5
+  /// and order 4 displacements of the step.
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus CheckStep(Particle& particle,
+                                       vtkm::FloatDefault stepLength,
+                                       vtkm::Vec3f& velocity,
+                                       vtkm::Vec3f& error,
+                                       LastCell& lastCell) const
+  {
+    using T = vtkm::FloatDefault;
+
+    auto time = particle.Time;
+    auto inpos = particle.GetEvaluationPosition(stepLength);
+    vtkm::FloatDefault boundary = this->Evaluator.GetTemporalBoundary(static_cast<vtkm::Id>(1));
+    if ((time + stepLength + vtkm::Epsilon<vtkm::FloatDefault>() - boundary) > 0.0)
+      stepLength = boundary - time;
+    const T h = stepLength;
+
+    vtkm::Vec3f v1, v2, v3, v4, v5, v6, v7;
+    vtkm::VecVariable<vtkm::Vec3f, 2> k;
+    GridEvaluatorStatus evalStatus;
+
+    evalStatus = this->Evaluator.Evaluate(inpos, time, k, lastCell);
+    if (evalStatus.CheckFail())
+      return IntegratorStatus(evalStatus);
+    v1 = particle.Velocity(k, stepLength);
+
+    evalStatus =
+      this->Evaluator.Evaluate(inpos + h * (T(1) / T(5)) * v1, time + h * T(1) / T(5), k, lastCell);
+    if (evalStatus.CheckFail())
+      return IntegratorStatus(evalStatus);
+    v2 = particle.Velocity(k, stepLength);
+
+    evalStatus = this->Evaluator.Evaluate(inpos + h * ((T(3) / T(40)) * v1 + (T(9) / T(40)) * v2),
+                                          time + h * T(3) / T(10),
+                                          k,
+                                          lastCell);
+    if (evalStatus.CheckFail())
+      return IntegratorStatus(evalStatus);
+    v3 = particle.Velocity(k, stepLength);
+
+    evalStatus = this->Evaluator.Evaluate(
+      inpos + h * ((T(44) / T(45)) * v1 - (T(56) / T(15)) * v2 + (T(32) / T(9)) * v3),
+      time + h * T(4) / T(5),
+      k,
+      lastCell);
+    if (evalStatus.CheckFail())
+      return IntegratorStatus(evalStatus);
+    v4 = particle.Velocity(k, stepLength);
+
+    evalStatus = this->Evaluator.Evaluate(
+      inpos +
+        h * ((T(19372) / T(6561)) * v1 - (T(25360) / T(2187)) * v2 + (T(64448) / T(6561)) * v3 -
+             (T(212) / T(729)) * v4),
+      time + h * T(8) / T(9),
+      k,
+      lastCell);
+    if (evalStatus.CheckFail())
+      return IntegratorStatus(evalStatus);
+    v5 = particle.Velocity(k, stepLength);
+
+    evalStatus = this->Evaluator.Evaluate(
+      inpos +
+        h * ((T(9017) / T(3168)) * v1 - (T(355) / T(33)) * v2 + (T(46732) / T(5247)) * v3 +
+             (T(49) / T(176)) * v4 - (T(5103) / T(18656)) * v5),
+      time + h,
+      k,
+      lastCell);
+    if (evalStatus.CheckFail())
+      return IntegratorStatus(evalStatus);
+    v6 = particle.Velocity(k, stepLength);
+
+    velocity = (T(35) / T(384)) * v1 + (T(500) / T(1113)) * v3 + (T(125) / T(192)) * v4 -
+      (T(2187) / T(6784)) * v5 + (T(11) / T(84)) * v6;
+
+    // The last stage is evaluated at the order 5 solution and only serves the error estimate.
+    evalStatus = this->Evaluator.Evaluate(inpos + h * velocity, time + h, k, lastCell);
+    if (evalStatus.CheckFail())
+      return IntegratorStatus(evalStatus);
+    v7 = particle.Velocity(k, stepLength);
+
+    error = h *
+      ((T(71) / T(57600)) * v1 - (T(71) / T(16695)) * v3 + (T(71) / T(1920)) * v4 -
+       (T(17253) / T(339200)) * v5 + (T(22) / T(525)) * v6 - (T(1) / T(40)) * v7);
+
+    return IntegratorStatus(evalStatus);
+  }
+
+private:
+  ExecEvaluatorType Evaluator;
+};
+
+template <typename EvaluatorType>
+class RK45Integrator
+{
+private:
+  EvaluatorType Evaluator;
+
+public:
+  VTKM_CONT
+  RK45Integrator() = default;
+
+  VTKM_CONT
+  RK45Integrator(const EvaluatorType& evaluator)
+    : Evaluator(evaluator)
+  {
+  }
+
+  VTKM_CONT auto PrepareForExecution(vtkm::cont::DeviceAdapterId device,
+                                     vtkm::cont::Token& token) const
+    -> ExecRK45Integrator<decltype(this->Evaluator.PrepareForExecution(device, token))>
+  {
+    auto evaluator = this->Evaluator.PrepareForExecution(device, token);
+    using ExecEvaluatorType = decltype(evaluator);
+    return ExecRK45Integrator<ExecEvaluatorType>(evaluator);
+  }
+};
+
+}
+}
+} //vtkm::worklet::flow
+
+#endif // vtk_m_filter_flow_worklet_RK45Integrator_h
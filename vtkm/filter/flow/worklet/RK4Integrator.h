@@ -33,10 +33,22 @@ public:
   {
   }
 
+  using LastCell = typename ExecEvaluatorType::LastCell;
+
   template <typename Particle>
   VTKM_EXEC IntegratorStatus CheckStep(Particle& particle,
                                        vtkm::FloatDefault stepLength,
                                        vtkm::Vec3f& velocity) const
+  {
+    LastCell lastCell;
+    return this->CheckStep(particle, stepLength, velocity, lastCell);
+  }
+
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus CheckStep(Particle& particle,
+                                       vtkm::FloatDefault stepLength,
+                                       vtkm::Vec3f& velocity,
+                                       LastCell& lastCell) const
   {
     auto time = particle.Time;
     auto inpos = particle.GetEvaluationPosition(stepLength);
@@ -60,22 +72,22 @@ public:
 
     GridEvaluatorStatus evalStatus;
 
-    evalStatus = this->Evaluator.Evaluate(inpos, time, k1);
+    evalStatus = this->Evaluator.Evaluate(inpos, time, k1, lastCell);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus);
     v1 = particle.Velocity(k1, stepLength);
 
-    evalStatus = this->Evaluator.Evaluate(inpos + var1 * v1, var2, k2);
+    evalStatus = this->Evaluator.Evaluate(inpos + var1 * v1, var2, k2, lastCell);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus);
     v2 = particle.Velocity(k2, stepLength);
 
-    evalStatus = this->Evaluator.Evaluate(inpos + var1 * v2, var2, k3);
+    evalStatus = this->Evaluator.Evaluate(inpos + var1 * v2, var2, k3, lastCell);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus);
     v3 = particle.Velocity(k3, stepLength);
 
-    evalStatus = this->Evaluator.Evaluate(inpos + stepLength * v3, var3, k4);
+    evalStatus = this->Evaluator.Evaluate(inpos + stepLength * v3, var3, k4, lastCell);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus);
     v4 = particle.Velocity(k4, stepLength);
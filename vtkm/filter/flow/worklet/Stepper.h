@@ -18,6 +18,7 @@
 #include <vtkm/filter/flow/worklet/Particles.h>
 
 #include <limits>
+#include <type_traits>
 
 namespace vtkm
 {
@@ -26,6 +27,21 @@ namespace worklet
 namespace flow
 {
 
+namespace detail
+{
+template <typename ExecIntegratorType, typename = void>
+struct IsAdaptiveIntegrator : std::false_type
+{
+};
+
+template <typename ExecIntegratorType>
+struct IsAdaptiveIntegrator<ExecIntegratorType,
+                            typename std::enable_if<ExecIntegratorType::IsAdaptive>::type>
+  : std::true_type
+{
+};
+} // namespace detail
+
 template <typename ExecIntegratorType, typename ExecEvaluatorType>
 class StepperImpl
 {
@@ -34,27 +50,84 @@ private:
   ExecEvaluatorType Evaluator;
   vtkm::FloatDefault DeltaT;
   vtkm::FloatDefault Tolerance;
+  vtkm::FloatDefault RelativeTolerance;
+  vtkm::FloatDefault MinimumStepLength;
+  vtkm::FloatDefault MaximumStepLength;
 
 public:
   VTKM_EXEC_CONT
   StepperImpl(const ExecIntegratorType& integrator,
               const ExecEvaluatorType& evaluator,
               const vtkm::FloatDefault deltaT,
-              const vtkm::FloatDefault tolerance)
+              const vtkm::FloatDefault tolerance,
+              const vtkm::FloatDefault relativeTolerance = 0,
+              const vtkm::FloatDefault minimumStepLength = 0,
+              const vtkm::FloatDefault maximumStepLength = vtkm::Infinity<vtkm::FloatDefault>())
     : Integrator(integrator)
     , Evaluator(evaluator)
     , DeltaT(deltaT)
     , Tolerance(tolerance)
+    , RelativeTolerance(relativeTolerance)
+    , MinimumStepLength(minimumStepLength)
+    , MaximumStepLength(maximumStepLength)
   {
   }
 
+  /// The length of the first step of a particle.
+  VTKM_EXEC vtkm::FloatDefault GetStepLength() const { return this->DeltaT; }
+
+  /// Hint for the cell locator. Using the same `LastCell` for every step of a particle
+  /// makes finding the cells of the particle much faster.
+  using LastCell = typename ExecEvaluatorType::LastCell;
+
   template <typename Particle>
   VTKM_EXEC IntegratorStatus Step(Particle& particle,
                                   vtkm::FloatDefault& time,
                                   vtkm::Vec3f& outpos) const
+  {
+    LastCell lastCell;
+    return this->Step(particle, time, outpos, lastCell);
+  }
+
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus Step(Particle& particle,
+                                  vtkm::FloatDefault& time,
+                                  vtkm::Vec3f& outpos,
+                                  LastCell& lastCell) const
+  {
+    vtkm::FloatDefault stepLength = this->DeltaT;
+    return this->Step(particle, time, outpos, lastCell, stepLength);
+  }
+
+  /// `stepLength` is the length of the step to try. Adaptive integrators replace it with the
+  /// length to try for the next step of the particle; other integrators always step by the
+  /// step size of the `Stepper`.
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus Step(Particle& particle,
+                                  vtkm::FloatDefault& time,
+                                  vtkm::Vec3f& outpos,
+                                  LastCell& lastCell,
+                                  vtkm::FloatDefault& stepLength) const
+  {
+    return this->Step(particle,
+                      time,
+                      outpos,
+                      lastCell,
+                      stepLength,
+                      detail::IsAdaptiveIntegrator<ExecIntegratorType>{});
+  }
+
+private:
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus Step(Particle& particle,
+                                  vtkm::FloatDefault& time,
+                                  vtkm::Vec3f& outpos,
+                                  LastCell& lastCell,
+                                  vtkm::FloatDefault& vtkmNotUsed(stepLength),
+                                  std::false_type) const
   {
     vtkm::Vec3f velocity(0, 0, 0);
-    auto status = this->Integrator.CheckStep(particle, this->DeltaT, velocity);
+    auto status = this->Integrator.CheckStep(particle, this->DeltaT, velocity, lastCell);
     if (status.CheckOk())
     {
       outpos = particle.Pos + this->DeltaT * velocity;
@@ -66,25 +139,94 @@ public:
     return status;
   }
 
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus Step(Particle& particle,
+                                  vtkm::FloatDefault& time,
+                                  vtkm::Vec3f& outpos,
+                                  LastCell& lastCell,
+                                  vtkm::FloatDefault& stepLength,
+                                  std::true_type) const
+  {
+    using T = vtkm::FloatDefault;
+    // Limits on how much the step length changes from one try to the next.
+    const T safety = static_cast<T>(0.9);
+    const T minScale = static_cast<T>(0.2);
+    const T maxScale = static_cast<T>(5);
+
+    T h = vtkm::Min(vtkm::Max(stepLength, this->MinimumStepLength), this->MaximumStepLength);
+    while (true)
+    {
+      vtkm::Vec3f velocity(0, 0, 0);
+      vtkm::Vec3f error(0, 0, 0);
+      auto status = this->Integrator.CheckStep(particle, h, velocity, error, lastCell);
+      if (!status.CheckOk())
+      {
+        // Steps that leave the data are finished by `SmallStep`.
+        outpos = particle.Pos;
+        return status;
+      }
+
+      // Error relative to the tolerance. The step is accepted when it is at most one.
+      T scale = this->Tolerance + this->RelativeTolerance * vtkm::Magnitude(particle.Pos);
+      T ratio = vtkm::Magnitude(error) / vtkm::Max(scale, vtkm::Epsilon<T>());
+      T factor = (ratio > 0) ? safety * vtkm::Pow(ratio, static_cast<T>(-0.2)) : maxScale;
+      factor = vtkm::Min(vtkm::Max(factor, minScale), maxScale);
+
+      if (ratio <= 1 || h <= this->MinimumStepLength)
+      {
+        outpos = particle.Pos + h * velocity;
+        time += h;
+        stepLength =
+          vtkm::Min(vtkm::Max(h * factor, this->MinimumStepLength), this->MaximumStepLength);
+        return status;
+      }
+      h = vtkm::Max(h * factor, this->MinimumStepLength);
+    }
+  }
+
+public:
+
   template <typename Particle>
   VTKM_EXEC IntegratorStatus SmallStep(Particle& particle,
                                        vtkm::FloatDefault& time,
                                        vtkm::Vec3f& outpos) const
   {
-    //Stepping by this->DeltaT goes beyond the bounds of the dataset.
+    LastCell lastCell;
+    return this->SmallStep(particle, time, outpos, lastCell);
+  }
+
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus SmallStep(Particle& particle,
+                                       vtkm::FloatDefault& time,
+                                       vtkm::Vec3f& outpos,
+                                       LastCell& lastCell) const
+  {
+    return this->SmallStep(particle, time, outpos, lastCell, this->DeltaT);
+  }
+
+  /// `stepLength` is the length of the step that left the data, which for adaptive
+  /// integrators is the current step length of the particle.
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus SmallStep(Particle& particle,
+                                       vtkm::FloatDefault& time,
+                                       vtkm::Vec3f& outpos,
+                                       LastCell& lastCell,
+                                       vtkm::FloatDefault stepLength) const
+  {
+    //Stepping by stepLength goes beyond the bounds of the dataset.
     //We need to take an Euler step that goes outside of the dataset.
     //Use a binary search to find the largest step INSIDE the dataset.
     //Binary search uses a shrinking bracket of inside / outside, so when
     //we terminate, the outside value is the stepsize that will nudge
     //the particle outside the dataset.
 
-    //The binary search will be between {0, this->DeltaT}
-    vtkm::FloatDefault stepRange[2] = { 0, this->DeltaT };
+    //The binary search will be between {0, stepLength}
+    vtkm::FloatDefault stepRange[2] = { 0, stepLength };
 
-    vtkm::Vec3f currPos(particle.GetEvaluationPosition(this->DeltaT));
+    vtkm::Vec3f currPos(particle.GetEvaluationPosition(stepLength));
     vtkm::Vec3f currVelocity(0, 0, 0);
     vtkm::VecVariable<vtkm::Vec3f, 2> currValue, tmp;
-    auto evalStatus = this->Evaluator.Evaluate(currPos, particle.Time, currValue);
+    auto evalStatus = this->Evaluator.Evaluate(currPos, particle.Time, currValue, lastCell);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus);
 
@@ -94,16 +236,17 @@ public:
     {
       //Try a step midway between stepRange[0] and stepRange[1]
       div *= 2;
-      vtkm::FloatDefault currStep = stepRange[0] + (this->DeltaT / div);
+      vtkm::FloatDefault currStep = stepRange[0] + (stepLength / div);
 
       //See if we can step by currStep
-      IntegratorStatus status = this->Integrator.CheckStep(particle, currStep, currVelocity);
+      IntegratorStatus status =
+        this->Integrator.CheckStep(particle, currStep, currVelocity, lastCell);
 
       if (status.CheckOk()) //Integration step succedded.
       {
         //See if this point is in/out.
         auto newPos = particle.Pos + currStep * currVelocity;
-        evalStatus = this->Evaluator.Evaluate(newPos, particle.Time + currStep, tmp);
+        evalStatus = this->Evaluator.Evaluate(newPos, particle.Time + currStep, tmp, lastCell);
         if (evalStatus.CheckOk())
         {
           //Point still in. Update currPos and set range to {currStep, stepRange[1]}
@@ -124,7 +267,8 @@ public:
       }
     }
 
-    evalStatus = this->Evaluator.Evaluate(currPos, particle.Time + stepRange[0], currValue);
+    evalStatus =
+      this->Evaluator.Evaluate(currPos, particle.Time + stepRange[0], currValue, lastCell);
     // The eval at Time + stepRange[0] better be *inside*
     VTKM_ASSERT(evalStatus.CheckOk() && !evalStatus.CheckSpatialBounds());
     if (evalStatus.CheckFail() || evalStatus.CheckSpatialBounds())
@@ -135,7 +279,7 @@ public:
     time += stepRange[1];
 
     // Get the evaluation status for the point that is moved by the euler step.
-    evalStatus = this->Evaluator.Evaluate(outpos, time, currValue);
+    evalStatus = this->Evaluator.Evaluate(outpos, time, currValue, lastCell);
 
     IntegratorStatus status(evalStatus);
     status.SetOk(); //status is ok.
@@ -154,6 +298,9 @@ private:
   vtkm::FloatDefault DeltaT;
   vtkm::FloatDefault Tolerance =
     std::numeric_limits<vtkm::FloatDefault>::epsilon() * static_cast<vtkm::FloatDefault>(100.0f);
+  vtkm::FloatDefault RelativeTolerance = 0;
+  vtkm::FloatDefault MinimumStepLength = 0;
+  vtkm::FloatDefault MaximumStepLength = vtkm::Infinity<vtkm::FloatDefault>();
 
 public:
   VTKM_CONT
@@ -167,8 +314,26 @@ public:
   {
   }
 
+  /// Adaptive integrators accept a step when its error estimate is at most the tolerance
+  /// plus the relative tolerance times the distance of the particle from the origin.
   VTKM_CONT
   void SetTolerance(vtkm::FloatDefault tolerance) { this->Tolerance = tolerance; }
+  VTKM_CONT
+  void SetRelativeTolerance(vtkm::FloatDefault tolerance) { this->RelativeTolerance = tolerance; }
+
+  /// Bounds of the step lengths chosen by adaptive integrators. The step size given to the
+  /// constructor is the length of the first step. A minimum of 0 (the default) stands for
+  /// `DefaultMinimumStepFraction` times the first step, so that rejected steps cannot shrink
+  /// to nothing.
+  VTKM_CONT
+  void SetStepLengthRange(vtkm::FloatDefault minimum, vtkm::FloatDefault maximum)
+  {
+    this->MinimumStepLength = minimum;
+    this->MaximumStepLength = maximum;
+  }
+
+  static constexpr vtkm::FloatDefault DefaultMinimumStepFraction =
+    static_cast<vtkm::FloatDefault>(1e-3);
 
 public:
   /// Return the StepperImpl object
@@ -182,8 +347,16 @@ public:
     auto evaluator = this->Evaluator.PrepareForExecution(device, token);
     using ExecIntegratorType = decltype(integrator);
     using ExecEvaluatorType = decltype(evaluator);
-    return StepperImpl<ExecIntegratorType, ExecEvaluatorType>(
-      integrator, evaluator, this->DeltaT, this->Tolerance);
+    const vtkm::FloatDefault minimumStepLength = (this->MinimumStepLength > 0)
+      ? this->MinimumStepLength
+      : DefaultMinimumStepFraction * vtkm::Abs(this->DeltaT);
+    return StepperImpl<ExecIntegratorType, ExecEvaluatorType>(integrator,
+                                                              evaluator,
+                                                              this->DeltaT,
+                                                              this->Tolerance,
+                                                              this->RelativeTolerance,
+                                                              minimumStepLength,
+                                                              this->MaximumStepLength);
   }
 };
 
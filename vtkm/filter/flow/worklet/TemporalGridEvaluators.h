@@ -69,10 +69,26 @@ public:
     return direction > 0 ? this->TimeTwo : this->TimeOne;
   }
 
+  struct LastCell
+  {
+    typename ExecutionGridEvaluator::LastCell One;
+    typename ExecutionGridEvaluator::LastCell Two;
+  };
+
   template <typename Point>
   VTKM_EXEC GridEvaluatorStatus Evaluate(const Point& particle,
                                          vtkm::FloatDefault time,
                                          vtkm::VecVariable<Point, 2>& out) const
+  {
+    LastCell lastCell;
+    return this->Evaluate(particle, time, out, lastCell);
+  }
+
+  template <typename Point>
+  VTKM_EXEC GridEvaluatorStatus Evaluate(const Point& particle,
+                                         vtkm::FloatDefault time,
+                                         vtkm::VecVariable<Point, 2>& out,
+                                         LastCell& lastCell) const
   {
     // Validate time is in bounds for the current two slices.
     GridEvaluatorStatus status;
@@ -85,10 +101,10 @@ public:
     }
 
     vtkm::VecVariable<Point, 2> e1, e2;
-    status = this->EvaluatorOne.Evaluate(particle, time, e1);
+    status = this->EvaluatorOne.Evaluate(particle, time, e1, lastCell.One);
     if (status.CheckFail())
       return status;
-    status = this->EvaluatorTwo.Evaluate(particle, time, e2);
+    status = this->EvaluatorTwo.Evaluate(particle, time, e2, lastCell.Two);
     if (status.CheckFail())
       return status;
 
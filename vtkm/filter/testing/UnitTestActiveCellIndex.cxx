@@ -0,0 +1,228 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/ActiveCellIndex.h>
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/filter/clean_grid/CleanGrid.h>
+#include <vtkm/filter/contour/ClipWithField.h>
+#include <vtkm/filter/contour/Contour.h>
+#include <vtkm/filter/contour/Slice.h>
+#include <vtkm/filter/entity_extraction/Threshold.h>
+#include <vtkm/source/Tangle.h>
+
+namespace
+{
+
+vtkm::cont::DataSet MakeInput()
+{
+  vtkm::cont::DataSet tangle = vtkm::source::Tangle(vtkm::Id3(20, 22, 18)).Execute();
+  vtkm::filter::clean_grid::CleanGrid clean;
+  vtkm::cont::DataSet input = clean.Execute(tangle);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+  vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(input.GetNumberOfCells()), cellIds);
+  input.AddCellField("cellIds", cellIds);
+  return input;
+}
+
+void CheckSameOutput(const vtkm::cont::DataSet& expected, const vtkm::cont::DataSet& result)
+{
+  VTKM_TEST_ASSERT(result.GetNumberOfCells() == expected.GetNumberOfCells(),
+                   "Wrong number of cells: ",
+                   result.GetNumberOfCells(),
+                   " instead of ",
+                   expected.GetNumberOfCells());
+  VTKM_TEST_ASSERT(result.GetNumberOfPoints() == expected.GetNumberOfPoints(),
+                   "Wrong number of points");
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetCoordinateSystem().GetData(),
+                                           expected.GetCoordinateSystem().GetData()),
+                   "Wrong points");
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetCellField("cellIds").GetData(),
+                                           expected.GetCellField("cellIds").GetData()),
+                   "Wrong cell field");
+}
+
+void TestCandidates()
+{
+  std::cout << "Test candidate cells" << std::endl;
+  vtkm::cont::DataSet input = MakeInput();
+  vtkm::filter::ActiveCellIndex index;
+  index.SetCellsPerMetacell(16);
+  index.Build(input, "tangle");
+
+  const vtkm::Id numberOfCells = input.GetNumberOfCells();
+  VTKM_TEST_ASSERT(index.GetNumberOfMetacells() == (numberOfCells + 15) / 16);
+  VTKM_TEST_ASSERT(index.IsValidFor(input, "tangle"));
+  VTKM_TEST_ASSERT(!index.IsValidFor(input, "cellIds"));
+
+  vtkm::Range range = input.GetPointField("tangle").GetRange().ReadPortal().Get(0);
+  VTKM_TEST_ASSERT(index.GetCandidateCells({ range }).GetNumberOfValues() == numberOfCells);
+  VTKM_TEST_ASSERT(index.GetCandidateCells({ vtkm::Range(range.Max + 1, range.Max + 2) })
+                     .GetNumberOfValues() == 0);
+
+  auto candidates = index.GetCandidateCells({ vtkm::Range(range.Center(), range.Center()) });
+  VTKM_TEST_ASSERT(candidates.GetNumberOfValues() > 0);
+  VTKM_TEST_ASSERT(candidates.GetNumberOfValues() < numberOfCells / 2,
+                   "Too many candidates: ",
+                   candidates.GetNumberOfValues());
+  auto portal = candidates.ReadPortal();
+  for (vtkm::Id i = 1; i < portal.GetNumberOfValues(); ++i)
+  {
+    VTKM_TEST_ASSERT(portal.Get(i - 1) < portal.Get(i), "Candidates not sorted");
+  }
+
+  // Modifying the field invalidates the index.
+  vtkm::cont::ArrayHandle<vtkm::Float32> values;
+  input.GetPointField("tangle").GetData().AsArrayHandle(values);
+  values.WritePortal().Set(0, 10.0f);
+  VTKM_TEST_ASSERT(!index.IsValidFor(input, "tangle"));
+
+  vtkm::cont::DataSet other = MakeInput();
+  VTKM_TEST_ASSERT(!index.IsValidFor(other, "tangle"));
+
+  bool threw = false;
+  try
+  {
+    index.Build(input, "coordinates");
+  }
+  catch (const vtkm::cont::ErrorBadValue&)
+  {
+    threw = true;
+  }
+  VTKM_TEST_ASSERT(threw, "Vector field not rejected");
+}
+
+void TestFilters()
+{
+  std::cout << "Test filters with an index" << std::endl;
+  vtkm::cont::DataSet input = MakeInput();
+  auto index = std::make_shared<vtkm::filter::ActiveCellIndex>();
+  index->Build(input, "tangle");
+  vtkm::Range range = input.GetPointField("tangle").GetRange().ReadPortal().Get(0);
+
+  for (vtkm::Float64 fraction : { 0.2, 0.5, 0.7 })
+  {
+    const vtkm::Float64 value = range.Min + fraction * range.Length();
+
+    vtkm::filter::contour::Contour contour;
+    contour.SetActiveField("tangle");
+    contour.SetIsoValues({ value, value + 0.05 * range.Length() });
+    contour.SetFieldsToPass("cellIds");
+    vtkm::cont::DataSet expected = contour.Execute(input);
+    contour.SetActiveCellIndex(index);
+    CheckSameOutput(expected, contour.Execute(input));
+
+    for (bool invert : { false, true })
+    {
+      vtkm::filter::contour::ClipWithField clip;
+      clip.SetActiveField("tangle");
+      clip.SetClipValue(value);
+      clip.SetInvertClip(invert);
+      expected = clip.Execute(input);
+      clip.SetActiveCellIndex(index);
+      CheckSameOutput(expected, clip.Execute(input));
+    }
+
+    for (bool allInRange : { false, true })
+    {
+      vtkm::filter::entity_extraction::Threshold threshold;
+      threshold.SetActiveField("tangle");
+      threshold.SetLowerThreshold(value);
+      threshold.SetUpperThreshold(value + 0.1 * range.Length());
+      threshold.SetAllInRange(allInRange);
+      expected = threshold.Execute(input);
+      threshold.SetActiveCellIndex(index);
+      vtkm::cont::DataSet result = threshold.Execute(input);
+      VTKM_TEST_ASSERT(result.GetNumberOfCells() == expected.GetNumberOfCells());
+      VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetCellField("cellIds").GetData(),
+                                               expected.GetCellField("cellIds").GetData()));
+    }
+  }
+
+  // A stale index is ignored.
+  vtkm::cont::DataSet modified = MakeInput();
+  vtkm::filter::contour::Contour contour;
+  contour.SetActiveField("tangle");
+  contour.SetIsoValue(range.Center());
+  contour.SetFieldsToPass("cellIds");
+  vtkm::cont::DataSet expected = contour.Execute(modified);
+  contour.SetActiveCellIndex(index);
+  CheckSameOutput(expected, contour.Execute(modified));
+
+  // Structured cells are still contoured with flying edges, which gives the same points in
+  // the same order.
+  vtkm::cont::DataSet structured = vtkm::source::Tangle(vtkm::Id3(20, 22, 18)).Execute();
+  auto structuredIndex = std::make_shared<vtkm::filter::ActiveCellIndex>();
+  structuredIndex->Build(structured, "tangle");
+  contour.SetFieldsToPass(vtkm::filter::FieldSelection::Mode::None);
+  contour.SetActiveCellIndex(nullptr);
+  expected = contour.Execute(structured);
+  contour.SetActiveCellIndex(structuredIndex);
+  vtkm::cont::DataSet result = contour.Execute(structured);
+  VTKM_TEST_ASSERT(result.GetNumberOfCells() == expected.GetNumberOfCells());
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetCoordinateSystem().GetData(),
+                                           expected.GetCoordinateSystem().GetData()));
+}
+
+void TestSliceSweep()
+{
+  std::cout << "Test slice sweep with a plane index" << std::endl;
+  vtkm::cont::DataSet input = MakeInput();
+  const vtkm::Vec3f normal(0.3f, 0.4f, 1.0f);
+  auto index = std::make_shared<vtkm::filter::ActiveCellIndex>();
+  index->Build(input, vtkm::Plane(vtkm::Vec3f(0.5f), normal));
+  VTKM_TEST_ASSERT(!index->IsValidFor(input, "tangle"));
+
+  vtkm::filter::contour::Slice slice;
+  slice.SetFieldsToPass("cellIds");
+  for (vtkm::FloatDefault z : { 0.1f, 0.35f, 0.5f, 0.8f })
+  {
+    const vtkm::Plane plane(vtkm::Vec3f(0.2f, 0.6f, z), normal);
+    VTKM_TEST_ASSERT(index->IsValidFor(input, plane));
+
+    slice.SetImplicitFunction(plane);
+    slice.SetActiveCellIndex(nullptr);
+    vtkm::cont::DataSet expected = slice.Execute(input);
+    slice.SetActiveCellIndex(index);
+    vtkm::cont::DataSet result = slice.Execute(input);
+    VTKM_TEST_ASSERT(expected.GetNumberOfCells() > 0);
+    VTKM_TEST_ASSERT(result.GetNumberOfCells() == expected.GetNumberOfCells());
+    VTKM_TEST_ASSERT(result.GetNumberOfPoints() == expected.GetNumberOfPoints());
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(result.GetCellField("cellIds").GetData(),
+                                             expected.GetCellField("cellIds").GetData()));
+  }
+
+  // Planes that are not parallel to the indexed plane are sliced without the index.
+  const vtkm::Plane tilted(vtkm::Vec3f(0.5f), vtkm::Vec3f(1.0f, 0.0f, 0.0f));
+  VTKM_TEST_ASSERT(!index->IsValidFor(input, tilted));
+  slice.SetImplicitFunction(tilted);
+  slice.SetActiveCellIndex(nullptr);
+  vtkm::cont::DataSet expected = slice.Execute(input);
+  slice.SetActiveCellIndex(index);
+  CheckSameOutput(expected, slice.Execute(input));
+}
+
+void TestActiveCellIndex()
+{
+  TestCandidates();
+  TestFilters();
+  TestSliceSweep();
+}
+
+} // anonymous namespace
+
+int UnitTestActiveCellIndex(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestActiveCellIndex, argc, argv);
+}
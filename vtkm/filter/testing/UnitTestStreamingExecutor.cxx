@@ -0,0 +1,173 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/StreamingExecutor.h>
+
+#include <vtkm/CellClassification.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/filter/contour/Contour.h>
+#include <vtkm/filter/entity_extraction/GhostCellRemove.h>
+
+#include <algorithm>
+
+namespace
+{
+
+const vtkm::Id3 MinExtent{ -10, -12, -9 };
+const vtkm::Id3 MaxExtent{ 14, 11, 13 };
+
+// Generates any sub-extent of a sphere distance field consistently.
+vtkm::cont::DataSet Generate(const vtkm::Id3& minExtent, const vtkm::Id3& maxExtent)
+{
+  const vtkm::Id3 dims = maxExtent - minExtent + vtkm::Id3(1);
+  vtkm::cont::DataSet dataSet =
+    vtkm::cont::DataSetBuilderUniform::Create(dims, vtkm::Vec3f(minExtent), vtkm::Vec3f(1));
+
+  std::vector<vtkm::Float32> values;
+  values.reserve(static_cast<std::size_t>(dims[0] * dims[1] * dims[2]));
+  for (vtkm::Id k = minExtent[2]; k <= maxExtent[2]; ++k)
+  {
+    for (vtkm::Id j = minExtent[1]; j <= maxExtent[1]; ++j)
+    {
+      for (vtkm::Id i = minExtent[0]; i <= maxExtent[0]; ++i)
+      {
+        values.push_back(static_cast<vtkm::Float32>(vtkm::Sqrt(i * i + j * j + k * k + 0.5)));
+      }
+    }
+  }
+  dataSet.AddPointField("distance", values);
+  return dataSet;
+}
+
+vtkm::Id CountOwnedCells(const vtkm::cont::DataSet& dataSet)
+{
+  auto ghosts = dataSet.GetGhostCellField()
+                  .GetData()
+                  .AsArrayHandle<vtkm::cont::ArrayHandle<vtkm::UInt8>>()
+                  .ReadPortal();
+  vtkm::Id owned = 0;
+  for (vtkm::Id i = 0; i < ghosts.GetNumberOfValues(); ++i)
+  {
+    owned += (ghosts.Get(i) == vtkm::CellClassification::Normal) ? 1 : 0;
+  }
+  return owned;
+}
+
+void TestBrickSource()
+{
+  std::cout << "Testing UniformBrickSource" << std::endl;
+  vtkm::filter::UniformBrickSource source(MinExtent, MaxExtent, Generate);
+  source.SetBrickDimensions({ 8, 8, 8 });
+  VTKM_TEST_ASSERT(source.GetNumberOfPieces() == 3 * 3 * 3, "Wrong number of pieces");
+
+  vtkm::filter::StreamingExecutor executor;
+  const vtkm::Id ownedCells = executor.Reduce(
+    source, vtkm::Id{ 0 }, [](vtkm::Id count, const vtkm::cont::DataSet& piece) {
+      return count + CountOwnedCells(piece);
+    });
+  const vtkm::Id3 cells = MaxExtent - MinExtent;
+  VTKM_TEST_ASSERT(ownedCells == cells[0] * cells[1] * cells[2], "Cells not owned exactly once");
+
+  std::cout << "Testing brick size from memory budget" << std::endl;
+  // 1 MB at 64 bytes per point is 16384 points, or 25 points (22 cells and ghosts) per side.
+  source.SetBrickDimensionsForBudget(1 << 20, 64);
+  VTKM_TEST_ASSERT(source.GetBrickDimensions() == vtkm::Id3(22, 22, 22), "Wrong brick size");
+  VTKM_TEST_ASSERT(source.GetNumberOfPieces() == 2 * 2 * 1, "Wrong number of pieces");
+}
+
+void TestContourChain()
+{
+  std::cout << "Testing streamed contour against whole data set" << std::endl;
+  auto contour = std::make_shared<vtkm::filter::contour::Contour>();
+  contour->SetActiveField("distance");
+  contour->SetIsoValue(7.3);
+  contour->SetGenerateNormals(false);
+  auto expected = contour->Execute(Generate(MinExtent, MaxExtent));
+
+  auto ghostRemove = std::make_shared<vtkm::filter::entity_extraction::GhostCellRemove>();
+  ghostRemove->RemoveAllGhost();
+
+  vtkm::filter::UniformBrickSource source(MinExtent, MaxExtent, Generate);
+  source.SetBrickDimensions({ 7, 9, 10 });
+  vtkm::filter::StreamingExecutor executor;
+  executor.AddFilter(contour);
+  executor.AddFilter(ghostRemove);
+
+  auto merged = executor.Execute(source);
+  VTKM_TEST_ASSERT(merged.GetNumberOfPartitions() == 1, "Output should be merged");
+  VTKM_TEST_ASSERT(merged.GetPartition(0).GetNumberOfCells() == expected.GetNumberOfCells(),
+                   "Streamed contour has ",
+                   merged.GetPartition(0).GetNumberOfCells(),
+                   " cells, expected ",
+                   expected.GetNumberOfCells());
+
+  executor.SetMergeOutput(false);
+  auto pieces = executor.Execute(source);
+  VTKM_TEST_ASSERT(pieces.GetNumberOfPartitions() == source.GetNumberOfPieces(),
+                   "Expected one partition per piece");
+
+  std::cout << "Testing memory budget" << std::endl;
+  executor.SetMemoryBudget(1000);
+  bool caught = false;
+  try
+  {
+    executor.Execute(source);
+  }
+  catch (const vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "Expected error: " << error.GetMessage() << std::endl;
+    caught = true;
+  }
+  VTKM_TEST_ASSERT(caught, "Memory budget not enforced");
+
+  std::cout << "Testing memory budget of the merged output" << std::endl;
+  // The kept outputs fit in the budget, but not together with their merged copy.
+  vtkm::UInt64 keptBytes = 0;
+  for (vtkm::Id i = 0; i < pieces.GetNumberOfPartitions(); ++i)
+  {
+    keptBytes += vtkm::filter::StreamingExecutor::EstimateMemoryUsage(pieces.GetPartition(i));
+  }
+  vtkm::UInt64 pieceBytes = 0;
+  for (vtkm::Id i = 0; i < source.GetNumberOfPieces(); ++i)
+  {
+    pieceBytes = std::max(
+      pieceBytes, vtkm::filter::StreamingExecutor::EstimateMemoryUsage(source.GetPiece(i)));
+  }
+  VTKM_TEST_ASSERT(pieceBytes < keptBytes, "Pieces should be smaller than the output");
+  executor.SetMemoryBudget(keptBytes + keptBytes / 2);
+  executor.Execute(source);
+  executor.SetMergeOutput(true);
+  caught = false;
+  try
+  {
+    executor.Execute(source);
+  }
+  catch (const vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "Expected error: " << error.GetMessage() << std::endl;
+    caught = true;
+  }
+  VTKM_TEST_ASSERT(caught, "Memory budget of the merged output not enforced");
+}
+
+void TestStreamingExecutor()
+{
+  TestBrickSource();
+  TestContourChain();
+}
+
+} // anonymous namespace
+
+int UnitTestStreamingExecutor(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestStreamingExecutor, argc, argv);
+}
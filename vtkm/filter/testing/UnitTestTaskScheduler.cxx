@@ -0,0 +1,168 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/TaskScheduler.h>
+
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/testing/Testing.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+
+void TestRunAll()
+{
+  std::cout << "Run every task exactly once" << std::endl;
+  vtkm::filter::TaskScheduler& scheduler = vtkm::filter::GetTaskScheduler();
+  VTKM_TEST_ASSERT(scheduler.GetMaximumConcurrency() >= 1);
+  VTKM_TEST_ASSERT(!vtkm::filter::TaskScheduler::InTask());
+
+  constexpr std::size_t numTasks = 100;
+  std::vector<std::atomic<int>> counts(numTasks);
+  std::vector<vtkm::filter::TaskScheduler::TaskType> tasks;
+  std::vector<vtkm::Id> costs;
+  for (std::size_t i = 0; i < numTasks; ++i)
+  {
+    counts[i] = 0;
+    tasks.emplace_back([&counts, i]() {
+      VTKM_TEST_ASSERT(vtkm::filter::TaskScheduler::InTask());
+      ++counts[i];
+    });
+    // Very uneven costs.
+    costs.push_back(static_cast<vtkm::Id>((i * 7919) % 1000) * ((i % 10 == 0) ? 1000 : 1));
+  }
+
+  for (vtkm::Id concurrency : { 1, 2, 4, 64 })
+  {
+    for (auto& count : counts)
+    {
+      count = 0;
+    }
+    scheduler.Run(tasks, costs, concurrency);
+    for (std::size_t i = 0; i < numTasks; ++i)
+    {
+      VTKM_TEST_ASSERT(counts[i] == 1, "Task ", i, " run ", counts[i].load(), " times");
+    }
+  }
+
+  // Costs are optional.
+  scheduler.Run(tasks, {}, 4);
+  for (std::size_t i = 0; i < numTasks; ++i)
+  {
+    VTKM_TEST_ASSERT(counts[i] == 2);
+  }
+  VTKM_TEST_ASSERT(!vtkm::filter::TaskScheduler::InTask());
+}
+
+void TestCostOrder()
+{
+  std::cout << "Run in order of cost" << std::endl;
+  constexpr std::size_t numTasks = 20;
+  std::vector<std::size_t> order;
+  std::vector<vtkm::filter::TaskScheduler::TaskType> tasks;
+  std::vector<vtkm::Id> costs;
+  for (std::size_t i = 0; i < numTasks; ++i)
+  {
+    tasks.emplace_back([&order, i]() { order.push_back(i); });
+    costs.push_back(static_cast<vtkm::Id>((i * 13) % numTasks));
+  }
+
+  // With one thread, the tasks must run from most to least expensive.
+  vtkm::filter::GetTaskScheduler().Run(tasks, costs, 1);
+  VTKM_TEST_ASSERT(order.size() == numTasks);
+  for (std::size_t i = 1; i < numTasks; ++i)
+  {
+    VTKM_TEST_ASSERT(costs[order[i - 1]] >= costs[order[i]], "Tasks not run in order of cost");
+  }
+}
+
+void TestNested()
+{
+  std::cout << "Run nested batches" << std::endl;
+  vtkm::filter::TaskScheduler& scheduler = vtkm::filter::GetTaskScheduler();
+  constexpr std::size_t numOuter = 16;
+  constexpr std::size_t numInner = 16;
+  std::atomic<std::size_t> numRun{ 0 };
+
+  std::vector<vtkm::filter::TaskScheduler::TaskType> outerTasks;
+  for (std::size_t i = 0; i < numOuter; ++i)
+  {
+    outerTasks.emplace_back([&scheduler, &numRun]() {
+      std::vector<vtkm::filter::TaskScheduler::TaskType> innerTasks;
+      for (std::size_t j = 0; j < numInner; ++j)
+      {
+        innerTasks.emplace_back([&numRun]() {
+          std::this_thread::sleep_for(std::chrono::microseconds(100));
+          ++numRun;
+        });
+      }
+      scheduler.Run(innerTasks, {}, scheduler.GetMaximumConcurrency());
+      VTKM_TEST_ASSERT(vtkm::filter::TaskScheduler::InTask());
+    });
+  }
+  scheduler.Run(outerTasks, {}, scheduler.GetMaximumConcurrency());
+  VTKM_TEST_ASSERT(numRun == numOuter * numInner);
+}
+
+void TestErrors()
+{
+  std::cout << "Propagate errors" << std::endl;
+  std::atomic<std::size_t> numRun{ 0 };
+  std::vector<vtkm::filter::TaskScheduler::TaskType> tasks;
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    tasks.emplace_back([&numRun, i]() {
+      ++numRun;
+      if (i == 3)
+      {
+        throw vtkm::cont::ErrorBadValue("Expected failure");
+      }
+    });
+  }
+
+  try
+  {
+    vtkm::filter::GetTaskScheduler().Run(tasks, {}, 4);
+    VTKM_TEST_FAIL("Error in task not rethrown.");
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+  VTKM_TEST_ASSERT(numRun == tasks.size(), "Not all tasks run after error.");
+
+  try
+  {
+    vtkm::filter::GetTaskScheduler().Run(tasks, { 1, 2 }, 4);
+    VTKM_TEST_FAIL("Wrong number of costs not caught.");
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void Run()
+{
+  TestRunAll();
+  TestCostOrder();
+  TestNested();
+  TestErrors();
+}
+
+} // anonymous namespace
+
+int UnitTestTaskScheduler(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(Run, argc, argv);
+}
@@ -0,0 +1,331 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_filter_zfp_ArrayHandleZFP_h
+#define vtk_m_filter_zfp_ArrayHandleZFP_h
+
+#include <vtkm/cont/ArrayHandle.h>
+
+#include <vtkm/filter/zfp/worklet/ZFPCompressor.h>
+#include <vtkm/filter/zfp/worklet/zfp/ZFPDecode.h>
+#include <vtkm/filter/zfp/worklet/zfp/ZFPStructs.h>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace zfp
+{
+
+/// The parameters needed to find and decode the blocks of a ZFP compressed 3D array.
+struct ZFPArrayInfo
+{
+  vtkm::Id3 Dimensions = vtkm::Id3(0);
+  vtkm::Int32 MaxBits = 0;
+  vtkm::Int32 MaxPrec = 0;
+  vtkm::Int32 MinExp = 0;
+
+  ZFPArrayInfo() = default;
+
+  VTKM_CONT ZFPArrayInfo(const vtkm::Id3& dims, const vtkm::worklet::zfp::ZFPStream& stream)
+    : Dimensions(dims)
+    , MaxBits(vtkm::Int32(stream.maxbits))
+    , MaxPrec(vtkm::Int32(stream.maxprec))
+    , MinExp(stream.minexp)
+  {
+  }
+};
+
+/// \brief A read-only portal of values decoded from a ZFP compressed 3D array.
+///
+/// Each `Get` decodes the 4x4x4 block that holds the value. Code that reads many nearby
+/// values should decode blocks through a `ZFPBlockCache` instead.
+///
+template <typename T, typename WordsPortalType, typename OffsetsPortalType>
+class ArrayPortalZFP
+{
+public:
+  using ValueType = T;
+  static constexpr vtkm::IdComponent BlockSize = 64;
+
+  ArrayPortalZFP() = default;
+
+  VTKM_CONT ArrayPortalZFP(const WordsPortalType& words,
+                           const OffsetsPortalType& blockOffsets,
+                           const ZFPArrayInfo& info)
+    : Words(words)
+    , BlockOffsets(blockOffsets)
+    , Info(info)
+    , BlockDimensions((info.Dimensions + vtkm::Id3(3)) / vtkm::Id3(4))
+  {
+  }
+
+  VTKM_EXEC_CONT vtkm::Id GetNumberOfValues() const
+  {
+    return this->Info.Dimensions[0] * this->Info.Dimensions[1] * this->Info.Dimensions[2];
+  }
+
+  VTKM_SUPPRESS_EXEC_WARNINGS
+  VTKM_EXEC_CONT ValueType Get(vtkm::Id index) const
+  {
+    ValueType values[BlockSize];
+    this->DecodeBlock(this->GetBlockIndex(index), values);
+    return values[this->GetIndexInBlock(index)];
+  }
+
+  /// Returns the index of the block that holds the value at the given index.
+  VTKM_EXEC_CONT vtkm::Id GetBlockIndex(vtkm::Id index) const
+  {
+    const vtkm::Id3& dims = this->Info.Dimensions;
+    vtkm::Id i = index % dims[0];
+    vtkm::Id j = (index / dims[0]) % dims[1];
+    vtkm::Id k = index / (dims[0] * dims[1]);
+    return (i / 4) + this->BlockDimensions[0] * ((j / 4) + this->BlockDimensions[1] * (k / 4));
+  }
+
+  /// Returns where the value at the given index is in its decoded block.
+  VTKM_EXEC_CONT vtkm::IdComponent GetIndexInBlock(vtkm::Id index) const
+  {
+    const vtkm::Id3& dims = this->Info.Dimensions;
+    vtkm::Id i = index % dims[0];
+    vtkm::Id j = (index / dims[0]) % dims[1];
+    vtkm::Id k = index / (dims[0] * dims[1]);
+    return static_cast<vtkm::IdComponent>((i % 4) + 4 * (j % 4) + 16 * (k % 4));
+  }
+
+  /// Decodes the 64 values of a block.
+  VTKM_SUPPRESS_EXEC_WARNINGS
+  VTKM_EXEC_CONT void DecodeBlock(vtkm::Id blockIndex, ValueType* values) const
+  {
+    for (vtkm::IdComponent i = 0; i < BlockSize; ++i)
+    {
+      values[i] = ValueType(0);
+    }
+    // Blocks compressed with a fixed rate all have the same size and need no offsets.
+    vtkm::Id bitOffset = (this->BlockOffsets.GetNumberOfValues() > 0)
+      ? this->BlockOffsets.Get(blockIndex)
+      : blockIndex * this->Info.MaxBits;
+    vtkm::worklet::zfp::zfp_decode_at<BlockSize>(
+      values, this->Info.MaxBits, this->Info.MaxPrec, this->Info.MinExp, bitOffset, this->Words);
+  }
+
+private:
+  WordsPortalType Words;
+  OffsetsPortalType BlockOffsets;
+  ZFPArrayInfo Info;
+  vtkm::Id3 BlockDimensions;
+};
+
+/// \brief Keeps the last few blocks decoded from an `ArrayPortalZFP`.
+///
+/// Declare a cache inside a worklet that reads many nearby values of a compressed array,
+/// such as a stencil or the points of a cell. Each thread then decodes each block it needs
+/// once instead of once for every value. The least recently decoded block is replaced
+/// when the cache is full.
+///
+template <typename PortalType, vtkm::IdComponent NumBlocks = 2>
+class ZFPBlockCache
+{
+public:
+  using ValueType = typename PortalType::ValueType;
+
+  VTKM_EXEC_CONT explicit ZFPBlockCache(const PortalType& portal)
+    : Portal(portal)
+  {
+    for (vtkm::IdComponent slot = 0; slot < NumBlocks; ++slot)
+    {
+      this->BlockIndices[slot] = -1;
+    }
+  }
+
+  VTKM_EXEC_CONT vtkm::Id GetNumberOfValues() const { return this->Portal.GetNumberOfValues(); }
+
+  VTKM_EXEC_CONT ValueType Get(vtkm::Id index)
+  {
+    vtkm::Id blockIndex = this->Portal.GetBlockIndex(index);
+    vtkm::IdComponent slot = 0;
+    while ((slot < NumBlocks) && (this->BlockIndices[slot] != blockIndex))
+    {
+      ++slot;
+    }
+    if (slot == NumBlocks)
+    {
+      slot = this->NextSlot;
+      this->NextSlot = (this->NextSlot + 1) % NumBlocks;
+      this->Portal.DecodeBlock(blockIndex, this->Values[slot]);
+      this->BlockIndices[slot] = blockIndex;
+      ++this->NumberOfDecodedBlocks;
+    }
+    return this->Values[slot][this->Portal.GetIndexInBlock(index)];
+  }
+
+  /// The number of blocks this cache has decoded.
+  VTKM_EXEC_CONT vtkm::Id GetNumberOfDecodedBlocks() const { return this->NumberOfDecodedBlocks; }
+
+private:
+  PortalType Portal;
+  vtkm::Id BlockIndices[NumBlocks];
+  ValueType Values[NumBlocks][PortalType::BlockSize];
+  vtkm::IdComponent NextSlot = 0;
+  vtkm::Id NumberOfDecodedBlocks = 0;
+};
+
+struct VTKM_ALWAYS_EXPORT StorageTagZFP
+{
+};
+
+} // namespace zfp
+} // namespace filter
+} // namespace vtkm
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+template <typename T>
+class Storage<T, vtkm::filter::zfp::StorageTagZFP>
+{
+  using Info = vtkm::filter::zfp::ZFPArrayInfo;
+  using WordsStorage = vtkm::cont::internal::Storage<vtkm::Int64, vtkm::cont::StorageTagBasic>;
+  using OffsetsStorage = vtkm::cont::internal::Storage<vtkm::Id, vtkm::cont::StorageTagBasic>;
+
+public:
+  VTKM_STORAGE_NO_RESIZE;
+  VTKM_STORAGE_NO_WRITE_PORTAL;
+
+  using ReadPortalType = vtkm::filter::zfp::ArrayPortalZFP<T,
+                                                           typename WordsStorage::ReadPortalType,
+                                                           typename OffsetsStorage::ReadPortalType>;
+
+  VTKM_CONT static Info& GetInfo(const std::vector<vtkm::cont::internal::Buffer>& buffers)
+  {
+    return buffers[0].GetMetaData<Info>();
+  }
+
+  VTKM_CONT static vtkm::Id GetNumberOfValues(
+    const std::vector<vtkm::cont::internal::Buffer>& buffers)
+  {
+    const vtkm::Id3& dims = GetInfo(buffers).Dimensions;
+    return dims[0] * dims[1] * dims[2];
+  }
+
+  VTKM_CONT static ReadPortalType CreateReadPortal(
+    const std::vector<vtkm::cont::internal::Buffer>& buffers,
+    vtkm::cont::DeviceAdapterId device,
+    vtkm::cont::Token& token)
+  {
+    return ReadPortalType(WordsStorage::CreateReadPortal({ buffers[1] }, device, token),
+                          OffsetsStorage::CreateReadPortal({ buffers[2] }, device, token),
+                          GetInfo(buffers));
+  }
+
+  VTKM_CONT static std::vector<vtkm::cont::internal::Buffer> CreateBuffers(
+    const vtkm::cont::ArrayHandle<vtkm::Int64>& words = vtkm::cont::ArrayHandle<vtkm::Int64>{},
+    const vtkm::cont::ArrayHandle<vtkm::Id>& blockOffsets = vtkm::cont::ArrayHandle<vtkm::Id>{},
+    const Info& info = Info{})
+  {
+    return vtkm::cont::internal::CreateBuffers(info, words, blockOffsets);
+  }
+
+  VTKM_CONT static vtkm::cont::ArrayHandle<vtkm::Int64> GetWords(
+    const std::vector<vtkm::cont::internal::Buffer>& buffers)
+  {
+    return vtkm::cont::ArrayHandle<vtkm::Int64>({ buffers[1] });
+  }
+
+  VTKM_CONT static vtkm::cont::ArrayHandle<vtkm::Id> GetBlockOffsets(
+    const std::vector<vtkm::cont::internal::Buffer>& buffers)
+  {
+    return vtkm::cont::ArrayHandle<vtkm::Id>({ buffers[2] });
+  }
+};
+
+} // namespace internal
+} // namespace cont
+} // namespace vtkm
+
+namespace vtkm
+{
+namespace filter
+{
+namespace zfp
+{
+
+/// \brief An `ArrayHandle` that keeps a 3D field compressed with ZFP.
+///
+/// The values stay compressed in memory and are decoded a 4x4x4 block at a time when a
+/// worklet reads them, so many more fields or time steps fit in memory than as dense
+/// arrays. The array is read only. Worklets that read many nearby values should get them
+/// through a `ZFPBlockCache` of the portal, so each block is decoded once.
+///
+/// The array can be compressed with a fixed rate, precision, or accuracy, as set on the
+/// `vtkm::worklet::zfp::ZFPStream`.
+///
+template <typename T>
+class VTKM_ALWAYS_EXPORT ArrayHandleZFP
+  : public vtkm::cont::ArrayHandle<T, vtkm::filter::zfp::StorageTagZFP>
+{
+public:
+  VTKM_ARRAY_HANDLE_SUBCLASS(ArrayHandleZFP,
+                             (ArrayHandleZFP<T>),
+                             (vtkm::cont::ArrayHandle<T, vtkm::filter::zfp::StorageTagZFP>));
+
+private:
+  using StorageType = vtkm::cont::internal::Storage<ValueType, StorageTag>;
+
+public:
+  /// Uses values that were compressed by `vtkm::worklet::ZFPCompressor` with `stream`.
+  VTKM_CONT ArrayHandleZFP(const vtkm::cont::ArrayHandle<vtkm::Int64>& compressed,
+                           const vtkm::cont::ArrayHandle<vtkm::Id>& blockOffsets,
+                           const vtkm::Id3& dims,
+                           const vtkm::worklet::zfp::ZFPStream& stream)
+    : Superclass(
+        StorageType::CreateBuffers(compressed, blockOffsets, ZFPArrayInfo(dims, stream)))
+  {
+  }
+
+  VTKM_CONT vtkm::Id3 GetDimensions() const
+  {
+    return StorageType::GetInfo(this->GetBuffers()).Dimensions;
+  }
+
+  /// The compressed bit stream.
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Int64> GetCompressedArray() const
+  {
+    return StorageType::GetWords(this->GetBuffers());
+  }
+
+  /// The bit offset of each block in the stream. Empty for a fixed rate.
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Id> GetBlockOffsets() const
+  {
+    return StorageType::GetBlockOffsets(this->GetBuffers());
+  }
+};
+
+/// Compresses a 3D field with the rate, precision, or accuracy set in `stream`.
+template <typename T, typename S>
+VTKM_CONT ArrayHandleZFP<T> make_ArrayHandleZFP(const vtkm::cont::ArrayHandle<T, S>& values,
+                                                const vtkm::Id3& dims,
+                                                const vtkm::worklet::zfp::ZFPStream& stream)
+{
+  vtkm::worklet::ZFPCompressor compressor;
+  vtkm::cont::ArrayHandle<vtkm::Id> blockOffsets;
+  vtkm::cont::ArrayHandle<vtkm::Int64> compressed =
+    compressor.Compress(values, stream, dims, blockOffsets);
+  return ArrayHandleZFP<T>(compressed, blockOffsets, dims, stream);
+}
+
+} // namespace zfp
+} // namespace filter
+} // namespace vtkm
+
+#endif //vtk_m_filter_zfp_ArrayHandleZFP_h
@@ -25,6 +25,22 @@ VTKM_CONT vtkm::cont::DataSet ZFPCompressor3D::DoExecute(const vtkm::cont::DataS
   vtkm::Id3 pointDimensions = cellSet.GetPointDimensions();
 
   vtkm::cont::ArrayHandle<vtkm::Int64> compressed;
+  vtkm::cont::ArrayHandle<vtkm::Id> blockOffsets;
+
+  vtkm::worklet::zfp::ZFPStream stream;
+  const vtkm::Int32 topoDims = 3;
+  if (precision > 0)
+  {
+    stream.SetPrecision(precision, topoDims, vtkm::Float64());
+  }
+  else if (accuracy > 0)
+  {
+    stream.SetAccuracy(accuracy, topoDims, vtkm::Float64());
+  }
+  else
+  {
+    stream.SetRate(rate, topoDims, vtkm::Float64());
+  }
 
   vtkm::worklet::ZFPCompressor compressor;
   using SupportedTypes = vtkm::List<vtkm::Int32, vtkm::Float32, vtkm::Float64>;
@@ -32,11 +48,17 @@ VTKM_CONT vtkm::cont::DataSet ZFPCompressor3D::DoExecute(const vtkm::cont::DataS
     .GetData()
     .CastAndCallForTypesWithFloatFallback<SupportedTypes, VTKM_DEFAULT_STORAGE_LIST>(
       [&](const auto& concrete) {
-        compressed = compressor.Compress(concrete, rate, pointDimensions);
+        compressed = compressor.Compress(concrete, stream, pointDimensions, blockOffsets);
       });
 
   // TODO: is it really PointField or WHOLE_MESH, should we do it the same way as Histogram?
-  return this->CreateResultFieldPoint(input, "compressed", compressed);
+  vtkm::cont::DataSet output = this->CreateResultFieldPoint(input, "compressed", compressed);
+  if (!stream.IsFixedRate())
+  {
+    output.AddField(vtkm::cont::Field(
+      "compressed_block_offsets", vtkm::cont::Field::Association::WholeMesh, blockOffsets));
+  }
+  return output;
 }
 } // namespace zfp
 } // namespace filter
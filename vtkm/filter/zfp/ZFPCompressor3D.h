@@ -22,20 +22,45 @@ namespace zfp
 {
 /// \brief Compress a scalar field using ZFP
 
-/// Takes as input a 1D array and generates on
+/// Takes as input a 3D field and generates on
 /// output of compressed data.
-/// @warning
-/// This filter is currently only supports 1D volumes.
+/// With a fixed precision or accuracy, the blocks vary in size and
+/// their bit offsets are also output in the `compressed_block_offsets`
+/// field, which the decompressor needs.
 class VTKM_FILTER_ZFP_EXPORT ZFPCompressor3D : public vtkm::filter::NewFilterField
 {
 public:
-  void SetRate(vtkm::Float64 _rate) { rate = _rate; }
+  /// Compresses every block of 4x4x4 values to the same number of bits per value.
+  void SetRate(vtkm::Float64 _rate)
+  {
+    rate = _rate;
+    precision = 0;
+    accuracy = 0;
+  }
   vtkm::Float64 GetRate() { return rate; }
 
+  /// Keeps the given number of bit planes of each block. Blocks vary in size.
+  void SetPrecision(vtkm::UInt32 _precision)
+  {
+    precision = _precision;
+    accuracy = 0;
+  }
+  vtkm::UInt32 GetPrecision() { return precision; }
+
+  /// Keeps the error of every value below the given tolerance. Blocks vary in size.
+  void SetAccuracy(vtkm::Float64 _accuracy)
+  {
+    accuracy = _accuracy;
+    precision = 0;
+  }
+  vtkm::Float64 GetAccuracy() { return accuracy; }
+
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
   vtkm::Float64 rate = 0;
+  vtkm::UInt32 precision = 0;
+  vtkm::Float64 accuracy = 0;
 };
 } // namespace zfp
 class VTKM_DEPRECATED(1.8, "Use vtkm::filter::zfp::ZFPCompressor3D.") ZFPCompressor3D
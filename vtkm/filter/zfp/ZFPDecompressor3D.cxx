@@ -9,6 +9,7 @@
 //============================================================================
 
 #include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ErrorFilterExecution.h>
 #include <vtkm/filter/zfp/ZFPDecompressor3D.h>
 #include <vtkm/filter/zfp/worklet/ZFPDecompress.h>
 
@@ -30,9 +31,36 @@ VTKM_CONT vtkm::cont::DataSet ZFPDecompressor3D::DoExecute(const vtkm::cont::Dat
   input.GetCellSet().AsCellSet(cellSet);
   vtkm::Id3 pointDimensions = cellSet.GetPointDimensions();
 
+  vtkm::worklet::zfp::ZFPStream stream;
+  const vtkm::Int32 topoDims = 3;
+  vtkm::cont::ArrayHandle<vtkm::Id> blockOffsets;
+  if ((precision > 0) || (accuracy > 0))
+  {
+    if (precision > 0)
+    {
+      stream.SetPrecision(precision, topoDims, vtkm::Float64());
+    }
+    else
+    {
+      stream.SetAccuracy(accuracy, topoDims, vtkm::Float64());
+    }
+    if (!input.HasField("compressed_block_offsets"))
+    {
+      throw vtkm::cont::ErrorFilterExecution(
+        "ZFP fields compressed with a fixed precision or accuracy need the "
+        "compressed_block_offsets field.");
+    }
+    vtkm::cont::ArrayCopyShallowIfPossible(
+      input.GetField("compressed_block_offsets").GetData(), blockOffsets);
+  }
+  else
+  {
+    stream.SetRate(this->rate, topoDims, vtkm::Float64());
+  }
+
   vtkm::cont::ArrayHandle<vtkm::Float64> decompressed;
   vtkm::worklet::ZFPDecompressor decompressor;
-  decompressor.Decompress(compressed, decompressed, this->rate, pointDimensions);
+  decompressor.Decompress(compressed, decompressed, stream, blockOffsets, pointDimensions);
 
   return this->CreateResultFieldPoint(input, "decompressed", decompressed);
 }
@@ -20,22 +20,45 @@ namespace filter
 {
 namespace zfp
 {
-/// \brief Compress a scalar field using ZFP
+/// \brief Decompress a scalar field using ZFP
 
-/// Takes as input a 1D array and generates on
-/// output of compressed data.
-/// @warning
-/// This filter is currently only supports 1D volumes.
+/// Takes as input a field compressed by ZFPCompressor3D and
+/// generates on output the decompressed field. The rate, precision,
+/// or accuracy must match the ones used to compress the field.
 class VTKM_FILTER_ZFP_EXPORT ZFPDecompressor3D : public vtkm::filter::NewFilterField
 {
 public:
-  void SetRate(vtkm::Float64 _rate) { rate = _rate; }
+  /// Decompresses a field compressed with a fixed rate.
+  void SetRate(vtkm::Float64 _rate)
+  {
+    rate = _rate;
+    precision = 0;
+    accuracy = 0;
+  }
   vtkm::Float64 GetRate() { return rate; }
 
+  /// Decompresses a field compressed with a fixed precision.
+  void SetPrecision(vtkm::UInt32 _precision)
+  {
+    precision = _precision;
+    accuracy = 0;
+  }
+  vtkm::UInt32 GetPrecision() { return precision; }
+
+  /// Decompresses a field compressed with a fixed accuracy.
+  void SetAccuracy(vtkm::Float64 _accuracy)
+  {
+    accuracy = _accuracy;
+    precision = 0;
+  }
+  vtkm::Float64 GetAccuracy() { return accuracy; }
+
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
   vtkm::Float64 rate = 0;
+  vtkm::UInt32 precision = 0;
+  vtkm::Float64 accuracy = 0;
 };
 } // namespace zfp
 class VTKM_DEPRECATED(1.8, "Use vtkm::filter::zfp::ZFPDecompressor3D.") ZFPDecompressor3D
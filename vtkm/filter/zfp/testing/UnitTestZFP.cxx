@@ -8,16 +8,24 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
 #include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 
+#include <vtkm/filter/zfp/ArrayHandleZFP.h>
 #include <vtkm/filter/zfp/ZFPCompressor1D.h>
 #include <vtkm/filter/zfp/ZFPCompressor2D.h>
 #include <vtkm/filter/zfp/ZFPCompressor3D.h>
 #include <vtkm/filter/zfp/ZFPDecompressor1D.h>
 #include <vtkm/filter/zfp/ZFPDecompressor2D.h>
 #include <vtkm/filter/zfp/ZFPDecompressor3D.h>
+#include <vtkm/filter/zfp/worklet/ZFPDecompress.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
 
 namespace
 {
@@ -114,11 +122,192 @@ void TestZFP3DFilter(vtkm::Float64 rate)
   }
 }
 
+vtkm::cont::DataSet MakeSmoothDataSet(const vtkm::Id3& dims)
+{
+  std::vector<vtkm::Float64> values;
+  for (vtkm::Id k = 0; k < dims[2]; ++k)
+  {
+    for (vtkm::Id j = 0; j < dims[1]; ++j)
+    {
+      for (vtkm::Id i = 0; i < dims[0]; ++i)
+      {
+        values.push_back(vtkm::Sin(0.3 * vtkm::Float64(i)) * vtkm::Cos(0.2 * vtkm::Float64(j)) +
+                         0.1 * vtkm::Float64(k));
+      }
+    }
+  }
+  vtkm::cont::DataSet dataset = vtkm::cont::DataSetBuilderUniform::Create(dims);
+  dataset.AddPointField("pointvar", values);
+  return dataset;
+}
+
+vtkm::Float64 MaxError(const vtkm::cont::UnknownArrayHandle& expected,
+                       const vtkm::cont::UnknownArrayHandle& actual)
+{
+  vtkm::cont::ArrayHandle<vtkm::Float64> expectedArray;
+  vtkm::cont::ArrayHandle<vtkm::Float64> actualArray;
+  expected.AsArrayHandle(expectedArray);
+  vtkm::cont::ArrayCopyShallowIfPossible(actual, actualArray);
+  VTKM_TEST_ASSERT(expectedArray.GetNumberOfValues() == actualArray.GetNumberOfValues());
+  auto expectedPortal = expectedArray.ReadPortal();
+  auto actualPortal = actualArray.ReadPortal();
+  vtkm::Float64 maxError = 0;
+  for (vtkm::Id i = 0; i < expectedArray.GetNumberOfValues(); ++i)
+  {
+    maxError = vtkm::Max(maxError, vtkm::Abs(expectedPortal.Get(i) - actualPortal.Get(i)));
+  }
+  return maxError;
+}
+
+void TestZFP3DAccuracy(vtkm::Float64 accuracy)
+{
+  std::cout << "Testing ZFP 3D with accuracy " << accuracy << std::endl;
+  vtkm::cont::DataSet dataset = MakeSmoothDataSet(vtkm::Id3(10, 9, 7));
+
+  vtkm::filter::zfp::ZFPCompressor3D compressor;
+  compressor.SetActiveField("pointvar");
+  compressor.SetAccuracy(accuracy);
+  auto compressed = compressor.Execute(dataset);
+  VTKM_TEST_ASSERT(compressed.HasField("compressed_block_offsets"));
+
+  vtkm::filter::zfp::ZFPDecompressor3D decompressor;
+  decompressor.SetActiveField("compressed");
+  decompressor.SetAccuracy(accuracy);
+  auto decompressed = decompressor.Execute(compressed);
+
+  vtkm::Float64 error = MaxError(dataset.GetField("pointvar").GetData(),
+                                 decompressed.GetField("decompressed").GetData());
+  std::cout << "  " << compressed.GetField("compressed").GetNumberOfValues()
+            << " words, max error " << error << std::endl;
+  VTKM_TEST_ASSERT(error <= accuracy, "Error ", error, " over tolerance ", accuracy);
+}
+
+vtkm::Id TestZFP3DPrecision(vtkm::UInt32 precision)
+{
+  std::cout << "Testing ZFP 3D with precision " << precision << std::endl;
+  vtkm::cont::DataSet dataset = MakeSmoothDataSet(vtkm::Id3(10, 9, 7));
+
+  vtkm::filter::zfp::ZFPCompressor3D compressor;
+  compressor.SetActiveField("pointvar");
+  compressor.SetPrecision(precision);
+  auto compressed = compressor.Execute(dataset);
+
+  vtkm::filter::zfp::ZFPDecompressor3D decompressor;
+  decompressor.SetActiveField("compressed");
+  decompressor.SetPrecision(precision);
+  auto decompressed = decompressor.Execute(compressed);
+
+  vtkm::Float64 error = MaxError(dataset.GetField("pointvar").GetData(),
+                                 decompressed.GetField("decompressed").GetData());
+  vtkm::Id numWords = compressed.GetField("compressed").GetNumberOfValues();
+  std::cout << "  " << numWords << " words, max error " << error << std::endl;
+  // Values are up to about 2, so each bit plane after the first few halves the error.
+  VTKM_TEST_ASSERT(error < vtkm::Pow(2.0, 6.0 - vtkm::Float64(precision)));
+  return numWords;
+}
+
+struct NeighborhoodSum : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn index, WholeArrayIn values, FieldOut sum);
+
+  vtkm::Id3 Dims;
+
+  VTKM_CONT NeighborhoodSum(const vtkm::Id3& dims)
+    : Dims(dims)
+  {
+  }
+
+  template <typename ValuesPortal>
+  VTKM_EXEC void operator()(vtkm::Id index, const ValuesPortal& values, vtkm::Float64& sum) const
+  {
+    this->Sum(index, values, sum);
+  }
+
+  template <typename T, typename W, typename O>
+  VTKM_EXEC void operator()(vtkm::Id index,
+                            const vtkm::filter::zfp::ArrayPortalZFP<T, W, O>& values,
+                            vtkm::Float64& sum) const
+  {
+    vtkm::filter::zfp::ZFPBlockCache<vtkm::filter::zfp::ArrayPortalZFP<T, W, O>> cache(values);
+    this->Sum(index, cache, sum);
+    // Neighborhoods span at most 8 blocks.
+    VTKM_ASSERT(cache.GetNumberOfDecodedBlocks() <= 8);
+  }
+
+  template <typename PortalType>
+  VTKM_EXEC void Sum(vtkm::Id index, PortalType& values, vtkm::Float64& sum) const
+  {
+    vtkm::Id3 ijk(index % Dims[0], (index / Dims[0]) % Dims[1], index / (Dims[0] * Dims[1]));
+    sum = 0;
+    for (vtkm::Id k = ijk[2]; k < vtkm::Min(ijk[2] + 2, Dims[2]); ++k)
+    {
+      for (vtkm::Id j = ijk[1]; j < vtkm::Min(ijk[1] + 2, Dims[1]); ++j)
+      {
+        for (vtkm::Id i = ijk[0]; i < vtkm::Min(ijk[0] + 2, Dims[0]); ++i)
+        {
+          sum += values.Get((k * Dims[1] + j) * Dims[0] + i);
+        }
+      }
+    }
+  }
+};
+
+void TestArrayHandleZFP()
+{
+  std::cout << "Testing ArrayHandleZFP" << std::endl;
+  const vtkm::Id3 dims(10, 9, 7);
+  vtkm::cont::DataSet dataset = MakeSmoothDataSet(dims);
+  vtkm::cont::ArrayHandle<vtkm::Float64> values;
+  dataset.GetField("pointvar").GetData().AsArrayHandle(values);
+
+  vtkm::worklet::zfp::ZFPStream stream;
+  const vtkm::Float64 accuracy = 1e-4;
+  stream.SetAccuracy(accuracy, 3, vtkm::Float64());
+  vtkm::filter::zfp::ArrayHandleZFP<vtkm::Float64> compressed =
+    vtkm::filter::zfp::make_ArrayHandleZFP(values, dims, stream);
+  VTKM_TEST_ASSERT(compressed.GetNumberOfValues() == values.GetNumberOfValues());
+  VTKM_TEST_ASSERT(compressed.GetDimensions() == dims);
+  std::cout << "  " << compressed.GetCompressedArray().GetNumberOfValues() << " words for "
+            << values.GetNumberOfValues() << " values" << std::endl;
+  VTKM_TEST_ASSERT(compressed.GetCompressedArray().GetNumberOfValues() <
+                   values.GetNumberOfValues() / 2);
+
+  // The values are the same as decompressing the whole array.
+  vtkm::cont::ArrayHandle<vtkm::Float64> decompressed;
+  vtkm::worklet::ZFPDecompressor decompressor;
+  decompressor.Decompress(
+    compressed.GetCompressedArray(), decompressed, stream, compressed.GetBlockOffsets(), dims);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(compressed, decompressed));
+  VTKM_TEST_ASSERT(MaxError(values, decompressed) <= accuracy);
+
+  // Worklets decode blocks as they need them.
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandleCounting<vtkm::Id> indices(0, 1, values.GetNumberOfValues());
+  vtkm::cont::ArrayHandle<vtkm::Float64> expectedSums;
+  vtkm::cont::ArrayHandle<vtkm::Float64> sums;
+  invoke(NeighborhoodSum(dims), indices, values, expectedSums);
+  invoke(NeighborhoodSum(dims), indices, compressed, sums);
+  VTKM_TEST_ASSERT(MaxError(expectedSums, sums) <= 8 * accuracy);
+
+  // Fixed rate arrays need no block offsets.
+  stream.SetRate(8, 3, vtkm::Float64());
+  compressed = vtkm::filter::zfp::make_ArrayHandleZFP(values, dims, stream);
+  VTKM_TEST_ASSERT(compressed.GetBlockOffsets().GetNumberOfValues() == 0);
+  decompressor.Decompress(compressed.GetCompressedArray(), decompressed, 8, dims);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(compressed, decompressed));
+}
+
 void TestZFPFilter()
 {
   TestZFP1DFilter(4);
   TestZFP2DFilter(4);
-  TestZFP2DFilter(4);
+  TestZFP3DFilter(4);
+  TestZFP3DAccuracy(1e-2);
+  TestZFP3DAccuracy(1e-6);
+  vtkm::Id lowPrecisionWords = TestZFP3DPrecision(12);
+  vtkm::Id highPrecisionWords = TestZFP3DPrecision(28);
+  VTKM_TEST_ASSERT(lowPrecisionWords < highPrecisionWords);
+  TestArrayHandleZFP();
 }
 } // anonymous namespace
 
@@ -90,6 +90,51 @@ public:
 
     return output;
   }
+
+  /// Compresses `data` with the rate, precision, or accuracy set in `stream`. Blocks
+  /// compressed with a fixed precision or accuracy vary in size, so the bit offset of each
+  /// block in the compressed array is returned in `blockOffsets`. It is left empty for a
+  /// fixed rate.
+  template <typename Scalar, typename Storage>
+  vtkm::cont::ArrayHandle<vtkm::Int64> Compress(
+    const vtkm::cont::ArrayHandle<Scalar, Storage>& data,
+    const zfp::ZFPStream& stream,
+    const vtkm::Id3 dims,
+    vtkm::cont::ArrayHandle<vtkm::Id>& blockOffsets)
+  {
+    blockOffsets.ReleaseResources();
+    if (stream.IsFixedRate())
+    {
+      vtkm::Float64 rate = vtkm::Float64(stream.maxbits) / 64;
+      return this->Compress(data, rate, dims);
+    }
+
+    vtkm::Id3 paddedDims = dims;
+    for (vtkm::IdComponent i = 0; i < 3; ++i)
+    {
+      if (paddedDims[i] % 4 != 0)
+        paddedDims[i] += 4 - dims[i] % 4;
+    }
+    vtkm::Id totalBlocks = (paddedDims[0] / 4) * (paddedDims[1] / 4) * (paddedDims[2] / 4);
+    vtkm::cont::ArrayHandleCounting<vtkm::Id> blockCounter(0, 1, totalBlocks);
+
+    // Blocks are encoded twice: once to find their sizes and then to write them.
+    vtkm::cont::ArrayHandle<vtkm::Id> blockBits;
+    vtkm::worklet::DispatcherMapField<zfp::Encode3Bits> sizeDispatcher(
+      zfp::Encode3Bits(dims, paddedDims, stream));
+    sizeDispatcher.Invoke(blockCounter, data, blockBits);
+    vtkm::Id totalBits = vtkm::cont::Algorithm::ScanExclusive(blockBits, blockOffsets);
+
+    vtkm::Id wordBits = vtkm::Id(sizeof(ZFPWord) * 8);
+    vtkm::cont::ArrayHandle<vtkm::Int64> output;
+    output.AllocateAndFill((totalBits + wordBits - 1) / wordBits, 0);
+
+    vtkm::worklet::DispatcherMapField<zfp::Encode3Variable> compressDispatcher(
+      zfp::Encode3Variable(dims, paddedDims, stream));
+    compressDispatcher.Invoke(blockCounter, blockOffsets, data, output);
+
+    return output;
+  }
 };
 } // namespace worklet
 } // namespace vtkm
@@ -84,6 +84,38 @@ public:
     //    std::cout<<"Decompress rate "<<rate<<" GB / sec\n";
     //    DataDump(output, "decompressed");
   }
+
+  /// Decompresses an array compressed with the rate, precision, or accuracy set in `stream`.
+  /// `blockOffsets` are the bit offsets of the blocks returned by `ZFPCompressor::Compress`.
+  template <typename Scalar, typename StorageIn, typename StorageOut>
+  void Decompress(const vtkm::cont::ArrayHandle<vtkm::Int64, StorageIn>& encodedData,
+                  vtkm::cont::ArrayHandle<Scalar, StorageOut>& output,
+                  const zfp::ZFPStream& stream,
+                  const vtkm::cont::ArrayHandle<vtkm::Id>& blockOffsets,
+                  vtkm::Id3 dims)
+  {
+    if (stream.IsFixedRate())
+    {
+      vtkm::Float64 rate = vtkm::Float64(stream.maxbits) / 64;
+      this->Decompress(encodedData, output, rate, dims);
+      return;
+    }
+
+    vtkm::Id3 paddedDims = dims;
+    for (vtkm::IdComponent i = 0; i < 3; ++i)
+    {
+      if (paddedDims[i] % 4 != 0)
+        paddedDims[i] += 4 - dims[i] % 4;
+    }
+    vtkm::Id totalBlocks = (paddedDims[0] / 4) * (paddedDims[1] / 4) * (paddedDims[2] / 4);
+    VTKM_ASSERT(blockOffsets.GetNumberOfValues() == totalBlocks);
+
+    output.Allocate(dims[0] * dims[1] * dims[2]);
+    vtkm::cont::ArrayHandleCounting<vtkm::Id> blockCounter(0, 1, totalBlocks);
+    vtkm::worklet::DispatcherMapField<zfp::Decode3Variable> decompressDispatcher(
+      zfp::Decode3Variable(dims, paddedDims, stream));
+    decompressDispatcher.Invoke(blockCounter, blockOffsets, output, encodedData);
+  }
 };
 } // namespace worklet
 } // namespace vtkm
@@ -48,6 +48,21 @@ struct BlockReader
     m_block_idx = block_idx;
   }
 
+  // Reads a block that starts at any bit of the stream. Used when blocks vary in size.
+  VTKM_EXEC
+  BlockReader(const WordsPortalType& words, const vtkm::Id& bitOffset)
+    : Words(words)
+    , m_maxbits(0)
+    , MaxIndex(words.GetNumberOfValues() - 1)
+  {
+    Index = bitOffset / vtkm::Id(sizeof(Word) * 8);
+    m_buffer = static_cast<Word>(Words.Get(Index));
+    m_current_bit = vtkm::Int32(bitOffset % vtkm::Id(sizeof(Word) * 8));
+
+    m_buffer >>= m_current_bit;
+    m_block_idx = -1;
+  }
+
   inline VTKM_EXEC unsigned int read_bit()
   {
     vtkm::UInt32 bit = vtkm::UInt32(m_buffer) & 1u;
@@ -44,6 +44,16 @@ struct BlockWriter
     m_start_bit = vtkm::Int32((block_idx * maxbits) % vtkm::Int32(sizeof(Word) * 8));
   }
 
+  // Writes a block that starts at any bit of the stream. Used when blocks vary in size.
+  VTKM_EXEC BlockWriter(AtomicPortalType& portal, const vtkm::Id& bitOffset)
+    : m_word_index(bitOffset / vtkm::Id(sizeof(Word) * 8))
+    , m_start_bit(vtkm::Int32(bitOffset % vtkm::Id(sizeof(Word) * 8)))
+    , m_current_bit(0)
+    , m_maxbits(0)
+    , Portal(portal)
+  {
+  }
+
   inline VTKM_EXEC void Add(const vtkm::Id index, Word& value)
   {
     UIntInt newval;
@@ -106,6 +116,24 @@ struct BlockWriter
   }
 };
 
+// Counts the bits that an encoder writes for a block without writing them anywhere.
+struct BlockBitCounter
+{
+  vtkm::Int32 m_current_bit = 0;
+
+  inline VTKM_EXEC vtkm::UInt64 write_bits(const vtkm::UInt64& bits, const unsigned int& n_bits)
+  {
+    m_current_bit += n_bits;
+    return bits >> (Word)n_bits;
+  }
+
+  inline VTKM_EXEC vtkm::UInt32 write_bit(const unsigned int& bit)
+  {
+    m_current_bit += 1;
+    return bit;
+  }
+};
+
 } // namespace zfp
 } // namespace worklet
 } // namespace vtkm
@@ -13,6 +13,7 @@
 #include <vtkm/Types.h>
 #include <vtkm/filter/zfp/worklet/zfp/ZFPBlockReader.h>
 #include <vtkm/filter/zfp/worklet/zfp/ZFPCodec.h>
+#include <vtkm/filter/zfp/worklet/zfp/ZFPFunctions.h>
 #include <vtkm/filter/zfp/worklet/zfp/ZFPTypeInfo.h>
 #include <vtkm/internal/ExportMacros.h>
 
@@ -173,7 +174,8 @@ template <vtkm::Int32 BlockSize,
 VTKM_EXEC void decode_ints(ReaderType<BlockSize, PortalType>& reader,
                            vtkm::Int32& maxbits,
                            UInt* data,
-                           const vtkm::Int32 intprec)
+                           const vtkm::Int32 intprec,
+                           const vtkm::Int32 maxprec)
 {
   for (vtkm::Int32 i = 0; i < BlockSize; ++i)
   {
@@ -181,7 +183,7 @@ VTKM_EXEC void decode_ints(ReaderType<BlockSize, PortalType>& reader,
   }
 
   vtkm::UInt64 x;
-  const vtkm::UInt32 kmin = 0;
+  const vtkm::UInt32 kmin = vtkm::UInt32(intprec > maxprec ? intprec - maxprec : 0);
   vtkm::Int32 bits = maxbits;
   for (vtkm::UInt32 k = static_cast<vtkm::UInt32>(intprec), n = 0; bits && k-- > kmin;)
   {
@@ -201,13 +203,17 @@ VTKM_EXEC void decode_ints(ReaderType<BlockSize, PortalType>& reader,
   }
 }
 
+// Decodes the block that starts at the given bit of the stream. Blocks compressed with a
+// fixed precision or accuracy also need the precision and minimum exponent they used.
 template <vtkm::Int32 BlockSize, typename Scalar, typename PortalType>
-VTKM_EXEC void zfp_decode(Scalar* fblock,
-                          vtkm::Int32 maxbits,
-                          vtkm::UInt32 blockIdx,
-                          PortalType stream)
+VTKM_EXEC void zfp_decode_at(Scalar* fblock,
+                             vtkm::Int32 maxbits,
+                             vtkm::Int32 maxprec,
+                             vtkm::Int32 minexp,
+                             vtkm::Id bitOffset,
+                             const PortalType& stream)
 {
-  zfp::BlockReader<BlockSize, PortalType> reader(stream, maxbits, vtkm::Int32(blockIdx));
+  zfp::BlockReader<BlockSize, PortalType> reader(stream, bitOffset);
   using Int = typename zfp::zfp_traits<Scalar>::Int;
   using UInt = typename zfp::zfp_traits<Scalar>::UInt;
 
@@ -222,11 +228,12 @@ VTKM_EXEC void zfp_decode(Scalar* fblock,
   {
     vtkm::UInt32 ebits = static_cast<vtkm::UInt32>(zfp::get_ebits<Scalar>()) + 1;
 
-    vtkm::UInt32 emax;
+    vtkm::UInt32 emax = 0;
     if (!zfp::is_int<Scalar>())
     {
       emax = vtkm::UInt32(reader.read_bits(static_cast<vtkm::Int32>(ebits) - 1));
       emax -= static_cast<vtkm::UInt32>(zfp::get_ebias<Scalar>());
+      maxprec = zfp::precision(static_cast<vtkm::Int32>(emax), maxprec, minexp);
     }
     else
     {
@@ -236,7 +243,7 @@ VTKM_EXEC void zfp_decode(Scalar* fblock,
 
     maxbits -= ebits;
     UInt ublock[BlockSize];
-    decode_ints<BlockSize>(reader, maxbits, ublock, zfp::get_precision<Scalar>());
+    decode_ints<BlockSize>(reader, maxbits, ublock, zfp::get_precision<Scalar>(), maxprec);
 
     Int iblock[BlockSize];
     const zfp::ZFPCodec<BlockSize> codec;
@@ -257,6 +264,20 @@ VTKM_EXEC void zfp_decode(Scalar* fblock,
     }
   }
 }
+
+template <vtkm::Int32 BlockSize, typename Scalar, typename PortalType>
+VTKM_EXEC void zfp_decode(Scalar* fblock,
+                          vtkm::Int32 maxbits,
+                          vtkm::UInt32 blockIdx,
+                          PortalType stream)
+{
+  zfp_decode_at<BlockSize>(fblock,
+                           maxbits,
+                           zfp::get_precision<Scalar>(),
+                           zfp::get_min_exp<Scalar>(),
+                           vtkm::Id(blockIdx) * maxbits,
+                           stream);
+}
 }
 }
 } // namespace vtkm::worklet::zfp
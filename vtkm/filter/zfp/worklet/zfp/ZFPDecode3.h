@@ -104,6 +104,15 @@ public:
     zfp::zfp_decode<BlockSize>(
       fblock, vtkm::Int32(MaxBits), static_cast<vtkm::UInt32>(blockIdx), stream);
 
+    this->ScatterBlock(blockIdx, fblock, scalars);
+  }
+
+protected:
+  template <typename Scalar, typename OutputScalarPortal>
+  VTKM_EXEC void ScatterBlock(const vtkm::Id blockIdx,
+                              const Scalar* fblock,
+                              OutputScalarPortal& scalars) const
+  {
     vtkm::Id3 zfpBlock;
     zfpBlock[0] = blockIdx % ZFPDims[0];
     zfpBlock[1] = (blockIdx / ZFPDims[0]) % ZFPDims[1];
@@ -135,6 +144,44 @@ public:
     }
   }
 };
+
+// Decodes blocks compressed with a fixed precision or accuracy, which start at the given bit
+// offsets of the stream.
+struct Decode3Variable : public Decode3
+{
+protected:
+  vtkm::Int32 MaxPrec;
+  vtkm::Int32 MinExp;
+
+public:
+  Decode3Variable(const vtkm::Id3 dims, const vtkm::Id3 paddedDims, const ZFPStream& stream)
+    : Decode3(dims, paddedDims, stream.maxbits)
+    , MaxPrec(vtkm::Int32(stream.maxprec))
+    , MinExp(stream.minexp)
+  {
+  }
+  using ControlSignature = void(FieldIn, FieldIn bitOffset, WholeArrayOut, WholeArrayIn bitstream);
+
+  template <typename OutputScalarPortal, typename BitstreamPortal>
+  VTKM_EXEC void operator()(const vtkm::Id blockIdx,
+                            const vtkm::Id bitOffset,
+                            OutputScalarPortal& scalars,
+                            const BitstreamPortal& stream) const
+  {
+    using Scalar = typename OutputScalarPortal::ValueType;
+    constexpr vtkm::Int32 BlockSize = 64;
+    Scalar fblock[BlockSize];
+    for (vtkm::Int32 i = 0; i < BlockSize; ++i)
+    {
+      fblock[i] = static_cast<Scalar>(0);
+    }
+
+    zfp::zfp_decode_at<BlockSize>(
+      fblock, vtkm::Int32(MaxBits), MaxPrec, MinExp, bitOffset, stream);
+
+    this->ScatterBlock(blockIdx, fblock, scalars);
+  }
+};
 }
 }
 } // namespace vtkm::worklet::zfp
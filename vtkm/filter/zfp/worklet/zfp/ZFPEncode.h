@@ -13,6 +13,7 @@
 #include <vtkm/Types.h>
 #include <vtkm/filter/zfp/worklet/zfp/ZFPBlockWriter.h>
 #include <vtkm/filter/zfp/worklet/zfp/ZFPCodec.h>
+#include <vtkm/filter/zfp/worklet/zfp/ZFPFunctions.h>
 #include <vtkm/filter/zfp/worklet/zfp/ZFPTypeInfo.h>
 #include <vtkm/internal/ExportMacros.h>
 
@@ -64,12 +65,6 @@ inline VTKM_EXEC vtkm::Int32 MaxExponent(const FloatType* vals)
   return -get_ebias<FloatType>();
 }
 
-// maximum number of bit planes to encode
-inline VTKM_EXEC vtkm::Int32 precision(vtkm::Int32 maxexp, vtkm::Int32 maxprec, vtkm::Int32 minexp)
-{
-  return vtkm::Min(maxprec, vtkm::Max(0, maxexp - minexp + 8));
-}
-
 template <typename Scalar>
 inline VTKM_EXEC Scalar quantize(Scalar x, vtkm::Int32 e)
 {
@@ -237,8 +232,8 @@ inline VTKM_EXEC void fwd_xform<vtkm::Int32, 4>(vtkm::Int32* p)
   fwd_lift<vtkm::Int32, 1>(p);
 }
 
-template <vtkm::Int32 BlockSize, typename PortalType, typename Int>
-VTKM_EXEC void encode_block(BlockWriter<BlockSize, PortalType>& stream,
+template <vtkm::Int32 BlockSize, typename WriterType, typename Int>
+VTKM_EXEC void encode_block(WriterType& stream,
                             vtkm::Int32 maxbits,
                             vtkm::Int32 maxprec,
                             Int* iblock)
@@ -281,18 +276,19 @@ VTKM_EXEC void encode_block(BlockWriter<BlockSize, PortalType>& stream,
 }
 
 
-template <vtkm::Int32 BlockSize, typename Scalar, typename PortalType>
-inline VTKM_EXEC void zfp_encodef(Scalar* fblock,
-                                  vtkm::Int32 maxbits,
-                                  vtkm::UInt32 blockIdx,
-                                  PortalType& stream)
+// Encodes a block of floating point values with at most maxbits bits, maxprec bit planes,
+// and no bit planes below minexp. The writer may also just count the bits of the block.
+template <vtkm::Int32 BlockSize, typename Scalar, typename WriterType>
+inline VTKM_EXEC void zfp_encodef_block(Scalar* fblock,
+                                        vtkm::Int32 maxbits,
+                                        vtkm::Int32 maxprec,
+                                        vtkm::Int32 minexp,
+                                        WriterType& blockWriter)
 {
   using Int = typename zfp::zfp_traits<Scalar>::Int;
-  zfp::BlockWriter<BlockSize, PortalType> blockWriter(stream, maxbits, vtkm::Id(blockIdx));
   vtkm::Int32 emax = zfp::MaxExponent<BlockSize, Scalar>(fblock);
   //  std::cout<<"EMAX "<<emax<<"\n";
-  vtkm::Int32 maxprec =
-    zfp::precision(emax, zfp::get_precision<Scalar>(), zfp::get_min_exp<Scalar>());
+  maxprec = zfp::precision(emax, maxprec, minexp);
   vtkm::UInt32 e = vtkm::UInt32(maxprec ? emax + zfp::get_ebias<Scalar>() : 0);
   /* encode block only if biased exponent is nonzero */
   if (e)
@@ -306,6 +302,21 @@ inline VTKM_EXEC void zfp_encodef(Scalar* fblock,
 
     encode_block<BlockSize>(blockWriter, maxbits - vtkm::Int32(ebits), maxprec, iblock);
   }
+  else
+  {
+    blockWriter.write_bit(0);
+  }
+}
+
+template <vtkm::Int32 BlockSize, typename Scalar, typename PortalType>
+inline VTKM_EXEC void zfp_encodef(Scalar* fblock,
+                                  vtkm::Int32 maxbits,
+                                  vtkm::UInt32 blockIdx,
+                                  PortalType& stream)
+{
+  zfp::BlockWriter<BlockSize, PortalType> blockWriter(stream, maxbits, vtkm::Id(blockIdx));
+  zfp_encodef_block<BlockSize>(
+    fblock, maxbits, zfp::get_precision<Scalar>(), zfp::get_min_exp<Scalar>(), blockWriter);
 }
 
 // helpers so we can do partial template instantiation since
@@ -325,6 +336,17 @@ struct ZFPBlockEncoder<BlockSize, vtkm::Float32, PortalType>
   {
     zfp_encodef<BlockSize>(fblock, maxbits, blockIdx, stream);
   }
+
+  // Encodes a block with a fixed precision or accuracy to any writer.
+  template <typename WriterType>
+  VTKM_EXEC void encode(vtkm::Float32* fblock,
+                        vtkm::Int32 maxbits,
+                        vtkm::Int32 maxprec,
+                        vtkm::Int32 minexp,
+                        WriterType& writer)
+  {
+    zfp_encodef_block<BlockSize>(fblock, maxbits, maxprec, minexp, writer);
+  }
 };
 
 template <vtkm::Int32 BlockSize, typename PortalType>
@@ -337,6 +359,17 @@ struct ZFPBlockEncoder<BlockSize, vtkm::Float64, PortalType>
   {
     zfp_encodef<BlockSize>(fblock, maxbits, blockIdx, stream);
   }
+
+  // Encodes a block with a fixed precision or accuracy to any writer.
+  template <typename WriterType>
+  VTKM_EXEC void encode(vtkm::Float64* fblock,
+                        vtkm::Int32 maxbits,
+                        vtkm::Int32 maxprec,
+                        vtkm::Int32 minexp,
+                        WriterType& writer)
+  {
+    zfp_encodef_block<BlockSize>(fblock, maxbits, maxprec, minexp, writer);
+  }
 };
 
 template <vtkm::Int32 BlockSize, typename PortalType>
@@ -351,6 +384,19 @@ struct ZFPBlockEncoder<BlockSize, vtkm::Int32, PortalType>
     zfp::BlockWriter<BlockSize, PortalType> blockWriter(stream, maxbits, vtkm::Id(blockIdx));
     encode_block<BlockSize>(blockWriter, maxbits, get_precision<vtkm::Int32>(), (Int*)fblock);
   }
+
+  // Encodes a block with a fixed precision or accuracy to any writer.
+  template <typename WriterType>
+  VTKM_EXEC void encode(vtkm::Int32* fblock,
+                        vtkm::Int32 maxbits,
+                        vtkm::Int32 maxprec,
+                        vtkm::Int32 vtkmNotUsed(minexp),
+                        WriterType& writer)
+  {
+    using Int = typename zfp::zfp_traits<vtkm::Int32>::Int;
+    encode_block<BlockSize>(
+      writer, maxbits, vtkm::Min(maxprec, get_precision<vtkm::Int32>()), (Int*)fblock);
+  }
 };
 
 template <vtkm::Int32 BlockSize, typename PortalType>
@@ -365,6 +411,19 @@ struct ZFPBlockEncoder<BlockSize, vtkm::Int64, PortalType>
     zfp::BlockWriter<BlockSize, PortalType> blockWriter(stream, maxbits, vtkm::Id(blockIdx));
     encode_block<BlockSize>(blockWriter, maxbits, get_precision<vtkm::Int64>(), (Int*)fblock);
   }
+
+  // Encodes a block with a fixed precision or accuracy to any writer.
+  template <typename WriterType>
+  VTKM_EXEC void encode(vtkm::Int64* fblock,
+                        vtkm::Int32 maxbits,
+                        vtkm::Int32 maxprec,
+                        vtkm::Int32 vtkmNotUsed(minexp),
+                        WriterType& writer)
+  {
+    using Int = typename zfp::zfp_traits<vtkm::Int64>::Int;
+    encode_block<BlockSize>(
+      writer, maxbits, vtkm::Min(maxprec, get_precision<vtkm::Int64>()), (Int*)fblock);
+  }
 };
 }
 }
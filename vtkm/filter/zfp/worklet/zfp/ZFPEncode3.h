@@ -112,7 +112,19 @@ public:
     using Scalar = typename InputScalarPortal::ValueType;
     constexpr vtkm::Int32 BlockSize = 64;
     Scalar fblock[BlockSize];
+    this->GatherBlock(blockIdx, scalars, fblock);
 
+    zfp::ZFPBlockEncoder<BlockSize, Scalar, BitstreamPortal> encoder;
+
+    encoder.encode(fblock, vtkm::Int32(MaxBits), vtkm::UInt32(blockIdx), stream);
+  }
+
+protected:
+  template <typename InputScalarPortal, typename Scalar>
+  VTKM_EXEC void GatherBlock(const vtkm::Id blockIdx,
+                             const InputScalarPortal& scalars,
+                             Scalar* fblock) const
+  {
     vtkm::Id3 zfpBlock;
     zfpBlock[0] = blockIdx % ZFPDims[0];
     zfpBlock[1] = (blockIdx / ZFPDims[0]) % ZFPDims[1];
@@ -145,10 +157,64 @@ public:
     {
       Gather3(fblock, scalars, Dims, offset);
     }
+  }
+};
 
-    zfp::ZFPBlockEncoder<BlockSize, Scalar, BitstreamPortal> encoder;
+// Counts the bits of each block compressed with a fixed precision or accuracy. These blocks
+// vary in size, so they are counted before they are written.
+struct Encode3Bits : public Encode3
+{
+protected:
+  vtkm::Int32 MaxPrec;
+  vtkm::Int32 MinExp;
 
-    encoder.encode(fblock, vtkm::Int32(MaxBits), vtkm::UInt32(blockIdx), stream);
+public:
+  Encode3Bits(const vtkm::Id3 dims, const vtkm::Id3 paddedDims, const ZFPStream& stream)
+    : Encode3(dims, paddedDims, stream.maxbits)
+    , MaxPrec(vtkm::Int32(stream.maxprec))
+    , MinExp(stream.minexp)
+  {
+  }
+  using ControlSignature = void(FieldIn, WholeArrayIn, FieldOut bits);
+
+  template <typename InputScalarPortal>
+  VTKM_EXEC void operator()(const vtkm::Id blockIdx,
+                            const InputScalarPortal& scalars,
+                            vtkm::Id& bits) const
+  {
+    using Scalar = typename InputScalarPortal::ValueType;
+    constexpr vtkm::Int32 BlockSize = 64;
+    Scalar fblock[BlockSize];
+    this->GatherBlock(blockIdx, scalars, fblock);
+
+    zfp::BlockBitCounter counter;
+    zfp::ZFPBlockEncoder<BlockSize, Scalar, zfp::BlockBitCounter> encoder;
+    encoder.encode(fblock, vtkm::Int32(MaxBits), MaxPrec, MinExp, counter);
+    bits = counter.m_current_bit;
+  }
+};
+
+// Writes each block compressed with a fixed precision or accuracy at its bit offset, which
+// is found by scanning the sizes from Encode3Bits.
+struct Encode3Variable : public Encode3Bits
+{
+  using Encode3Bits::Encode3Bits;
+  using ControlSignature = void(FieldIn, FieldIn bitOffset, WholeArrayIn, AtomicArrayInOut);
+
+  template <typename InputScalarPortal, typename BitstreamPortal>
+  VTKM_EXEC void operator()(const vtkm::Id blockIdx,
+                            const vtkm::Id bitOffset,
+                            const InputScalarPortal& scalars,
+                            BitstreamPortal& stream) const
+  {
+    using Scalar = typename InputScalarPortal::ValueType;
+    constexpr vtkm::Int32 BlockSize = 64;
+    Scalar fblock[BlockSize];
+    this->GatherBlock(blockIdx, scalars, fblock);
+
+    zfp::BlockWriter<BlockSize, BitstreamPortal> writer(stream, bitOffset);
+    zfp::ZFPBlockEncoder<BlockSize, Scalar, BitstreamPortal> encoder;
+    encoder.encode(fblock, vtkm::Int32(MaxBits), MaxPrec, MinExp, writer);
   }
 };
 }
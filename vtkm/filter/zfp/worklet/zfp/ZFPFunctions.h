@@ -36,6 +36,12 @@ void PrintBits(T bits)
   printf("\n");
 }
 
+// maximum number of bit planes to encode
+inline VTKM_EXEC vtkm::Int32 precision(vtkm::Int32 maxexp, vtkm::Int32 maxprec, vtkm::Int32 minexp)
+{
+  return vtkm::Min(maxprec, vtkm::Max(0, maxexp - minexp + 8));
+}
+
 template <typename T>
 inline vtkm::UInt32 MinBits(const vtkm::UInt32 bits)
 {
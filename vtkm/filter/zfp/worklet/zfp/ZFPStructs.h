@@ -49,6 +49,47 @@ struct ZFPStream
     minexp = ZFP_MIN_EXP;
     return (double)bits / n;
   }
+
+  /// Compresses each block to the given number of bit planes. The number of bits used by
+  /// each block depends on its values.
+  template <typename T>
+  vtkm::UInt32 SetPrecision(const vtkm::UInt32 precision,
+                            const vtkm::Int32 vtkmNotUsed(dims),
+                            T vtkmNotUsed(valueType))
+  {
+    minbits = ZFP_MIN_BITS;
+    maxbits = ZFP_MAX_BITS;
+    maxprec = vtkm::Min(precision, vtkm::UInt32(ZFP_MAX_PREC));
+    minexp = ZFP_MIN_EXP;
+    return maxprec;
+  }
+
+  /// Compresses each block so that the absolute error of each value is at most the given
+  /// tolerance. The number of bits used by each block depends on its values. Only floating
+  /// point values can be compressed with a fixed accuracy.
+  template <typename T>
+  vtkm::Float64 SetAccuracy(const vtkm::Float64 tolerance,
+                            const vtkm::Int32 vtkmNotUsed(dims),
+                            T vtkmNotUsed(valueType))
+  {
+    vtkm::Int32 emin = ZFP_MIN_EXP;
+    if (tolerance > 0)
+    {
+      /* tolerance = x * 2^emin, with 0.5 <= x < 1 */
+      frexp(tolerance, &emin);
+      emin--;
+      /* assert(tolerance >= ldexp(1.0, emin)); */
+    }
+    minbits = ZFP_MIN_BITS;
+    maxbits = ZFP_MAX_BITS;
+    maxprec = ZFP_MAX_PREC;
+    minexp = emin;
+    return tolerance > 0 ? ldexp(1.0, emin) : 0;
+  }
+
+  /// Returns true if every block is compressed to the same number of bits. Otherwise, the
+  /// blocks need to be located with their bit offsets.
+  bool IsFixedRate() const { return minbits == maxbits; }
 };
 }
 }
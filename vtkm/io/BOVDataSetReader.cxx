@@ -10,6 +10,7 @@
 
 #include <vtkm/io/BOVDataSetReader.h>
 
+#include <vtkm/cont/ArrayHandleMemoryMapped.h>
 #include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/io/ErrorIO.h>
 
@@ -28,54 +29,20 @@ enum class DataFormat
   DoubleData
 };
 
+// The raw data file is mapped into memory rather than read. Pages of the file are only
+// loaded when the data are accessed. The mapping is copy-on-write so that modifying the
+// field does not change the file.
 template <typename T>
-void ReadBuffer(const std::string& fName, const vtkm::Id& sz, std::vector<T>& buff)
+void ReadArray(const std::string& fName, const vtkm::Id& nTuples, vtkm::cont::ArrayHandle<T>& var)
 {
-  FILE* fp = fopen(fName.c_str(), "rb");
-  size_t readSize = static_cast<size_t>(sz);
-  if (fp == nullptr)
-  {
-    throw vtkm::io::ErrorIO("Unable to open data file: " + fName);
-  }
-  buff.resize(readSize);
-  size_t nread = fread(&buff[0], sizeof(T), readSize, fp);
-  if (nread != readSize)
-  {
-    throw vtkm::io::ErrorIO("Data file read failed: " + fName);
-  }
-  fclose(fp);
-}
-
-template <typename T>
-void ReadScalar(const std::string& fName, const vtkm::Id& nTuples, vtkm::cont::ArrayHandle<T>& var)
-{
-  std::vector<T> buff;
-  ReadBuffer(fName, nTuples, buff);
-  var.Allocate(nTuples);
-  auto writePortal = var.WritePortal();
-  for (vtkm::Id i = 0; i < nTuples; i++)
+  try
   {
-    writePortal.Set(i, buff[static_cast<size_t>(i)]);
+    var = vtkm::cont::make_ArrayHandleMemoryMapped<T>(
+      fName, nTuples, 0, vtkm::cont::MemoryMapMode::CopyOnWrite);
   }
-}
-
-template <typename T>
-void ReadVector(const std::string& fName,
-                const vtkm::Id& nTuples,
-                vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>>& var)
-{
-  std::vector<T> buff;
-  ReadBuffer(fName, nTuples * 3, buff);
-
-  var.Allocate(nTuples);
-  vtkm::Vec<T, 3> v;
-  auto writePortal = var.WritePortal();
-  for (vtkm::Id i = 0; i < nTuples; i++)
+  catch (vtkm::cont::Error& error)
   {
-    v[0] = buff[static_cast<size_t>(i * 3 + 0)];
-    v[1] = buff[static_cast<size_t>(i * 3 + 1)];
-    v[2] = buff[static_cast<size_t>(i * 3 + 2)];
-    writePortal.Set(i, v);
+    throw vtkm::io::ErrorIO("Data file read failed: " + error.GetMessage());
   }
 }
 
@@ -221,13 +188,13 @@ void BOVDataSetReader::LoadFile()
     if (dataFormat == DataFormat::FloatData)
     {
       vtkm::cont::ArrayHandle<vtkm::Float32> var;
-      ReadScalar(fullPathDataFile, numTuples, var);
+      ReadArray(fullPathDataFile, numTuples, var);
       this->DataSet.AddPointField(variableName, var);
     }
     else if (dataFormat == DataFormat::DoubleData)
     {
       vtkm::cont::ArrayHandle<vtkm::Float64> var;
-      ReadScalar(fullPathDataFile, numTuples, var);
+      ReadArray(fullPathDataFile, numTuples, var);
       this->DataSet.AddPointField(variableName, var);
     }
   }
@@ -236,13 +203,13 @@ void BOVDataSetReader::LoadFile()
     if (dataFormat == DataFormat::FloatData)
     {
       vtkm::cont::ArrayHandle<vtkm::Vec3f_32> var;
-      ReadVector(fullPathDataFile, numTuples, var);
+      ReadArray(fullPathDataFile, numTuples, var);
       this->DataSet.AddPointField(variableName, var);
     }
     else if (dataFormat == DataFormat::DoubleData)
     {
       vtkm::cont::ArrayHandle<vtkm::Vec3f_64> var;
-      ReadVector(fullPathDataFile, numTuples, var);
+      ReadArray(fullPathDataFile, numTuples, var);
       this->DataSet.AddPointField(variableName, var);
     }
   }
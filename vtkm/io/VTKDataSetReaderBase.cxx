@@ -120,8 +120,40 @@ struct ClosestFloat<vtkm::UInt64>
   using Type = vtkm::Float64;
 };
 
+// Moves the data read into an array without copying when the type is already supported.
 template <typename T>
-vtkm::cont::UnknownArrayHandle CreateUnknownArrayHandle(const std::vector<T>& vec)
+vtkm::cont::ArrayHandle<T> ConvertVectorToArray(std::vector<T>&& vec, T)
+{
+  return vtkm::cont::make_ArrayHandleMove(std::move(vec));
+}
+
+template <typename InType, typename OutType>
+vtkm::cont::ArrayHandle<OutType> ConvertVectorToArray(std::vector<InType>&& vec, OutType)
+{
+  using InTraits = vtkm::VecTraits<InType>;
+  using OutTraits = vtkm::VecTraits<OutType>;
+  using OutComponentType = typename OutTraits::ComponentType;
+
+  vtkm::cont::ArrayHandle<OutType> output;
+  output.Allocate(static_cast<vtkm::Id>(vec.size()));
+  auto portal = output.WritePortal();
+  for (vtkm::Id i = 0; i < output.GetNumberOfValues(); ++i)
+  {
+    OutType outval = OutType();
+    for (vtkm::IdComponent j = 0; j < OutTraits::NUM_COMPONENTS; ++j)
+    {
+      OutTraits::SetComponent(
+        outval,
+        j,
+        static_cast<OutComponentType>(InTraits::GetComponent(vec[static_cast<std::size_t>(i)], j)));
+    }
+    portal.Set(i, outval);
+  }
+  return output;
+}
+
+template <typename T>
+vtkm::cont::UnknownArrayHandle CreateUnknownArrayHandle(std::vector<T>&& vec)
 {
   switch (vtkm::VecTraits<T>::NUM_COMPONENTS)
   {
@@ -137,15 +169,7 @@ vtkm::cont::UnknownArrayHandle CreateUnknownArrayHandle(const std::vector<T>& ve
                            << vtkm::io::internal::DataTypeName<CommonType>::Name() << ".");
       }
 
-      vtkm::cont::ArrayHandle<CommonType> output;
-      output.Allocate(static_cast<vtkm::Id>(vec.size()));
-      auto portal = output.WritePortal();
-      for (vtkm::Id i = 0; i < output.GetNumberOfValues(); ++i)
-      {
-        portal.Set(i, static_cast<CommonType>(vec[static_cast<std::size_t>(i)]));
-      }
-
-      return vtkm::cont::UnknownArrayHandle(output);
+      return vtkm::cont::UnknownArrayHandle(ConvertVectorToArray(std::move(vec), CommonType{}));
     }
     case 2:
     case 3:
@@ -167,21 +191,7 @@ vtkm::cont::UnknownArrayHandle CreateUnknownArrayHandle(const std::vector<T>& ve
                            << numComps << "].");
       }
 
-      vtkm::cont::ArrayHandle<CommonType> output;
-      output.Allocate(static_cast<vtkm::Id>(vec.size()));
-      auto portal = output.WritePortal();
-      for (vtkm::Id i = 0; i < output.GetNumberOfValues(); ++i)
-      {
-        CommonType outval = CommonType();
-        for (vtkm::IdComponent j = 0; j < numComps; ++j)
-        {
-          outval[j] = static_cast<OutComponentType>(
-            vtkm::VecTraits<T>::GetComponent(vec[static_cast<std::size_t>(i)], j));
-        }
-        portal.Set(i, outval);
-      }
-
-      return vtkm::cont::UnknownArrayHandle(output);
+      return vtkm::cont::UnknownArrayHandle(ConvertVectorToArray(std::move(vec), CommonType{}));
     }
     default:
     {
@@ -720,7 +730,7 @@ public:
     if ((this->Association != vtkm::cont::Field::Association::Cells) ||
         (this->Reader->GetCellsPermutation().GetNumberOfValues() < 1))
     {
-      *this->Data = CreateUnknownArrayHandle(buffer);
+      *this->Data = CreateUnknownArrayHandle(std::move(buffer));
     }
     else
     {
@@ -734,7 +744,7 @@ public:
         std::size_t inIndex = static_cast<std::size_t>(permutation.Get(outIndex));
         permutedBuffer[static_cast<std::size_t>(outIndex)] = buffer[inIndex];
       }
-      *this->Data = CreateUnknownArrayHandle(permutedBuffer);
+      *this->Data = CreateUnknownArrayHandle(std::move(permutedBuffer));
     }
   }
 
@@ -816,11 +826,7 @@ void VTKDataSetReaderBase::SkipArray(std::size_t numElements,
   }
   else
   {
-    for (std::size_t i = 0; i < numElements; ++i)
-    {
-      vtkm::UInt16 val;
-      this->DataFile->Stream >> val;
-    }
+    vtkm::io::internal::SkipASCIIValues(this->DataFile->Stream, numElements);
   }
   this->DataFile->Stream >> std::ws;
   this->SkipArrayMetaData(numComponents);
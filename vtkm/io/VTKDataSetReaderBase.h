@@ -10,12 +10,14 @@
 #ifndef vtk_m_io_VTKDataSetReaderBase_h
 #define vtk_m_io_VTKDataSetReaderBase_h
 
+#include <vtkm/StaticAssert.h>
 #include <vtkm/Types.h>
 #include <vtkm/cont/DataSet.h>
 #include <vtkm/io/ErrorIO.h>
 #include <vtkm/io/vtkm_io_export.h>
 
 #include <vtkm/io/internal/Endian.h>
+#include <vtkm/io/internal/ParseASCII.h>
 #include <vtkm/io/internal/VTKDataSetStructures.h>
 #include <vtkm/io/internal/VTKDataSetTypes.h>
 
@@ -199,7 +201,7 @@ protected:
     std::size_t numElements = buffer.size();
     if (this->DataFile->IsBinary)
     {
-      this->DataFile->Stream.read(reinterpret_cast<char*>(&buffer[0]),
+      this->DataFile->Stream.read(reinterpret_cast<char*>(buffer.data()),
                                   static_cast<std::streamsize>(numElements * sizeof(T)));
       if (vtkm::io::internal::IsLittleEndian())
       {
@@ -208,15 +210,11 @@ protected:
     }
     else
     {
-      for (std::size_t i = 0; i < numElements; ++i)
-      {
-        for (vtkm::IdComponent j = 0; j < numComponents; ++j)
-        {
-          typename internal::StreamIOType<ComponentType>::Type val;
-          this->DataFile->Stream >> val;
-          vtkm::VecTraits<T>::SetComponent(buffer[i], j, static_cast<ComponentType>(val));
-        }
-      }
+      // The components of T are stored contiguously, so they can be parsed as a flat array.
+      VTKM_STATIC_ASSERT(sizeof(T) == sizeof(ComponentType) * numComponents);
+      vtkm::io::internal::ReadASCIIValues(this->DataFile->Stream,
+                                          reinterpret_cast<ComponentType*>(buffer.data()),
+                                          numElements * static_cast<std::size_t>(numComponents));
     }
     this->DataFile->Stream >> std::ws;
     this->SkipArrayMetaData(numComponents);
@@ -237,7 +235,6 @@ protected:
   template <typename T>
   void SkipArray(std::size_t numElements, T)
   {
-    using ComponentType = typename vtkm::VecTraits<T>::ComponentType;
     constexpr vtkm::IdComponent numComponents = vtkm::VecTraits<T>::NUM_COMPONENTS;
 
     if (this->DataFile->IsBinary)
@@ -247,14 +244,8 @@ protected:
     }
     else
     {
-      for (std::size_t i = 0; i < numElements; ++i)
-      {
-        for (vtkm::IdComponent j = 0; j < numComponents; ++j)
-        {
-          typename internal::StreamIOType<ComponentType>::Type val;
-          this->DataFile->Stream >> val;
-        }
-      }
+      vtkm::io::internal::SkipASCIIValues(this->DataFile->Stream,
+                                          numElements * static_cast<std::size_t>(numComponents));
     }
     this->DataFile->Stream >> std::ws;
     this->SkipArrayMetaData(numComponents);
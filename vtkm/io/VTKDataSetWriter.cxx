@@ -12,12 +12,17 @@
 
 #include <vtkm/CellShape.h>
 
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleStride.h>
 #include <vtkm/cont/CellSetExplicit.h>
 #include <vtkm/cont/CellSetSingleType.h>
 #include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/ErrorBadType.h>
 #include <vtkm/cont/ErrorBadValue.h>
 #include <vtkm/cont/Field.h>
+#include <vtkm/cont/Logging.h>
+
+#include <vtkm/cont/internal/ArrayCopyUnknown.h>
 
 #include <vtkm/io/ErrorIO.h>
 
@@ -25,9 +30,12 @@
 #include <vtkm/io/internal/VTKDataSetTypes.h>
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cstring>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -77,6 +85,90 @@ void CallForBaseType(Functor&& functor, const vtkm::cont::UnknownArrayHandle& ar
   }
 }
 
+// Binary data are written in blocks of about this many bytes. While one block is written, the
+// byte swap for the next block is done on another thread.
+constexpr std::size_t BinaryBlockSize = std::size_t{ 4 } << 20;
+
+template <typename T>
+void WriteBinaryValues(std::ostream& out, const T* values, std::size_t numValues)
+{
+  if (!vtkm::io::internal::IsLittleEndian())
+  {
+    out.write(reinterpret_cast<const char*>(values),
+              static_cast<std::streamsize>(numValues * sizeof(T)));
+    return;
+  }
+
+  const std::size_t valuesPerBlock = std::max(BinaryBlockSize / sizeof(T), std::size_t{ 1 });
+  const std::size_t numBlocks = (numValues + valuesPerBlock - 1) / valuesPerBlock;
+  auto swapBlock = [values, numValues, valuesPerBlock](std::size_t blockIndex,
+                                                       std::vector<T>& block) {
+    const std::size_t begin = blockIndex * valuesPerBlock;
+    const std::size_t end = std::min(begin + valuesPerBlock, numValues);
+    block.assign(values + begin, values + end);
+    vtkm::io::internal::FlipEndianness(block);
+  };
+
+  std::array<std::vector<T>, 2> blocks;
+  if (numBlocks > 0)
+  {
+    swapBlock(0, blocks[0]);
+  }
+  for (std::size_t blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+  {
+    std::future<void> nextBlock;
+    if ((blockIndex + 1) < numBlocks)
+    {
+      nextBlock = std::async(
+        std::launch::async, swapBlock, blockIndex + 1, std::ref(blocks[(blockIndex + 1) % 2]));
+    }
+    const std::vector<T>& block = blocks[blockIndex % 2];
+    out.write(reinterpret_cast<const char*>(block.data()),
+              static_cast<std::streamsize>(block.size() * sizeof(T)));
+    if (nextBlock.valid())
+    {
+      nextBlock.get();
+    }
+  }
+}
+
+// Returns a basic array containing the components of `array` interleaved as they are written
+// to the file. If the array already stores its components that way (as `ArrayHandleBasic`
+// does), its memory is used directly. Otherwise, the components are gathered on the device.
+template <typename T>
+vtkm::cont::ArrayHandleBasic<T> GetInterleavedComponents(const vtkm::cont::UnknownArrayHandle& array)
+{
+  const vtkm::Id numValues = array.GetNumberOfValues();
+  const vtkm::IdComponent numComponents = array.GetNumberOfComponentsFlat();
+
+  std::vector<vtkm::cont::ArrayHandleStride<T>> components;
+  bool interleaved = true;
+  for (vtkm::IdComponent cIndex = 0; cIndex < numComponents; ++cIndex)
+  {
+    components.push_back(array.ExtractComponent<T>(cIndex));
+    const auto& component = components.back();
+    interleaved = interleaved && (component.GetStride() == numComponents) &&
+      (component.GetOffset() == cIndex) && (component.GetModulo() == 0) &&
+      (component.GetDivisor() == 1) &&
+      (component.GetBasicArray() == components.front().GetBasicArray());
+  }
+  if (interleaved && !components.empty() &&
+      (components.front().GetBasicArray().GetNumberOfValues() >= (numValues * numComponents)))
+  {
+    return components.front().GetBasicArray();
+  }
+
+  vtkm::cont::ArrayHandleBasic<T> flat;
+  flat.Allocate(numValues * numComponents);
+  for (vtkm::IdComponent cIndex = 0; cIndex < numComponents; ++cIndex)
+  {
+    vtkm::cont::ArrayHandleStride<T> destination(flat, numValues, numComponents, cIndex);
+    vtkm::cont::internal::ArrayCopyUnknown(components[static_cast<std::size_t>(cIndex)],
+                                           vtkm::cont::UnknownArrayHandle(destination));
+  }
+  return flat;
+}
+
 template <typename T>
 using ArrayHandleRectilinearCoordinates =
   vtkm::cont::ArrayHandleCartesianProduct<vtkm::cont::ArrayHandle<T>,
@@ -91,19 +183,28 @@ struct OutputArrayDataFunctor
                             std::ostream& out,
                             vtkm::io::FileType fileType) const
   {
-    auto componentArray = array.ExtractArrayFromComponents<T>();
-    auto portal = componentArray.ReadPortal();
     switch (fileType)
     {
       case vtkm::io::FileType::ASCII:
-        this->OutputAsciiArray(portal, out);
+        this->OutputAsciiArray(array.ExtractArrayFromComponents<T>().ReadPortal(), out);
         break;
       case vtkm::io::FileType::BINARY:
-        this->OutputBinaryArray(portal, out);
+        this->OutputBinaryArray(T{}, array, out);
         break;
     }
   }
 
+  template <typename T>
+  void OutputBinaryArray(T, const vtkm::cont::UnknownArrayHandle& array, std::ostream& out) const
+  {
+    vtkm::cont::ArrayHandleBasic<T> flat = GetInterleavedComponents<T>(array);
+    auto portal = flat.ReadPortal();
+    WriteBinaryValues(out,
+                      portal.GetArray(),
+                      static_cast<std::size_t>(array.GetNumberOfValues() *
+                                               array.GetNumberOfComponentsFlat()));
+  }
+
   template <typename PortalType>
   void OutputAsciiArray(const PortalType& portal, std::ostream& out) const
   {
@@ -128,30 +229,6 @@ struct OutputArrayDataFunctor
       out << "\n";
     }
   }
-
-  template <typename PortalType>
-  void OutputBinaryArray(const PortalType& portal, std::ostream& out) const
-  {
-    using T = typename PortalType::ValueType::ComponentType;
-
-    vtkm::Id numValues = portal.GetNumberOfValues();
-    std::vector<T> tuple;
-    for (vtkm::Id valueIndex = 0; valueIndex < numValues; ++valueIndex)
-    {
-      auto value = portal.Get(valueIndex);
-      tuple.resize(static_cast<std::size_t>(value.GetNumberOfComponents()));
-      for (vtkm::IdComponent cIndex = 0; cIndex < value.GetNumberOfComponents(); ++cIndex)
-      {
-        tuple[static_cast<std::size_t>(cIndex)] = value[cIndex];
-      }
-      if (vtkm::io::internal::IsLittleEndian())
-      {
-        vtkm::io::internal::FlipEndianness(tuple);
-      }
-      out.write(reinterpret_cast<const char*>(tuple.data()),
-                static_cast<std::streamsize>(tuple.size() * sizeof(T)));
-    }
-  }
 };
 
 void OutputArrayData(const vtkm::cont::UnknownArrayHandle& array,
@@ -292,6 +369,69 @@ void WriteExplicitCellsBinary(std::ostream& out, const CellSetType& cellSet)
             static_cast<std::streamsize>(buffer.size() * sizeof(vtkm::Int32)));
 }
 
+template <typename ShapesArrayType, typename ConnectivityArrayType, typename OffsetsArrayType>
+void WriteExplicitCellArraysBinary(std::ostream& out,
+                                   const ShapesArrayType& shapes,
+                                   const ConnectivityArrayType& connectivity,
+                                   const OffsetsArrayType& offsets)
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "Write binary explicit cells");
+
+  // The legacy format stores everything as 32-bit ints. Convert on the device.
+  vtkm::cont::ArrayHandle<vtkm::Int32> connectivity32;
+  vtkm::cont::ArrayCopy(connectivity, connectivity32);
+  vtkm::cont::ArrayHandle<vtkm::Int32> shapes32;
+  vtkm::cont::ArrayCopy(shapes, shapes32);
+
+  const vtkm::Id nCells = shapes32.GetNumberOfValues();
+  const vtkm::Id conn_length = nCells + connectivity32.GetNumberOfValues();
+  out << "CELLS " << nCells << " " << conn_length << '\n';
+
+  // Each cell is written as its number of points followed by its point indices.
+  auto offsetsPortal = offsets.ReadPortal();
+  auto connectivityPortal = connectivity32.ReadPortal();
+  const vtkm::Int32* connectivityPointer = connectivityPortal.GetArray();
+  std::vector<vtkm::Int32> buffer(static_cast<std::size_t>(conn_length));
+  std::size_t bufferIndex = 0;
+  for (vtkm::Id i = 0; i < nCells; ++i)
+  {
+    const vtkm::Id begin = offsetsPortal.Get(i);
+    const vtkm::Id end = offsetsPortal.Get(i + 1);
+    buffer[bufferIndex++] = static_cast<vtkm::Int32>(end - begin);
+    std::copy(connectivityPointer + begin, connectivityPointer + end, buffer.data() + bufferIndex);
+    bufferIndex += static_cast<std::size_t>(end - begin);
+  }
+  VTKM_ASSERT(bufferIndex == buffer.size());
+  WriteBinaryValues(out, buffer.data(), buffer.size());
+
+  out << "CELL_TYPES " << nCells << '\n';
+  WriteBinaryValues(
+    out, shapes32.ReadPortal().GetArray(), static_cast<std::size_t>(shapes32.GetNumberOfValues()));
+}
+
+template <typename ShapesStorage, typename ConnectivityStorage, typename OffsetsStorage>
+void WriteExplicitCellsBinary(
+  std::ostream& out,
+  const vtkm::cont::CellSetExplicit<ShapesStorage, ConnectivityStorage, OffsetsStorage>& cellSet)
+{
+  WriteExplicitCellArraysBinary(
+    out,
+    cellSet.GetShapesArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{}),
+    cellSet.GetConnectivityArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{}),
+    cellSet.GetOffsetsArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{}));
+}
+
+template <typename ConnectivityStorage>
+void WriteExplicitCellsBinary(std::ostream& out,
+                              const vtkm::cont::CellSetSingleType<ConnectivityStorage>& cellSet)
+{
+  WriteExplicitCellArraysBinary(
+    out,
+    cellSet.GetShapesArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{}),
+    cellSet.GetConnectivityArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{}),
+    cellSet.GetOffsetsArray(vtkm::TopologyElementTagCell{}, vtkm::TopologyElementTagPoint{}));
+}
+
 template <class CellSetType>
 void WriteExplicitCells(std::ostream& out, const CellSetType& cellSet, vtkm::io::FileType fileType)
 {
@@ -13,6 +13,7 @@
 #include <vtkm/Types.h>
 
 #include <algorithm>
+#include <cstring>
 #include <vector>
 
 namespace vtkm
@@ -29,32 +30,84 @@ inline bool IsLittleEndian()
   return (*i8p == 1);
 }
 
-template <typename T>
-inline void FlipEndianness(std::vector<T>& buffer)
+namespace detail
+{
+
+// The byte swaps are written with shifts on unsigned integers so that compilers recognize
+// them as byte swap instructions and vectorize the loops in `FlipEndianness`.
+inline vtkm::UInt16 ByteSwap(vtkm::UInt16 value)
+{
+  return static_cast<vtkm::UInt16>((value << 8) | (value >> 8));
+}
+
+inline vtkm::UInt32 ByteSwap(vtkm::UInt32 value)
+{
+  return ((value & 0x000000FFu) << 24) | ((value & 0x0000FF00u) << 8) |
+    ((value & 0x00FF0000u) >> 8) | ((value & 0xFF000000u) >> 24);
+}
+
+inline vtkm::UInt64 ByteSwap(vtkm::UInt64 value)
+{
+  return (static_cast<vtkm::UInt64>(ByteSwap(static_cast<vtkm::UInt32>(value))) << 32) |
+    static_cast<vtkm::UInt64>(ByteSwap(static_cast<vtkm::UInt32>(value >> 32)));
+}
+
+template <typename UIntType>
+inline void ByteSwapWords(vtkm::UInt8* bytes, std::size_t numWords)
 {
-  vtkm::UInt8* bytes = reinterpret_cast<vtkm::UInt8*>(&buffer[0]);
-  const std::size_t tsize = sizeof(T);
-  const std::size_t bsize = buffer.size();
-  for (std::size_t i = 0; i < bsize; i++, bytes += tsize)
+  for (std::size_t i = 0; i < numWords; ++i, bytes += sizeof(UIntType))
   {
-    std::reverse(bytes, bytes + tsize);
+    // Use memcpy to avoid aliasing problems. It is optimized away.
+    UIntType word;
+    std::memcpy(&word, bytes, sizeof(UIntType));
+    word = ByteSwap(word);
+    std::memcpy(bytes, &word, sizeof(UIntType));
   }
 }
 
-template <typename T, vtkm::IdComponent N>
-inline void FlipEndianness(std::vector<vtkm::Vec<T, N>>& buffer)
+} // namespace detail
+
+/// \brief Reverses the bytes of each of `numComponents` contiguous components.
+///
+/// Each component is `componentSize` bytes. The common sizes of 2, 4, and 8 bytes are
+/// swapped in bulk, which is much faster than reversing each component independently.
+inline void FlipEndianness(void* data, std::size_t numComponents, std::size_t componentSize)
 {
-  vtkm::UInt8* bytes = reinterpret_cast<vtkm::UInt8*>(&buffer[0]);
-  const std::size_t tsize = sizeof(T);
-  const std::size_t bsize = buffer.size();
-  for (std::size_t i = 0; i < bsize; i++)
+  vtkm::UInt8* bytes = reinterpret_cast<vtkm::UInt8*>(data);
+  switch (componentSize)
   {
-    for (vtkm::IdComponent j = 0; j < N; j++, bytes += tsize)
-    {
-      std::reverse(bytes, bytes + tsize);
-    }
+    case 1:
+      break;
+    case 2:
+      detail::ByteSwapWords<vtkm::UInt16>(bytes, numComponents);
+      break;
+    case 4:
+      detail::ByteSwapWords<vtkm::UInt32>(bytes, numComponents);
+      break;
+    case 8:
+      detail::ByteSwapWords<vtkm::UInt64>(bytes, numComponents);
+      break;
+    default:
+      for (std::size_t i = 0; i < numComponents; i++, bytes += componentSize)
+      {
+        std::reverse(bytes, bytes + componentSize);
+      }
+      break;
   }
 }
+
+template <typename T>
+inline void FlipEndianness(std::vector<T>& buffer)
+{
+  vtkm::io::internal::FlipEndianness(buffer.data(), buffer.size(), sizeof(T));
+}
+
+template <typename T, vtkm::IdComponent N>
+inline void FlipEndianness(std::vector<vtkm::Vec<T, N>>& buffer)
+{
+  vtkm::io::internal::FlipEndianness(
+    buffer.data(), buffer.size() * static_cast<std::size_t>(N), sizeof(T));
+}
 }
 }
 } // vtkm::io::internal
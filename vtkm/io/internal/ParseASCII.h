@@ -0,0 +1,438 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_io_internal_ParseASCII_h
+#define vtk_m_io_internal_ParseASCII_h
+
+#include <vtkm/Types.h>
+#include <vtkm/io/ErrorIO.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <future>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <locale.h>
+#if defined(__APPLE__) || defined(__FreeBSD__)
+#include <xlocale.h>
+#endif
+
+namespace vtkm
+{
+namespace io
+{
+namespace internal
+{
+
+namespace detail
+{
+
+// The largest block of characters read from the file at once.
+constexpr std::size_t ASCIIBlockSize = std::size_t{ 16 } << 20;
+
+// Blocks are split into pieces parsed on separate threads. Pieces are no smaller than this.
+constexpr std::size_t ASCIIMinimumPieceSize = std::size_t{ 512 } << 10;
+
+// Used to guess how many characters to read for the number of values requested. Reading too
+// little is fine (another block is read), but reading far too much for small arrays wastes
+// time since the unused characters get read again for the next array.
+constexpr std::size_t ASCIICharactersPerValueEstimate = 24;
+
+inline bool IsSpace(char c)
+{
+  return (c == ' ') || (c == '\n') || (c == '\r') || (c == '\t') || (c == '\v') || (c == '\f');
+}
+
+inline bool IsTokenEnd(const char* cursor)
+{
+  return (*cursor == '\0') || IsSpace(*cursor);
+}
+
+// The numbers in files are always written in the "C" locale, so they are parsed in that
+// locale regardless of the global locale of the program (which, for example, might use a
+// comma as the decimal separator).
+#if defined(_WIN32)
+using CLocaleType = _locale_t;
+
+struct CLocale
+{
+  CLocaleType Locale = _create_locale(LC_NUMERIC, "C");
+  ~CLocale() { _free_locale(this->Locale); }
+};
+#else
+using CLocaleType = locale_t;
+
+struct CLocale
+{
+  CLocaleType Locale = newlocale(LC_NUMERIC_MASK, "C", static_cast<CLocaleType>(0));
+  ~CLocale() { freelocale(this->Locale); }
+};
+#endif
+
+inline CLocaleType GetCLocale()
+{
+  static const CLocale cLocale;
+  return cLocale.Locale;
+}
+
+inline vtkm::Float32 StringToFloat32(const char* string, char** end)
+{
+#if defined(_WIN32)
+  return _strtof_l(string, end, GetCLocale());
+#else
+  return strtof_l(string, end, GetCLocale());
+#endif
+}
+
+inline vtkm::Float64 StringToFloat64(const char* string, char** end)
+{
+#if defined(_WIN32)
+  return _strtod_l(string, end, GetCLocale());
+#else
+  return strtod_l(string, end, GetCLocale());
+#endif
+}
+
+// The strto*_l functions require a null terminated string, which the blocks are. On success,
+// `cursor` is moved to the end of the token.
+inline bool ParseToken(const char*& cursor, vtkm::Float32& value)
+{
+  char* end;
+  value = StringToFloat32(cursor, &end);
+  if ((end == cursor) || !IsTokenEnd(end))
+  {
+    return false;
+  }
+  cursor = end;
+  return true;
+}
+
+inline bool ParseToken(const char*& cursor, vtkm::Float64& value)
+{
+  char* end;
+  value = StringToFloat64(cursor, &end);
+  if ((end == cursor) || !IsTokenEnd(end))
+  {
+    return false;
+  }
+  cursor = end;
+  return true;
+}
+
+// Integers are simple enough to parse directly, which does not depend on the locale. Parses
+// an optional sign followed by decimal digits. Fails if the magnitude does not fit in 64 bits.
+inline bool ParseIntegerToken(const char*& cursor, bool& negative, vtkm::UInt64& magnitude)
+{
+  const char* end = cursor;
+  negative = (*end == '-');
+  if ((*end == '-') || (*end == '+'))
+  {
+    ++end;
+  }
+  const char* digits = end;
+  magnitude = 0;
+  constexpr vtkm::UInt64 maxMagnitude = std::numeric_limits<vtkm::UInt64>::max();
+  for (; (*end >= '0') && (*end <= '9'); ++end)
+  {
+    const vtkm::UInt64 digit = static_cast<vtkm::UInt64>(*end - '0');
+    if (magnitude > (maxMagnitude - digit) / 10)
+    {
+      return false;
+    }
+    magnitude = (magnitude * 10) + digit;
+  }
+  if ((end == digits) || !IsTokenEnd(end))
+  {
+    return false;
+  }
+  cursor = end;
+  return true;
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, bool>::type
+ParseToken(const char*& cursor, T& value)
+{
+  bool negative;
+  vtkm::UInt64 magnitude;
+  const char* end = cursor;
+  if (!ParseIntegerToken(end, negative, magnitude))
+  {
+    return false;
+  }
+  constexpr vtkm::UInt64 maxPositive =
+    static_cast<vtkm::UInt64>(std::numeric_limits<vtkm::Int64>::max());
+  if (magnitude > (negative ? maxPositive + 1 : maxPositive))
+  {
+    return false;
+  }
+  // Negate in unsigned arithmetic so that the most negative value does not overflow.
+  value = static_cast<T>(static_cast<vtkm::Int64>(negative ? (0 - magnitude) : magnitude));
+  cursor = end;
+  return true;
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value, bool>::type
+ParseToken(const char*& cursor, T& value)
+{
+  bool negative;
+  vtkm::UInt64 magnitude;
+  if (!ParseIntegerToken(cursor, negative, magnitude))
+  {
+    return false;
+  }
+  // Like strtoull, a negative value wraps around.
+  value = static_cast<T>(negative ? (0 - magnitude) : magnitude);
+  return true;
+}
+
+struct ParsePieceResult
+{
+  std::size_t NumberOfValues = 0;
+  // Where parsing stopped. Either after the last value or at the token that could not be
+  // parsed.
+  const char* End = nullptr;
+  bool Failed = false;
+};
+
+// Parses up to `maxValues` whitespace separated values in [begin, end). `end` must be at a
+// whitespace character or at the null terminator of the block.
+template <typename T, typename OutputIterator>
+inline ParsePieceResult ParsePiece(const char* begin,
+                                   const char* end,
+                                   std::size_t maxValues,
+                                   OutputIterator output)
+{
+  ParsePieceResult result;
+  const char* cursor = begin;
+  while (result.NumberOfValues < maxValues)
+  {
+    while ((cursor < end) && IsSpace(*cursor))
+    {
+      ++cursor;
+    }
+    if (cursor >= end)
+    {
+      break;
+    }
+    T value;
+    if (!ParseToken(cursor, value))
+    {
+      result.Failed = true;
+      break;
+    }
+    *output++ = value;
+    ++result.NumberOfValues;
+  }
+  result.End = cursor;
+  return result;
+}
+
+// Returns the position just after the `numTokens`th token starting at `cursor`, or `end` if
+// there are fewer tokens. `numTokens` is decremented by the number of tokens skipped.
+inline const char* SkipTokens(const char* cursor, const char* end, std::size_t& numTokens)
+{
+  while (numTokens > 0)
+  {
+    while ((cursor < end) && IsSpace(*cursor))
+    {
+      ++cursor;
+    }
+    if (cursor >= end)
+    {
+      break;
+    }
+    while ((cursor < end) && !IsSpace(*cursor))
+    {
+      ++cursor;
+    }
+    --numTokens;
+  }
+  return cursor;
+}
+
+// Parses the values in a block, splitting it across threads if it is big enough. Returns the
+// offset into the block where parsing stopped.
+template <typename T>
+inline std::size_t ParseBlock(const char* block,
+                              std::size_t length,
+                              T* values,
+                              std::size_t maxValues,
+                              std::size_t& numValues)
+{
+  std::size_t numPieces = std::min<std::size_t>(
+    std::max(std::thread::hardware_concurrency(), 1u), length / ASCIIMinimumPieceSize);
+  if (numPieces <= 1)
+  {
+    ParsePieceResult result = ParsePiece<T>(block, block + length, maxValues, values);
+    numValues = result.NumberOfValues;
+    return static_cast<std::size_t>(result.End - block);
+  }
+
+  // Split the block at whitespace so that no token is broken across pieces.
+  std::vector<const char*> boundaries(numPieces + 1);
+  boundaries[0] = block;
+  boundaries[numPieces] = block + length;
+  for (std::size_t piece = 1; piece < numPieces; ++piece)
+  {
+    const char* boundary = std::max(block + (length * piece) / numPieces, boundaries[piece - 1]);
+    while ((boundary < block + length) && !IsSpace(*boundary))
+    {
+      ++boundary;
+    }
+    boundaries[piece] = boundary;
+  }
+
+  // Each piece is parsed without knowing how many values come before it, so it may parse
+  // more values than are needed. The extra values are dropped.
+  struct PieceValues
+  {
+    std::vector<T> Values;
+    ParsePieceResult Result;
+  };
+  std::vector<std::future<PieceValues>> futures;
+  futures.reserve(numPieces);
+  for (std::size_t piece = 0; piece < numPieces; ++piece)
+  {
+    const char* begin = boundaries[piece];
+    const char* end = boundaries[piece + 1];
+    futures.push_back(std::async(std::launch::async, [begin, end, maxValues]() {
+      PieceValues pieceValues;
+      pieceValues.Result =
+        ParsePiece<T>(begin, end, maxValues, std::back_inserter(pieceValues.Values));
+      return pieceValues;
+    }));
+  }
+
+  numValues = 0;
+  const char* stop = block;
+  for (std::size_t piece = 0; piece < numPieces; ++piece)
+  {
+    PieceValues pieceValues = futures[piece].get();
+    std::size_t numToCopy =
+      std::min(pieceValues.Values.size(), maxValues - numValues);
+    std::copy(pieceValues.Values.begin(),
+              pieceValues.Values.begin() + static_cast<std::ptrdiff_t>(numToCopy),
+              values + numValues);
+    numValues += numToCopy;
+
+    if (numToCopy < pieceValues.Values.size())
+    {
+      std::size_t numTokens = numToCopy;
+      stop = SkipTokens(boundaries[piece], boundaries[piece + 1], numTokens);
+      break;
+    }
+    stop = pieceValues.Result.End;
+    if ((numValues == maxValues) || pieceValues.Result.Failed)
+    {
+      break;
+    }
+  }
+  // Any futures not retrieved finish when they are destroyed.
+  return static_cast<std::size_t>(stop - block);
+}
+
+// Reads the next block of characters from `buffer` into `block`. The block is trimmed back
+// to whitespace so that the last token is never cut in half, and it is null terminated.
+// Returns the number of characters in the block.
+inline std::size_t ReadBlock(std::streambuf* buffer,
+                             std::size_t requestedLength,
+                             std::vector<char>& block)
+{
+  requestedLength = std::min(std::max(requestedLength, std::size_t{ 4096 }), ASCIIBlockSize);
+  block.resize(requestedLength + 1);
+  std::size_t length = static_cast<std::size_t>(
+    buffer->sgetn(block.data(), static_cast<std::streamsize>(requestedLength)));
+  if (length == requestedLength)
+  {
+    // Not at the end of the file, so the last token might continue into the next block.
+    while ((length > 0) && !IsSpace(block[length - 1]))
+    {
+      --length;
+    }
+    if (length == 0)
+    {
+      throw vtkm::io::ErrorIO("Parse Error: token too long");
+    }
+  }
+  block[length] = '\0';
+  return length;
+}
+
+} // namespace detail
+
+/// \brief Reads `numValues` whitespace separated numbers from an ASCII stream.
+///
+/// This is much faster than reading each value with `operator>>`. Large blocks of characters
+/// are read from the stream at once and parsed on multiple threads. When this returns, the
+/// stream is positioned just after the last value read. An `ErrorIO` is thrown if the stream
+/// ends early or a token cannot be parsed as a `T`.
+///
+template <typename T>
+inline void ReadASCIIValues(std::istream& stream, T* values, std::size_t numValues)
+{
+  std::streambuf* buffer = stream.rdbuf();
+  std::vector<char> block;
+  std::size_t numRead = 0;
+  while (numRead < numValues)
+  {
+    std::streampos blockStart = buffer->pubseekoff(0, std::ios_base::cur, std::ios_base::in);
+    std::size_t length = detail::ReadBlock(
+      buffer, (numValues - numRead) * detail::ASCIICharactersPerValueEstimate, block);
+
+    std::size_t numInBlock;
+    std::size_t stop =
+      detail::ParseBlock(block.data(), length, values + numRead, numValues - numRead, numInBlock);
+    buffer->pubseekpos(blockStart + static_cast<std::streamoff>(stop), std::ios_base::in);
+
+    // Stopping before the end of the block without all the values means there is a bad token.
+    // An empty block means the file ended.
+    if ((length == 0) || ((stop < length) && (numRead + numInBlock < numValues)))
+    {
+      throw vtkm::io::ErrorIO("Parse Error: expected " + std::to_string(numValues) +
+                              " values but could only read " +
+                              std::to_string(numRead + numInBlock));
+    }
+    numRead += numInBlock;
+  }
+}
+
+/// \brief Skips `numValues` whitespace separated tokens in an ASCII stream.
+///
+inline void SkipASCIIValues(std::istream& stream, std::size_t numValues)
+{
+  std::streambuf* buffer = stream.rdbuf();
+  std::vector<char> block;
+  while (numValues > 0)
+  {
+    std::streampos blockStart = buffer->pubseekoff(0, std::ios_base::cur, std::ios_base::in);
+    std::size_t length = detail::ReadBlock(
+      buffer, numValues * detail::ASCIICharactersPerValueEstimate, block);
+    if (length == 0)
+    {
+      throw vtkm::io::ErrorIO("Parse Error: unexpected end of file");
+    }
+
+    const char* stop = detail::SkipTokens(block.data(), block.data() + length, numValues);
+    buffer->pubseekpos(blockStart + static_cast<std::streamoff>(stop - block.data()),
+                       std::ios_base::in);
+  }
+}
+
+}
+}
+} // vtkm::io::internal
+
+#endif //vtk_m_io_internal_ParseASCII_h
@@ -0,0 +1,211 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/io/internal/Endian.h>
+#include <vtkm/io/internal/ParseASCII.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <clocale>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+template <typename T>
+void TestReadValues(std::size_t numValues)
+{
+  std::cout << "Reading " << numValues << " values of " << vtkm::testing::TypeName<T>::Name()
+            << std::endl;
+
+  // Mix up the whitespace and follow the values with more text, like a VTK file would.
+  std::stringstream stream;
+  stream.precision(17);
+  for (std::size_t index = 0; index < numValues; ++index)
+  {
+    stream << +TestValue(static_cast<vtkm::Id>(index), T{});
+    stream << (((index % 9) == 8) ? "\n" : ((index % 5) == 4) ? "\t  " : " ");
+  }
+  stream << "\nMETADATA\n";
+
+  std::vector<T> values(numValues);
+  vtkm::io::internal::ReadASCIIValues(stream, values.data(), numValues);
+  for (std::size_t index = 0; index < numValues; ++index)
+  {
+    VTKM_TEST_ASSERT(test_equal(values[index], TestValue(static_cast<vtkm::Id>(index), T{})),
+                     "Bad value at ",
+                     index);
+  }
+
+  std::string tag;
+  stream >> tag;
+  VTKM_TEST_ASSERT(tag == "METADATA", "Stream not left after last value. Got ", tag);
+
+  // Skipping should leave the stream in the same place.
+  stream.clear();
+  stream.seekg(0);
+  vtkm::io::internal::SkipASCIIValues(stream, numValues);
+  stream >> tag;
+  VTKM_TEST_ASSERT(tag == "METADATA", "Skip did not leave stream after last value. Got ", tag);
+}
+
+void TestErrors()
+{
+  std::cout << "Test parse errors" << std::endl;
+  std::vector<vtkm::Float32> values(4);
+
+  std::stringstream tooShort("1 2 3");
+  try
+  {
+    vtkm::io::internal::ReadASCIIValues(tooShort, values.data(), 4);
+    VTKM_TEST_FAIL("Did not throw for missing values.");
+  }
+  catch (vtkm::io::ErrorIO& error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  std::stringstream badToken("1 2 3x 4");
+  try
+  {
+    vtkm::io::internal::ReadASCIIValues(badToken, values.data(), 4);
+    VTKM_TEST_FAIL("Did not throw for bad token.");
+  }
+  catch (vtkm::io::ErrorIO& error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  std::vector<vtkm::Int32> ints(2);
+  std::stringstream floatForInt("1 2.5");
+  try
+  {
+    vtkm::io::internal::ReadASCIIValues(floatForInt, ints.data(), 2);
+    VTKM_TEST_FAIL("Did not throw for float in int array.");
+  }
+  catch (vtkm::io::ErrorIO& error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void TestLocale()
+{
+  std::cout << "Test parsing with a different global locale" << std::endl;
+
+  // Look for a locale that uses a comma as the decimal separator.
+  std::string oldLocale = setlocale(LC_NUMERIC, nullptr);
+  const char* commaLocales[] = { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "German" };
+  bool foundLocale = false;
+  for (const char* localeName : commaLocales)
+  {
+    if (setlocale(LC_NUMERIC, localeName) != nullptr)
+    {
+      foundLocale = true;
+      break;
+    }
+  }
+  if (!foundLocale)
+  {
+    std::cout << "  No locale with a comma decimal separator available. Skipping." << std::endl;
+    return;
+  }
+
+  std::vector<vtkm::Float64> values(3);
+  std::stringstream stream("1.5 -2.25 3e2");
+  vtkm::io::internal::ReadASCIIValues(stream, values.data(), 3);
+  setlocale(LC_NUMERIC, oldLocale.c_str());
+  VTKM_TEST_ASSERT(values == std::vector<vtkm::Float64>{ 1.5, -2.25, 300 },
+                   "Values not parsed in the C locale.");
+}
+
+void TestIntegerLimits()
+{
+  std::cout << "Test integer limits" << std::endl;
+  std::vector<vtkm::Int64> values(2);
+  std::stringstream limits("-9223372036854775808 9223372036854775807");
+  vtkm::io::internal::ReadASCIIValues(limits, values.data(), 2);
+  VTKM_TEST_ASSERT(values[0] == std::numeric_limits<vtkm::Int64>::min());
+  VTKM_TEST_ASSERT(values[1] == std::numeric_limits<vtkm::Int64>::max());
+
+  std::stringstream tooBig("9223372036854775808");
+  try
+  {
+    vtkm::io::internal::ReadASCIIValues(tooBig, values.data(), 1);
+    VTKM_TEST_FAIL("Did not throw for integer out of range.");
+  }
+  catch (vtkm::io::ErrorIO& error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+template <typename T>
+void TestFlipEndianness()
+{
+  std::cout << "Flip endianness of " << vtkm::testing::TypeName<T>::Name() << std::endl;
+  constexpr std::size_t numValues = 1000;
+  std::vector<T> values(numValues);
+  for (std::size_t index = 0; index < numValues; ++index)
+  {
+    values[index] = TestValue(static_cast<vtkm::Id>(index), T{});
+  }
+  std::vector<T> flipped = values;
+  vtkm::io::internal::FlipEndianness(flipped);
+  for (std::size_t index = 0; index < numValues; ++index)
+  {
+    const vtkm::UInt8* original = reinterpret_cast<const vtkm::UInt8*>(&values[index]);
+    const vtkm::UInt8* reversed = reinterpret_cast<const vtkm::UInt8*>(&flipped[index]);
+    using ComponentType = typename vtkm::VecTraits<T>::ComponentType;
+    for (std::size_t byte = 0; byte < sizeof(T); ++byte)
+    {
+      std::size_t component = byte / sizeof(ComponentType);
+      std::size_t offset = byte % sizeof(ComponentType);
+      VTKM_TEST_ASSERT(
+        reversed[byte] ==
+        original[component * sizeof(ComponentType) + sizeof(ComponentType) - offset - 1]);
+    }
+  }
+  vtkm::io::internal::FlipEndianness(flipped);
+  VTKM_TEST_ASSERT(flipped == values);
+}
+
+void Run()
+{
+  TestReadValues<vtkm::Float32>(100);
+  TestReadValues<vtkm::Float64>(100);
+  TestReadValues<vtkm::Int8>(100);
+  TestReadValues<vtkm::UInt8>(100);
+  TestReadValues<vtkm::Int32>(100);
+  TestReadValues<vtkm::UInt64>(100);
+  // Big enough to be split into multiple blocks and parsed on multiple threads.
+  TestReadValues<vtkm::Float64>(2000000);
+  TestReadValues<vtkm::Int64>(2000000);
+  TestErrors();
+  TestLocale();
+  TestIntegerLimits();
+
+  TestFlipEndianness<vtkm::UInt8>();
+  TestFlipEndianness<vtkm::Int16>();
+  TestFlipEndianness<vtkm::Float32>();
+  TestFlipEndianness<vtkm::Float64>();
+  TestFlipEndianness<vtkm::Vec3f_32>();
+  TestFlipEndianness<vtkm::Vec<vtkm::Int64, 2>>();
+}
+
+} // anonymous namespace
+
+int UnitTestParseASCII(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(Run, argc, argv);
+}
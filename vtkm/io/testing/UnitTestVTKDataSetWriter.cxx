@@ -265,12 +265,44 @@ void TestVTKCompoundWrite()
   std::remove("chirp.vtk");
 }
 
+void TestVTKBinaryRoundTrip()
+{
+  // Use enough points that the binary arrays span several write blocks, and store one field
+  // with non-interleaved components so that it has to be gathered before it is written.
+  const vtkm::Id3 dims(80, 80, 100);
+  vtkm::cont::DataSet dataSet = vtkm::cont::DataSetBuilderUniform::Create(dims);
+  const vtkm::Id numPoints = dataSet.GetNumberOfPoints();
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> scalars;
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_32> vectors;
+  vtkm::cont::ArrayHandleSOA<vtkm::Vec3f_32> soaVectors;
+  scalars.Allocate(numPoints);
+  vectors.Allocate(numPoints);
+  soaVectors.Allocate(numPoints);
+  SetPortal(scalars.WritePortal());
+  SetPortal(vectors.WritePortal());
+  SetPortal(soaVectors.WritePortal());
+  dataSet.AddPointField("scalars", scalars);
+  dataSet.AddPointField("vectors", vectors);
+  dataSet.AddPointField("soa_vectors", soaVectors);
+
+  std::cout << "Writing large binary data set" << std::endl;
+  vtkm::io::VTKDataSetWriter writer("binary-round-trip.vtk");
+  writer.SetFileTypeToBinary();
+  writer.WriteDataSet(dataSet);
+
+  vtkm::io::VTKDataSetReader reader("binary-round-trip.vtk");
+  CheckWrittenReadData(dataSet, reader.ReadDataSet());
+  std::remove("binary-round-trip.vtk");
+}
+
 void TestVTKWrite()
 {
   TestVTKExplicitWrite();
   TestVTKUniformWrite();
   TestVTKRectilinearWrite();
   TestVTKCompoundWrite();
+  TestVTKBinaryRoundTrip();
 }
 
 } //Anonymous namespace
@@ -0,0 +1,503 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/rendering/Compositor.h>
+
+#include <vtkm/cont/EnvironmentTracker.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Logging.h>
+
+#include <vtkm/thirdparty/diy/diy.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace vtkm
+{
+namespace rendering
+{
+
+namespace
+{
+
+using CompositeMode = vtkm::rendering::Compositor::CompositeMode;
+
+struct Image
+{
+  std::vector<vtkm::Vec4f_32> Colors;
+  std::vector<vtkm::Float32> Depths;
+  vtkm::Id Order;
+};
+
+// The part of the image owned by a block during the exchange. `Order` is the smallest
+// visibility order of the images composited into it so far.
+struct CompositeBlock
+{
+  vtkm::Id Begin;
+  vtkm::Id End;
+  vtkm::Id Order;
+  std::vector<vtkm::Vec4f_32> Colors;
+  std::vector<vtkm::Float32> Depths;
+};
+
+// A run-length compressed range of pixels. `Runs` holds pairs of (first pixel, number of
+// pixels) for the non-empty pixels, whose values are stored contiguously.
+struct Piece
+{
+  vtkm::Id Begin = 0;
+  vtkm::Id End = 0;
+  vtkm::Id Order = 0;
+  std::vector<vtkm::Id> Runs;
+  std::vector<vtkm::Vec4f_32> Colors;
+  std::vector<vtkm::Float32> Depths;
+};
+
+VTKM_CONT inline bool IsEmpty(const vtkm::Vec4f_32& color, vtkm::Float32 depth)
+{
+  return (color[3] <= 0.0f) && (depth >= 1.0f);
+}
+
+VTKM_CONT Piece Compress(const CompositeBlock& block, vtkm::Id begin, vtkm::Id end)
+{
+  Piece piece;
+  piece.Begin = begin;
+  piece.End = end;
+  piece.Order = block.Order;
+  vtkm::Id pixel = begin;
+  while (pixel < end)
+  {
+    std::size_t index = static_cast<std::size_t>(pixel - block.Begin);
+    if (IsEmpty(block.Colors[index], block.Depths[index]))
+    {
+      ++pixel;
+      continue;
+    }
+    vtkm::Id runStart = pixel;
+    while (pixel < end && !IsEmpty(block.Colors[index], block.Depths[index]))
+    {
+      piece.Colors.push_back(block.Colors[index]);
+      piece.Depths.push_back(block.Depths[index]);
+      ++pixel;
+      ++index;
+    }
+    piece.Runs.push_back(runStart);
+    piece.Runs.push_back(pixel - runStart);
+  }
+  return piece;
+}
+
+template <typename Proxy, typename Target>
+VTKM_CONT void Enqueue(const Proxy& proxy, const Target& target, const Piece& piece)
+{
+  proxy.enqueue(target, piece.Begin);
+  proxy.enqueue(target, piece.End);
+  proxy.enqueue(target, piece.Order);
+  proxy.enqueue(target, piece.Runs);
+  proxy.enqueue(target, piece.Colors);
+  proxy.enqueue(target, piece.Depths);
+}
+
+template <typename Proxy>
+VTKM_CONT Piece Dequeue(const Proxy& proxy, int gid)
+{
+  Piece piece;
+  proxy.dequeue(gid, piece.Begin);
+  proxy.dequeue(gid, piece.End);
+  proxy.dequeue(gid, piece.Order);
+  proxy.dequeue(gid, piece.Runs);
+  proxy.dequeue(gid, piece.Colors);
+  proxy.dequeue(gid, piece.Depths);
+  return piece;
+}
+
+// Composites `piece` behind (or depth tested against) the pixels already in `block`.
+VTKM_CONT void CompositePiece(CompositeBlock& block, const Piece& piece, CompositeMode mode)
+{
+  std::size_t value = 0;
+  for (std::size_t run = 0; run < piece.Runs.size(); run += 2)
+  {
+    std::size_t index = static_cast<std::size_t>(piece.Runs[run] - block.Begin);
+    for (vtkm::Id i = 0; i < piece.Runs[run + 1]; ++i, ++index, ++value)
+    {
+      vtkm::Vec4f_32& color = block.Colors[index];
+      vtkm::Float32& depth = block.Depths[index];
+      if (mode == CompositeMode::ZBuffer)
+      {
+        if (piece.Depths[value] < depth)
+        {
+          color = piece.Colors[value];
+          depth = piece.Depths[value];
+        }
+      }
+      else
+      {
+        color = color + piece.Colors[value] * (1.0f - color[3]);
+        depth = vtkm::Min(depth, piece.Depths[value]);
+      }
+    }
+  }
+}
+
+// Places every block on the rank that added its image.
+class ImageAssigner : public vtkmdiy::StaticAssigner
+{
+public:
+  ImageAssigner(int numRanks, const std::vector<int>& gidRanks)
+    : vtkmdiy::StaticAssigner(numRanks, static_cast<int>(gidRanks.size()))
+    , GidRanks(gidRanks)
+  {
+  }
+
+  void local_gids(int rank, std::vector<int>& gids) const override
+  {
+    gids.clear();
+    for (std::size_t gid = 0; gid < this->GidRanks.size(); ++gid)
+    {
+      if (this->GidRanks[gid] == rank)
+      {
+        gids.push_back(static_cast<int>(gid));
+      }
+    }
+  }
+
+  int rank(int gid) const override { return this->GidRanks[static_cast<std::size_t>(gid)]; }
+
+private:
+  std::vector<int> GidRanks;
+};
+
+} // anonymous namespace
+
+struct Compositor::InternalsType
+{
+  CompositeMode Mode = CompositeMode::ZBuffer;
+  vtkm::IdComponent Radix = 8;
+  vtkm::Id Width = 0;
+  vtkm::Id Height = 0;
+  std::vector<Image> Images;
+  vtkm::Id PixelsSent = 0;
+
+  bool Composite(std::vector<vtkm::Vec4f_32>& colors, std::vector<vtkm::Float32>& depths);
+};
+
+Compositor::Compositor()
+  : Internals(new InternalsType)
+{
+}
+
+Compositor::~Compositor() = default;
+
+void Compositor::SetCompositeMode(CompositeMode mode)
+{
+  this->Internals->Mode = mode;
+}
+
+Compositor::CompositeMode Compositor::GetCompositeMode() const
+{
+  return this->Internals->Mode;
+}
+
+void Compositor::SetRadix(vtkm::IdComponent radix)
+{
+  if (radix < 2)
+  {
+    throw vtkm::cont::ErrorBadValue("Compositor radix must be at least 2.");
+  }
+  this->Internals->Radix = radix;
+}
+
+vtkm::IdComponent Compositor::GetRadix() const
+{
+  return this->Internals->Radix;
+}
+
+void Compositor::AddImage(const vtkm::rendering::Canvas& canvas, vtkm::Id visibilityOrder)
+{
+  this->AddImage(canvas.GetColorBuffer(),
+                 canvas.GetDepthBuffer(),
+                 canvas.GetWidth(),
+                 canvas.GetHeight(),
+                 visibilityOrder);
+}
+
+void Compositor::AddImage(const vtkm::cont::ArrayHandle<vtkm::Vec4f_32>& colors,
+                          const vtkm::cont::ArrayHandle<vtkm::Float32>& depths,
+                          vtkm::Id width,
+                          vtkm::Id height,
+                          vtkm::Id visibilityOrder)
+{
+  if (colors.GetNumberOfValues() != width * height || depths.GetNumberOfValues() != width * height)
+  {
+    throw vtkm::cont::ErrorBadValue("Image buffers do not match the image size.");
+  }
+  if (!this->Internals->Images.empty() &&
+      (width != this->Internals->Width || height != this->Internals->Height))
+  {
+    throw vtkm::cont::ErrorBadValue("All composited images must have the same size.");
+  }
+  this->Internals->Width = width;
+  this->Internals->Height = height;
+
+  Image image;
+  image.Order = visibilityOrder;
+  image.Colors.resize(static_cast<std::size_t>(width * height));
+  image.Depths.resize(static_cast<std::size_t>(width * height));
+  auto colorPortal = colors.ReadPortal();
+  auto depthPortal = depths.ReadPortal();
+  for (vtkm::Id i = 0; i < width * height; ++i)
+  {
+    image.Colors[static_cast<std::size_t>(i)] = colorPortal.Get(i);
+    image.Depths[static_cast<std::size_t>(i)] = depthPortal.Get(i);
+  }
+  this->Internals->Images.push_back(std::move(image));
+}
+
+void Compositor::ClearImages()
+{
+  this->Internals->Images.clear();
+}
+
+vtkm::Id Compositor::GetNumberOfImages() const
+{
+  return static_cast<vtkm::Id>(this->Internals->Images.size());
+}
+
+vtkm::Id Compositor::GetNumberOfPixelsSent() const
+{
+  return this->Internals->PixelsSent;
+}
+
+bool Compositor::Composite(vtkm::rendering::Canvas& canvas)
+{
+  std::vector<vtkm::Vec4f_32> colors;
+  std::vector<vtkm::Float32> depths;
+  if (!this->Internals->Composite(colors, depths))
+  {
+    return false;
+  }
+  canvas.ResizeBuffers(this->Internals->Width, this->Internals->Height);
+  auto colorPortal = canvas.GetColorBuffer().WritePortal();
+  auto depthPortal = canvas.GetDepthBuffer().WritePortal();
+  for (std::size_t i = 0; i < colors.size(); ++i)
+  {
+    colorPortal.Set(static_cast<vtkm::Id>(i), colors[i]);
+    depthPortal.Set(static_cast<vtkm::Id>(i), depths[i]);
+  }
+  return true;
+}
+
+bool Compositor::Composite(vtkm::cont::ArrayHandle<vtkm::Vec4f_32>& colors,
+                           vtkm::cont::ArrayHandle<vtkm::Float32>& depths)
+{
+  std::vector<vtkm::Vec4f_32> colorValues;
+  std::vector<vtkm::Float32> depthValues;
+  if (!this->Internals->Composite(colorValues, depthValues))
+  {
+    return false;
+  }
+  colors = vtkm::cont::make_ArrayHandleMove(std::move(colorValues));
+  depths = vtkm::cont::make_ArrayHandleMove(std::move(depthValues));
+  return true;
+}
+
+bool Compositor::InternalsType::Composite(std::vector<vtkm::Vec4f_32>& colors,
+                                          std::vector<vtkm::Float32>& depths)
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "Compositor::Composite");
+  this->PixelsSent = 0;
+
+  vtkmdiy::mpi::communicator comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+
+  // Assign a global id to every image: its visibility order, or its position in the
+  // concatenation of the images of all ranks.
+  std::vector<int> localGids;
+  if (this->Mode == CompositeMode::VisibilityOrder)
+  {
+    for (const Image& image : this->Images)
+    {
+      localGids.push_back(static_cast<int>(image.Order));
+    }
+  }
+  else
+  {
+    std::vector<int> counts;
+    vtkmdiy::mpi::all_gather(comm, static_cast<int>(this->Images.size()), counts);
+    int offset = std::accumulate(counts.begin(), counts.begin() + comm.rank(), 0);
+    localGids.resize(this->Images.size());
+    std::iota(localGids.begin(), localGids.end(), offset);
+  }
+
+  std::vector<std::vector<int>> allGids;
+  vtkmdiy::mpi::all_gather(comm, localGids, allGids);
+  std::size_t numBlocks = 0;
+  for (const std::vector<int>& gids : allGids)
+  {
+    numBlocks += gids.size();
+  }
+  if (numBlocks == 0)
+  {
+    return false;
+  }
+
+  std::vector<int> gidRanks(numBlocks, -1);
+  for (std::size_t rank = 0; rank < allGids.size(); ++rank)
+  {
+    for (int gid : allGids[rank])
+    {
+      if (gid < 0 || static_cast<std::size_t>(gid) >= numBlocks ||
+          gidRanks[static_cast<std::size_t>(gid)] != -1)
+      {
+        throw vtkm::cont::ErrorBadValue(
+          "The visibility orders of the composited images must be 0, 1, ..., N-1.");
+      }
+      gidRanks[static_cast<std::size_t>(gid)] = static_cast<int>(rank);
+    }
+  }
+
+  std::vector<vtkm::Id> sizes;
+  vtkmdiy::mpi::all_gather(comm, this->Images.empty() ? vtkm::Id{ -1 } : this->Width, sizes);
+  std::vector<vtkm::Id> heights;
+  vtkmdiy::mpi::all_gather(comm, this->Images.empty() ? vtkm::Id{ -1 } : this->Height, heights);
+  for (std::size_t rank = 0; rank < sizes.size(); ++rank)
+  {
+    if (sizes[rank] != -1)
+    {
+      this->Width = sizes[rank];
+      this->Height = heights[rank];
+    }
+  }
+  for (std::size_t rank = 0; rank < sizes.size(); ++rank)
+  {
+    if (sizes[rank] != -1 && (sizes[rank] != this->Width || heights[rank] != this->Height))
+    {
+      throw vtkm::cont::ErrorBadValue("All composited images must have the same size.");
+    }
+  }
+  const vtkm::Id numPixels = this->Width * this->Height;
+
+  vtkmdiy::Master master(comm,
+                         1,
+                         -1,
+                         []() -> void* { return new CompositeBlock(); },
+                         [](void* ptr) { delete static_cast<CompositeBlock*>(ptr); });
+  ImageAssigner assigner(comm.size(), gidRanks);
+  for (std::size_t i = 0; i < this->Images.size(); ++i)
+  {
+    CompositeBlock* block = new CompositeBlock;
+    block->Begin = 0;
+    block->End = numPixels;
+    block->Order = localGids[i];
+    block->Colors = std::move(this->Images[i].Colors);
+    block->Depths = std::move(this->Images[i].Depths);
+    master.add(localGids[i], block, new vtkmdiy::Link);
+  }
+  // The images are consumed by the exchange.
+  this->Images.clear();
+
+  // Adjacent global ids are grouped first, so every block always covers a contiguous range
+  // of visibility orders and the pieces can be blended in the order of their senders.
+  const int numGids = static_cast<int>(numBlocks);
+  vtkmdiy::RegularDecomposer<vtkmdiy::DiscreteBounds> decomposer(
+    1, vtkmdiy::interval(0, numGids - 1), numGids);
+  vtkmdiy::RegularSwapPartners partners(decomposer, this->Radix, true);
+
+  const CompositeMode mode = this->Mode;
+  vtkm::Id& pixelsSent = this->PixelsSent;
+  vtkmdiy::reduce(
+    master,
+    assigner,
+    partners,
+    [mode, &pixelsSent](CompositeBlock* block,
+                        const vtkmdiy::ReduceProxy& proxy,
+                        const vtkmdiy::RegularSwapPartners&) {
+      std::vector<int> incoming;
+      proxy.incoming(incoming);
+      if (!incoming.empty())
+      {
+        std::vector<Piece> pieces;
+        for (int gid : incoming)
+        {
+          pieces.push_back(Dequeue(proxy, gid));
+        }
+        std::sort(pieces.begin(), pieces.end(), [](const Piece& a, const Piece& b) {
+          return a.Order < b.Order;
+        });
+        block->Begin = pieces.front().Begin;
+        block->End = pieces.front().End;
+        block->Order = pieces.front().Order;
+        const std::size_t size = static_cast<std::size_t>(block->End - block->Begin);
+        block->Colors.assign(size, vtkm::Vec4f_32(0.0f));
+        block->Depths.assign(size, VTKM_DEFAULT_CANVAS_DEPTH);
+        for (const Piece& piece : pieces)
+        {
+          CompositePiece(*block, piece, mode);
+        }
+      }
+
+      const int numParts = proxy.out_link().size();
+      const vtkm::Id size = block->End - block->Begin;
+      for (int part = 0; part < numParts; ++part)
+      {
+        Piece piece = Compress(*block,
+                               block->Begin + (size * part) / numParts,
+                               block->Begin + (size * (part + 1)) / numParts);
+        vtkmdiy::BlockID target = proxy.out_link().target(part);
+        if (target.gid != proxy.gid())
+        {
+          pixelsSent += static_cast<vtkm::Id>(piece.Depths.size());
+        }
+        Enqueue(proxy, target, piece);
+      }
+    });
+
+  // Gather the composited pieces on the block with global id 0.
+  const vtkmdiy::BlockID root{ 0, assigner.rank(0) };
+  master.foreach ([&](CompositeBlock* block, const vtkmdiy::Master::ProxyWithLink& proxy) {
+    Piece piece = Compress(*block, block->Begin, block->End);
+    if (proxy.gid() != root.gid)
+    {
+      pixelsSent += static_cast<vtkm::Id>(piece.Depths.size());
+    }
+    Enqueue(proxy, root, piece);
+  });
+  master.exchange(true);
+
+  bool hasResult = false;
+  master.foreach ([&](CompositeBlock*, const vtkmdiy::Master::ProxyWithLink& proxy) {
+    if (proxy.gid() != root.gid)
+    {
+      return;
+    }
+    colors.assign(static_cast<std::size_t>(numPixels), vtkm::Vec4f_32(0.0f));
+    depths.assign(static_cast<std::size_t>(numPixels), VTKM_DEFAULT_CANVAS_DEPTH);
+    std::vector<int> incoming;
+    proxy.incoming(incoming);
+    for (int gid : incoming)
+    {
+      Piece piece = Dequeue(proxy, gid);
+      std::size_t value = 0;
+      for (std::size_t run = 0; run < piece.Runs.size(); run += 2)
+      {
+        for (vtkm::Id i = 0; i < piece.Runs[run + 1]; ++i, ++value)
+        {
+          const std::size_t index = static_cast<std::size_t>(piece.Runs[run] + i);
+          colors[index] = piece.Colors[value];
+          depths[index] = piece.Depths[value];
+        }
+      }
+    }
+    hasResult = true;
+  });
+  return hasResult;
+}
+
+}
+} // namespace vtkm::rendering
@@ -0,0 +1,94 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_rendering_Compositor_h
+#define vtk_m_rendering_Compositor_h
+
+#include <vtkm/rendering/vtkm_rendering_export.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/rendering/Canvas.h>
+
+#include <memory>
+
+namespace vtkm
+{
+namespace rendering
+{
+
+/// \brief Sort-last parallel compositing of images rendered on several ranks.
+///
+/// Each rank renders its part of the data into one or more images of the same size and
+/// adds them to the `Compositor`. `Composite` then combines all the images of all the ranks
+/// in the communicator of `vtkm::cont::EnvironmentTracker` with a radix-k exchange: every
+/// image becomes a DIY block, and in each round groups of (at most) k blocks swap pieces of
+/// their image region so that each block ends up owning a 1/k part of the region of its group.
+/// A radix of 2 is the classic binary-swap algorithm.
+///
+/// Two compositing operators are supported. `CompositeMode::ZBuffer` keeps the nearest
+/// fragment of each pixel and is meant for opaque surfaces. `CompositeMode::VisibilityOrder`
+/// blends premultiplied-alpha colors front to back in the visibility order given for each image
+/// (for example the partial images of a volume rendering) and requires the orders of all the
+/// images to form the sequence 0, 1, ..., N-1 across all ranks.
+///
+/// Empty pixels (fully transparent and at or beyond the far plane, which is what
+/// `Canvas::Clear` produces) are run-length compressed before being sent, so that the
+/// amount of data exchanged is proportional to the covered part of the images.
+///
+class VTKM_RENDERING_EXPORT Compositor
+{
+public:
+  enum struct CompositeMode
+  {
+    ZBuffer,
+    VisibilityOrder
+  };
+
+  Compositor();
+  ~Compositor();
+
+  void SetCompositeMode(CompositeMode mode);
+  CompositeMode GetCompositeMode() const;
+
+  /// The maximum number of blocks exchanging image pieces in one round. Must be at least 2.
+  void SetRadix(vtkm::IdComponent radix);
+  vtkm::IdComponent GetRadix() const;
+
+  /// Adds the color and depth buffers of a canvas. `visibilityOrder` is only used in
+  /// `CompositeMode::VisibilityOrder`, where 0 is the image nearest to the viewer.
+  void AddImage(const vtkm::rendering::Canvas& canvas, vtkm::Id visibilityOrder = 0);
+  void AddImage(const vtkm::cont::ArrayHandle<vtkm::Vec4f_32>& colors,
+                const vtkm::cont::ArrayHandle<vtkm::Float32>& depths,
+                vtkm::Id width,
+                vtkm::Id height,
+                vtkm::Id visibilityOrder = 0);
+
+  void ClearImages();
+  vtkm::Id GetNumberOfImages() const;
+
+  /// Composites the images added on all ranks. This is a collective operation. The result is
+  /// written into `canvas` on the rank that holds the first image (the one with visibility
+  /// order 0, or the first image of the lowest rank that has images in `ZBuffer` mode), in
+  /// which case `true` is returned. Other ranks return `false` and leave `canvas` untouched.
+  /// The added images are consumed by the exchange.
+  bool Composite(vtkm::rendering::Canvas& canvas);
+  bool Composite(vtkm::cont::ArrayHandle<vtkm::Vec4f_32>& colors,
+                 vtkm::cont::ArrayHandle<vtkm::Float32>& depths);
+
+  /// The number of non-empty pixels this rank sent during the last call to `Composite`.
+  vtkm::Id GetNumberOfPixelsSent() const;
+
+private:
+  struct InternalsType;
+  std::unique_ptr<InternalsType> Internals;
+};
+}
+} //namespace vtkm::rendering
+
+#endif //vtk_m_rendering_Compositor_h
@@ -71,12 +71,76 @@ VTKM_EXEC inline bool IntersectAABB(const BVHPortalType& bvh,
   return (min0 > min1);
 }
 
+// Intersects a ray with the 4 children of a node of the wide BVH. The children are in
+// structure of arrays form so the compiler can test them together with SIMD instructions.
+// Returns the number of children hit and puts them, nearest first, in hitChildren.
+template <typename BVHPortalType, typename Precision>
+VTKM_EXEC inline vtkm::Int32 IntersectWideAABBs(const BVHPortalType& bvh,
+                                                const vtkm::Int32& currentNode,
+                                                const vtkm::Vec<Precision, 3>& originDir,
+                                                const vtkm::Vec<Precision, 3>& invDir,
+                                                const Precision& closestDistance,
+                                                const Precision& minDistance,
+                                                vtkm::Int32 hitChildren[4])
+{
+  const vtkm::Vec4f_32 xmins = bvh.Get(currentNode);
+  const vtkm::Vec4f_32 ymins = bvh.Get(currentNode + 1);
+  const vtkm::Vec4f_32 zmins = bvh.Get(currentNode + 2);
+  const vtkm::Vec4f_32 xmaxs = bvh.Get(currentNode + 3);
+  const vtkm::Vec4f_32 ymaxs = bvh.Get(currentNode + 4);
+  const vtkm::Vec4f_32 zmaxs = bvh.Get(currentNode + 5);
+  const vtkm::Vec4f_32 children = bvh.Get(currentNode + 6);
+
+  Precision minDistances[4];
+  Precision maxDistances[4];
+  for (vtkm::IdComponent i = 0; i < 4; ++i)
+  {
+    const Precision xmin = xmins[i] * invDir[0] - originDir[0];
+    const Precision ymin = ymins[i] * invDir[1] - originDir[1];
+    const Precision zmin = zmins[i] * invDir[2] - originDir[2];
+    const Precision xmax = xmaxs[i] * invDir[0] - originDir[0];
+    const Precision ymax = ymaxs[i] * invDir[1] - originDir[1];
+    const Precision zmax = zmaxs[i] * invDir[2] - originDir[2];
+    minDistances[i] = vtkm::Max(
+      vtkm::Max(vtkm::Max(vtkm::Min(ymin, ymax), vtkm::Min(xmin, xmax)), vtkm::Min(zmin, zmax)),
+      minDistance);
+    maxDistances[i] = vtkm::Min(
+      vtkm::Min(vtkm::Min(vtkm::Max(ymin, ymax), vtkm::Max(xmin, xmax)), vtkm::Max(zmin, zmax)),
+      closestDistance);
+  }
+
+  vtkm::Int32 numHits = 0;
+  Precision hitDistances[4];
+  for (vtkm::IdComponent i = 0; i < 4; ++i)
+  {
+    vtkm::Int32 child;
+    memcpy(&child, &children[i], 4);
+    // A child of 0 is an empty slot, since the root is no node's child.
+    if ((child == 0) || (maxDistances[i] < minDistances[i]))
+    {
+      continue;
+    }
+    // Insertion sort by the distance to the child.
+    vtkm::Int32 j = numHits;
+    while ((j > 0) && (hitDistances[j - 1] > minDistances[i]))
+    {
+      hitDistances[j] = hitDistances[j - 1];
+      hitChildren[j] = hitChildren[j - 1];
+      --j;
+    }
+    hitDistances[j] = minDistances[i];
+    hitChildren[j] = child;
+    ++numHits;
+  }
+  return numHits;
+}
+
 class BVHTraverser
 {
 public:
   class Intersector : public vtkm::worklet::WorkletMapField
   {
-  private:
+  protected:
     VTKM_EXEC
     inline vtkm::Float32 rcp(vtkm::Float32 f) const { return 1.0f / f; }
     VTKM_EXEC
@@ -218,12 +282,117 @@ public:
   };
 
 
+  // Traverses the wide BVH, which has 4 children per node, instead of the binary BVH.
+  class WideIntersector : public Intersector
+  {
+  public:
+    template <typename PointPortalType,
+              typename Precision,
+              typename LeafType,
+              typename InnerNodePortalType,
+              typename LeafPortalType>
+    VTKM_EXEC void operator()(const vtkm::Vec<Precision, 3>& dir,
+                              const vtkm::Vec<Precision, 3>& origin,
+                              Precision& distance,
+                              const Precision& minDistance,
+                              const Precision& maxDistance,
+                              Precision& minU,
+                              Precision& minV,
+                              vtkm::Id& hitIndex,
+                              const PointPortalType& points,
+                              LeafType& leafIntersector,
+                              const InnerNodePortalType& wideBVH,
+                              const LeafPortalType& leafs) const
+    {
+      Precision closestDistance = maxDistance;
+      distance = maxDistance;
+      hitIndex = -1;
+
+      vtkm::Vec<Precision, 3> invDir;
+      invDir[0] = rcp_safe(dir[0]);
+      invDir[1] = rcp_safe(dir[1]);
+      invDir[2] = rcp_safe(dir[2]);
+      vtkm::Vec<Precision, 3> originDir = origin * invDir;
+
+      // Each node pushes up to 3 children. Wide trees that could overflow the stack are not
+      // made (see LinearBVH::BuildWideNodes).
+      vtkm::Int32 todo[LinearBVH::WideTraversalStackSize];
+      vtkm::Int32 stackptr = 0;
+      vtkm::Int32 barrier = (vtkm::Int32)END_FLAG;
+      vtkm::Int32 currentNode = 0;
+      todo[stackptr] = barrier;
+
+      while (currentNode != END_FLAG)
+      {
+        if (currentNode > -1)
+        {
+          vtkm::Int32 hitChildren[4];
+          vtkm::Int32 numHits = IntersectWideAABBs(
+            wideBVH, currentNode, originDir, invDir, closestDistance, minDistance, hitChildren);
+          if (numHits == 0)
+          {
+            currentNode = todo[stackptr];
+            stackptr--;
+          }
+          else
+          {
+            // Visit the nearest child next and the others later, nearest first.
+            currentNode = hitChildren[0];
+            for (vtkm::Int32 i = numHits - 1; i > 0; --i)
+            {
+              stackptr++;
+              todo[stackptr] = hitChildren[i];
+            }
+          }
+        } // if inner node
+
+        if (currentNode < 0 && currentNode != barrier)
+        {
+          currentNode = -currentNode - 1; //swap the neg address
+          leafIntersector.IntersectLeaf(currentNode,
+                                        origin,
+                                        dir,
+                                        points,
+                                        hitIndex,
+                                        closestDistance,
+                                        minU,
+                                        minV,
+                                        leafs,
+                                        minDistance);
+          currentNode = todo[stackptr];
+          stackptr--;
+        } // if leaf node
+      }   //while
+
+      if (hitIndex != -1)
+        distance = closestDistance;
+    } // ()
+  };
+
   template <typename Precision, typename LeafIntersectorType>
   VTKM_CONT void IntersectRays(Ray<Precision>& rays,
                                LinearBVH& bvh,
                                LeafIntersectorType& leafIntersector,
                                vtkm::cont::CoordinateSystem& coordsHandle)
   {
+    if (bvh.GetUseWideNodes() && (bvh.WideBVH.GetNumberOfValues() > 0))
+    {
+      vtkm::worklet::DispatcherMapField<WideIntersector> intersectDispatch;
+      intersectDispatch.Invoke(rays.Dir,
+                               rays.Origin,
+                               rays.Distance,
+                               rays.MinDistance,
+                               rays.MaxDistance,
+                               rays.U,
+                               rays.V,
+                               rays.HitIdx,
+                               coordsHandle,
+                               leafIntersector,
+                               bvh.WideBVH,
+                               bvh.Leafs);
+      return;
+    }
+
     vtkm::worklet::DispatcherMapField<Intersector> intersectDispatch;
     intersectDispatch.Invoke(rays.Dir,
                              rays.Origin,
@@ -9,14 +9,21 @@
 //============================================================================
 
 #include <math.h>
+#include <vector>
 
+#include <vtkm/BinaryOperators.h>
 #include <vtkm/Math.h>
 #include <vtkm/VectorAnalysis.h>
 
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayGetValues.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandleStride.h>
 #include <vtkm/cont/DeviceAdapter.h>
 #include <vtkm/cont/DeviceAdapterAlgorithm.h>
 #include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/Logging.h>
 #include <vtkm/cont/RuntimeDeviceTracker.h>
 #include <vtkm/cont/TryExecute.h>
 
@@ -58,6 +65,16 @@ public:
 
   class TreeBuilder;
 
+  class RefitAABBs;
+
+  class NodeSurfaceArea;
+
+  class TreeletOptimizer;
+
+  class FindWideNodes;
+
+  class CollapseWideNodes;
+
   VTKM_CONT
   LinearBVHBuilder() {}
 
@@ -65,9 +82,34 @@ public:
 
   VTKM_CONT void BuildHierarchy(BVHData& bvh);
 
-  VTKM_CONT void Build(LinearBVH& linearBVH);
+  VTKM_CONT void OptimizeTreelets(BVHData& bvh);
+
+  VTKM_CONT void Build(LinearBVH& linearBVH, vtkm::cont::ArrayHandle<vtkm::Id>& parents);
 }; // class LinearBVHBuilder
 
+// Gets the bounds of both children of an inner node from the first 3 values of the node in
+// the flat BVH.
+VTKM_EXEC_CONT inline void GetInnerNodeBounds(const vtkm::Vec4f_32& first4Vec,
+                                              const vtkm::Vec4f_32& second4Vec,
+                                              const vtkm::Vec4f_32& third4Vec,
+                                              vtkm::Vec3f_32& minPoint,
+                                              vtkm::Vec3f_32& maxPoint)
+{
+  minPoint[0] = vtkm::Min(first4Vec[0], second4Vec[2]);
+  minPoint[1] = vtkm::Min(first4Vec[1], second4Vec[3]);
+  minPoint[2] = vtkm::Min(first4Vec[2], third4Vec[0]);
+  maxPoint[0] = vtkm::Max(first4Vec[3], third4Vec[1]);
+  maxPoint[1] = vtkm::Max(second4Vec[0], third4Vec[2]);
+  maxPoint[2] = vtkm::Max(second4Vec[1], third4Vec[3]);
+}
+
+VTKM_EXEC_CONT inline vtkm::Float64 SurfaceArea(const vtkm::Vec3f_32& minPoint,
+                                                const vtkm::Vec3f_32& maxPoint)
+{
+  const vtkm::Vec3f_64 size = maxPoint - minPoint;
+  return 2.0 * (size[0] * size[1] + size[1] * size[2] + size[2] * size[0]);
+}
+
 class LinearBVHBuilder::CountingIterator : public vtkm::worklet::WorkletMapField
 {
 public:
@@ -508,6 +550,590 @@ public:
   }
 }; // class TreeBuilder
 
+// Updates the bounds of the inner nodes from the bounds of the leafs. This works like
+// PropagateAABBs except that the children of each node are read from the existing flat BVH.
+class LinearBVHBuilder::RefitAABBs : public vtkm::worklet::WorkletMapField
+{
+private:
+  vtkm::Id LeafCount;
+
+  template <typename InputPortalType, typename BVHType>
+  VTKM_EXEC void GetChildBounds(vtkm::Int32 child,
+                                const InputPortalType& xmin,
+                                const InputPortalType& ymin,
+                                const InputPortalType& zmin,
+                                const InputPortalType& xmax,
+                                const InputPortalType& ymax,
+                                const InputPortalType& zmax,
+                                const BVHType& flatBVH,
+                                vtkm::Vec3f_32& minPoint,
+                                vtkm::Vec3f_32& maxPoint) const
+  {
+    if (child < 0)
+    {
+      // Leafs are referenced by their offset in the leaf array, which has 2 values per leaf.
+      const vtkm::Id leaf = (-child - 1) / 2;
+      minPoint = vtkm::Vec3f_32(xmin.Get(leaf), ymin.Get(leaf), zmin.Get(leaf));
+      maxPoint = vtkm::Vec3f_32(xmax.Get(leaf), ymax.Get(leaf), zmax.Get(leaf));
+    }
+    else
+    {
+      GetInnerNodeBounds(
+        flatBVH.Get(child), flatBVH.Get(child + 1), flatBVH.Get(child + 2), minPoint, maxPoint);
+    }
+  }
+
+public:
+  VTKM_CONT
+  RefitAABBs(vtkm::Id leafCount)
+    : LeafCount(leafCount)
+  {
+  }
+  using ControlSignature = void(WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayIn,     //Parents
+                                AtomicArrayInOut, //counters
+                                WholeArrayInOut   // flatbvh
+  );
+  using ExecutionSignature = void(WorkIndex, _1, _2, _3, _4, _5, _6, _7, _8, _9);
+
+  template <typename InputPortalType,
+            typename IdPortalType,
+            typename AtomicType,
+            typename BVHType>
+  VTKM_EXEC void operator()(const vtkm::Id workIndex,
+                            const InputPortalType& xmin,
+                            const InputPortalType& ymin,
+                            const InputPortalType& zmin,
+                            const InputPortalType& xmax,
+                            const InputPortalType& ymax,
+                            const InputPortalType& zmax,
+                            const IdPortalType& parents,
+                            AtomicType& counters,
+                            BVHType& flatBVH) const
+  {
+    //move up into the inner nodes
+    vtkm::Id currentNode = LeafCount - 1 + workIndex;
+    while (currentNode != 0)
+    {
+      currentNode = parents.Get(currentNode);
+      vtkm::Int32 oldCount = counters.Add(currentNode, 1);
+      if (oldCount == 0)
+      {
+        // The other child is not done yet. The thread that finishes it continues up.
+        return;
+      }
+      const vtkm::Id currentNodeOffset = currentNode * 4;
+
+      vtkm::Vec4f_32 fourth4Vec = flatBVH.Get(currentNodeOffset + 3);
+      vtkm::Int32 leftChild;
+      vtkm::Int32 rightChild;
+      memcpy(&leftChild, &fourth4Vec[0], 4);
+      memcpy(&rightChild, &fourth4Vec[1], 4);
+
+      vtkm::Vec3f_32 leftMin, leftMax, rightMin, rightMax;
+      this->GetChildBounds(
+        leftChild, xmin, ymin, zmin, xmax, ymax, zmax, flatBVH, leftMin, leftMax);
+      this->GetChildBounds(
+        rightChild, xmin, ymin, zmin, xmax, ymax, zmax, flatBVH, rightMin, rightMax);
+
+      flatBVH.Set(currentNodeOffset,
+                  vtkm::Vec4f_32(leftMin[0], leftMin[1], leftMin[2], leftMax[0]));
+      flatBVH.Set(currentNodeOffset + 1,
+                  vtkm::Vec4f_32(leftMax[1], leftMax[2], rightMin[0], rightMin[1]));
+      flatBVH.Set(currentNodeOffset + 2,
+                  vtkm::Vec4f_32(rightMin[2], rightMax[0], rightMax[1], rightMax[2]));
+    }
+  }
+}; //class RefitAABBs
+
+// Computes the sum of the surface areas of the two children of each inner node.
+class LinearBVHBuilder::NodeSurfaceArea : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn, FieldOut, WholeArrayIn);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename BVHType>
+  VTKM_EXEC void operator()(const vtkm::Id node, vtkm::Float64& area, const BVHType& flatBVH) const
+  {
+    const vtkm::Id nodeOffset = node * 4;
+    vtkm::Vec4f_32 first4Vec = flatBVH.Get(nodeOffset);
+    vtkm::Vec4f_32 second4Vec = flatBVH.Get(nodeOffset + 1);
+    vtkm::Vec4f_32 third4Vec = flatBVH.Get(nodeOffset + 2);
+    area = SurfaceArea(vtkm::Vec3f_32(first4Vec[0], first4Vec[1], first4Vec[2]),
+                       vtkm::Vec3f_32(first4Vec[3], second4Vec[0], second4Vec[1])) +
+      SurfaceArea(vtkm::Vec3f_32(second4Vec[2], second4Vec[3], third4Vec[0]),
+                  vtkm::Vec3f_32(third4Vec[1], third4Vec[2], third4Vec[3]));
+  }
+}; //class NodeSurfaceArea
+
+// Restructures treelets of the tree to minimize the SAH cost, as described in "Fast
+// Parallel Construction of High-Quality Bounding Volume Hierarchies" by Karras and Aila.
+// Like PropagateAABBs, one thread per leaf moves up the tree and the second thread to
+// arrive at a node processes it. At that point the whole subtree of the node is final. The
+// thread forms a treelet of the node and its descendents with 7 treelet leafs, finds the
+// topology of the treelet with the lowest cost, and rewires the inner nodes of the treelet
+// to it. Because every leaf holds one primitive, the cost of a node is the sum of the surface
+// areas of the inner nodes in its subtree.
+class LinearBVHBuilder::TreeletOptimizer : public vtkm::worklet::WorkletMapField
+{
+private:
+  static constexpr vtkm::IdComponent TreeletSize = 7;
+  static constexpr vtkm::UInt32 NumSubsets = 1 << TreeletSize;
+
+  vtkm::Id LeafCount;
+  vtkm::Id InnerCount;
+
+  template <typename InputPortalType, typename BoundsPortalType>
+  VTKM_EXEC void GetNodeBounds(vtkm::Id node,
+                               const InputPortalType& xmin,
+                               const InputPortalType& ymin,
+                               const InputPortalType& zmin,
+                               const InputPortalType& xmax,
+                               const InputPortalType& ymax,
+                               const InputPortalType& zmax,
+                               const BoundsPortalType& nodeMins,
+                               const BoundsPortalType& nodeMaxs,
+                               vtkm::Vec3f_32& minPoint,
+                               vtkm::Vec3f_32& maxPoint) const
+  {
+    if (node >= InnerCount)
+    {
+      const vtkm::Id leaf = node - InnerCount;
+      minPoint = vtkm::Vec3f_32(xmin.Get(leaf), ymin.Get(leaf), zmin.Get(leaf));
+      maxPoint = vtkm::Vec3f_32(xmax.Get(leaf), ymax.Get(leaf), zmax.Get(leaf));
+    }
+    else
+    {
+      minPoint = nodeMins.Get(node);
+      maxPoint = nodeMaxs.Get(node);
+    }
+  }
+
+  template <typename InputPortalType, typename BoundsPortalType>
+  VTKM_EXEC vtkm::Float32 GetNodeArea(vtkm::Id node,
+                                      const InputPortalType& xmin,
+                                      const InputPortalType& ymin,
+                                      const InputPortalType& zmin,
+                                      const InputPortalType& xmax,
+                                      const InputPortalType& ymax,
+                                      const InputPortalType& zmax,
+                                      const BoundsPortalType& nodeMins,
+                                      const BoundsPortalType& nodeMaxs) const
+  {
+    vtkm::Vec3f_32 minPoint, maxPoint;
+    this->GetNodeBounds(
+      node, xmin, ymin, zmin, xmax, ymax, zmax, nodeMins, nodeMaxs, minPoint, maxPoint);
+    return static_cast<vtkm::Float32>(SurfaceArea(minPoint, maxPoint));
+  }
+
+  // Sets the bounds, cost, and leaf count of an inner node from its children.
+  template <typename InputPortalType,
+            typename IdPortalType,
+            typename BoundsPortalType,
+            typename CostPortalType>
+  VTKM_EXEC void UpdateNode(vtkm::Id node,
+                            const InputPortalType& xmin,
+                            const InputPortalType& ymin,
+                            const InputPortalType& zmin,
+                            const InputPortalType& xmax,
+                            const InputPortalType& ymax,
+                            const InputPortalType& zmax,
+                            const IdPortalType& leftChildren,
+                            const IdPortalType& rightChildren,
+                            BoundsPortalType& nodeMins,
+                            BoundsPortalType& nodeMaxs,
+                            CostPortalType& nodeCosts,
+                            IdPortalType& nodeLeafCounts) const
+  {
+    const vtkm::Id children[2] = { leftChildren.Get(node), rightChildren.Get(node) };
+    vtkm::Vec3f_32 minPoint(vtkm::Infinity32());
+    vtkm::Vec3f_32 maxPoint(vtkm::NegativeInfinity32());
+    vtkm::Float32 cost = 0.f;
+    vtkm::Id leafCount = 0;
+    for (vtkm::Id child : children)
+    {
+      vtkm::Vec3f_32 childMin, childMax;
+      this->GetNodeBounds(
+        child, xmin, ymin, zmin, xmax, ymax, zmax, nodeMins, nodeMaxs, childMin, childMax);
+      for (vtkm::IdComponent i = 0; i < 3; ++i)
+      {
+        minPoint[i] = vtkm::Min(minPoint[i], childMin[i]);
+        maxPoint[i] = vtkm::Max(maxPoint[i], childMax[i]);
+      }
+      if (child >= InnerCount)
+      {
+        leafCount += 1;
+      }
+      else
+      {
+        cost += nodeCosts.Get(child);
+        leafCount += nodeLeafCounts.Get(child);
+      }
+    }
+    nodeMins.Set(node, minPoint);
+    nodeMaxs.Set(node, maxPoint);
+    nodeCosts.Set(node, cost + static_cast<vtkm::Float32>(SurfaceArea(minPoint, maxPoint)));
+    nodeLeafCounts.Set(node, leafCount);
+  }
+
+public:
+  VTKM_CONT
+  TreeletOptimizer(vtkm::Id leafCount)
+    : LeafCount(leafCount)
+    , InnerCount(leafCount - 1)
+  {
+  }
+  using ControlSignature = void(WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayIn,
+                                WholeArrayInOut,  //Parents
+                                WholeArrayInOut,  //lchild
+                                WholeArrayInOut,  //rchild
+                                AtomicArrayInOut, //counters
+                                WholeArrayInOut,  //node mins
+                                WholeArrayInOut,  //node maxs
+                                WholeArrayInOut,  //node costs
+                                WholeArrayInOut   //node leaf counts
+  );
+  using ExecutionSignature =
+    void(WorkIndex, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14);
+
+  template <typename InputPortalType,
+            typename IdPortalType,
+            typename AtomicType,
+            typename BoundsPortalType,
+            typename CostPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id workIndex,
+                            const InputPortalType& xmin,
+                            const InputPortalType& ymin,
+                            const InputPortalType& zmin,
+                            const InputPortalType& xmax,
+                            const InputPortalType& ymax,
+                            const InputPortalType& zmax,
+                            IdPortalType& parents,
+                            IdPortalType& leftChildren,
+                            IdPortalType& rightChildren,
+                            AtomicType& counters,
+                            BoundsPortalType& nodeMins,
+                            BoundsPortalType& nodeMaxs,
+                            CostPortalType& nodeCosts,
+                            IdPortalType& nodeLeafCounts) const
+  {
+    //move up into the inner nodes
+    vtkm::Id currentNode = InnerCount + workIndex;
+    while (currentNode != 0)
+    {
+      currentNode = parents.Get(currentNode);
+      vtkm::Int32 oldCount = counters.Add(currentNode, 1);
+      if (oldCount == 0)
+      {
+        return;
+      }
+
+      this->UpdateNode(currentNode,
+                       xmin,
+                       ymin,
+                       zmin,
+                       xmax,
+                       ymax,
+                       zmax,
+                       leftChildren,
+                       rightChildren,
+                       nodeMins,
+                       nodeMaxs,
+                       nodeCosts,
+                       nodeLeafCounts);
+      if (nodeLeafCounts.Get(currentNode) < TreeletSize)
+      {
+        continue;
+      }
+
+      // Form the treelet by repeatedly expanding the treelet leaf with the largest area.
+      vtkm::Id treeletLeafs[TreeletSize];
+      vtkm::Float32 treeletLeafAreas[TreeletSize];
+      vtkm::Id treeletInner[TreeletSize - 1];
+      treeletInner[0] = currentNode;
+      treeletLeafs[0] = leftChildren.Get(currentNode);
+      treeletLeafs[1] = rightChildren.Get(currentNode);
+      vtkm::IdComponent numLeafs = 2;
+      for (vtkm::IdComponent i = 0; i < 2; ++i)
+      {
+        treeletLeafAreas[i] = this->GetNodeArea(
+          treeletLeafs[i], xmin, ymin, zmin, xmax, ymax, zmax, nodeMins, nodeMaxs);
+      }
+      while (numLeafs < TreeletSize)
+      {
+        vtkm::IdComponent expand = -1;
+        for (vtkm::IdComponent i = 0; i < numLeafs; ++i)
+        {
+          if ((treeletLeafs[i] < InnerCount) &&
+              ((expand < 0) || (treeletLeafAreas[i] > treeletLeafAreas[expand])))
+          {
+            expand = i;
+          }
+        }
+        const vtkm::Id node = treeletLeafs[expand];
+        treeletInner[numLeafs - 1] = node;
+        treeletLeafs[expand] = leftChildren.Get(node);
+        treeletLeafs[numLeafs] = rightChildren.Get(node);
+        treeletLeafAreas[expand] = this->GetNodeArea(
+          treeletLeafs[expand], xmin, ymin, zmin, xmax, ymax, zmax, nodeMins, nodeMaxs);
+        treeletLeafAreas[numLeafs] = this->GetNodeArea(
+          treeletLeafs[numLeafs], xmin, ymin, zmin, xmax, ymax, zmax, nodeMins, nodeMaxs);
+        ++numLeafs;
+      }
+
+      // Find the lowest cost of every subset of the treelet leafs. Subsets are visited in
+      // increasing order, so all subsets of a subset are done before it.
+      vtkm::Vec3f_32 leafMins[TreeletSize];
+      vtkm::Vec3f_32 leafMaxs[TreeletSize];
+      vtkm::Float32 costs[NumSubsets];
+      vtkm::UInt8 splits[NumSubsets];
+      for (vtkm::IdComponent i = 0; i < TreeletSize; ++i)
+      {
+        this->GetNodeBounds(treeletLeafs[i],
+                            xmin,
+                            ymin,
+                            zmin,
+                            xmax,
+                            ymax,
+                            zmax,
+                            nodeMins,
+                            nodeMaxs,
+                            leafMins[i],
+                            leafMaxs[i]);
+        costs[1 << i] = (treeletLeafs[i] < InnerCount) ? nodeCosts.Get(treeletLeafs[i]) : 0.f;
+      }
+      for (vtkm::UInt32 subset = 1; subset < NumSubsets; ++subset)
+      {
+        if (vtkm::CountSetBits(subset) < 2)
+        {
+          continue;
+        }
+        vtkm::Vec3f_32 minPoint(vtkm::Infinity32());
+        vtkm::Vec3f_32 maxPoint(vtkm::NegativeInfinity32());
+        for (vtkm::IdComponent i = 0; i < TreeletSize; ++i)
+        {
+          if (subset & (1u << i))
+          {
+            for (vtkm::IdComponent j = 0; j < 3; ++j)
+            {
+              minPoint[j] = vtkm::Min(minPoint[j], leafMins[i][j]);
+              maxPoint[j] = vtkm::Max(maxPoint[j], leafMaxs[i][j]);
+            }
+          }
+        }
+        vtkm::Float32 bestCost = vtkm::Infinity32();
+        vtkm::UInt32 bestSplit = 0;
+        for (vtkm::UInt32 part = (subset - 1) & subset; part > 0; part = (part - 1) & subset)
+        {
+          const vtkm::Float32 cost = costs[part] + costs[subset ^ part];
+          if (cost < bestCost)
+          {
+            bestCost = cost;
+            bestSplit = part;
+          }
+        }
+        costs[subset] = bestCost + static_cast<vtkm::Float32>(SurfaceArea(minPoint, maxPoint));
+        splits[subset] = static_cast<vtkm::UInt8>(bestSplit);
+      }
+
+      if (!(costs[NumSubsets - 1] < nodeCosts.Get(currentNode)))
+      {
+        continue;
+      }
+
+      // Rewire the inner nodes of the treelet to the best topology. Nodes are assigned top
+      // down, so updating them in reverse order updates children before their parents.
+      vtkm::UInt32 stackSubsets[TreeletSize - 1];
+      vtkm::Id stackNodes[TreeletSize - 1];
+      vtkm::IdComponent stackSize = 1;
+      stackSubsets[0] = NumSubsets - 1;
+      stackNodes[0] = currentNode;
+      vtkm::Id updateOrder[TreeletSize - 1];
+      vtkm::IdComponent numUpdates = 0;
+      vtkm::IdComponent nextInner = 1;
+      while (stackSize > 0)
+      {
+        --stackSize;
+        const vtkm::UInt32 subset = stackSubsets[stackSize];
+        const vtkm::Id node = stackNodes[stackSize];
+        updateOrder[numUpdates++] = node;
+        const vtkm::UInt32 sides[2] = { splits[subset], subset ^ splits[subset] };
+        for (vtkm::IdComponent side = 0; side < 2; ++side)
+        {
+          vtkm::Id child;
+          if (vtkm::CountSetBits(sides[side]) == 1)
+          {
+            child = treeletLeafs[vtkm::FindFirstSetBit(sides[side]) - 1];
+          }
+          else
+          {
+            child = treeletInner[nextInner++];
+            stackSubsets[stackSize] = sides[side];
+            stackNodes[stackSize] = child;
+            ++stackSize;
+          }
+          parents.Set(child, node);
+          if (side == 0)
+          {
+            leftChildren.Set(node, child);
+          }
+          else
+          {
+            rightChildren.Set(node, child);
+          }
+        }
+      }
+      for (vtkm::IdComponent i = numUpdates - 1; i >= 0; --i)
+      {
+        this->UpdateNode(updateOrder[i],
+                         xmin,
+                         ymin,
+                         zmin,
+                         xmax,
+                         ymax,
+                         zmax,
+                         leftChildren,
+                         rightChildren,
+                         nodeMins,
+                         nodeMaxs,
+                         nodeCosts,
+                         nodeLeafCounts);
+      }
+    }
+  }
+}; //class TreeletOptimizer
+
+// Marks the inner nodes at an even depth of the binary tree. These are the nodes of the wide
+// tree. Also gives the depth of each node.
+class LinearBVHBuilder::FindWideNodes : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn, FieldOut, FieldOut, WholeArrayIn);
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  template <typename IdPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id node,
+                            vtkm::Id& isWideNode,
+                            vtkm::Id& depth,
+                            const IdPortalType& parents) const
+  {
+    depth = 0;
+    for (vtkm::Id current = node; current != 0; current = parents.Get(current))
+    {
+      ++depth;
+    }
+    isWideNode = ((depth % 2) == 0) ? 1 : 0;
+  }
+}; //class FindWideNodes
+
+// Makes a node of the wide tree from a node of the binary tree and its children. The children
+// of the wide node are the grandchildren of the binary node, or its children that are leafs.
+class LinearBVHBuilder::CollapseWideNodes : public vtkm::worklet::WorkletMapField
+{
+private:
+  template <typename BVHType>
+  VTKM_EXEC void GetChildren(vtkm::Int32 offset,
+                             const BVHType& flatBVH,
+                             vtkm::Int32 children[2],
+                             vtkm::Vec3f_32 minPoints[2],
+                             vtkm::Vec3f_32 maxPoints[2]) const
+  {
+    const vtkm::Vec4f_32 first4Vec = flatBVH.Get(offset);
+    const vtkm::Vec4f_32 second4Vec = flatBVH.Get(offset + 1);
+    const vtkm::Vec4f_32 third4Vec = flatBVH.Get(offset + 2);
+    const vtkm::Vec4f_32 fourth4Vec = flatBVH.Get(offset + 3);
+    minPoints[0] = vtkm::Vec3f_32(first4Vec[0], first4Vec[1], first4Vec[2]);
+    maxPoints[0] = vtkm::Vec3f_32(first4Vec[3], second4Vec[0], second4Vec[1]);
+    minPoints[1] = vtkm::Vec3f_32(second4Vec[2], second4Vec[3], third4Vec[0]);
+    maxPoints[1] = vtkm::Vec3f_32(third4Vec[1], third4Vec[2], third4Vec[3]);
+    memcpy(&children[0], &fourth4Vec[0], 4);
+    memcpy(&children[1], &fourth4Vec[1], 4);
+  }
+
+  VTKM_EXEC void AddChild(vtkm::Vec4f_32 wideNode[7],
+                          vtkm::IdComponent& numChildren,
+                          vtkm::Int32 child,
+                          const vtkm::Vec3f_32& minPoint,
+                          const vtkm::Vec3f_32& maxPoint) const
+  {
+    for (vtkm::IdComponent i = 0; i < 3; ++i)
+    {
+      wideNode[i][numChildren] = minPoint[i];
+      wideNode[i + 3][numChildren] = maxPoint[i];
+    }
+    memcpy(&wideNode[6][numChildren], &child, 4);
+    ++numChildren;
+  }
+
+public:
+  using ControlSignature = void(FieldIn, FieldIn, WholeArrayIn, WholeArrayIn, WholeArrayOut);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+  template <typename IdPortalType, typename BVHType, typename WideBVHType>
+  VTKM_EXEC void operator()(const vtkm::Id node,
+                            const vtkm::Id isWideNode,
+                            const IdPortalType& wideIndices,
+                            const BVHType& flatBVH,
+                            WideBVHType& wideBVH) const
+  {
+    if (isWideNode == 0)
+    {
+      return;
+    }
+
+    vtkm::Vec4f_32 wideNode[7];
+    for (vtkm::IdComponent i = 0; i < 7; ++i)
+    {
+      wideNode[i] = vtkm::Vec4f_32(0.f);
+    }
+    vtkm::IdComponent numChildren = 0;
+
+    vtkm::Int32 children[2];
+    vtkm::Vec3f_32 minPoints[2];
+    vtkm::Vec3f_32 maxPoints[2];
+    this->GetChildren(static_cast<vtkm::Int32>(node * 4), flatBVH, children, minPoints, maxPoints);
+    for (vtkm::IdComponent c = 0; c < 2; ++c)
+    {
+      if (children[c] < 0)
+      {
+        this->AddChild(wideNode, numChildren, children[c], minPoints[c], maxPoints[c]);
+        continue;
+      }
+
+      vtkm::Int32 grandchildren[2];
+      vtkm::Vec3f_32 grandchildMins[2];
+      vtkm::Vec3f_32 grandchildMaxs[2];
+      this->GetChildren(children[c], flatBVH, grandchildren, grandchildMins, grandchildMaxs);
+      for (vtkm::IdComponent g = 0; g < 2; ++g)
+      {
+        vtkm::Int32 grandchild = grandchildren[g];
+        if (grandchild >= 0)
+        {
+          grandchild = static_cast<vtkm::Int32>(wideIndices.Get(grandchild / 4) * 7);
+        }
+        this->AddChild(wideNode, numChildren, grandchild, grandchildMins[g], grandchildMaxs[g]);
+      }
+    }
+
+    const vtkm::Id wideOffset = wideIndices.Get(node) * 7;
+    for (vtkm::IdComponent i = 0; i < 7; ++i)
+    {
+      wideBVH.Set(wideOffset + i, wideNode[i]);
+    }
+  }
+}; //class CollapseWideNodes
+
 VTKM_CONT void LinearBVHBuilder::SortAABBS(BVHData& bvh, bool singleAABB)
 {
   //create array of indexes to be sorted with morton codes
@@ -584,7 +1210,46 @@ VTKM_CONT void LinearBVHBuilder::SortAABBS(BVHData& bvh, bool singleAABB)
 
 } // method SortAABB
 
-VTKM_CONT void LinearBVHBuilder::Build(LinearBVH& linearBVH)
+VTKM_CONT void LinearBVHBuilder::OptimizeTreelets(BVHData& bvh)
+{
+  const vtkm::Id innerCount = bvh.GetNumberOfInnerNodes();
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_32> nodeMins;
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_32> nodeMaxs;
+  vtkm::cont::ArrayHandle<vtkm::Float32> nodeCosts;
+  vtkm::cont::ArrayHandle<vtkm::Id> nodeLeafCounts;
+  nodeMins.Allocate(innerCount);
+  nodeMaxs.Allocate(innerCount);
+  nodeCosts.Allocate(innerCount);
+  nodeLeafCounts.Allocate(innerCount);
+  vtkm::cont::ArrayHandle<vtkm::Int32> counters;
+
+  // Each pass can improve the treelets formed from the restructured nodes of the last one.
+  // The gains after 3 passes are small.
+  vtkm::worklet::DispatcherMapField<TreeletOptimizer> treeletDispatch(
+    TreeletOptimizer{ bvh.GetNumberOfPrimitives() });
+  for (int pass = 0; pass < 3; ++pass)
+  {
+    vtkm::cont::Algorithm::Copy(vtkm::cont::ArrayHandleConstant<vtkm::Int32>(0, innerCount),
+                                counters);
+    treeletDispatch.Invoke(bvh.AABB.xmins,
+                           bvh.AABB.ymins,
+                           bvh.AABB.zmins,
+                           bvh.AABB.xmaxs,
+                           bvh.AABB.ymaxs,
+                           bvh.AABB.zmaxs,
+                           bvh.parent,
+                           bvh.leftChild,
+                           bvh.rightChild,
+                           counters,
+                           nodeMins,
+                           nodeMaxs,
+                           nodeCosts,
+                           nodeLeafCounts);
+  }
+}
+
+VTKM_CONT void LinearBVHBuilder::Build(LinearBVH& linearBVH,
+                                       vtkm::cont::ArrayHandle<vtkm::Id>& parents)
 {
 
   //
@@ -669,6 +1334,11 @@ VTKM_CONT void LinearBVHBuilder::Build(LinearBVH& linearBVH)
     TreeBuilder(bvh.GetNumberOfPrimitives()));
   treeDispatch.Invoke(bvh.leftChild, bvh.rightChild, bvh.mortonCodes, bvh.parent);
 
+  if (linearBVH.GetBuildType() == LinearBVH::BuildType::Treelet)
+  {
+    OptimizeTreelets(bvh);
+  }
+
   const vtkm::Int32 primitiveCount = vtkm::Int32(bvh.GetNumberOfPrimitives());
 
   vtkm::cont::ArrayHandle<vtkm::Int32> counters;
@@ -693,6 +1363,7 @@ VTKM_CONT void LinearBVHBuilder::Build(LinearBVH& linearBVH)
                       linearBVH.FlatBVH);
 
   linearBVH.Leafs = bvh.leafs;
+  parents = bvh.parent;
 }
 } //namespace detail
 
@@ -713,9 +1384,15 @@ LinearBVH::LinearBVH(const LinearBVH& other)
   : AABB(other.AABB)
   , FlatBVH(other.FlatBVH)
   , Leafs(other.Leafs)
+  , WideBVH(other.WideBVH)
   , LeafCount(other.LeafCount)
   , IsConstructed(other.IsConstructed)
   , CanConstruct(other.CanConstruct)
+  , Parents(other.Parents)
+  , ConstructedSAHCost(other.ConstructedSAHCost)
+  , RefitThreshold(other.RefitThreshold)
+  , TreeBuildType(other.TreeBuildType)
+  , UseWideNodes(other.UseWideNodes)
 {
 }
 
@@ -734,7 +1411,13 @@ void LinearBVH::Construct()
       "Linear BVH: coordinates and triangles must be set before calling construct!");
 
   detail::LinearBVHBuilder builder;
-  builder.Build(*this);
+  builder.Build(*this, this->Parents);
+  IsConstructed = true;
+  if (UseWideNodes)
+  {
+    this->BuildWideNodes();
+  }
+  ConstructedSAHCost = this->ComputeSAHCost();
 }
 
 VTKM_CONT
@@ -745,6 +1428,164 @@ void LinearBVH::SetData(AABBs& aabbs)
   CanConstruct = true;
 }
 
+VTKM_CONT
+void LinearBVH::Refit(AABBs& aabbs)
+{
+  const vtkm::Id numberOfAABBs = aabbs.xmins.GetNumberOfValues();
+  if (!IsConstructed || (numberOfAABBs < 2) || (numberOfAABBs != LeafCount))
+  {
+    this->SetData(aabbs);
+    this->Construct();
+    return;
+  }
+
+  // The leafs are in Morton order. Each leaf has the index of its primitive.
+  vtkm::cont::ArrayHandleStride<vtkm::Id> leafPrimitives(this->Leafs, LeafCount, 2, 1);
+  AABBs sortedAABBs;
+  vtkm::cont::Algorithm::Copy(vtkm::cont::make_ArrayHandlePermutation(leafPrimitives, aabbs.xmins),
+                              sortedAABBs.xmins);
+  vtkm::cont::Algorithm::Copy(vtkm::cont::make_ArrayHandlePermutation(leafPrimitives, aabbs.ymins),
+                              sortedAABBs.ymins);
+  vtkm::cont::Algorithm::Copy(vtkm::cont::make_ArrayHandlePermutation(leafPrimitives, aabbs.zmins),
+                              sortedAABBs.zmins);
+  vtkm::cont::Algorithm::Copy(vtkm::cont::make_ArrayHandlePermutation(leafPrimitives, aabbs.xmaxs),
+                              sortedAABBs.xmaxs);
+  vtkm::cont::Algorithm::Copy(vtkm::cont::make_ArrayHandlePermutation(leafPrimitives, aabbs.ymaxs),
+                              sortedAABBs.ymaxs);
+  vtkm::cont::Algorithm::Copy(vtkm::cont::make_ArrayHandlePermutation(leafPrimitives, aabbs.zmaxs),
+                              sortedAABBs.zmaxs);
+
+  vtkm::cont::ArrayHandle<vtkm::Int32> counters;
+  vtkm::cont::Algorithm::Copy(vtkm::cont::ArrayHandleConstant<vtkm::Int32>(0, LeafCount - 1),
+                              counters);
+
+  vtkm::worklet::DispatcherMapField<detail::LinearBVHBuilder::RefitAABBs> refitDispatch(
+    detail::LinearBVHBuilder::RefitAABBs{ LeafCount });
+  refitDispatch.Invoke(sortedAABBs.xmins,
+                       sortedAABBs.ymins,
+                       sortedAABBs.zmins,
+                       sortedAABBs.xmaxs,
+                       sortedAABBs.ymaxs,
+                       sortedAABBs.zmaxs,
+                       this->Parents,
+                       counters,
+                       this->FlatBVH);
+  AABB = sortedAABBs;
+
+  const vtkm::Float32 cost = this->ComputeSAHCost();
+  if (cost > RefitThreshold * ConstructedSAHCost)
+  {
+    // The primitives moved too far for the old topology to be any good.
+    this->SetData(aabbs);
+    this->Construct();
+    return;
+  }
+
+  // The root node holds the bounds of everything.
+  std::vector<vtkm::Vec4f_32> root = vtkm::cont::ArrayGetValues({ 0, 1, 2 }, this->FlatBVH);
+  vtkm::Vec3f_32 minPoint;
+  vtkm::Vec3f_32 maxPoint;
+  detail::GetInnerNodeBounds(root[0], root[1], root[2], minPoint, maxPoint);
+  TotalBounds = vtkm::Bounds(minPoint, maxPoint);
+
+  if (UseWideNodes)
+  {
+    this->BuildWideNodes();
+  }
+}
+
+VTKM_CONT void LinearBVH::BuildWideNodes()
+{
+  const vtkm::Id innerCount = LeafCount - 1;
+  vtkm::cont::ArrayHandle<vtkm::Id> isWideNode;
+  vtkm::cont::ArrayHandle<vtkm::Id> depths;
+  vtkm::worklet::DispatcherMapField<detail::LinearBVHBuilder::FindWideNodes> findDispatch;
+  findDispatch.Invoke(vtkm::cont::ArrayHandleIndex(innerCount), isWideNode, depths, this->Parents);
+
+  // Every wide node on the way down pushes up to 3 children on the stack of the traversal.
+  const vtkm::Id maxDepth = vtkm::cont::Algorithm::Reduce(depths, vtkm::Id{ 0 }, vtkm::Maximum());
+  const vtkm::Id numWideLevels = (maxDepth / 2) + 1;
+  if ((3 * numWideLevels) >= WideTraversalStackSize)
+  {
+    VTKM_LOG_S(vtkm::cont::LogLevel::Warn,
+               "BVH of depth " << maxDepth << " is too deep for wide nodes. Using binary nodes.");
+    WideBVH = InnerNodesHandle();
+    return;
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> wideIndices;
+  const vtkm::Id numWideNodes = vtkm::cont::Algorithm::ScanExclusive(isWideNode, wideIndices);
+  WideBVH.Allocate(numWideNodes * 7);
+
+  vtkm::worklet::DispatcherMapField<detail::LinearBVHBuilder::CollapseWideNodes> collapseDispatch;
+  collapseDispatch.Invoke(
+    vtkm::cont::ArrayHandleIndex(innerCount), isWideNode, wideIndices, this->FlatBVH, WideBVH);
+}
+
+VTKM_CONT
+vtkm::Float32 LinearBVH::ComputeSAHCost() const
+{
+  if (!IsConstructed)
+  {
+    return 0.f;
+  }
+
+  std::vector<vtkm::Vec4f_32> root = vtkm::cont::ArrayGetValues({ 0, 1, 2 }, this->FlatBVH);
+  vtkm::Vec3f_32 minPoint;
+  vtkm::Vec3f_32 maxPoint;
+  detail::GetInnerNodeBounds(root[0], root[1], root[2], minPoint, maxPoint);
+  const vtkm::Float64 rootArea = detail::SurfaceArea(minPoint, maxPoint);
+  if (rootArea <= 0)
+  {
+    return 0.f;
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> childAreas;
+  vtkm::worklet::DispatcherMapField<detail::LinearBVHBuilder::NodeSurfaceArea> areaDispatch;
+  areaDispatch.Invoke(vtkm::cont::ArrayHandleIndex(LeafCount - 1), childAreas, this->FlatBVH);
+  const vtkm::Float64 area = rootArea + vtkm::cont::Algorithm::Reduce(childAreas, 0.0);
+  return static_cast<vtkm::Float32>(area / rootArea);
+}
+
+VTKM_CONT void LinearBVH::SetRefitThreshold(vtkm::Float32 threshold)
+{
+  RefitThreshold = threshold;
+}
+
+VTKM_CONT vtkm::Float32 LinearBVH::GetRefitThreshold() const
+{
+  return RefitThreshold;
+}
+
+VTKM_CONT void LinearBVH::SetBuildType(BuildType buildType)
+{
+  TreeBuildType = buildType;
+}
+
+VTKM_CONT LinearBVH::BuildType LinearBVH::GetBuildType() const
+{
+  return TreeBuildType;
+}
+
+VTKM_CONT void LinearBVH::SetUseWideNodes(bool useWideNodes)
+{
+  UseWideNodes = useWideNodes;
+  if (!UseWideNodes)
+  {
+    WideBVH = InnerNodesHandle();
+  }
+  else if (IsConstructed && (WideBVH.GetNumberOfValues() == 0))
+  {
+    // Does nothing again for trees too deep for wide traversal, which is cheap enough.
+    this->BuildWideNodes();
+  }
+}
+
+VTKM_CONT bool LinearBVH::GetUseWideNodes() const
+{
+  return UseWideNodes;
+}
+
 // explicitly export
 //template VTKM_RENDERING_EXPORT void LinearBVH::ConstructOnDevice<
 //  vtkm::cont::DeviceAdapterTagSerial>(vtkm::cont::DeviceAdapterTagSerial);
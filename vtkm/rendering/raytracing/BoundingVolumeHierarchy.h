@@ -37,17 +37,47 @@ struct AABBs
 class VTKM_RENDERING_EXPORT LinearBVH
 {
 public:
+  /// How the topology of the tree is built.
+  ///
+  enum struct BuildType
+  {
+    /// Splits the primitives by their Morton codes. This is the fastest build, but it can
+    /// make poor trees for clustered geometry.
+    Morton,
+    /// Builds the Morton tree and then restructures small treelets of it to minimize the
+    /// SAH cost. The build takes longer, but rays traverse the tree faster.
+    Treelet
+  };
+
   using InnerNodesHandle = vtkm::cont::ArrayHandle<vtkm::Vec4f_32>;
+
+  /// The size of the stack used to trace a ray through the wide tree.
+  ///
+  static constexpr vtkm::Int32 WideTraversalStackSize = 96;
+
   using LeafNodesHandle = vtkm::cont::ArrayHandle<Id>;
   AABBs AABB;
   InnerNodesHandle FlatBVH;
   LeafNodesHandle Leafs;
+  // The tree with 4 children per node. Each node is 7 Vec4s: the minimum x, y, z and maximum
+  // x, y, z of the 4 children, and then the children. A child is the offset of a node, a
+  // negative leaf reference like in FlatBVH, or 0 for an empty slot. Empty unless wide nodes
+  // are used and the tree is shallow enough to be traversed (see WideTraversalStackSize).
+  InnerNodesHandle WideBVH;
   vtkm::Bounds TotalBounds;
   vtkm::Id LeafCount;
 
 protected:
   bool IsConstructed;
   bool CanConstruct;
+  // Parent of every node (inner nodes first, then leafs). Kept so the tree can be refit.
+  vtkm::cont::ArrayHandle<vtkm::Id> Parents;
+  vtkm::Float32 ConstructedSAHCost = 0.f;
+  vtkm::Float32 RefitThreshold = 1.5f;
+  BuildType TreeBuildType = BuildType::Morton;
+  bool UseWideNodes = false;
+
+  VTKM_CONT void BuildWideNodes();
 
 public:
   LinearBVH();
@@ -66,6 +96,48 @@ public:
   VTKM_CONT
   void SetData(AABBs& aabbs);
 
+  /// Updates the bounds of the tree for new AABBs without changing its topology.
+  ///
+  /// The AABBs must be for the same primitives, in the same order, as those the tree was
+  /// constructed with, although they may have moved (for example, the points of a deforming
+  /// mesh). The bounds are updated from the leafs to the root, which is much faster than
+  /// constructing a new tree. If the primitives moved far, the old topology can make a poor
+  /// tree. When the SAH cost of the refit tree exceeds the refit threshold times the cost of
+  /// the tree when it was constructed, the tree is constructed again instead. It is also
+  /// constructed if it was not constructed before or the number of AABBs changed.
+  ///
+  VTKM_CONT
+  void Refit(AABBs& aabbs);
+
+  /// Returns the surface area heuristic (SAH) cost of the tree.
+  ///
+  /// The cost is the sum of the surface areas of all nodes divided by the surface area of the
+  /// root. It is proportional to the expected work to trace a random ray through the tree.
+  ///
+  VTKM_CONT
+  vtkm::Float32 ComputeSAHCost() const;
+
+  /// The SAH cost ratio to the constructed tree above which `Refit` constructs a new tree.
+  ///
+  VTKM_CONT void SetRefitThreshold(vtkm::Float32 threshold);
+  VTKM_CONT vtkm::Float32 GetRefitThreshold() const;
+
+  /// Sets how the tree is built. This takes effect the next time the tree is constructed.
+  ///
+  VTKM_CONT void SetBuildType(BuildType buildType);
+  VTKM_CONT BuildType GetBuildType() const;
+
+  /// Sets whether to also make a tree with 4 children per node (`WideBVH`).
+  ///
+  /// Tracing a ray through the wide tree visits half as many levels and tests the 4 children
+  /// of a node together, which is faster on CPUs.
+  ///
+  /// The wide tree is not made if tracing a ray through it could need more than
+  /// `WideTraversalStackSize` entries on the traversal stack. Rays then use the binary tree.
+  ///
+  VTKM_CONT void SetUseWideNodes(bool useWideNodes);
+  VTKM_CONT bool GetUseWideNodes() const;
+
   VTKM_CONT
   AABBs& GetAABBs();
 
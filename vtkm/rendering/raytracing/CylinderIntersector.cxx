@@ -443,7 +443,7 @@ void CylinderIntersector::SetData(const vtkm::cont::CoordinateSystem& coords,
             AABB.zmaxs,
             CoordsHandle);
 
-  this->SetAABBs(AABB);
+  this->SetAABBs(AABB, this->CylIds);
 }
 
 void CylinderIntersector::IntersectRays(Ray<vtkm::Float32>& rays, bool returnCellIndex)
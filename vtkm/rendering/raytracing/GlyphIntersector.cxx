@@ -556,7 +556,7 @@ void GlyphIntersector::SetData(const vtkm::cont::CoordinateSystem& coords,
             AABB.zmaxs,
             CoordsHandle);
 
-  this->SetAABBs(AABB);
+  this->SetAABBs(AABB, this->PointIds);
 }
 
 void GlyphIntersector::IntersectRays(Ray<vtkm::Float32>& rays, bool returnCellIndex)
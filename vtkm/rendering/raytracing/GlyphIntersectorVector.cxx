@@ -631,7 +631,7 @@ void GlyphIntersectorVector::SetData(const vtkm::cont::CoordinateSystem& coords,
     AABB.zmaxs,
     CoordsHandle);
 
-  this->SetAABBs(AABB);
+  this->SetAABBs(AABB, this->PointIds);
 }
 
 void GlyphIntersectorVector::IntersectRays(Ray<vtkm::Float32>& rays, bool returnCellIndex)
@@ -566,7 +566,7 @@ void QuadIntersector::SetData(const vtkm::cont::CoordinateSystem& coords,
                        AABB.zmaxs,
                        CoordsHandle);
 
-  this->SetAABBs(AABB);
+  this->SetAABBs(AABB, this->QuadIds);
 }
 
 vtkm::Id QuadIntersector::GetNumberOfShapes() const
@@ -8,6 +8,8 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 #include <vtkm/rendering/raytracing/ShapeIntersector.h>
+
+#include <vtkm/cont/internal/Fingerprint.h>
 #include <vtkm/worklet/WorkletMapField.h>
 
 namespace vtkm
@@ -87,10 +89,37 @@ vtkm::Bounds ShapeIntersector::GetShapeBounds() const
   return ShapeBounds;
 }
 
-void ShapeIntersector::SetAABBs(AABBs& aabbs)
+void ShapeIntersector::SetBVHBuildType(LinearBVH::BuildType buildType)
+{
+  this->BVH.SetBuildType(buildType);
+}
+
+void ShapeIntersector::SetUseWideBVH(bool useWideBVH)
+{
+  this->BVH.SetUseWideNodes(useWideBVH);
+}
+
+void ShapeIntersector::SetAABBs(AABBs& aabbs, const vtkm::cont::UnknownArrayHandle& primitives)
 {
-  this->BVH.SetData(aabbs);
-  this->BVH.Construct();
+  std::vector<vtkm::UInt64> fingerprint;
+  if (!vtkm::cont::internal::AppendArrayFingerprint(fingerprint, primitives))
+  {
+    fingerprint.clear();
+  }
+
+  if (!fingerprint.empty() && this->BVH.GetIsConstructed() &&
+      (fingerprint == this->PrimitivesFingerprint))
+  {
+    // The same shapes, possibly in new positions, so the topology of the tree still fits.
+    // Refit constructs a new tree if that does not work out.
+    this->BVH.Refit(aabbs);
+  }
+  else
+  {
+    this->BVH.SetData(aabbs);
+    this->BVH.Construct();
+  }
+  this->PrimitivesFingerprint = fingerprint;
   this->ShapeBounds = this->BVH.TotalBounds;
 }
 }
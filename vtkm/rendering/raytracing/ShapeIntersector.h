@@ -11,9 +11,12 @@
 #define vtk_m_rendering_raytracing_Shape_Intersector_h
 
 #include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/UnknownArrayHandle.h>
 #include <vtkm/rendering/raytracing/BoundingVolumeHierarchy.h>
 #include <vtkm/rendering/raytracing/Ray.h>
 
+#include <vector>
+
 namespace vtkm
 {
 namespace rendering
@@ -27,7 +30,15 @@ protected:
   LinearBVH BVH;
   vtkm::cont::CoordinateSystem CoordsHandle;
   vtkm::Bounds ShapeBounds;
-  void SetAABBs(AABBs& aabbs);
+  // Identifies the primitives the BVH was built for (see SetAABBs).
+  std::vector<vtkm::UInt64> PrimitivesFingerprint;
+
+  //
+  // Builds the BVH for the AABBs of the shapes. `primitives` holds the shapes the AABBs were
+  // found from. If the BVH was built for the same, unmodified primitives (for example, when only
+  // the points moved), it is refit instead.
+  //
+  void SetAABBs(AABBs& aabbs, const vtkm::cont::UnknownArrayHandle& primitives);
 
 public:
   ShapeIntersector();
@@ -66,6 +77,17 @@ public:
   void IntersectionPoint(Ray<vtkm::Float64>& rays);
 
   vtkm::Bounds GetShapeBounds() const;
+
+  //
+  // Sets how the BVH of the shapes is built. Set this before setting the shapes.
+  //
+  void SetBVHBuildType(LinearBVH::BuildType buildType);
+
+  //
+  // Sets whether rays traverse a BVH with 4 children per node, which is faster on CPUs.
+  //
+  void SetUseWideBVH(bool useWideBVH);
+
   virtual vtkm::Id GetNumberOfShapes() const = 0;
 }; // class ShapeIntersector
 }
@@ -319,7 +319,7 @@ void SphereIntersector::SetData(const vtkm::cont::CoordinateSystem& coords,
             AABB.zmaxs,
             CoordsHandle);
 
-  this->SetAABBs(AABB);
+  this->SetAABBs(AABB, this->PointIds);
 }
 
 void SphereIntersector::IntersectRays(Ray<vtkm::Float32>& rays, bool returnCellIndex)
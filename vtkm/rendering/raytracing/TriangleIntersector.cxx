@@ -489,7 +489,7 @@ void TriangleIntersector::SetData(const vtkm::cont::CoordinateSystem& coords,
             AABB.zmaxs,
             CoordsHandle);
 
-  this->SetAABBs(AABB);
+  this->SetAABBs(AABB, this->Triangles);
 }
 
 vtkm::cont::ArrayHandle<vtkm::Id4> TriangleIntersector::GetTriangles()
@@ -0,0 +1,546 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/VectorAnalysis.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/rendering/raytracing/BoundingVolumeHierarchy.h>
+#include <vtkm/rendering/raytracing/Ray.h>
+#include <vtkm/rendering/raytracing/TriangleIntersector.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace
+{
+
+using vtkm::rendering::raytracing::AABBs;
+using vtkm::rendering::raytracing::LinearBVH;
+
+constexpr vtkm::Id NUM_BOXES = 1000;
+constexpr vtkm::Id NUM_RAYS = 2000;
+
+// Centers of boxes along a few lines, like the segments of tubes around streamlines.
+std::vector<vtkm::Vec3f_32> MakeClusteredCenters(std::mt19937& generator)
+{
+  std::uniform_real_distribution<vtkm::Float32> distribution(0.f, 1.f);
+  std::vector<vtkm::Vec3f_32> centers(NUM_BOXES);
+  constexpr vtkm::Id numLines = 8;
+  for (vtkm::Id line = 0; line < numLines; ++line)
+  {
+    const vtkm::Vec3f_32 start(
+      distribution(generator), distribution(generator), distribution(generator));
+    const vtkm::Vec3f_32 end(
+      distribution(generator), distribution(generator), distribution(generator));
+    for (vtkm::Id i = line; i < NUM_BOXES; i += numLines)
+    {
+      const vtkm::Vec3f_32 jitter(
+        distribution(generator), distribution(generator), distribution(generator));
+      centers[static_cast<std::size_t>(i)] =
+        vtkm::Lerp(start, end, distribution(generator)) + jitter * 0.02f;
+    }
+  }
+  return centers;
+}
+
+AABBs MakeBoxes(const std::vector<vtkm::Vec3f_32>& centers)
+{
+  AABBs aabbs;
+  const vtkm::Id numBoxes = static_cast<vtkm::Id>(centers.size());
+  aabbs.xmins.Allocate(numBoxes);
+  aabbs.ymins.Allocate(numBoxes);
+  aabbs.zmins.Allocate(numBoxes);
+  aabbs.xmaxs.Allocate(numBoxes);
+  aabbs.ymaxs.Allocate(numBoxes);
+  aabbs.zmaxs.Allocate(numBoxes);
+  auto xmins = aabbs.xmins.WritePortal();
+  auto ymins = aabbs.ymins.WritePortal();
+  auto zmins = aabbs.zmins.WritePortal();
+  auto xmaxs = aabbs.xmaxs.WritePortal();
+  auto ymaxs = aabbs.ymaxs.WritePortal();
+  auto zmaxs = aabbs.zmaxs.WritePortal();
+  for (vtkm::Id i = 0; i < numBoxes; ++i)
+  {
+    const vtkm::Vec3f_32& center = centers[static_cast<std::size_t>(i)];
+    xmins.Set(i, center[0] - 0.01f);
+    ymins.Set(i, center[1] - 0.01f);
+    zmins.Set(i, center[2] - 0.01f);
+    xmaxs.Set(i, center[0] + 0.01f);
+    ymaxs.Set(i, center[1] + 0.01f);
+    zmaxs.Set(i, center[2] + 0.01f);
+  }
+  return aabbs;
+}
+
+// Checks that every node of the tree holds the exact bounds of the boxes below it and that
+// every box is in exactly one leaf.
+struct TreeChecker
+{
+  std::vector<vtkm::Vec4f_32> FlatBVH;
+  std::vector<vtkm::Id> Leafs;
+  std::vector<vtkm::Vec3f_32> Centers;
+  std::vector<int> Visited;
+
+  void GetChild(vtkm::Int32 child, vtkm::Vec3f_32& minPoint, vtkm::Vec3f_32& maxPoint)
+  {
+    if (child < 0)
+    {
+      const vtkm::Id leafOffset = -child - 1;
+      VTKM_TEST_ASSERT(this->Leafs[static_cast<std::size_t>(leafOffset)] == 1);
+      const vtkm::Id box = this->Leafs[static_cast<std::size_t>(leafOffset + 1)];
+      ++this->Visited[static_cast<std::size_t>(box)];
+      minPoint = this->Centers[static_cast<std::size_t>(box)] - vtkm::Vec3f_32(0.01f);
+      maxPoint = this->Centers[static_cast<std::size_t>(box)] + vtkm::Vec3f_32(0.01f);
+    }
+    else
+    {
+      this->CheckNode(child, minPoint, maxPoint);
+    }
+  }
+
+  void CheckNode(vtkm::Id offset, vtkm::Vec3f_32& minPoint, vtkm::Vec3f_32& maxPoint)
+  {
+    const vtkm::Vec4f_32 first = this->FlatBVH[static_cast<std::size_t>(offset)];
+    const vtkm::Vec4f_32 second = this->FlatBVH[static_cast<std::size_t>(offset + 1)];
+    const vtkm::Vec4f_32 third = this->FlatBVH[static_cast<std::size_t>(offset + 2)];
+    const vtkm::Vec4f_32 fourth = this->FlatBVH[static_cast<std::size_t>(offset + 3)];
+    vtkm::Int32 leftChild;
+    vtkm::Int32 rightChild;
+    std::memcpy(&leftChild, &fourth[0], 4);
+    std::memcpy(&rightChild, &fourth[1], 4);
+
+    vtkm::Vec3f_32 leftMin, leftMax, rightMin, rightMax;
+    this->GetChild(leftChild, leftMin, leftMax);
+    this->GetChild(rightChild, rightMin, rightMax);
+    VTKM_TEST_ASSERT(test_equal(vtkm::Vec3f_32(first[0], first[1], first[2]), leftMin));
+    VTKM_TEST_ASSERT(test_equal(vtkm::Vec3f_32(first[3], second[0], second[1]), leftMax));
+    VTKM_TEST_ASSERT(test_equal(vtkm::Vec3f_32(second[2], second[3], third[0]), rightMin));
+    VTKM_TEST_ASSERT(test_equal(vtkm::Vec3f_32(third[1], third[2], third[3]), rightMax));
+
+    for (vtkm::IdComponent i = 0; i < 3; ++i)
+    {
+      minPoint[i] = vtkm::Min(leftMin[i], rightMin[i]);
+      maxPoint[i] = vtkm::Max(leftMax[i], rightMax[i]);
+    }
+  }
+
+  void Check(const LinearBVH& bvh)
+  {
+    auto flatPortal = bvh.FlatBVH.ReadPortal();
+    this->FlatBVH.assign(vtkm::cont::ArrayPortalToIteratorBegin(flatPortal),
+                         vtkm::cont::ArrayPortalToIteratorEnd(flatPortal));
+    auto leafPortal = bvh.Leafs.ReadPortal();
+    this->Leafs.assign(vtkm::cont::ArrayPortalToIteratorBegin(leafPortal),
+                       vtkm::cont::ArrayPortalToIteratorEnd(leafPortal));
+    this->Visited.assign(this->Centers.size(), 0);
+
+    vtkm::Vec3f_32 minPoint, maxPoint;
+    this->CheckNode(0, minPoint, maxPoint);
+    for (int visits : this->Visited)
+    {
+      VTKM_TEST_ASSERT(visits == 1, "Box not in exactly one leaf.");
+    }
+    VTKM_TEST_ASSERT(test_equal(bvh.TotalBounds, vtkm::Bounds(minPoint, maxPoint)));
+  }
+};
+
+// Checks that every slot of the wide tree holds the exact bounds of the boxes below it and
+// that every box is in exactly one leaf.
+struct WideTreeChecker
+{
+  std::vector<vtkm::Vec4f_32> WideBVH;
+  std::vector<vtkm::Id> Leafs;
+  std::vector<vtkm::Vec3f_32> Centers;
+  std::vector<int> Visited;
+
+  void CheckNode(vtkm::Int32 offset, vtkm::Vec3f_32& minPoint, vtkm::Vec3f_32& maxPoint)
+  {
+    VTKM_TEST_ASSERT(offset % 7 == 0, "Bad wide node offset.");
+    minPoint = vtkm::Vec3f_32(vtkm::Infinity32());
+    maxPoint = vtkm::Vec3f_32(vtkm::NegativeInfinity32());
+    vtkm::IdComponent numChildren = 0;
+    for (vtkm::IdComponent slot = 0; slot < 4; ++slot)
+    {
+      vtkm::Int32 child;
+      std::memcpy(&child, &this->WideBVH[static_cast<std::size_t>(offset + 6)][slot], 4);
+      if (child == 0)
+      {
+        continue;
+      }
+      ++numChildren;
+
+      vtkm::Vec3f_32 childMin, childMax;
+      if (child < 0)
+      {
+        const vtkm::Id leafOffset = -child - 1;
+        VTKM_TEST_ASSERT(this->Leafs[static_cast<std::size_t>(leafOffset)] == 1);
+        const vtkm::Id box = this->Leafs[static_cast<std::size_t>(leafOffset + 1)];
+        ++this->Visited[static_cast<std::size_t>(box)];
+        childMin = this->Centers[static_cast<std::size_t>(box)] - vtkm::Vec3f_32(0.01f);
+        childMax = this->Centers[static_cast<std::size_t>(box)] + vtkm::Vec3f_32(0.01f);
+      }
+      else
+      {
+        this->CheckNode(child, childMin, childMax);
+      }
+
+      for (vtkm::IdComponent i = 0; i < 3; ++i)
+      {
+        VTKM_TEST_ASSERT(
+          test_equal(this->WideBVH[static_cast<std::size_t>(offset + i)][slot], childMin[i]));
+        VTKM_TEST_ASSERT(
+          test_equal(this->WideBVH[static_cast<std::size_t>(offset + i + 3)][slot], childMax[i]));
+        minPoint[i] = vtkm::Min(minPoint[i], childMin[i]);
+        maxPoint[i] = vtkm::Max(maxPoint[i], childMax[i]);
+      }
+    }
+    VTKM_TEST_ASSERT(numChildren >= 2, "Wide node with less than 2 children.");
+  }
+
+  void Check(const LinearBVH& bvh)
+  {
+    auto widePortal = bvh.WideBVH.ReadPortal();
+    this->WideBVH.assign(vtkm::cont::ArrayPortalToIteratorBegin(widePortal),
+                         vtkm::cont::ArrayPortalToIteratorEnd(widePortal));
+    auto leafPortal = bvh.Leafs.ReadPortal();
+    this->Leafs.assign(vtkm::cont::ArrayPortalToIteratorBegin(leafPortal),
+                       vtkm::cont::ArrayPortalToIteratorEnd(leafPortal));
+    this->Visited.assign(this->Centers.size(), 0);
+
+    vtkm::Vec3f_32 minPoint, maxPoint;
+    this->CheckNode(0, minPoint, maxPoint);
+    for (int visits : this->Visited)
+    {
+      VTKM_TEST_ASSERT(visits == 1, "Box not in exactly one leaf.");
+    }
+    VTKM_TEST_ASSERT(test_equal(bvh.TotalBounds, vtkm::Bounds(minPoint, maxPoint)));
+  }
+};
+
+void TestRefit()
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<vtkm::Float32> distribution(0.f, 1.f);
+  std::vector<vtkm::Vec3f_32> centers(NUM_BOXES);
+  for (auto& center : centers)
+  {
+    center = { distribution(generator), distribution(generator), distribution(generator) };
+  }
+
+  TreeChecker checker;
+  checker.Centers = centers;
+
+  std::cout << "Construct" << std::endl;
+  AABBs aabbs = MakeBoxes(centers);
+  LinearBVH bvh(aabbs);
+  bvh.Construct();
+  VTKM_TEST_ASSERT(bvh.GetIsConstructed());
+  checker.Check(bvh);
+  const vtkm::Float32 constructedCost = bvh.ComputeSAHCost();
+  std::cout << "  SAH cost " << constructedCost << std::endl;
+  VTKM_TEST_ASSERT(constructedCost > 1.f);
+  vtkm::cont::ArrayHandle<vtkm::Id> constructedLeafs = bvh.Leafs;
+
+  std::cout << "Refit small motion" << std::endl;
+  for (auto& center : centers)
+  {
+    center = center * 1.5f + vtkm::Vec3f_32(1, 2, 3) +
+      vtkm::Vec3f_32(distribution(generator), distribution(generator), distribution(generator)) *
+        0.01f;
+  }
+  checker.Centers = centers;
+  aabbs = MakeBoxes(centers);
+  bvh.Refit(aabbs);
+  checker.Check(bvh);
+  std::cout << "  SAH cost " << bvh.ComputeSAHCost() << std::endl;
+  VTKM_TEST_ASSERT(bvh.Leafs == constructedLeafs, "Refit should keep the tree.");
+
+  std::cout << "Refit scrambled boxes without rebuild" << std::endl;
+  std::shuffle(centers.begin(), centers.end(), generator);
+  checker.Centers = centers;
+  aabbs = MakeBoxes(centers);
+  LinearBVH refitBVH(bvh);
+  refitBVH.SetRefitThreshold(vtkm::Infinity32());
+  refitBVH.Refit(aabbs);
+  checker.Check(refitBVH);
+  const vtkm::Float32 scrambledCost = refitBVH.ComputeSAHCost();
+  std::cout << "  SAH cost " << scrambledCost << std::endl;
+  VTKM_TEST_ASSERT(refitBVH.Leafs == constructedLeafs, "Refit should keep the tree.");
+  VTKM_TEST_ASSERT(scrambledCost > bvh.GetRefitThreshold() * constructedCost);
+
+  std::cout << "Refit scrambled boxes with rebuild" << std::endl;
+  bvh.Refit(aabbs);
+  checker.Check(bvh);
+  std::cout << "  SAH cost " << bvh.ComputeSAHCost() << std::endl;
+  VTKM_TEST_ASSERT(bvh.ComputeSAHCost() < scrambledCost);
+  VTKM_TEST_ASSERT(bvh.Leafs != constructedLeafs, "Refit should rebuild the tree.");
+
+  std::cout << "Refit different number of boxes" << std::endl;
+  centers.resize(NUM_BOXES / 2);
+  checker.Centers = centers;
+  aabbs = MakeBoxes(centers);
+  bvh.Refit(aabbs);
+  checker.Check(bvh);
+  VTKM_TEST_ASSERT(bvh.LeafCount == NUM_BOXES / 2);
+}
+
+void TestTreelet()
+{
+  std::mt19937 generator(7);
+  std::vector<vtkm::Vec3f_32> centers = MakeClusteredCenters(generator);
+  TreeChecker checker;
+  checker.Centers = centers;
+
+  std::cout << "Construct Morton tree" << std::endl;
+  AABBs mortonAABBs = MakeBoxes(centers);
+  LinearBVH mortonBVH(mortonAABBs);
+  mortonBVH.Construct();
+  checker.Check(mortonBVH);
+  const vtkm::Float32 mortonCost = mortonBVH.ComputeSAHCost();
+  std::cout << "  SAH cost " << mortonCost << std::endl;
+
+  std::cout << "Construct treelet tree" << std::endl;
+  AABBs treeletAABBs = MakeBoxes(centers);
+  LinearBVH treeletBVH(treeletAABBs);
+  treeletBVH.SetBuildType(LinearBVH::BuildType::Treelet);
+  treeletBVH.Construct();
+  checker.Check(treeletBVH);
+  const vtkm::Float32 treeletCost = treeletBVH.ComputeSAHCost();
+  std::cout << "  SAH cost " << treeletCost << std::endl;
+  VTKM_TEST_ASSERT(treeletCost < mortonCost, "Treelets did not improve the tree.");
+
+  std::cout << "Refit treelet tree" << std::endl;
+  for (auto& center : centers)
+  {
+    center = center + vtkm::Vec3f_32(0.001f, 0.002f, 0.003f);
+  }
+  checker.Centers = centers;
+  treeletAABBs = MakeBoxes(centers);
+  treeletBVH.Refit(treeletAABBs);
+  checker.Check(treeletBVH);
+}
+
+void TestWide()
+{
+  std::mt19937 generator(11);
+  std::vector<vtkm::Vec3f_32> centers = MakeClusteredCenters(generator);
+  WideTreeChecker checker;
+  checker.Centers = centers;
+
+  for (LinearBVH::BuildType buildType :
+       { LinearBVH::BuildType::Morton, LinearBVH::BuildType::Treelet })
+  {
+    std::cout << "Construct wide tree" << std::endl;
+    AABBs aabbs = MakeBoxes(centers);
+    LinearBVH bvh(aabbs);
+    bvh.SetBuildType(buildType);
+    bvh.SetUseWideNodes(true);
+    bvh.Construct();
+    checker.Check(bvh);
+
+    std::cout << "Refit wide tree" << std::endl;
+    std::vector<vtkm::Vec3f_32> movedCenters = centers;
+    for (auto& center : movedCenters)
+    {
+      center = center * 2.f;
+    }
+    checker.Centers = movedCenters;
+    aabbs = MakeBoxes(movedCenters);
+    bvh.Refit(aabbs);
+    checker.Check(bvh);
+    checker.Centers = centers;
+  }
+
+  std::cout << "Enable wide nodes after construction" << std::endl;
+  AABBs aabbs = MakeBoxes(centers);
+  LinearBVH bvh(aabbs);
+  bvh.Construct();
+  VTKM_TEST_ASSERT(bvh.WideBVH.GetNumberOfValues() == 0);
+  bvh.SetUseWideNodes(true);
+  checker.Check(bvh);
+  bvh.SetUseWideNodes(false);
+  VTKM_TEST_ASSERT(bvh.WideBVH.GetNumberOfValues() == 0);
+}
+
+void TestWideTraversal()
+{
+  std::cout << "Trace rays through binary and wide trees" << std::endl;
+  std::mt19937 generator(13);
+  std::uniform_real_distribution<vtkm::Float32> distribution(0.f, 1.f);
+  std::vector<vtkm::Vec3f_32> centers = MakeClusteredCenters(generator);
+
+  std::vector<vtkm::Vec3f_32> points;
+  std::vector<vtkm::Id4> triangles;
+  for (std::size_t i = 0; i < centers.size(); ++i)
+  {
+    const vtkm::Id first = static_cast<vtkm::Id>(points.size());
+    for (int corner = 0; corner < 3; ++corner)
+    {
+      const vtkm::Vec3f_32 offset(
+        distribution(generator), distribution(generator), distribution(generator));
+      points.push_back(centers[i] + (offset - vtkm::Vec3f_32(0.5f)) * 0.05f);
+    }
+    triangles.push_back(vtkm::Id4(static_cast<vtkm::Id>(i), first, first + 1, first + 2));
+  }
+  vtkm::cont::CoordinateSystem coords(
+    "coords", vtkm::cont::make_ArrayHandle(points, vtkm::CopyFlag::On));
+  vtkm::cont::ArrayHandle<vtkm::Id4> triangleArray =
+    vtkm::cont::make_ArrayHandle(triangles, vtkm::CopyFlag::On);
+
+  vtkm::rendering::raytracing::Ray<vtkm::Float32> rays;
+  rays.Resize(static_cast<vtkm::Int32>(NUM_RAYS), vtkm::cont::DeviceAdapterTagSerial{});
+  {
+    auto originX = rays.OriginX.WritePortal();
+    auto originY = rays.OriginY.WritePortal();
+    auto originZ = rays.OriginZ.WritePortal();
+    auto dirX = rays.DirX.WritePortal();
+    auto dirY = rays.DirY.WritePortal();
+    auto dirZ = rays.DirZ.WritePortal();
+    for (vtkm::Id i = 0; i < NUM_RAYS; ++i)
+    {
+      const vtkm::Vec3f_32 origin(
+        distribution(generator) * 3.f - 1.f, distribution(generator) * 3.f - 1.f, -1.f);
+      // Aim at the centroid of a triangle so that most rays hit something.
+      const std::size_t first = static_cast<std::size_t>((i % NUM_BOXES) * 3);
+      const vtkm::Vec3f_32 target = (points[first] + points[first + 1] + points[first + 2]) / 3.f;
+      const vtkm::Vec3f_32 dir = vtkm::Normal(target - origin);
+      originX.Set(i, origin[0]);
+      originY.Set(i, origin[1]);
+      originZ.Set(i, origin[2]);
+      dirX.Set(i, dir[0]);
+      dirY.Set(i, dir[1]);
+      dirZ.Set(i, dir[2]);
+    }
+  }
+
+  auto trace = [&](vtkm::rendering::raytracing::TriangleIntersector& intersector,
+                   vtkm::cont::ArrayHandle<vtkm::Id>& hits,
+                   vtkm::cont::ArrayHandle<vtkm::Float32>& distances) {
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandleConstant(0.f, NUM_RAYS), rays.MinDistance);
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandleConstant(vtkm::Infinity32(), NUM_RAYS),
+                          rays.MaxDistance);
+    intersector.IntersectRays(rays);
+    vtkm::cont::ArrayCopy(rays.HitIdx, hits);
+    vtkm::cont::ArrayCopy(rays.Distance, distances);
+  };
+
+  vtkm::rendering::raytracing::TriangleIntersector binaryIntersector;
+  binaryIntersector.SetData(coords, triangleArray);
+  vtkm::cont::ArrayHandle<vtkm::Id> binaryHits;
+  vtkm::cont::ArrayHandle<vtkm::Float32> binaryDistances;
+  trace(binaryIntersector, binaryHits, binaryDistances);
+
+  vtkm::rendering::raytracing::TriangleIntersector wideIntersector;
+  wideIntersector.SetBVHBuildType(LinearBVH::BuildType::Treelet);
+  wideIntersector.SetUseWideBVH(true);
+  wideIntersector.SetData(coords, triangleArray);
+  vtkm::cont::ArrayHandle<vtkm::Id> wideHits;
+  vtkm::cont::ArrayHandle<vtkm::Float32> wideDistances;
+  trace(wideIntersector, wideHits, wideDistances);
+
+  auto binaryHitsPortal = binaryHits.ReadPortal();
+  auto binaryDistancesPortal = binaryDistances.ReadPortal();
+  auto wideHitsPortal = wideHits.ReadPortal();
+  auto wideDistancesPortal = wideDistances.ReadPortal();
+  vtkm::Id numHits = 0;
+  for (vtkm::Id i = 0; i < NUM_RAYS; ++i)
+  {
+    VTKM_TEST_ASSERT(binaryHitsPortal.Get(i) == wideHitsPortal.Get(i),
+                     "Wide traversal found a different hit.");
+    if (binaryHitsPortal.Get(i) != -1)
+    {
+      VTKM_TEST_ASSERT(test_equal(binaryDistancesPortal.Get(i), wideDistancesPortal.Get(i)));
+      ++numHits;
+    }
+  }
+  std::cout << "  " << numHits << " of " << NUM_RAYS << " rays hit" << std::endl;
+  VTKM_TEST_ASSERT(numHits > NUM_RAYS / 2);
+}
+
+// Exposes the BVH of the intersector.
+class TestTriangleIntersector : public vtkm::rendering::raytracing::TriangleIntersector
+{
+public:
+  LinearBVH& GetBVH() { return this->BVH; }
+};
+
+std::vector<vtkm::Id> GetLeafs(const LinearBVH& bvh)
+{
+  auto portal = bvh.Leafs.ReadPortal();
+  return std::vector<vtkm::Id>(vtkm::cont::ArrayPortalToIteratorBegin(portal),
+                               vtkm::cont::ArrayPortalToIteratorEnd(portal));
+}
+
+void TestIntersectorRefit()
+{
+  std::cout << "Refit the BVH of an intersector only for the same shapes" << std::endl;
+  std::mt19937 generator(17);
+  std::vector<vtkm::Vec3f_32> centers = MakeClusteredCenters(generator);
+
+  std::vector<vtkm::Vec3f_32> points;
+  std::vector<vtkm::Id4> triangles;
+  for (std::size_t i = 0; i < centers.size(); ++i)
+  {
+    const vtkm::Id first = static_cast<vtkm::Id>(points.size());
+    points.push_back(centers[i] + vtkm::Vec3f_32(0.01f, 0.f, 0.f));
+    points.push_back(centers[i] + vtkm::Vec3f_32(0.f, 0.01f, 0.f));
+    points.push_back(centers[i] + vtkm::Vec3f_32(0.f, 0.f, 0.01f));
+    triangles.push_back(vtkm::Id4(static_cast<vtkm::Id>(i), first, first + 1, first + 2));
+  }
+  auto makeCoords = [](const std::vector<vtkm::Vec3f_32>& values) {
+    return vtkm::cont::CoordinateSystem("coords",
+                                        vtkm::cont::make_ArrayHandle(values, vtkm::CopyFlag::On));
+  };
+  vtkm::cont::ArrayHandle<vtkm::Id4> triangleArray =
+    vtkm::cont::make_ArrayHandle(triangles, vtkm::CopyFlag::On);
+
+  TestTriangleIntersector intersector;
+  intersector.SetData(makeCoords(points), triangleArray);
+  // Never construct a new tree because of the SAH cost, so refits can be told apart.
+  intersector.GetBVH().SetRefitThreshold(vtkm::Infinity32());
+  const std::vector<vtkm::Id> leafs = GetLeafs(intersector.GetBVH());
+
+  // Moving the points of the same triangles refits the tree, which keeps the leafs.
+  for (auto& point : points)
+  {
+    point = vtkm::Vec3f_32(point[1], point[0], point[2]);
+  }
+  vtkm::cont::CoordinateSystem movedCoords = makeCoords(points);
+  intersector.SetData(movedCoords, triangleArray);
+  VTKM_TEST_ASSERT(GetLeafs(intersector.GetBVH()) == leafs, "Tree of same shapes not refit.");
+
+  // As many triangles, but different ones, need a new tree.
+  std::reverse(triangles.begin(), triangles.end());
+  vtkm::cont::ArrayHandle<vtkm::Id4> reversedArray =
+    vtkm::cont::make_ArrayHandle(triangles, vtkm::CopyFlag::On);
+  intersector.SetData(movedCoords, reversedArray);
+  TestTriangleIntersector constructed;
+  constructed.SetData(movedCoords, reversedArray);
+  VTKM_TEST_ASSERT(GetLeafs(intersector.GetBVH()) == GetLeafs(constructed.GetBVH()),
+                   "Tree of new shapes not constructed.");
+}
+
+void TestBoundingVolumeHierarchy()
+{
+  TestRefit();
+  TestTreelet();
+  TestWide();
+  TestWideTraversal();
+  TestIntersectorRefit();
+}
+
+} // anonymous namespace
+
+int UnitTestBoundingVolumeHierarchy(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestBoundingVolumeHierarchy, argc, argv);
+}
@@ -0,0 +1,185 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/rendering/CanvasRayTracer.h>
+#include <vtkm/rendering/Compositor.h>
+
+#include <vector>
+
+namespace
+{
+
+constexpr vtkm::Id Width = 43;
+constexpr vtkm::Id Height = 23;
+constexpr vtkm::Id NumImages = 6;
+
+// Image i covers a band of columns, overlapping its neighbors, with a depth that depends
+// on the row so that images are in front of each other in different parts of the image.
+bool Covers(vtkm::Id image, vtkm::Id x)
+{
+  return x >= image * 6 && x < image * 6 + 12;
+}
+
+vtkm::Float32 Depth(vtkm::Id image, vtkm::Id y)
+{
+  return static_cast<vtkm::Float32>((image * 7 + y * 3) % 11) / 11.0f;
+}
+
+vtkm::Vec4f_32 Color(vtkm::Id image, vtkm::Id x, vtkm::Id y)
+{
+  vtkm::Float32 alpha = 0.25f + 0.1f * static_cast<vtkm::Float32>(image);
+  vtkm::Vec4f_32 color(static_cast<vtkm::Float32>(x) / static_cast<vtkm::Float32>(Width),
+                       static_cast<vtkm::Float32>(y) / static_cast<vtkm::Float32>(Height),
+                       static_cast<vtkm::Float32>(image) / static_cast<vtkm::Float32>(NumImages),
+                       1.0f);
+  return color * alpha;
+}
+
+vtkm::rendering::CanvasRayTracer MakeImage(vtkm::Id image)
+{
+  vtkm::rendering::CanvasRayTracer canvas(Width, Height);
+  canvas.Clear();
+  auto colors = canvas.GetColorBuffer().WritePortal();
+  auto depths = canvas.GetDepthBuffer().WritePortal();
+  for (vtkm::Id y = 0; y < Height; ++y)
+  {
+    for (vtkm::Id x = 0; x < Width; ++x)
+    {
+      if (Covers(image, x))
+      {
+        colors.Set(y * Width + x, Color(image, x, y));
+        depths.Set(y * Width + x, Depth(image, y));
+      }
+    }
+  }
+  return canvas;
+}
+
+void CheckResult(const vtkm::rendering::Canvas& canvas,
+                 vtkm::rendering::Compositor::CompositeMode mode,
+                 const std::vector<vtkm::Id>& visibilityOrder)
+{
+  auto colors = canvas.GetColorBuffer().ReadPortal();
+  auto depths = canvas.GetDepthBuffer().ReadPortal();
+  for (vtkm::Id y = 0; y < Height; ++y)
+  {
+    for (vtkm::Id x = 0; x < Width; ++x)
+    {
+      vtkm::Vec4f_32 expectedColor(0.0f);
+      vtkm::Float32 expectedDepth = VTKM_DEFAULT_CANVAS_DEPTH;
+      for (vtkm::Id order = 0; order < NumImages; ++order)
+      {
+        vtkm::Id image = visibilityOrder[static_cast<std::size_t>(order)];
+        if (!Covers(image, x))
+        {
+          continue;
+        }
+        if (mode == vtkm::rendering::Compositor::CompositeMode::ZBuffer)
+        {
+          if (Depth(image, y) < expectedDepth)
+          {
+            expectedColor = Color(image, x, y);
+            expectedDepth = Depth(image, y);
+          }
+        }
+        else
+        {
+          expectedColor = expectedColor + Color(image, x, y) * (1.0f - expectedColor[3]);
+          expectedDepth = vtkm::Min(expectedDepth, Depth(image, y));
+        }
+      }
+      VTKM_TEST_ASSERT(test_equal(colors.Get(y * Width + x), expectedColor),
+                       "Bad color at ",
+                       x,
+                       ", ",
+                       y);
+      VTKM_TEST_ASSERT(test_equal(depths.Get(y * Width + x), expectedDepth),
+                       "Bad depth at ",
+                       x,
+                       ", ",
+                       y);
+    }
+  }
+}
+
+void TestComposite(vtkm::rendering::Compositor::CompositeMode mode, vtkm::IdComponent radix)
+{
+  std::cout << "Compositing " << NumImages << " images with radix " << radix << " in "
+            << (mode == vtkm::rendering::Compositor::CompositeMode::ZBuffer ? "z-buffer"
+                                                                             : "visibility order")
+            << " mode" << std::endl;
+
+  // Images are added out of visibility order to check that the blending follows the order.
+  std::vector<vtkm::Id> visibilityOrder = { 3, 0, 5, 4, 1, 2 };
+
+  vtkm::rendering::Compositor compositor;
+  compositor.SetCompositeMode(mode);
+  compositor.SetRadix(radix);
+  for (vtkm::Id order = 0; order < NumImages; ++order)
+  {
+    vtkm::Id image = visibilityOrder[static_cast<std::size_t>(order)];
+    compositor.AddImage(MakeImage(image), order);
+  }
+  VTKM_TEST_ASSERT(compositor.GetNumberOfImages() == NumImages);
+
+  vtkm::rendering::CanvasRayTracer result(1, 1);
+  VTKM_TEST_ASSERT(compositor.Composite(result), "Image not composited on this rank.");
+  VTKM_TEST_ASSERT(result.GetWidth() == Width && result.GetHeight() == Height);
+  CheckResult(result, mode, visibilityOrder);
+
+  // Each image covers less than half of the image, so the empty pixels are not sent.
+  std::cout << "  sent " << compositor.GetNumberOfPixelsSent() << " pixels" << std::endl;
+  VTKM_TEST_ASSERT(compositor.GetNumberOfPixelsSent() < NumImages * Width * Height / 2);
+}
+
+void TestBadInput()
+{
+  vtkm::rendering::Compositor compositor;
+  try
+  {
+    compositor.SetRadix(1);
+    VTKM_TEST_FAIL("Did not reject a radix of 1.");
+  }
+  catch (const vtkm::cont::ErrorBadValue&)
+  {
+  }
+
+  compositor.SetCompositeMode(vtkm::rendering::Compositor::CompositeMode::VisibilityOrder);
+  compositor.AddImage(MakeImage(0), 0);
+  compositor.AddImage(MakeImage(1), 2);
+  vtkm::rendering::CanvasRayTracer result(Width, Height);
+  try
+  {
+    compositor.Composite(result);
+    VTKM_TEST_FAIL("Did not reject visibility orders with a gap.");
+  }
+  catch (const vtkm::cont::ErrorBadValue&)
+  {
+  }
+}
+
+void TestCompositor()
+{
+  for (vtkm::IdComponent radix : { 2, 3, 8 })
+  {
+    TestComposite(vtkm::rendering::Compositor::CompositeMode::ZBuffer, radix);
+    TestComposite(vtkm::rendering::Compositor::CompositeMode::VisibilityOrder, radix);
+  }
+  TestBadInput();
+}
+
+} // anonymous namespace
+
+int UnitTestCompositor(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestCompositor, argc, argv);
+}
@@ -36,6 +36,8 @@
 
 #include <vtkm/BinaryOperators.h>
 
+#include <vector>
+
 namespace vtkm
 {
 namespace worklet
@@ -141,6 +143,9 @@ enum class KeysSortType
 /// Keys structure is reused for all the \c Invoke. This is more efficient than
 /// creating a different \c Keys structure for each \c Invoke.
 ///
+/// Building the arrays can skip work when the caller knows something about the
+/// keys. See \c SetCheckPresorted and \c SetReuseArrays.
+///
 template <typename T>
 class VTKM_ALWAYS_EXPORT Keys : public internal::KeysBase
 {
@@ -185,6 +190,26 @@ public:
     KeysSortType sort,
     vtkm::cont::DeviceAdapterId device = vtkm::cont::DeviceAdapterTagAny());
 
+  /// When true, the arrays check whether the keys are already sorted, or already have all
+  /// equal keys next to each other, and then avoid sorting them again. The check takes a pass
+  /// over the keys, so it only pays off when such keys are likely. Off by default.
+  ///
+  VTKM_CONT bool GetCheckPresorted() const { return this->CheckPresorted; }
+  VTKM_CONT void SetCheckPresorted(bool flag) { this->CheckPresorted = flag; }
+
+  /// When true, \c BuildArrays remembers the key array it was given. If it is called again
+  /// with the same key array and sort type, and the keys have not been written to since (for
+  /// example, on a new time step that uses the same keys), the existing arrays are reused.
+  /// Writes are detected with \c vtkm::cont::internal::Buffer::GetModifiedStamp. Off by
+  /// default.
+  ///
+  VTKM_CONT bool GetReuseArrays() const { return this->ReuseArrays; }
+  VTKM_CONT void SetReuseArrays(bool flag)
+  {
+    this->ReuseArrays = flag;
+    this->KeysModifiedStamps.clear();
+  }
+
   VTKM_CONT
   KeyArrayHandleType GetUniqueKeys() const { return this->UniqueKeys; }
 
@@ -231,9 +256,29 @@ private:
   /// @cond NONE
   KeyArrayHandleType UniqueKeys;
 
+  // Identifies the keys last given to BuildArrays so that the arrays can be reused.
+  std::vector<vtkm::UInt64> KeysModifiedStamps;
+  KeysSortType KeysSort = KeysSortType::Unstable;
+  bool CheckPresorted = false;
+  bool ReuseArrays = false;
+
   template <typename KeyArrayType>
   VTKM_CONT void BuildArraysInternal(KeyArrayType& keys, vtkm::cont::DeviceAdapterId device);
 
+  // Builds the arrays without sorting if the keys are sorted or grouped. Returns false
+  // otherwise.
+  template <typename KeyArrayType>
+  VTKM_CONT bool BuildArraysPresorted(const KeyArrayType& keys,
+                                      vtkm::cont::DeviceAdapterId device);
+
+  template <typename KeyArrayType>
+  VTKM_CONT void BuildArraysSorted(const KeyArrayType& keys, vtkm::cont::DeviceAdapterId device);
+
+  template <typename KeyArrayType>
+  VTKM_CONT bool BuildArraysGrouped(const KeyArrayType& keys,
+                                    vtkm::Id numRuns,
+                                    vtkm::cont::DeviceAdapterId device);
+
   template <typename KeyArrayType>
   VTKM_CONT void BuildArraysInternalStable(const KeyArrayType& keys,
                                            vtkm::cont::DeviceAdapterId device);
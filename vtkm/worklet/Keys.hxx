@@ -12,10 +12,67 @@
 
 #include <vtkm/worklet/Keys.h>
 
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/ArrayHandleView.h>
+#include <vtkm/cont/ArrayHandleZip.h>
+
+#include <vtkm/BinaryPredicates.h>
+
 namespace vtkm
 {
 namespace worklet
 {
+namespace detail
+{
+
+// Compares each key with the next key. The first component is 1 if the keys differ, and the
+// second component is 1 if the keys are out of order.
+struct KeysCompareNeighbors
+{
+  template <typename T>
+  VTKM_EXEC_CONT vtkm::Id2 operator()(const vtkm::Pair<T, T>& neighbors) const
+  {
+    return vtkm::Id2((neighbors.first != neighbors.second) ? 1 : 0,
+                     vtkm::SortLess{}(neighbors.second, neighbors.first) ? 1 : 0);
+  }
+};
+
+// Returns the number of times neighboring keys change value and the number of times neighboring
+// keys are out of order. This takes a single pass over the keys, which is much cheaper than
+// sorting them.
+template <typename KeyArrayType>
+VTKM_CONT vtkm::Id2 CompareNeighborKeys(const KeyArrayType& keys,
+                                        vtkm::cont::DeviceAdapterId device)
+{
+  const vtkm::Id numKeys = keys.GetNumberOfValues();
+  if (numKeys < 2)
+  {
+    return vtkm::Id2(0, 0);
+  }
+
+  auto neighbors = vtkm::cont::make_ArrayHandleZip(
+    vtkm::cont::make_ArrayHandleView(keys, 0, numKeys - 1),
+    vtkm::cont::make_ArrayHandleView(keys, 1, numKeys - 1));
+  return vtkm::cont::Algorithm::Reduce(
+    device,
+    vtkm::cont::make_ArrayHandleTransform(neighbors, KeysCompareNeighbors{}),
+    vtkm::Id2(0, 0),
+    vtkm::Sum());
+}
+
+template <typename KeyArrayType>
+VTKM_CONT std::vector<vtkm::UInt64> GetKeysModifiedStamps(const KeyArrayType& keys)
+{
+  std::vector<vtkm::UInt64> stamps;
+  for (auto&& buffer : keys.GetBuffers())
+  {
+    stamps.push_back(buffer.GetModifiedStamp());
+  }
+  return stamps;
+}
+
+} // namespace detail
+
 /// Build the internal arrays without modifying the input. This is more
 /// efficient for stable sorted arrays, but requires an extra copy of the
 /// keys for unstable sorting.
@@ -27,20 +84,40 @@ VTKM_CONT void Keys<T>::BuildArrays(const KeyArrayType& keys,
 {
   VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "Keys::BuildArrays");
 
-  switch (sort)
+  std::vector<vtkm::UInt64> stamps;
+  if (this->ReuseArrays)
   {
-    case KeysSortType::Unstable:
+    stamps = detail::GetKeysModifiedStamps(keys);
+    if (!stamps.empty() && (stamps == this->KeysModifiedStamps) && (sort == this->KeysSort))
     {
-      KeyArrayHandleType mutableKeys;
-      vtkm::cont::Algorithm::Copy(device, keys, mutableKeys);
-
-      this->BuildArraysInternal(mutableKeys, device);
+      VTKM_LOG_S(vtkm::cont::LogLevel::Perf, "Keys unchanged. Reusing arrays.");
+      return;
     }
-    break;
-    case KeysSortType::Stable:
-      this->BuildArraysInternalStable(keys, device);
+  }
+  this->KeysModifiedStamps.clear();
+
+  // Sorting is not necessary when the keys are already grouped together. Sorted and grouped keys
+  // keep equal keys in their original order, so this works for both sort types.
+  if (!this->CheckPresorted || !this->BuildArraysPresorted(keys, device))
+  {
+    switch (sort)
+    {
+      case KeysSortType::Unstable:
+      {
+        KeyArrayHandleType mutableKeys;
+        vtkm::cont::Algorithm::Copy(device, keys, mutableKeys);
+
+        this->BuildArraysInternal(mutableKeys, device);
+      }
       break;
+      case KeysSortType::Stable:
+        this->BuildArraysInternalStable(keys, device);
+        break;
+    }
   }
+
+  this->KeysModifiedStamps = std::move(stamps);
+  this->KeysSort = sort;
 }
 
 /// Build the internal arrays and also sort the input keys. This is more
@@ -54,23 +131,158 @@ VTKM_CONT void Keys<T>::BuildArraysInPlace(KeyArrayType& keys,
 {
   VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "Keys::BuildArraysInPlace");
 
-  switch (sort)
+  // The keys are modified, so these arrays cannot be reused for them.
+  this->KeysModifiedStamps.clear();
+
+  bool grouped = false;
+  bool permuteKeys = true;
+  if (this->CheckPresorted)
   {
-    case KeysSortType::Unstable:
-      this->BuildArraysInternal(keys, device);
-      break;
-    case KeysSortType::Stable:
+    const vtkm::Id2 neighbors = detail::CompareNeighborKeys(keys, device);
+    if (neighbors[1] == 0)
+    {
+      // Keys are already in place.
+      this->BuildArraysSorted(keys, device);
+      return;
+    }
+    grouped = this->BuildArraysGrouped(keys, neighbors[0] + 1, device);
+  }
+
+  if (!grouped)
+  {
+    switch (sort)
     {
-      this->BuildArraysInternalStable(keys, device);
-      KeyArrayHandleType tmp;
-      // Copy into a temporary array so that the permutation array copy
-      // won't alias input/output memory:
-      vtkm::cont::Algorithm::Copy(device, keys, tmp);
-      vtkm::cont::Algorithm::Copy(
-        device, vtkm::cont::make_ArrayHandlePermutation(this->SortedValuesMap, tmp), keys);
+      case KeysSortType::Unstable:
+        this->BuildArraysInternal(keys, device);
+        permuteKeys = false;
+        break;
+      case KeysSortType::Stable:
+        this->BuildArraysInternalStable(keys, device);
+        break;
     }
-    break;
   }
+
+  if (permuteKeys)
+  {
+    KeyArrayHandleType tmp;
+    // Copy into a temporary array so that the permutation array copy
+    // won't alias input/output memory:
+    vtkm::cont::Algorithm::Copy(device, keys, tmp);
+    vtkm::cont::Algorithm::Copy(
+      device, vtkm::cont::make_ArrayHandlePermutation(this->SortedValuesMap, tmp), keys);
+  }
+}
+
+template <typename T>
+template <typename KeyArrayType>
+VTKM_CONT bool Keys<T>::BuildArraysPresorted(const KeyArrayType& keys,
+                                             vtkm::cont::DeviceAdapterId device)
+{
+  const vtkm::Id2 neighbors = detail::CompareNeighborKeys(keys, device);
+  if (neighbors[1] == 0)
+  {
+    this->BuildArraysSorted(keys, device);
+    return true;
+  }
+  return this->BuildArraysGrouped(keys, neighbors[0] + 1, device);
+}
+
+template <typename T>
+template <typename KeyArrayType>
+VTKM_CONT void Keys<T>::BuildArraysSorted(const KeyArrayType& keys,
+                                          vtkm::cont::DeviceAdapterId device)
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "Keys::BuildArraysSorted");
+
+  const vtkm::Id numKeys = keys.GetNumberOfValues();
+
+  vtkm::cont::Algorithm::Copy(device, vtkm::cont::ArrayHandleIndex(numKeys), this->SortedValuesMap);
+
+  // Find the unique keys and the number of values per key.
+  vtkm::cont::Algorithm::ReduceByKey(device,
+                                     keys,
+                                     vtkm::cont::ArrayHandleConstant<vtkm::IdComponent>(1, numKeys),
+                                     this->UniqueKeys,
+                                     this->Counts,
+                                     vtkm::Sum());
+
+  // Get the offsets from the counts with a scan.
+  vtkm::cont::Algorithm::ScanExtended(
+    device, vtkm::cont::make_ArrayHandleCast(this->Counts, vtkm::Id()), this->Offsets);
+
+  VTKM_ASSERT(numKeys ==
+              vtkm::cont::ArrayGetValue(this->Offsets.GetNumberOfValues() - 1, this->Offsets));
+}
+
+template <typename T>
+template <typename KeyArrayType>
+VTKM_CONT bool Keys<T>::BuildArraysGrouped(const KeyArrayType& keys,
+                                           vtkm::Id numRuns,
+                                           vtkm::cont::DeviceAdapterId device)
+{
+  const vtkm::Id numKeys = keys.GetNumberOfValues();
+  if (numRuns > (numKeys / 2))
+  {
+    // Too many runs of equal keys for sorting the runs to be much cheaper than sorting the keys.
+    return false;
+  }
+
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "Keys::BuildArraysGrouped");
+
+  // Collapse each run of equal keys.
+  KeyArrayHandleType runKeys;
+  vtkm::cont::ArrayHandle<vtkm::IdComponent> runCounts;
+  vtkm::cont::Algorithm::ReduceByKey(device,
+                                     keys,
+                                     vtkm::cont::ArrayHandleConstant<vtkm::IdComponent>(1, numKeys),
+                                     runKeys,
+                                     runCounts,
+                                     vtkm::Sum());
+  VTKM_ASSERT(runKeys.GetNumberOfValues() == numRuns);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> runStarts;
+  vtkm::cont::Algorithm::ScanExtended(
+    device, vtkm::cont::make_ArrayHandleCast(runCounts, vtkm::Id()), runStarts);
+
+  // Sort the runs. The keys are grouped if no two runs have the same key.
+  vtkm::cont::ArrayHandle<vtkm::Id> runOrder;
+  vtkm::cont::Algorithm::Copy(device, vtkm::cont::ArrayHandleIndex(numRuns), runOrder);
+  vtkm::cont::Algorithm::SortByKey(device, runKeys, runOrder);
+  if (detail::CompareNeighborKeys(runKeys, device)[0] != (numRuns - 1))
+  {
+    return false;
+  }
+
+  this->UniqueKeys = runKeys;
+  vtkm::cont::Algorithm::Copy(
+    device, vtkm::cont::make_ArrayHandlePermutation(runOrder, runCounts), this->Counts);
+  vtkm::cont::Algorithm::ScanExtended(
+    device, vtkm::cont::make_ArrayHandleCast(this->Counts, vtkm::Id()), this->Offsets);
+
+  // The value at sorted index i comes from the run containing it. It is offset from the start of
+  // that run in the input by the same amount it is offset from the start of its group.
+  vtkm::cont::ArrayHandle<vtkm::Id> groupOfValue;
+  vtkm::cont::Algorithm::UpperBounds(device,
+                                     vtkm::cont::make_ArrayHandleView(this->Offsets, 1, numRuns),
+                                     vtkm::cont::ArrayHandleIndex(numKeys),
+                                     groupOfValue);
+  vtkm::cont::ArrayHandle<vtkm::Id> groupShift;
+  vtkm::cont::Algorithm::Transform(
+    device,
+    vtkm::cont::make_ArrayHandlePermutation(runOrder, runStarts),
+    vtkm::cont::make_ArrayHandleView(this->Offsets, 0, numRuns),
+    groupShift,
+    vtkm::Subtract());
+  vtkm::cont::Algorithm::Transform(
+    device,
+    vtkm::cont::ArrayHandleIndex(numKeys),
+    vtkm::cont::make_ArrayHandlePermutation(groupOfValue, groupShift),
+    this->SortedValuesMap,
+    vtkm::Sum());
+
+  VTKM_ASSERT(numKeys ==
+              vtkm::cont::ArrayGetValue(this->Offsets.GetNumberOfValues() - 1, this->Offsets));
+  return true;
 }
 
 template <typename T>
@@ -59,6 +59,29 @@ struct BoundingIntervalHierarchyTester : public vtkm::worklet::WorkletMapField
   }
 }; // struct BoundingIntervalHierarchyTester
 
+struct BoundingIntervalHierarchyHintTester : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, ExecObject, FieldIn, FieldOut);
+  typedef _4 ExecutionSignature(_1, _2, _3);
+
+  template <typename Point, typename BoundingIntervalHierarchyExecObject>
+  VTKM_EXEC vtkm::IdComponent operator()(const Point& point,
+                                         const BoundingIntervalHierarchyExecObject& bih,
+                                         const vtkm::Id expectedId) const
+  {
+    vtkm::Vec3f parametric;
+    vtkm::Id cellId = -1;
+    typename BoundingIntervalHierarchyExecObject::LastCell lastCell;
+    // Prime the hint with a point in a neighboring cell.
+    bih.FindCell(point + Point(1, 0, 0), cellId, parametric, lastCell);
+    bih.FindCell(point, cellId, parametric, lastCell);
+    vtkm::IdComponent numDiffs = (1 - static_cast<vtkm::IdComponent>(expectedId == cellId));
+    // Again with the hint holding this cell.
+    bih.FindCell(point, cellId, parametric, lastCell);
+    return numDiffs + (1 - static_cast<vtkm::IdComponent>(expectedId == cellId));
+  }
+}; // struct BoundingIntervalHierarchyHintTester
+
 vtkm::cont::DataSet ConstructDataSet(vtkm::Id size)
 {
   return vtkm::cont::DataSetBuilderUniform().Create(vtkm::Id3(size, size, size));
@@ -89,6 +112,11 @@ void TestBoundingIntervalHierarchy(vtkm::cont::DataSet dataSet, vtkm::IdComponen
 
   vtkm::Id numDiffs = vtkm::cont::Algorithm::Reduce(results, 0, vtkm::Add());
   VTKM_TEST_ASSERT(numDiffs == 0, "Calculated cell Ids not the same as expected cell Ids");
+
+  vtkm::worklet::DispatcherMapField<BoundingIntervalHierarchyHintTester>().Invoke(
+    centroids, bih, expectedCellIds, results);
+  numDiffs = vtkm::cont::Algorithm::Reduce(results, 0, vtkm::Add());
+  VTKM_TEST_ASSERT(numDiffs == 0, "Cell Ids found with last cell hint not as expected");
 }
 
 void RunTest()
@@ -9,9 +9,12 @@
 //============================================================================
 
 #include <vtkm/worklet/Keys.h>
+#include <vtkm/worklet/Keys.hxx>
 
 #include <vtkm/cont/ArrayCopy.h>
 
+#include <algorithm>
+
 #include <vtkm/cont/testing/Testing.h>
 
 // Make sure deprecated types still work (while applicable)
@@ -83,6 +86,159 @@ void TryKeyType(KeyType)
                  keys.GetCounts().ReadPortal());
 }
 
+template <typename KeyType>
+void CheckKeys(const vtkm::cont::ArrayHandle<KeyType>& originalKeys,
+               const vtkm::worklet::Keys<KeyType>& keys,
+               vtkm::worklet::KeysSortType sort)
+{
+  CheckKeyReduce(originalKeys.ReadPortal(),
+                 keys.GetUniqueKeys().ReadPortal(),
+                 keys.GetSortedValuesMap().ReadPortal(),
+                 keys.GetOffsets().ReadPortal(),
+                 keys.GetCounts().ReadPortal());
+
+  auto uniqueKeys = keys.GetUniqueKeys().ReadPortal();
+  for (vtkm::Id index = 1; index < uniqueKeys.GetNumberOfValues(); ++index)
+  {
+    VTKM_TEST_ASSERT(vtkm::SortLess{}(uniqueKeys.Get(index - 1), uniqueKeys.Get(index)),
+                     "Unique keys not sorted.");
+  }
+
+  if (sort == vtkm::worklet::KeysSortType::Stable)
+  {
+    auto sortedValuesMap = keys.GetSortedValuesMap().ReadPortal();
+    auto offsets = keys.GetOffsets().ReadPortal();
+    for (vtkm::Id uniqueIndex = 0; uniqueIndex < uniqueKeys.GetNumberOfValues(); ++uniqueIndex)
+    {
+      for (vtkm::Id index = offsets.Get(uniqueIndex) + 1; index < offsets.Get(uniqueIndex + 1);
+           ++index)
+      {
+        VTKM_TEST_ASSERT(sortedValuesMap.Get(index - 1) < sortedValuesMap.Get(index),
+                         "Stable sort did not keep values in order.");
+      }
+    }
+  }
+}
+
+template <typename KeyType>
+void TryKeyOrder(const vtkm::cont::ArrayHandle<KeyType>& keyArray)
+{
+  for (auto sort : { vtkm::worklet::KeysSortType::Unstable, vtkm::worklet::KeysSortType::Stable })
+  {
+    vtkm::worklet::Keys<KeyType> keys;
+    keys.SetCheckPresorted(true);
+    keys.BuildArrays(keyArray, sort);
+    CheckKeys(keyArray, keys, sort);
+
+    vtkm::cont::ArrayHandle<KeyType> sortedKeys;
+    vtkm::cont::ArrayCopy(keyArray, sortedKeys);
+    vtkm::worklet::Keys<KeyType> keysInPlace;
+    keysInPlace.SetCheckPresorted(true);
+    keysInPlace.BuildArraysInPlace(sortedKeys, sort);
+    CheckKeys(keyArray, keysInPlace, sort);
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+      sortedKeys,
+      vtkm::cont::make_ArrayHandlePermutation(keysInPlace.GetSortedValuesMap(), keyArray)));
+  }
+}
+
+template <typename KeyType>
+void TryKeyOrders(KeyType)
+{
+  constexpr vtkm::Id groupSize = 10;
+  constexpr vtkm::Id numGroups = (ARRAY_SIZE + groupSize - 1) / groupSize;
+
+  std::vector<KeyType> keyBuffer(ARRAY_SIZE);
+
+  std::cout << "  Sorted keys" << std::endl;
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    keyBuffer[static_cast<std::size_t>(index)] = TestValue(index % NUM_UNIQUE, KeyType());
+  }
+  std::sort(keyBuffer.begin(), keyBuffer.end(), vtkm::SortLess{});
+  TryKeyOrder(vtkm::cont::make_ArrayHandle(keyBuffer, vtkm::CopyFlag::On));
+
+  std::cout << "  Grouped keys" << std::endl;
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    // 37 and numGroups are coprime, so each group gets a different key.
+    keyBuffer[static_cast<std::size_t>(index)] =
+      TestValue(((index / groupSize) * 37) % numGroups, KeyType());
+  }
+  TryKeyOrder(vtkm::cont::make_ArrayHandle(keyBuffer, vtkm::CopyFlag::On));
+
+  std::cout << "  Runs of keys that are not grouped" << std::endl;
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    keyBuffer[static_cast<std::size_t>(index)] =
+      TestValue((index / groupSize) % (numGroups / 3), KeyType());
+  }
+  TryKeyOrder(vtkm::cont::make_ArrayHandle(keyBuffer, vtkm::CopyFlag::On));
+
+  std::cout << "  Unordered keys" << std::endl;
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    keyBuffer[static_cast<std::size_t>(index)] = TestValue(index % NUM_UNIQUE, KeyType());
+  }
+  TryKeyOrder(vtkm::cont::make_ArrayHandle(keyBuffer, vtkm::CopyFlag::On));
+}
+
+vtkm::UInt64 GetModifiedStamp(const vtkm::cont::ArrayHandle<vtkm::Id>& array)
+{
+  return array.GetBuffers()[0].GetModifiedStamp();
+}
+
+void TestKeysReuse()
+{
+  std::cout << "Testing reuse of Keys." << std::endl;
+  std::vector<vtkm::Id> keyBuffer(ARRAY_SIZE);
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    keyBuffer[static_cast<std::size_t>(index)] = TestValue(index % NUM_UNIQUE, vtkm::Id());
+  }
+  vtkm::cont::ArrayHandle<vtkm::Id> keyArray =
+    vtkm::cont::make_ArrayHandle(keyBuffer, vtkm::CopyFlag::On);
+
+  // Arrays are only reused when asked for.
+  vtkm::worklet::Keys<vtkm::Id> keys;
+  keys.BuildArrays(keyArray, vtkm::worklet::KeysSortType::Unstable);
+  vtkm::UInt64 stamp = GetModifiedStamp(keys.GetSortedValuesMap());
+  keys.BuildArrays(keyArray, vtkm::worklet::KeysSortType::Unstable);
+  VTKM_TEST_ASSERT(GetModifiedStamp(keys.GetSortedValuesMap()) != stamp,
+                   "Keys arrays reused without asking.");
+
+  keys.SetReuseArrays(true);
+  keys.BuildArrays(keyArray, vtkm::worklet::KeysSortType::Unstable);
+  stamp = GetModifiedStamp(keys.GetSortedValuesMap());
+
+  // Same keys and same sort reuse the arrays.
+  keys.BuildArrays(keyArray, vtkm::worklet::KeysSortType::Unstable);
+  VTKM_TEST_ASSERT(GetModifiedStamp(keys.GetSortedValuesMap()) == stamp,
+                   "Keys arrays not reused.");
+
+  // A different sort type builds new arrays.
+  keys.BuildArrays(keyArray, vtkm::worklet::KeysSortType::Stable);
+  VTKM_TEST_ASSERT(GetModifiedStamp(keys.GetSortedValuesMap()) != stamp,
+                   "Keys arrays wrongly reused.");
+  stamp = GetModifiedStamp(keys.GetSortedValuesMap());
+
+  // Modifying the keys builds new arrays, even when the portal is still held afterward.
+  auto keyPortal = keyArray.WritePortal();
+  keyPortal.Set(0, -1);
+  keys.BuildArrays(keyArray, vtkm::worklet::KeysSortType::Stable);
+  VTKM_TEST_ASSERT(GetModifiedStamp(keys.GetSortedValuesMap()) != stamp,
+                   "Keys arrays wrongly reused.");
+  VTKM_TEST_ASSERT(keys.GetUniqueKeys().ReadPortal().Get(0) == -1);
+  VTKM_TEST_ASSERT(keys.GetSortedValuesMap().ReadPortal().Get(0) == 0);
+  CheckKeys(keyArray, keys, vtkm::worklet::KeysSortType::Stable);
+
+  keyPortal.Set(1, -2);
+  keys.BuildArrays(keyArray, vtkm::worklet::KeysSortType::Stable);
+  VTKM_TEST_ASSERT(keys.GetUniqueKeys().ReadPortal().Get(0) == -2);
+  VTKM_TEST_ASSERT(keys.GetSortedValuesMap().ReadPortal().Get(0) == 1);
+  CheckKeys(keyArray, keys, vtkm::worklet::KeysSortType::Stable);
+}
+
 void TestKeys()
 {
   std::cout << "Testing vtkm::Id keys." << std::endl;
@@ -96,6 +252,14 @@ void TestKeys()
 
   std::cout << "Testing vtkm::Id3 keys." << std::endl;
   TryKeyType(vtkm::Id3());
+
+  std::cout << "Testing order of vtkm::Id keys." << std::endl;
+  TryKeyOrders(vtkm::Id());
+
+  std::cout << "Testing order of vtkm::Id3 keys." << std::endl;
+  TryKeyOrders(vtkm::Id3());
+
+  TestKeysReuse();
 }
 
 } // anonymous namespace